@@ -1,3 +1,12 @@
 include(CMakeFindDependencyMacro)
 
+find_dependency(LibXml2)
+find_dependency(Threads)
+
+# The decompression libraries are optional: they are looked for quietly so
+# that the targets linked against them (if any) are known to consumers.
+find_package(ZLIB QUIET)
+find_package(LibLZMA QUIET)
+find_package(BZip2 QUIET)
+
 include("${CMAKE_CURRENT_LIST_DIR}/crillab-autisTargets.cmake")
@@ -0,0 +1,529 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file BasicCnfParser.hpp
+ * @brief Provides a CNF parser that is specialized at compile-time for the object receiving the clauses.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_BASICCNFPARSER_HPP
+#define AUTIS_BASICCNFPARSER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <future>
+#include <vector>
+
+#include <crillab-except/except.hpp>
+
+#include "../core/MappedScanner.hpp"
+#include "../core/ParserConfiguration.hpp"
+#include "../core/ReservingSink.hpp"
+#include "../core/Scanner.hpp"
+#include "ClauseSink.hpp"
+
+namespace Autis {
+
+    /**
+     * The BasicCnfParser reads inputs written using the CNF format, and gives
+     * the clauses it reads to a sink whose type is known at compile-time.
+     * This allows calls to the sink to be inlined.
+     *
+     * @tparam Sink The type of the sink receiving the clauses.
+     */
+    template <Autis::ClauseSink Sink>
+    class BasicCnfParser {
+
+    private:
+
+        /**
+         * The maximum number of literals read at once from the input.
+         */
+        static constexpr std::size_t LITERAL_BUFFER_SIZE = 256;
+
+        /**
+         * The number of characters read by a thread at once when the input is
+         * read in parallel.
+         * The input is only read in parallel when it has at least two chunks.
+         */
+        static constexpr std::size_t CHUNK_SIZE = 1 << 20;
+
+        /**
+         * The number of chunks that may be read ahead of the chunk given to
+         * the sink, for each thread.
+         * This bounds the number of literals kept in memory at any time.
+         */
+        static constexpr std::size_t CHUNKS_PER_THREAD = 2;
+
+        /**
+         * The number of literals from which a batch of clauses is given to
+         * the sink.
+         */
+        static constexpr std::size_t BATCH_SIZE = 1 << 16;
+
+        /**
+         * The Chunk gathers the literals read by a thread from a part of the
+         * input.
+         */
+        struct Chunk {
+
+            /**
+             * The literals that have been read, including the 0s ending
+             * the clauses.
+             */
+            std::vector<int> literals;
+
+            /**
+             * The position at which the thread had to stop, because it read
+             * something it could not interpret by itself (null if the whole
+             * part has been read).
+             */
+            const char *stop = nullptr;
+
+        };
+
+        /**
+         * The scanner used to read the input.
+         */
+        Autis::Scanner &scanner;
+
+        /**
+         * The sink receiving the clauses.
+         */
+        Sink &sink;
+
+        /**
+         * The number of threads that may be used to read the clauses.
+         */
+        unsigned numberOfThreads;
+
+        /**
+         * The number of variables declared in the input.
+         */
+        int numberOfVariables;
+
+        /**
+         * The number of clauses declared in the input.
+         */
+        int numberOfConstraints;
+
+        /**
+         * The clause that is being read.
+         */
+        std::vector<int> clause;
+
+        /**
+         * Whether a clause is being read.
+         */
+        bool inClause;
+
+        /**
+         * The number of clauses that have been read so far.
+         */
+        int nbClausesRead;
+
+        /**
+         * The literals of the clauses in the current batch.
+         */
+        std::vector<std::int32_t> batchLiterals;
+
+        /**
+         * The offsets of the clauses in the current batch.
+         */
+        std::vector<std::size_t> batchOffsets;
+
+    public:
+
+        /**
+         * Creates a new BasicCnfParser.
+         *
+         * @param scanner The scanner used to read the input.
+         * @param sink The sink receiving the clauses.
+         * @param configuration The configuration of the parser.
+         */
+        BasicCnfParser(Autis::Scanner &scanner, Sink &sink,
+                const Autis::ParserConfiguration &configuration = Autis::ParserConfiguration());
+
+        /**
+         * Parses the input to read the clauses it contains.
+         *
+         * @throws ParseException If the input is not a well-formed CNF.
+         */
+        void parse();
+
+        /**
+         * Gives the number of variables declared in the input.
+         *
+         * @return The number of variables.
+         */
+        [[nodiscard]] int getNumberOfVariables() const;
+
+        /**
+         * Gives the number of clauses declared in the input.
+         *
+         * @return The number of clauses.
+         */
+        [[nodiscard]] int getNumberOfConstraints() const;
+
+    private:
+
+        /**
+         * Reads the clauses of the input, using several threads.
+         * The remaining input must be in memory, and start with a literal.
+         * The input is cut into chunks that are read by the threads, and whose
+         * literals are given to the sink in the order of the input as soon as
+         * they have been read.
+         * Only a few chunks are read ahead of the chunk given to the sink, so
+         * that the literals of the whole input are never in memory at once.
+         * If a thread reads something it cannot interpret (such as a misplaced
+         * problem description line or an ill-formed number), the scanner is
+         * moved to the position where this thread stopped, so that the rest
+         * of the input is read sequentially.
+         * If an exception is thrown while giving the literals to the sink, the
+         * chunks that are being read are abandoned.
+         */
+        void readInParallel();
+
+        /**
+         * Gives the end of the chunk starting at the given position, which is
+         * right after the end of a line.
+         *
+         * @param begin The first character of the chunk.
+         * @param end The character right after the last character of the input.
+         *
+         * @return The character right after the last character of the chunk.
+         */
+        static const char *endOfChunk(const char *begin, const char *end);
+
+        /**
+         * Reads the literals in a part of the input.
+         *
+         * @param begin The first character of the part to read.
+         * @param end The character right after the last character to read.
+         * @param cancelled Whether the chunks being read have been abandoned,
+         *        in which case reading stops as soon as possible.
+         *
+         * @return The chunk of literals that have been read.
+         */
+        static Chunk readChunk(const char *begin, const char *end, const std::atomic<bool> &cancelled);
+
+        /**
+         * Considers the next literal of the input.
+         *
+         * @param literal The literal to consider, which is 0 at the end of a
+         *        clause.
+         */
+        void addLiteral(int literal);
+
+        /**
+         * Ends the clause that is being read.
+         */
+        void endClause();
+
+        /**
+         * Gives the current batch of clauses to the sink, if it is not empty.
+         */
+        void flushBatch();
+
+        /**
+         * Checks whether the given literal is correct w.r.t. the expected
+         * number of variables.
+         *
+         * @param literal The literal to check.
+         *
+         * @return The given literal.
+         */
+        [[nodiscard]] int checkLiteral(int literal) const;
+
+    };
+
+    template <Autis::ClauseSink Sink>
+    BasicCnfParser<Sink>::BasicCnfParser(
+            Autis::Scanner &scanner, Sink &sink, const Autis::ParserConfiguration &configuration) :
+            scanner(scanner),
+            sink(sink),
+            numberOfThreads(configuration.getNumberOfThreads()),
+            numberOfVariables(0),
+            numberOfConstraints(0),
+            clause(),
+            inClause(false),
+            nbClausesRead(0),
+            batchLiterals(),
+            batchOffsets(1, 0) {
+        // Nothing to do: everything already initialized.
+    }
+
+    template <Autis::ClauseSink Sink>
+    void BasicCnfParser<Sink>::parse() {
+        int literals[LITERAL_BUFFER_SIZE];
+
+        try {
+            for (char next; scanner.look(next);) {
+                if (next == 'c') {
+                    // This is a comment to skip.
+                    scanner.skipLine();
+
+                } else if (next == 'p') {
+                    // This is the problem description line.
+                    scanner.read(numberOfVariables);
+                    scanner.read(numberOfConstraints);
+                    scanner.skipLine();
+
+                    if constexpr (Autis::ReservingSink<Sink>) {
+                        // The sink may now allocate what it needs for the problem.
+                        sink.reserve(numberOfVariables, numberOfConstraints);
+                    }
+
+                } else if ((numberOfThreads > 1) && scanner.isInMemory()
+                        && (static_cast<std::size_t>(scanner.getEnd() - scanner.getPosition()) >= 2 * CHUNK_SIZE)) {
+                    // The clauses are large enough to be read in parallel.
+                    readInParallel();
+
+                } else {
+                    // There are literals to read, as many as possible at once.
+                    std::size_t nbLiterals = scanner.readIntegers(literals, LITERAL_BUFFER_SIZE);
+                    if (nbLiterals == 0) {
+                        // The next literal cannot be read by the tokenizer.
+                        scanner.read(literals[0]);
+                        nbLiterals = 1;
+                    }
+
+                    for (std::size_t i = 0; i < nbLiterals; i++) {
+                        addLiteral(literals[i]);
+                    }
+                }
+            }
+
+        } catch (Except::ParseException &) {
+            // The clauses read before the error are still given to the sink.
+            flushBatch();
+            throw;
+        }
+
+        if (inClause) {
+            // The last clause has not been added.
+            endClause();
+        }
+        flushBatch();
+
+        if (nbClausesRead != numberOfConstraints) {
+            // The number of read clauses is not the expected one.
+            throw Except::ParseException("Unexpected number of clauses");
+        }
+    }
+
+    template <Autis::ClauseSink Sink>
+    int BasicCnfParser<Sink>::getNumberOfVariables() const {
+        return numberOfVariables;
+    }
+
+    template <Autis::ClauseSink Sink>
+    int BasicCnfParser<Sink>::getNumberOfConstraints() const {
+        return numberOfConstraints;
+    }
+
+    template <Autis::ClauseSink Sink>
+    void BasicCnfParser<Sink>::readInParallel() {
+        const char *end = scanner.getEnd();
+        const char *nextChunk = scanner.getPosition();
+        std::size_t maxPending = CHUNKS_PER_THREAD * numberOfThreads;
+        std::atomic<bool> cancelled(false);
+        std::deque<std::future<Chunk>> pending;
+
+        // Reading the first chunks of the input.
+        while ((pending.size() < maxPending) && (nextChunk < end)) {
+            const char *chunkEnd = endOfChunk(nextChunk, end);
+            pending.push_back(std::async(std::launch::async,
+                    readChunk, nextChunk, chunkEnd, std::cref(cancelled)));
+            nextChunk = chunkEnd;
+        }
+
+        const char *stop = end;
+        try {
+            // Considering the literals in the order of the input.
+            while (!pending.empty()) {
+                Chunk read = pending.front().get();
+                pending.pop_front();
+
+                if (read.stop != nullptr) {
+                    // The rest of the input must be read sequentially.
+                    cancelled = true;
+                    stop = read.stop;
+                    numberOfThreads = 1;
+                }
+
+                if (!cancelled && (nextChunk < end)) {
+                    // Another thread may start reading the next chunk.
+                    const char *chunkEnd = endOfChunk(nextChunk, end);
+                    pending.push_back(std::async(std::launch::async,
+                            readChunk, nextChunk, chunkEnd, std::cref(cancelled)));
+                    nextChunk = chunkEnd;
+                }
+
+                for (int literal : read.literals) {
+                    addLiteral(literal);
+                }
+
+                if (read.stop != nullptr) {
+                    // The chunks after this one have been abandoned.
+                    break;
+                }
+            }
+
+        } catch (...) {
+            // The chunks that are still being read are abandoned.
+            cancelled = true;
+            throw;
+        }
+
+        scanner.moveTo(stop);
+    }
+
+    template <Autis::ClauseSink Sink>
+    const char *BasicCnfParser<Sink>::endOfChunk(const char *begin, const char *end) {
+        if (static_cast<std::size_t>(end - begin) <= CHUNK_SIZE) {
+            // This is the last chunk.
+            return end;
+        }
+
+        auto endOfLine = static_cast<const char *>(std::memchr(begin + CHUNK_SIZE, '\n',
+                static_cast<std::size_t>(end - begin) - CHUNK_SIZE));
+        return (endOfLine == nullptr) ? end : (endOfLine + 1);
+    }
+
+    template <Autis::ClauseSink Sink>
+    typename BasicCnfParser<Sink>::Chunk BasicCnfParser<Sink>::readChunk(
+            const char *begin, const char *end, const std::atomic<bool> &cancelled) {
+        Chunk chunk;
+        Autis::MappedScanner chunkScanner(begin, end);
+        int literals[LITERAL_BUFFER_SIZE];
+
+        for (char next; (!cancelled.load(std::memory_order_relaxed)) && chunkScanner.look(next);) {
+            if (next == 'c') {
+                // This is a comment to skip.
+                chunkScanner.skipLine();
+                continue;
+            }
+
+            if (next == 'p') {
+                // The problem description line must be read sequentially.
+                chunk.stop = chunkScanner.getPosition();
+                break;
+            }
+
+            std::size_t nbLiterals = chunkScanner.readIntegers(literals, LITERAL_BUFFER_SIZE);
+            if (nbLiterals == 0) {
+                // The next literal cannot be read by the tokenizer.
+                const char *position = chunkScanner.getPosition();
+                try {
+                    chunkScanner.read(literals[0]);
+                    nbLiterals = 1;
+
+                } catch (Except::ParseException &) {
+                    // The error will be reported when reading sequentially.
+                    chunk.stop = position;
+                    break;
+                }
+            }
+
+            chunk.literals.insert(chunk.literals.end(), literals, literals + nbLiterals);
+        }
+
+        return chunk;
+    }
+
+    template <Autis::ClauseSink Sink>
+    void BasicCnfParser<Sink>::addLiteral(int literal) {
+        if (!inClause) {
+            // This is a new clause to read.
+            clause.clear();
+            inClause = true;
+            nbClausesRead++;
+        }
+
+        if (literal == 0) {
+            // This is the end of a clause.
+            endClause();
+
+        } else if constexpr (Autis::ClauseBatchSink<Sink>) {
+            // The literal is added to the batch if and only if it is correct.
+            batchLiterals.push_back(checkLiteral(literal));
+
+        } else {
+            // The literal is added if and only if it is correct.
+            clause.push_back(checkLiteral(literal));
+        }
+    }
+
+    template <Autis::ClauseSink Sink>
+    void BasicCnfParser<Sink>::endClause() {
+        inClause = false;
+
+        if constexpr (Autis::ClauseBatchSink<Sink>) {
+            // The clause is added to the current batch.
+            batchOffsets.push_back(batchLiterals.size());
+            if (batchLiterals.size() >= BATCH_SIZE) {
+                flushBatch();
+            }
+
+        } else {
+            // The clause is given on its own.
+            sink.addClause(clause);
+        }
+    }
+
+    template <Autis::ClauseSink Sink>
+    void BasicCnfParser<Sink>::flushBatch() {
+        if constexpr (Autis::ClauseBatchSink<Sink>) {
+            if (batchOffsets.size() <= 1) {
+                // There is no clause in the batch.
+                return;
+            }
+
+            sink.addClauses(std::span<const std::int32_t>(batchLiterals), std::span<const std::size_t>(batchOffsets));
+            batchLiterals.clear();
+            batchOffsets.resize(1);
+        }
+    }
+
+    template <Autis::ClauseSink Sink>
+    int BasicCnfParser<Sink>::checkLiteral(int literal) const {
+        // The magnitude of INT_MIN does not fit in an int, so it is never a variable.
+        if ((literal == 0) || (literal == INT_MIN) || (std::abs(literal) > numberOfVariables)) {
+            throw Except::ParseException("An invalid literal has been read");
+        }
+        return literal;
+    }
+
+}
+
+#endif
@@ -0,0 +1,388 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file BasicWcnfParser.hpp
+ * @brief Provides a WCNF parser that is specialized at compile-time for the object receiving the clauses.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_BASICWCNFPARSER_HPP
+#define AUTIS_BASICWCNFPARSER_HPP
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <span>
+#include <vector>
+
+#include <crillab-except/except.hpp>
+
+#include "../core/ReservingSink.hpp"
+#include "../core/Scanner.hpp"
+#include "ClauseSink.hpp"
+
+namespace Autis {
+
+    /**
+     * The BasicWcnfParser reads (weighted) MaxSAT problems written using the
+     * WCNF format, and gives the clauses it reads to a sink whose type is
+     * known at compile-time.
+     * Both the legacy format (with a "p wcnf" line, where hard clauses are
+     * those whose weight is at least the top cost) and the format used since
+     * the 2022 MaxSAT Evaluation (without any header, where hard clauses are
+     * prefixed by "h") are supported.
+     * Hard and soft clauses are streamed separately: soft clauses are given
+     * to the sink as soon as they are read, while hard clauses are gathered
+     * into bounded batches when the sink supports them.
+     * The memory used by this parser thus does not depend on the size of the
+     * input.
+     *
+     * @tparam Sink The type of the sink receiving the clauses.
+     */
+    template <Autis::WeightedClauseSink Sink>
+    class BasicWcnfParser {
+
+    private:
+
+        /**
+         * The number of literals from which a batch of hard clauses is given
+         * to the sink.
+         */
+        static constexpr std::size_t BATCH_SIZE = 1 << 16;
+
+        /**
+         * The scanner used to read the input.
+         */
+        Autis::Scanner &scanner;
+
+        /**
+         * The sink receiving the clauses.
+         */
+        Sink &sink;
+
+        /**
+         * Whether the input has a problem description line.
+         */
+        bool declared;
+
+        /**
+         * The number of variables declared in the input, or the greatest
+         * variable read so far if the input has no problem description line.
+         */
+        int numberOfVariables;
+
+        /**
+         * The number of clauses declared in the input, or read from the input
+         * if it has no problem description line.
+         */
+        int numberOfConstraints;
+
+        /**
+         * The top cost declared in the input, or 0 if there is none.
+         */
+        std::int64_t topCost;
+
+        /**
+         * The soft clause that is being read.
+         */
+        std::vector<int> clause;
+
+        /**
+         * The number of clauses that have been read so far.
+         */
+        int nbClausesRead;
+
+        /**
+         * The literals of the hard clauses in the current batch.
+         */
+        std::vector<std::int32_t> batchLiterals;
+
+        /**
+         * The offsets of the hard clauses in the current batch.
+         */
+        std::vector<std::size_t> batchOffsets;
+
+    public:
+
+        /**
+         * Creates a new BasicWcnfParser.
+         *
+         * @param scanner The scanner used to read the input.
+         * @param sink The sink receiving the clauses.
+         */
+        BasicWcnfParser(Autis::Scanner &scanner, Sink &sink);
+
+        /**
+         * Parses the input to read the clauses it contains.
+         *
+         * @throws ParseException If the input is not a well-formed WCNF.
+         */
+        void parse();
+
+        /**
+         * Gives the number of variables of the input.
+         *
+         * @return The number of variables declared in the input, or the
+         *         greatest variable appearing in the input if it has no
+         *         problem description line.
+         */
+        [[nodiscard]] int getNumberOfVariables() const;
+
+        /**
+         * Gives the number of clauses of the input.
+         *
+         * @return The number of clauses declared in the input, or read from
+         *         the input if it has no problem description line.
+         */
+        [[nodiscard]] int getNumberOfConstraints() const;
+
+    private:
+
+        /**
+         * Reads the problem description line of the legacy format.
+         */
+        void readProblemLine();
+
+        /**
+         * Reads a clause, prefixed by its weight or by "h", and gives it to
+         * the sink.
+         *
+         * @param next The first character of the clause.
+         */
+        void readClause(char next);
+
+        /**
+         * Reads the literals of a clause, up to the 0 ending it.
+         *
+         * @param literals The vector to which the literals are appended.
+         */
+        void readLiterals(std::vector<std::int32_t> &literals);
+
+        /**
+         * Gives the current batch of hard clauses to the sink, if it is not
+         * empty.
+         */
+        void flushBatch();
+
+        /**
+         * Checks whether the given literal is correct w.r.t. the expected
+         * number of variables.
+         *
+         * @param literal The literal to check.
+         *
+         * @return The given literal.
+         */
+        [[nodiscard]] int checkLiteral(int literal);
+
+    };
+
+    template <Autis::WeightedClauseSink Sink>
+    BasicWcnfParser<Sink>::BasicWcnfParser(Autis::Scanner &scanner, Sink &sink) :
+            scanner(scanner),
+            sink(sink),
+            declared(false),
+            numberOfVariables(0),
+            numberOfConstraints(0),
+            topCost(0),
+            clause(),
+            nbClausesRead(0),
+            batchLiterals(),
+            batchOffsets(1, 0) {
+        // Nothing to do: everything is already initialized.
+    }
+
+    template <Autis::WeightedClauseSink Sink>
+    void BasicWcnfParser<Sink>::parse() {
+        try {
+            for (char next; scanner.look(next);) {
+                if (next == 'c') {
+                    // This is a comment to skip.
+                    scanner.skipLine();
+
+                } else if (next == 'p') {
+                    // This is the problem description line.
+                    readProblemLine();
+
+                } else {
+                    // This is a clause.
+                    readClause(next);
+                }
+            }
+
+        } catch (Except::ParseException &) {
+            // The clauses read before the error are still given to the sink.
+            flushBatch();
+            throw;
+        }
+
+        flushBatch();
+
+        if (!declared) {
+            // The number of clauses is only known now.
+            numberOfConstraints = nbClausesRead;
+
+        } else if (nbClausesRead != numberOfConstraints) {
+            // The number of read clauses is not the expected one.
+            throw Except::ParseException("Unexpected number of clauses");
+        }
+    }
+
+    template <Autis::WeightedClauseSink Sink>
+    int BasicWcnfParser<Sink>::getNumberOfVariables() const {
+        return numberOfVariables;
+    }
+
+    template <Autis::WeightedClauseSink Sink>
+    int BasicWcnfParser<Sink>::getNumberOfConstraints() const {
+        return numberOfConstraints;
+    }
+
+    template <Autis::WeightedClauseSink Sink>
+    void BasicWcnfParser<Sink>::readProblemLine() {
+        if (declared || (nbClausesRead > 0)) {
+            throw Except::ParseException("Unexpected problem description line");
+        }
+
+        // Reading the "p wcnf" keywords.
+        char c;
+        (void) scanner.read();
+        if ((!scanner.look(c)) || (scanner.read() != 'w') || (scanner.read() != 'c') || (scanner.read() != 'n')
+                || (scanner.read() != 'f')) {
+            throw Except::ParseException("Keyword `wcnf' expected");
+        }
+
+        // Reading the size of the problem.
+        scanner.read(numberOfVariables);
+        scanner.read(numberOfConstraints);
+        declared = true;
+
+        // Reading the top cost, which is optional but must be on the same line.
+        while (scanner.peek(c) && ((c == ' ') || (c == '\t') || (c == '\r'))) {
+            scanner.advance();
+        }
+        if (scanner.peek(c) && (c != '\n')) {
+            scanner.readInt64(topCost);
+            if (topCost <= 0) {
+                throw Except::ParseException("Top cost must be positive");
+            }
+        }
+        scanner.skipLine();
+
+        if constexpr (Autis::ReservingSink<Sink>) {
+            // The sink may now allocate what it needs for the problem.
+            sink.reserve(numberOfVariables, numberOfConstraints);
+        }
+    }
+
+    template <Autis::WeightedClauseSink Sink>
+    void BasicWcnfParser<Sink>::readClause(char next) {
+        // Reading the weight of the clause.
+        bool hard;
+        std::int64_t weight = 0;
+        if (next == 'h') {
+            (void) scanner.read();
+            hard = true;
+
+        } else {
+            scanner.readInt64(weight);
+            if (weight <= 0) {
+                throw Except::ParseException("Weight of soft clause must be positive");
+            }
+            hard = (topCost > 0) && (weight >= topCost);
+        }
+        nbClausesRead++;
+
+        if (!hard) {
+            // The soft clause is given on its own.
+            clause.clear();
+            readLiterals(clause);
+            sink.addSoftClause(clause, weight);
+
+        } else if constexpr (Autis::ClauseBatchSink<Sink>) {
+            // The hard clause is added to the current batch.
+            readLiterals(batchLiterals);
+            batchOffsets.push_back(batchLiterals.size());
+            if (batchLiterals.size() >= BATCH_SIZE) {
+                flushBatch();
+            }
+
+        } else {
+            // The hard clause is given on its own.
+            clause.clear();
+            readLiterals(clause);
+            sink.addClause(clause);
+        }
+    }
+
+    template <Autis::WeightedClauseSink Sink>
+    void BasicWcnfParser<Sink>::readLiterals(std::vector<std::int32_t> &literals) {
+        for (int literal;;) {
+            scanner.read(literal);
+            if (literal == 0) {
+                // This is the end of the clause.
+                return;
+            }
+            literals.push_back(checkLiteral(literal));
+        }
+    }
+
+    template <Autis::WeightedClauseSink Sink>
+    void BasicWcnfParser<Sink>::flushBatch() {
+        if constexpr (Autis::ClauseBatchSink<Sink>) {
+            if (batchOffsets.size() <= 1) {
+                // There is no clause in the batch.
+                return;
+            }
+
+            sink.addClauses(std::span<const std::int32_t>(batchLiterals), std::span<const std::size_t>(batchOffsets));
+            batchLiterals.clear();
+            batchOffsets.resize(1);
+        }
+    }
+
+    template <Autis::WeightedClauseSink Sink>
+    int BasicWcnfParser<Sink>::checkLiteral(int literal) {
+        if (literal == INT_MIN) {
+            // The magnitude of INT_MIN does not fit in an int, so it is never a variable.
+            throw Except::ParseException("An invalid literal has been read");
+        }
+
+        int variable = std::abs(literal);
+        if (!declared) {
+            // The variables are only known once they appear.
+            if (variable > numberOfVariables) {
+                numberOfVariables = variable;
+            }
+
+        } else if (variable > numberOfVariables) {
+            throw Except::ParseException("An invalid literal has been read");
+        }
+        return literal;
+    }
+
+}
+
+#endif
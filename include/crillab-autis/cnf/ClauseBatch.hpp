@@ -0,0 +1,261 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file ClauseBatch.hpp
+ * @brief Gathers clauses read by a parser so that they can be given to a sink later.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_CLAUSEBATCH_HPP
+#define AUTIS_CLAUSEBATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <crillab-except/except.hpp>
+
+#include "../core/ReservingSink.hpp"
+#include "ClauseSink.hpp"
+
+namespace Autis {
+
+    /**
+     * The ClauseBatch gathers clauses read by a parser, stored in the same way
+     * as for an IClauseBatchListener, so that they can be given to a sink
+     * later (e.g., by another thread).
+     * A batch may also carry the size of the problem declared in the input.
+     * A batch is itself a ClauseBatchSink (and a ReservingSink and a
+     * WeightedClauseSink), so that a whole input may be read into a single
+     * batch.
+     */
+    struct ClauseBatch {
+
+        /**
+         * Whether this batch carries the size of the problem.
+         */
+        bool reservation = false;
+
+        /**
+         * The number of variables declared in the input, if this batch
+         * carries the size of the problem.
+         */
+        int nbVariables = 0;
+
+        /**
+         * The number of clauses declared in the input, if this batch carries
+         * the size of the problem.
+         */
+        int nbConstraints = 0;
+
+        /**
+         * The literals of the clauses in this batch.
+         */
+        std::vector<std::int32_t> literals;
+
+        /**
+         * The offsets of the clauses in the array of literals, followed by
+         * the number of literals.
+         */
+        std::vector<std::size_t> offsets = {0};
+
+        /**
+         * The weights of the clauses in this batch, where hard clauses have a
+         * weight of 0.
+         * This vector remains empty as long as all the clauses in this batch
+         * are hard.
+         */
+        std::vector<std::int64_t> weights;
+
+        /**
+         * Gives the number of clauses in this batch.
+         *
+         * @return The number of clauses.
+         */
+        [[nodiscard]] std::size_t size() const {
+            return offsets.size() - 1;
+        }
+
+        /**
+         * Records the size of the problem in this batch.
+         *
+         * @param nbVariables The number of variables declared in the input.
+         * @param nbClauses The number of clauses declared in the input.
+         */
+        void reserve(int nbVariables, int nbClauses) {
+            reservation = true;
+            this->nbVariables = nbVariables;
+            this->nbConstraints = nbClauses;
+        }
+
+        /**
+         * Adds a clause at the end of this batch.
+         *
+         * @param clause The literals of the clause.
+         */
+        void addClause(std::span<const int> clause) {
+            literals.insert(literals.end(), clause.begin(), clause.end());
+            offsets.push_back(literals.size());
+            if (!weights.empty()) {
+                // This is a hard clause.
+                weights.push_back(0);
+            }
+        }
+
+        /**
+         * Adds a soft clause at the end of this batch.
+         *
+         * @param clause The literals of the clause.
+         * @param weight The cost of falsifying the clause (which is positive).
+         */
+        void addSoftClause(std::span<const int> clause, std::int64_t weight) {
+            // The clauses before this one are all hard.
+            weights.resize(size(), 0);
+            literals.insert(literals.end(), clause.begin(), clause.end());
+            offsets.push_back(literals.size());
+            weights.push_back(weight);
+        }
+
+        /**
+         * Adds clauses at the end of this batch.
+         *
+         * @param clauseLiterals The literals of the clauses.
+         * @param clauseOffsets The offsets of the clauses in the array of
+         *        literals, followed by the number of literals in this array.
+         */
+        void addClauses(std::span<const std::int32_t> clauseLiterals, std::span<const std::size_t> clauseOffsets) {
+            // The offsets are shifted after the literals already in the batch.
+            std::size_t shift = literals.size() - clauseOffsets[0];
+            auto added = clauseLiterals.subspan(clauseOffsets[0], clauseOffsets.back() - clauseOffsets[0]);
+            literals.insert(literals.end(), added.begin(), added.end());
+            for (std::size_t i = 1; i < clauseOffsets.size(); i++) {
+                offsets.push_back(clauseOffsets[i] + shift);
+            }
+            if (!weights.empty()) {
+                // These are hard clauses.
+                weights.resize(size(), 0);
+            }
+        }
+
+        /**
+         * Gives the content of this batch to a sink.
+         *
+         * @tparam Sink The type of the sink receiving the clauses.
+         *
+         * @param sink The sink receiving the clauses.
+         * @param clause A vector that may be used to store a clause while it is
+         *        given to the sink, which may be reused from one batch to the
+         *        next.
+         */
+        template <Autis::ClauseSink Sink>
+        void replay(Sink &sink, std::vector<int> &clause) const {
+            if constexpr (Autis::ReservingSink<Sink>) {
+                if (reservation) {
+                    sink.reserve(nbVariables, nbConstraints);
+                }
+            }
+
+            if (size() == 0) {
+                // There is no clause in this batch.
+                return;
+            }
+
+            if (weights.empty()) {
+                // All the clauses are hard.
+                replayHard(sink, clause, 0, size());
+                return;
+            }
+
+            if constexpr (Autis::WeightedClauseSink<Sink>) {
+                // The runs of hard clauses are given between the soft clauses.
+                std::size_t begin = 0;
+                for (std::size_t i = 0; i < size(); i++) {
+                    if (weights[i] != 0) {
+                        replayHard(sink, clause, begin, i);
+                        auto clauseLiterals = literalsOf(i);
+                        clause.assign(clauseLiterals.begin(), clauseLiterals.end());
+                        sink.addSoftClause(clause, weights[i]);
+                        begin = i + 1;
+                    }
+                }
+                replayHard(sink, clause, begin, size());
+
+            } else {
+                throw Except::UnsupportedOperationException("Soft clauses not supported");
+            }
+        }
+
+    private:
+
+        /**
+         * Gives a run of consecutive hard clauses of this batch to a sink.
+         *
+         * @tparam Sink The type of the sink receiving the clauses.
+         *
+         * @param sink The sink receiving the clauses.
+         * @param clause A vector that may be used to store a clause while it is
+         *        given to the sink.
+         * @param begin The index of the first clause to give.
+         * @param end The index right after the last clause to give.
+         */
+        template <Autis::ClauseSink Sink>
+        void replayHard(Sink &sink, std::vector<int> &clause, std::size_t begin, std::size_t end) const {
+            if (begin == end) {
+                // There is no clause to give.
+                return;
+            }
+
+            if constexpr (Autis::ClauseBatchSink<Sink>) {
+                // The run is given in place, the literals being cut after its last clause.
+                sink.addClauses(std::span<const std::int32_t>(literals).first(offsets[end]),
+                        std::span<const std::size_t>(offsets).subspan(begin, end - begin + 1));
+
+            } else {
+                // The clauses are given one at a time.
+                for (std::size_t i = begin; i < end; i++) {
+                    auto clauseLiterals = literalsOf(i);
+                    clause.assign(clauseLiterals.begin(), clauseLiterals.end());
+                    sink.addClause(clause);
+                }
+            }
+        }
+
+        /**
+         * Gives the literals of a clause of this batch.
+         *
+         * @param index The index of the clause.
+         *
+         * @return The literals of the clause.
+         */
+        [[nodiscard]] std::span<const int> literalsOf(std::size_t index) const {
+            return std::span<const int>(literals).subspan(offsets[index], offsets[index + 1] - offsets[index]);
+        }
+
+    };
+
+}
+
+#endif
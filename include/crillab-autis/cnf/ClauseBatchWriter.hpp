@@ -0,0 +1,121 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file ClauseBatchWriter.hpp
+ * @brief Provides a sink filling batches of clauses into a queue.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_CLAUSEBATCHWRITER_HPP
+#define AUTIS_CLAUSEBATCHWRITER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "../core/SpscQueue.hpp"
+#include "ClauseBatch.hpp"
+
+namespace Autis {
+
+    /**
+     * The ClauseBatchWriter is a ClauseBatchSink (and a ReservingSink and a
+     * WeightedClauseSink) that gathers the clauses it receives into batches,
+     * and pushes these batches into a queue as soon as they are large enough.
+     * It is used on the producer side of a pipelined parse.
+     */
+    class ClauseBatchWriter {
+
+    private:
+
+        /**
+         * The number of literals from which a batch is pushed into the queue.
+         */
+        static constexpr std::size_t BATCH_SIZE = 1 << 16;
+
+        /**
+         * The queue into which batches are pushed.
+         */
+        Autis::SpscQueue<Autis::ClauseBatch> &queue;
+
+        /**
+         * The batch that is being filled.
+         */
+        Autis::ClauseBatch batch;
+
+    public:
+
+        /**
+         * Creates a new ClauseBatchWriter.
+         *
+         * @param queue The queue into which batches are pushed.
+         */
+        explicit ClauseBatchWriter(Autis::SpscQueue<Autis::ClauseBatch> &queue);
+
+        /**
+         * Records the size of the problem, which is pushed before the clauses
+         * that follow.
+         *
+         * @param nbVariables The number of variables declared in the input.
+         * @param nbConstraints The number of clauses declared in the input.
+         */
+        void reserve(int nbVariables, int nbConstraints);
+
+        /**
+         * Adds a soft clause to the current batch.
+         *
+         * @param clause The literals of the clause.
+         * @param weight The cost of falsifying the clause.
+         */
+        void addSoftClause(std::span<const int> clause, std::int64_t weight);
+
+        /**
+         * Adds a clause to the current batch.
+         *
+         * @param clause The literals of the clause.
+         */
+        void addClause(std::span<const int> clause);
+
+        /**
+         * Adds clauses to the current batch.
+         *
+         * @param literals The literals of the clauses.
+         * @param offsets The offsets of the clauses in the array of literals,
+         *        followed by the number of literals in this array.
+         */
+        void addClauses(std::span<const std::int32_t> literals, std::span<const std::size_t> offsets);
+
+        /**
+         * Pushes the current batch into the queue, if it is not empty.
+         *
+         * @throws PipelineCancelledException If the consumer has stopped.
+         */
+        void flush();
+
+    };
+
+}
+
+#endif
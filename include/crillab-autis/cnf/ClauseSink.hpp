@@ -0,0 +1,75 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file ClauseSink.hpp
+ * @brief Defines the concepts of the objects receiving the clauses read by a parser.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_CLAUSESINK_HPP
+#define AUTIS_CLAUSESINK_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace Autis {
+
+    /**
+     * A ClauseSink is any object to which clauses can be given one at a time,
+     * as a contiguous sequence of (non-zero) literals.
+     * The literals are only valid during the call.
+     */
+    template <typename Sink>
+    concept ClauseSink = requires(Sink &sink, std::span<const int> clause) {
+        sink.addClause(clause);
+    };
+
+    /**
+     * A ClauseBatchSink is a ClauseSink to which clauses can also be given by
+     * large batches, in the same way as to an IClauseBatchListener.
+     * Parsers always prefer batches when they are supported.
+     */
+    template <typename Sink>
+    concept ClauseBatchSink = ClauseSink<Sink> && requires(
+            Sink &sink, std::span<const std::int32_t> literals, std::span<const std::size_t> offsets) {
+        sink.addClauses(literals, offsets);
+    };
+
+    /**
+     * A WeightedClauseSink is a ClauseSink to which soft clauses can also be
+     * given one at a time, together with their weight.
+     * As for hard clauses, the literals are only valid during the call.
+     */
+    template <typename Sink>
+    concept WeightedClauseSink = ClauseSink<Sink> && requires(
+            Sink &sink, std::span<const int> clause, std::int64_t weight) {
+        sink.addSoftClause(clause, weight);
+    };
+
+}
+
+#endif
@@ -31,27 +31,68 @@
 #ifndef AUTIS_CNFPARSER_HPP
 #define AUTIS_CNFPARSER_HPP
 
+#include <cstddef>
+
 #include <crillab-universe/sat/IUniverseSatSolver.hpp>
 
 #include "../core/AbstractParser.hpp"
+#include "../core/IReservationListener.hpp"
+#include "../core/ParserConfiguration.hpp"
+#include "IClauseBatchListener.hpp"
 
 namespace Autis {
 
     /**
      * The CnfParser specializes AbstractParser to read inputs written
      * using the CNF format.
+     * It relies on a BasicCnfParser to feed its solver, which is viewed
+     * either as an IClauseBatchListener (if possible) or as an
+     * IUniverseSatSolver, and notified of the size of the problem if it is
+     * an IReservationListener.
      */
     class CnfParser : public Autis::AbstractParser {
 
+    private:
+
+        /**
+         * The maximum number of batches of clauses waiting to be given to the
+         * solver when the input is read in a pipeline.
+         */
+        static constexpr std::size_t PIPELINE_CAPACITY = 16;
+
+        /**
+         * The solver to feed while parsing, as a SAT solver.
+         */
+        Universe::IUniverseSatSolver *satSolver;
+
+        /**
+         * The solver as a batch listener, or null if it cannot receive batches
+         * of clauses.
+         */
+        Autis::IClauseBatchListener *batchListener;
+
+        /**
+         * The solver as a reservation listener, or null if it is not one.
+         */
+        Autis::IReservationListener *reservationListener;
+
+        /**
+         * The configuration of this parser.
+         */
+        Autis::ParserConfiguration configuration;
+
     public:
 
         /**
          * Creates a new CnfParser.
          *
          * @param scanner The scanner used to read the input stream.
-         * @param solver The solver to feed while parsing the instance.
+         * @param solver The solver to feed while parsing the instance, which
+         *        may be null if the parser is only used to build instances.
+         * @param configuration The configuration of the parser.
          */
-        explicit CnfParser(Autis::Scanner &scanner, Universe::IUniverseSatSolver *solver);
+        explicit CnfParser(Autis::Scanner &scanner, Universe::IUniverseSatSolver *solver,
+                const Autis::ParserConfiguration &configuration = Autis::ParserConfiguration());
 
         /**
          * Destroys this CnfParser.
@@ -63,6 +104,14 @@ namespace Autis {
          */
         void parse() override;
 
+        /**
+         * Parses the input to store the clauses it defines in the given
+         * instance, instead of feeding the solver.
+         *
+         * @param instance The instance in which to store the clauses.
+         */
+        void parse(Autis::Instance &instance) override;
+
     protected:
 
         /**
@@ -72,6 +121,29 @@ namespace Autis {
          */
         Universe::IUniverseSatSolver *getConcreteSolver() override;
 
+    private:
+
+        /**
+         * Parses the input, giving the clauses to the given sink.
+         *
+         * @tparam Sink The type of the sink receiving the clauses.
+         *
+         * @param sink The sink receiving the clauses.
+         */
+        template <typename Sink>
+        void parse(Sink &sink);
+
+        /**
+         * Parses the input on a dedicated thread, while the calling thread
+         * gives the clauses to the given sink.
+         *
+         * @tparam Sink The type of the sink receiving the clauses.
+         *
+         * @param sink The sink receiving the clauses.
+         */
+        template <typename Sink>
+        void parseInPipeline(Sink &sink);
+
     };
 
 }
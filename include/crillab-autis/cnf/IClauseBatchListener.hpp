@@ -0,0 +1,74 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file IClauseBatchListener.hpp
+ * @brief Defines an interface for solvers that can receive clauses by batches.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_ICLAUSEBATCHLISTENER_HPP
+#define AUTIS_ICLAUSEBATCHLISTENER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace Autis {
+
+    /**
+     * The IClauseBatchListener is an optional interface that a SAT solver may
+     * implement to receive the clauses read by a parser by large batches,
+     * rather than one clause at a time.
+     * When the solver does not implement it, the clauses are given to the
+     * solver one by one through IUniverseSatSolver::addClause().
+     */
+    class IClauseBatchListener {
+
+    public:
+
+        /**
+         * Destroys this IClauseBatchListener.
+         */
+        virtual ~IClauseBatchListener() = default;
+
+        /**
+         * Adds a batch of clauses to this solver.
+         * The literals of all the clauses are stored one after the other in
+         * a single array, and the i-th clause is made of the literals between
+         * offsets[i] (included) and offsets[i + 1] (excluded).
+         * The arrays are only valid during the call.
+         *
+         * @param literals The literals of the clauses in the batch.
+         * @param offsets The offsets of the clauses in the array of literals,
+         *        followed by the number of literals in this array.
+         *        There is thus one more offset than clauses.
+         */
+        virtual void addClauses(std::span<const std::int32_t> literals, std::span<const std::size_t> offsets) = 0;
+
+    };
+
+}
+
+#endif
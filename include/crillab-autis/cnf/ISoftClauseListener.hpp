@@ -0,0 +1,68 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file ISoftClauseListener.hpp
+ * @brief Defines the interface of the solvers receiving the soft clauses of MaxSAT problems.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_ISOFTCLAUSELISTENER_HPP
+#define AUTIS_ISOFTCLAUSELISTENER_HPP
+
+#include <cstdint>
+#include <vector>
+
+namespace Autis {
+
+    /**
+     * The ISoftClauseListener is an optional interface that a SAT solver may
+     * implement to receive the soft clauses of (weighted) MaxSAT problems.
+     * Hard clauses are still given through IUniverseSatSolver (or through
+     * IClauseBatchListener, if the solver implements it).
+     * When the solver does not implement it, reading a soft clause fails with
+     * an UnsupportedOperationException.
+     */
+    class ISoftClauseListener {
+
+    public:
+
+        /**
+         * Destroys this ISoftClauseListener.
+         */
+        virtual ~ISoftClauseListener() = default;
+
+        /**
+         * Adds a soft clause to this solver.
+         *
+         * @param clause The literals of the clause.
+         * @param weight The cost of falsifying the clause.
+         */
+        virtual void addSoftClause(const std::vector<int> &clause, std::int64_t weight) = 0;
+
+    };
+
+}
+
+#endif
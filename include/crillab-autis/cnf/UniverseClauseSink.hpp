@@ -0,0 +1,267 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file UniverseClauseSink.hpp
+ * @brief Adapts Universe SAT solvers to the ClauseSink concepts.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_UNIVERSECLAUSESINK_HPP
+#define AUTIS_UNIVERSECLAUSESINK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <crillab-except/except.hpp>
+#include <crillab-universe/sat/IUniverseSatSolver.hpp>
+
+#include "../core/IReservationListener.hpp"
+#include "IClauseBatchListener.hpp"
+#include "ISoftClauseListener.hpp"
+
+namespace Autis {
+
+    /**
+     * The UniverseClauseSink is a ClauseSink giving the clauses it receives
+     * to an IUniverseSatSolver.
+     * It is also a WeightedClauseSink, giving the soft clauses it receives to
+     * the solver if it is an ISoftClauseListener.
+     */
+    class UniverseClauseSink {
+
+    private:
+
+        /**
+         * The solver to which clauses are given.
+         */
+        Universe::IUniverseSatSolver *solver;
+
+        /**
+         * The solver as a reservation listener, or null if it is not one.
+         */
+        Autis::IReservationListener *reservationListener;
+
+        /**
+         * The solver as a soft clause listener, or null if it is not one.
+         */
+        Autis::ISoftClauseListener *softClauseListener;
+
+    public:
+
+        /**
+         * Creates a new UniverseClauseSink.
+         *
+         * @param solver The solver to which clauses are given.
+         * @param reservationListener The solver as a reservation listener, if
+         *        it is one.
+         * @param softClauseListener The solver as a soft clause listener, if
+         *        it is one.
+         */
+        explicit UniverseClauseSink(Universe::IUniverseSatSolver *solver,
+                Autis::IReservationListener *reservationListener = nullptr,
+                Autis::ISoftClauseListener *softClauseListener = nullptr) :
+                solver(solver),
+                reservationListener(reservationListener),
+                softClauseListener(softClauseListener) {
+            // Nothing to do: everything is already initialized.
+        }
+
+        /**
+         * Notifies the solver of the size of the problem, if it is an
+         * IReservationListener.
+         *
+         * @param nbVariables The number of variables declared in the input.
+         * @param nbConstraints The number of constraints declared in the input.
+         */
+        void reserve(int nbVariables, int nbConstraints) {
+            if (reservationListener != nullptr) {
+                reservationListener->reserve(nbVariables, nbConstraints);
+            }
+        }
+
+        /**
+         * Gives a clause to the solver, without copying it.
+         *
+         * @param clause The literals of the clause.
+         */
+        void addClause(const std::vector<int> &clause) {
+            solver->addClause(clause);
+        }
+
+        /**
+         * Gives a clause to the solver.
+         *
+         * @param clause The literals of the clause.
+         */
+        void addClause(std::span<const int> clause) {
+            solver->addClause(std::vector<int>(clause.begin(), clause.end()));
+        }
+
+        /**
+         * Gives a soft clause to the solver, without copying it.
+         *
+         * @param clause The literals of the clause.
+         * @param weight The cost of falsifying the clause.
+         *
+         * @throws UnsupportedOperationException If the solver is not an
+         *         ISoftClauseListener.
+         */
+        void addSoftClause(const std::vector<int> &clause, std::int64_t weight) {
+            if (softClauseListener == nullptr) {
+                throw Except::UnsupportedOperationException("Soft clauses not supported by the solver");
+            }
+            softClauseListener->addSoftClause(clause, weight);
+        }
+
+        /**
+         * Gives a soft clause to the solver.
+         *
+         * @param clause The literals of the clause.
+         * @param weight The cost of falsifying the clause.
+         *
+         * @throws UnsupportedOperationException If the solver is not an
+         *         ISoftClauseListener.
+         */
+        void addSoftClause(std::span<const int> clause, std::int64_t weight) {
+            addSoftClause(std::vector<int>(clause.begin(), clause.end()), weight);
+        }
+
+    };
+
+    /**
+     * The UniverseClauseBatchSink is a ClauseBatchSink giving the clauses it
+     * receives to an IClauseBatchListener.
+     * It is also a WeightedClauseSink, giving the soft clauses it receives to
+     * the solver if it is an ISoftClauseListener.
+     */
+    class UniverseClauseBatchSink {
+
+    private:
+
+        /**
+         * The listener to which clauses are given.
+         */
+        Autis::IClauseBatchListener *listener;
+
+        /**
+         * The solver as a reservation listener, or null if it is not one.
+         */
+        Autis::IReservationListener *reservationListener;
+
+        /**
+         * The solver as a soft clause listener, or null if it is not one.
+         */
+        Autis::ISoftClauseListener *softClauseListener;
+
+    public:
+
+        /**
+         * Creates a new UniverseClauseBatchSink.
+         *
+         * @param listener The listener to which clauses are given.
+         * @param reservationListener The solver as a reservation listener, if
+         *        it is one.
+         * @param softClauseListener The solver as a soft clause listener, if
+         *        it is one.
+         */
+        explicit UniverseClauseBatchSink(Autis::IClauseBatchListener *listener,
+                Autis::IReservationListener *reservationListener = nullptr,
+                Autis::ISoftClauseListener *softClauseListener = nullptr) :
+                listener(listener),
+                reservationListener(reservationListener),
+                softClauseListener(softClauseListener) {
+            // Nothing to do: everything is already initialized.
+        }
+
+        /**
+         * Notifies the solver of the size of the problem, if it is an
+         * IReservationListener.
+         *
+         * @param nbVariables The number of variables declared in the input.
+         * @param nbConstraints The number of constraints declared in the input.
+         */
+        void reserve(int nbVariables, int nbConstraints) {
+            if (reservationListener != nullptr) {
+                reservationListener->reserve(nbVariables, nbConstraints);
+            }
+        }
+
+        /**
+         * Gives a single clause to the listener, as a batch.
+         *
+         * @param clause The literals of the clause.
+         */
+        void addClause(std::span<const int> clause) {
+            const std::size_t offsets[] = {0, clause.size()};
+            listener->addClauses(clause, offsets);
+        }
+
+        /**
+         * Gives a batch of clauses to the listener.
+         *
+         * @param literals The literals of the clauses in the batch.
+         * @param offsets The offsets of the clauses in the array of literals,
+         *        followed by the number of literals in this array.
+         */
+        void addClauses(std::span<const std::int32_t> literals, std::span<const std::size_t> offsets) {
+            listener->addClauses(literals, offsets);
+        }
+
+        /**
+         * Gives a soft clause to the solver, without copying it.
+         *
+         * @param clause The literals of the clause.
+         * @param weight The cost of falsifying the clause.
+         *
+         * @throws UnsupportedOperationException If the solver is not an
+         *         ISoftClauseListener.
+         */
+        void addSoftClause(const std::vector<int> &clause, std::int64_t weight) {
+            if (softClauseListener == nullptr) {
+                throw Except::UnsupportedOperationException("Soft clauses not supported by the solver");
+            }
+            softClauseListener->addSoftClause(clause, weight);
+        }
+
+        /**
+         * Gives a soft clause to the solver.
+         *
+         * @param clause The literals of the clause.
+         * @param weight The cost of falsifying the clause.
+         *
+         * @throws UnsupportedOperationException If the solver is not an
+         *         ISoftClauseListener.
+         */
+        void addSoftClause(std::span<const int> clause, std::int64_t weight) {
+            addSoftClause(std::vector<int>(clause.begin(), clause.end()), weight);
+        }
+
+    };
+
+}
+
+#endif
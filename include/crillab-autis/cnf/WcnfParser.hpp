@@ -0,0 +1,158 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file WcnfParser.hpp
+ * @brief Defines the parser for parsing MaxSAT problems (in the WCNF format).
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_WCNFPARSER_HPP
+#define AUTIS_WCNFPARSER_HPP
+
+#include <cstddef>
+
+#include <crillab-universe/sat/IUniverseSatSolver.hpp>
+
+#include "../core/AbstractParser.hpp"
+#include "../core/IReservationListener.hpp"
+#include "../core/ParserConfiguration.hpp"
+#include "IClauseBatchListener.hpp"
+#include "ISoftClauseListener.hpp"
+
+namespace Autis {
+
+    /**
+     * The WcnfParser specializes AbstractParser to read inputs written
+     * using the WCNF format.
+     * It relies on a BasicWcnfParser to feed its solver, which receives the
+     * hard clauses in the same way as with CnfParser, and the soft clauses
+     * as an ISoftClauseListener.
+     */
+    class WcnfParser : public Autis::AbstractParser {
+
+    private:
+
+        /**
+         * The maximum number of batches of clauses waiting to be given to the
+         * solver when the input is read in a pipeline.
+         */
+        static constexpr std::size_t PIPELINE_CAPACITY = 16;
+
+        /**
+         * The solver to feed while parsing, as a SAT solver.
+         */
+        Universe::IUniverseSatSolver *satSolver;
+
+        /**
+         * The solver as a batch listener, or null if it cannot receive batches
+         * of clauses.
+         */
+        Autis::IClauseBatchListener *batchListener;
+
+        /**
+         * The solver as a reservation listener, or null if it is not one.
+         */
+        Autis::IReservationListener *reservationListener;
+
+        /**
+         * The solver as a soft clause listener, or null if it is not one.
+         */
+        Autis::ISoftClauseListener *softClauseListener;
+
+        /**
+         * The configuration of this parser.
+         */
+        Autis::ParserConfiguration configuration;
+
+    public:
+
+        /**
+         * Creates a new WcnfParser.
+         *
+         * @param scanner The scanner used to read the input stream.
+         * @param solver The solver to feed while parsing the instance, which
+         *        may be null if the parser is only used to build instances.
+         * @param configuration The configuration of the parser.
+         */
+        explicit WcnfParser(Autis::Scanner &scanner, Universe::IUniverseSatSolver *solver,
+                const Autis::ParserConfiguration &configuration = Autis::ParserConfiguration());
+
+        /**
+         * Destroys this WcnfParser.
+         */
+        ~WcnfParser() override = default;
+
+        /**
+         * Parses the input to read the problem to solve.
+         */
+        void parse() override;
+
+        /**
+         * Parses the input to store the clauses it defines in the given
+         * instance, instead of feeding the solver.
+         *
+         * @param instance The instance in which to store the clauses.
+         */
+        void parse(Autis::Instance &instance) override;
+
+        bool isOptimization() override;
+
+    protected:
+
+        /**
+         * Gives the SAT solver to feed while parsing the input.
+         *
+         * @return The solver to feed.
+         */
+        Universe::IUniverseSatSolver *getConcreteSolver() override;
+
+    private:
+
+        /**
+         * Parses the input, giving the clauses to the given sink.
+         *
+         * @tparam Sink The type of the sink receiving the clauses.
+         *
+         * @param sink The sink receiving the clauses.
+         */
+        template <typename Sink>
+        void parse(Sink &sink);
+
+        /**
+         * Parses the input on a dedicated thread, while the calling thread
+         * gives the clauses to the given sink.
+         *
+         * @tparam Sink The type of the sink receiving the clauses.
+         *
+         * @param sink The sink receiving the clauses.
+         */
+        template <typename Sink>
+        void parseInPipeline(Sink &sink);
+
+    };
+
+}
+
+#endif
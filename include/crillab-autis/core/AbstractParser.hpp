@@ -37,6 +37,8 @@
 
 namespace Autis {
 
+    class Instance;
+
     /**
      * The AbstractParser is the parent class of classes used to parse input streams
      * so as to read a problem to solve.
@@ -89,6 +91,14 @@ namespace Autis {
          */
         virtual void parse() = 0;
 
+        /**
+         * Parses the input to store the problem it defines in the given
+         * instance, instead of feeding the solver.
+         *
+         * @param instance The instance in which to store the problem.
+         */
+        virtual void parse(Autis::Instance &instance) = 0;
+
     protected:
 
         /**
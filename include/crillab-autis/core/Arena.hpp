@@ -0,0 +1,135 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file Arena.hpp
+ * @brief Provides a flat storage for sequences of values.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_ARENA_HPP
+#define AUTIS_ARENA_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <vector>
+
+namespace Autis {
+
+    /**
+     * The Arena stores sequences of values one after the other in a single
+     * array, so that storing many small sequences does not require as many
+     * allocations.
+     * Sequences are identified by the order in which they have been added.
+     *
+     * @tparam T The type of the values in the sequences.
+     */
+    template <typename T>
+    class Arena {
+
+    private:
+
+        /**
+         * The values of all the sequences in this arena.
+         */
+        std::vector<T> values;
+
+        /**
+         * The offsets of the sequences in the array of values, followed by
+         * the number of values.
+         */
+        std::vector<std::size_t> offsets;
+
+    public:
+
+        /**
+         * Creates a new, empty, Arena.
+         */
+        Arena() :
+                values(),
+                offsets({0}) {
+            // Nothing to do: everything is already initialized.
+        }
+
+        /**
+         * Adds a sequence at the end of this arena.
+         *
+         * @tparam Range The type of the sequence to add.
+         *
+         * @param sequence The sequence to add.
+         *
+         * @return The index of the added sequence.
+         */
+        template <typename Range>
+        std::size_t add(const Range &sequence) {
+            values.insert(values.end(), std::begin(sequence), std::end(sequence));
+            offsets.push_back(values.size());
+            return offsets.size() - 2;
+        }
+
+        /**
+         * Gives the sequence at the given index in this arena.
+         * The sequence remains valid until a sequence is added to this arena.
+         *
+         * @param index The index of the sequence.
+         *
+         * @return The values of the sequence.
+         */
+        [[nodiscard]] std::span<const T> operator[](std::size_t index) const {
+            return std::span<const T>(values.data() + offsets[index], offsets[index + 1] - offsets[index]);
+        }
+
+        /**
+         * Gives the number of sequences in this arena.
+         *
+         * @return The number of sequences.
+         */
+        [[nodiscard]] std::size_t size() const {
+            return offsets.size() - 1;
+        }
+
+        /**
+         * Gives the number of values in all the sequences of this arena.
+         *
+         * @return The number of values.
+         */
+        [[nodiscard]] std::size_t getNumberOfValues() const {
+            return values.size();
+        }
+
+        /**
+         * Removes all the sequences from this arena.
+         * The memory used by this arena is kept to be reused.
+         */
+        void clear() {
+            values.clear();
+            offsets.resize(1);
+        }
+
+    };
+
+}
+
+#endif
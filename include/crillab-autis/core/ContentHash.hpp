@@ -0,0 +1,134 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file ContentHash.hpp
+ * @brief Computes a fingerprint of the content of an input.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_CONTENTHASH_HPP
+#define AUTIS_CONTENTHASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Autis {
+
+    /**
+     * The ContentHash computes a 64-bit fingerprint of a sequence of bytes,
+     * given in as many pieces as needed.
+     * The fingerprint is that of the XXH64 algorithm (with a seed of 0), which
+     * is fast enough to be computed while the input is being read.
+     */
+    class ContentHash {
+
+    private:
+
+        /**
+         * The number of bytes processed at once by the algorithm.
+         */
+        static constexpr std::size_t STRIPE_SIZE = 32;
+
+        /**
+         * The accumulators of the algorithm.
+         */
+        std::uint64_t accumulators[4];
+
+        /**
+         * The bytes that have not been processed yet, as they do not form a
+         * complete stripe.
+         */
+        unsigned char pending[STRIPE_SIZE];
+
+        /**
+         * The number of bytes in the pending stripe.
+         */
+        std::size_t nbPending;
+
+        /**
+         * The total number of bytes given to this hash.
+         */
+        std::uint64_t length;
+
+    public:
+
+        /**
+         * Creates a new ContentHash, to which no byte has been given yet.
+         */
+        ContentHash();
+
+        /**
+         * Gives the next bytes of the content to this hash.
+         *
+         * @param data The bytes to give.
+         * @param size The number of bytes to give.
+         */
+        void update(const char *data, std::size_t size);
+
+        /**
+         * Gives the fingerprint of all the bytes given so far.
+         * More bytes may still be given to this hash after this call.
+         *
+         * @return The fingerprint of the content.
+         */
+        [[nodiscard]] std::uint64_t digest() const;
+
+        /**
+         * Computes the fingerprint of a sequence of bytes given at once.
+         *
+         * @param data The bytes to hash.
+         * @param size The number of bytes to hash.
+         *
+         * @return The fingerprint of the bytes.
+         */
+        static std::uint64_t of(const char *data, std::size_t size);
+
+        /**
+         * Computes the fingerprint of the (raw) content of a file.
+         *
+         * @param path The path of the file to hash.
+         *
+         * @return The fingerprint of the file.
+         *
+         * @throws ParseException If the file cannot be read.
+         */
+        static std::uint64_t ofFile(const std::string &path);
+
+        /**
+         * Gives the hexadecimal representation of a fingerprint, which may be
+         * used as a file name.
+         *
+         * @param fingerprint The fingerprint to represent.
+         *
+         * @return The 16 hexadecimal digits of the fingerprint.
+         */
+        static std::string toString(std::uint64_t fingerprint);
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,190 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file DecompressionStreamBuffer.hpp
+ * @brief Provides the base class of the stream buffers decompressing their input on the fly.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_DECOMPRESSIONSTREAMBUFFER_HPP
+#define AUTIS_DECOMPRESSIONSTREAMBUFFER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <streambuf>
+#include <vector>
+
+namespace Autis {
+
+    /**
+     * The CompressionFormat enumerates the compression formats that can be
+     * recognized from the first bytes of an input.
+     */
+    enum class CompressionFormat {
+
+        /**
+         * The input is not compressed.
+         */
+        NONE,
+
+        /**
+         * The input is compressed with gzip (or zlib).
+         */
+        GZIP,
+
+        /**
+         * The input is compressed with xz.
+         */
+        XZ,
+
+        /**
+         * The input is compressed with bzip2.
+         */
+        BZIP2,
+
+        /**
+         * The input is compressed with Zstandard.
+         */
+        ZSTD
+
+    };
+
+    /**
+     * The DecompressionStreamBuffer is the parent class of the read-only stream
+     * buffers that decompress, block by block, the content of another stream
+     * buffer.
+     * This allows to read compressed inputs without decompressing them first.
+     */
+    class DecompressionStreamBuffer : public std::streambuf {
+
+    public:
+
+        /**
+         * The number of bytes needed to recognize any compression format.
+         */
+        static constexpr std::size_t MAGIC_SIZE = 6;
+
+    private:
+
+        /**
+         * The number of bytes read from, or produced for, the input at once.
+         */
+        static constexpr std::size_t BUFFER_SIZE = 1 << 16;
+
+        /**
+         * The stream buffer from which compressed data is read.
+         */
+        std::streambuf &source;
+
+        /**
+         * The buffer in which compressed data is read.
+         */
+        std::vector<char> compressed;
+
+        /**
+         * The buffer in which decompressed data is written.
+         */
+        std::vector<char> decompressed;
+
+    public:
+
+        /**
+         * Recognizes the compression format of an input from its first bytes.
+         *
+         * @param header The first bytes of the input.
+         * @param size The number of bytes in the header (at most MAGIC_SIZE
+         *        bytes are considered).
+         *
+         * @return The compression format of the input.
+         */
+        static Autis::CompressionFormat detect(const char *header, std::size_t size);
+
+        /**
+         * Creates a stream buffer decompressing the content of another stream
+         * buffer.
+         *
+         * @param format The compression format of the content to decompress.
+         * @param source The stream buffer from which compressed data is read.
+         *
+         * @return The created stream buffer.
+         *
+         * @throws UnsupportedOperationException If the library has been built
+         *         without support for the given format.
+         */
+        static std::unique_ptr<Autis::DecompressionStreamBuffer> create(
+                Autis::CompressionFormat format, std::streambuf &source);
+
+        /**
+         * Destroys this DecompressionStreamBuffer.
+         */
+        ~DecompressionStreamBuffer() override = default;
+
+    protected:
+
+        /**
+         * Creates a new DecompressionStreamBuffer.
+         *
+         * @param source The stream buffer from which compressed data is read.
+         */
+        explicit DecompressionStreamBuffer(std::streambuf &source);
+
+        /**
+         * Reads the next block of compressed data.
+         *
+         * @param data The variable in which to store the first byte of the
+         *        read block.
+         * @param size The variable in which to store the size of the block.
+         *
+         * @return Whether a block has been read, meaning that the end of the
+         *         compressed data has not been reached.
+         */
+        bool readCompressed(const char *&data, std::size_t &size);
+
+        /**
+         * Decompresses the next part of the input.
+         *
+         * @param data The array in which to write the decompressed data.
+         * @param capacity The maximum number of bytes to write.
+         *
+         * @return The number of bytes that have been written, which is 0 only
+         *         when the end of the input has been reached.
+         *
+         * @throws ParseException If the compressed data is corrupted.
+         */
+        virtual std::size_t decompress(char *data, std::size_t capacity) = 0;
+
+        /**
+         * Decompresses the next block of the input once all the decompressed
+         * characters have been read.
+         *
+         * @return The next character, or EOF if there is none.
+         */
+        int_type underflow() override;
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,99 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file GzipStreamBuffer.hpp
+ * @brief Provides a stream buffer decompressing gzip data on the fly.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_GZIPSTREAMBUFFER_HPP
+#define AUTIS_GZIPSTREAMBUFFER_HPP
+
+#ifdef AUTIS_WITH_ZLIB
+
+#include <zlib.h>
+
+#include "DecompressionStreamBuffer.hpp"
+
+namespace Autis {
+
+    /**
+     * The GzipStreamBuffer is a stream buffer decompressing gzip data on the fly.
+     * Concatenated gzip members are decompressed one after the other.
+     */
+    class GzipStreamBuffer : public Autis::DecompressionStreamBuffer {
+
+    private:
+
+        /**
+         * The state of the gzip decoder.
+         */
+        z_stream stream;
+
+        /**
+         * Whether the end of the member being decompressed has been reached.
+         */
+        bool endOfStream;
+
+    public:
+
+        /**
+         * Creates a new GzipStreamBuffer.
+         *
+         * @param source The stream buffer from which compressed data is read.
+         */
+        explicit GzipStreamBuffer(std::streambuf &source);
+
+        /**
+         * Destroys this GzipStreamBuffer.
+         */
+        ~GzipStreamBuffer() override;
+
+        GzipStreamBuffer(const GzipStreamBuffer &) = delete;
+
+        GzipStreamBuffer &operator=(const GzipStreamBuffer &) = delete;
+
+    protected:
+
+        /**
+         * Decompresses the next part of the input.
+         *
+         * @param data The array in which to write the decompressed data.
+         * @param capacity The maximum number of bytes to write.
+         *
+         * @return The number of bytes that have been written, which is 0 only
+         *         when the end of the input has been reached.
+         *
+         * @throws ParseException If the compressed data is corrupted.
+         */
+        std::size_t decompress(char *data, std::size_t capacity) override;
+
+    };
+
+}
+
+#endif
+
+#endif
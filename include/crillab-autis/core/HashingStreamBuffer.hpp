@@ -0,0 +1,105 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file HashingStreamBuffer.hpp
+ * @brief Computes the fingerprint of a stream while it is being read.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_HASHINGSTREAMBUFFER_HPP
+#define AUTIS_HASHINGSTREAMBUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <streambuf>
+#include <vector>
+
+#include "ContentHash.hpp"
+
+namespace Autis {
+
+    /**
+     * The HashingStreamBuffer reads another stream buffer block by block,
+     * and computes the fingerprint of all the bytes it reads along the way.
+     * This allows to fingerprint an input that can only be read once, such
+     * as a pipe.
+     */
+    class HashingStreamBuffer : public std::streambuf {
+
+    private:
+
+        /**
+         * The number of bytes read at once from the source buffer.
+         */
+        static constexpr std::size_t BLOCK_SIZE = 1 << 16;
+
+        /**
+         * The stream buffer from which bytes are read.
+         */
+        std::streambuf &source;
+
+        /**
+         * The block of bytes that has been read last.
+         */
+        std::vector<char> block;
+
+        /**
+         * The fingerprint of the bytes read so far.
+         */
+        Autis::ContentHash hash;
+
+    public:
+
+        /**
+         * Creates a new HashingStreamBuffer.
+         *
+         * @param source The stream buffer from which bytes are read.
+         */
+        explicit HashingStreamBuffer(std::streambuf &source);
+
+        /**
+         * Reads the remaining bytes of the source buffer, and gives the
+         * fingerprint of its whole content.
+         * Nothing may be read from this buffer anymore after this call.
+         *
+         * @return The fingerprint of the content of the source buffer.
+         */
+        std::uint64_t finish();
+
+    protected:
+
+        /**
+         * Reads the next block of bytes from the source buffer when the
+         * current block has been entirely read.
+         *
+         * @return The next character to read, or EOF if there is none.
+         */
+        int_type underflow() override;
+
+    };
+
+}
+
+#endif
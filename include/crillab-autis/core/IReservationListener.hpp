@@ -0,0 +1,71 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file IReservationListener.hpp
+ * @brief Defines an interface for solvers that can use the size of a problem before reading it.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_IRESERVATIONLISTENER_HPP
+#define AUTIS_IRESERVATIONLISTENER_HPP
+
+namespace Autis {
+
+    /**
+     * The IReservationListener is an optional interface that a solver may
+     * implement to be notified of the size of the problem declared in the
+     * header of the input, before any constraint is given to it.
+     * This allows the solver to allocate its data structures once, instead
+     * of growing them while the problem is read.
+     */
+    class IReservationListener {
+
+    public:
+
+        /**
+         * Destroys this IReservationListener.
+         */
+        virtual ~IReservationListener() = default;
+
+        /**
+         * Notifies this listener of the size of the problem that is going to
+         * be read.
+         * These values are only hints: the input may not respect them, in
+         * which case the parser reports an error after having read it.
+         * When products of literals are linearized, they also count the
+         * auxiliary variables and constraints needed for the products declared
+         * in the input: they are then upper bounds, as a product appearing
+         * several times is only defined once.
+         *
+         * @param nbVariables The number of variables the problem may have.
+         * @param nbConstraints The number of constraints the problem may have.
+         */
+        virtual void reserve(int nbVariables, int nbConstraints) = 0;
+
+    };
+
+}
+
+#endif
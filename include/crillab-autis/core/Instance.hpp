@@ -0,0 +1,188 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file Instance.hpp
+ * @brief Stores a problem in a solver-neutral form.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_INSTANCE_HPP
+#define AUTIS_INSTANCE_HPP
+
+#include <vector>
+
+#include <crillab-universe/core/IUniverseSolver.hpp>
+
+#include "../cnf/ClauseBatch.hpp"
+#include "../pb/ConstraintBatch.hpp"
+#include "../xcsp/XcspInstance.hpp"
+
+namespace Autis {
+
+    /**
+     * The InstanceType enumerates the types of problems that may be stored in
+     * an Instance.
+     */
+    enum class InstanceType {
+
+        /**
+         * A SAT problem, read from a CNF input.
+         */
+        SAT,
+
+        /**
+         * A pseudo-Boolean problem, read from an OPB input.
+         */
+        PSEUDO_BOOLEAN,
+
+        /**
+         * A CSP problem, read from an XCSP3 input.
+         */
+        CSP
+
+    };
+
+    /**
+     * The Instance stores a problem that has been read once, in flat arrays
+     * that do not depend on any solver, so that it can be given to as many
+     * solvers as needed without reading its input again.
+     */
+    class Instance {
+
+    private:
+
+        /**
+         * The type of this instance.
+         */
+        Autis::InstanceType type;
+
+        /**
+         * The clauses of this instance, if it is a SAT problem.
+         */
+        Autis::ClauseBatch clauses;
+
+        /**
+         * The constraints of this instance, if it is a pseudo-Boolean problem.
+         */
+        Autis::ConstraintBatch constraints;
+
+        /**
+         * The variables, constraints and objective function of this instance,
+         * if it is a CSP problem.
+         */
+        Autis::XcspInstance cspInstance;
+
+    public:
+
+        /**
+         * Creates a new, empty, Instance.
+         *
+         * @param type The type of the instance.
+         */
+        explicit Instance(Autis::InstanceType type);
+
+        /**
+         * Gives the type of this instance.
+         *
+         * @return The type of this instance.
+         */
+        [[nodiscard]] Autis::InstanceType getType() const;
+
+        /**
+         * Gives the clauses of this instance.
+         *
+         * @return The clauses of this instance.
+         */
+        Autis::ClauseBatch &getClauses();
+
+        /**
+         * Gives the clauses of this instance.
+         *
+         * @return The clauses of this instance.
+         */
+        [[nodiscard]] const Autis::ClauseBatch &getClauses() const;
+
+        /**
+         * Gives the pseudo-Boolean constraints of this instance.
+         *
+         * @return The constraints of this instance.
+         */
+        Autis::ConstraintBatch &getConstraints();
+
+        /**
+         * Gives the pseudo-Boolean constraints of this instance.
+         *
+         * @return The constraints of this instance.
+         */
+        [[nodiscard]] const Autis::ConstraintBatch &getConstraints() const;
+
+        /**
+         * Gives the CSP part of this instance.
+         *
+         * @return The CSP part of this instance.
+         */
+        Autis::XcspInstance &getCspInstance();
+
+        /**
+         * Gives the CSP part of this instance.
+         *
+         * @return The CSP part of this instance.
+         */
+        [[nodiscard]] const Autis::XcspInstance &getCspInstance() const;
+
+        /**
+         * Gives this instance to a solver.
+         * The solver must be able to solve problems of the type of this
+         * instance.
+         *
+         * @param solver The solver to give this instance to.
+         *
+         * @throws IllegalArgumentException If the solver cannot solve
+         *         problems of the type of this instance.
+         */
+        void replay(Universe::IUniverseSolver &solver) const;
+
+        /**
+         * Gives this instance to several solvers at once, from the same
+         * (unmodified) data.
+         * Native solvers are each fed on their own thread, and must thus not
+         * share any state that is not thread-safe.
+         * Java solvers are fed one after the other on the calling thread,
+         * because the threads started here are not attached to the JVM.
+         * All the solvers must be able to solve problems of the type of this
+         * instance.
+         *
+         * @param solvers The solvers to give this instance to.
+         *
+         * @throws IllegalArgumentException If one of the solvers cannot solve
+         *         problems of the type of this instance.
+         */
+        void replay(const std::vector<Universe::IUniverseSolver *> &solvers) const;
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,79 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file IntegerTokenizer.hpp
+ * @brief Provides a vectorized tokenizer for runs of integers separated by blanks.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_INTEGERTOKENIZER_HPP
+#define AUTIS_INTEGERTOKENIZER_HPP
+
+#include <cstddef>
+
+namespace Autis {
+
+    /**
+     * The IntegerTokenizer reads runs of (small) integers separated by blank
+     * characters, such as the literals of DIMACS clauses.
+     * Characters are classified by blocks of 64 bytes using the widest vector
+     * instructions supported by the CPU (AVX2 or SSE4.2, chosen at runtime),
+     * and the digits of each number are converted all at once.
+     * A scalar implementation is used on other platforms.
+     */
+    class IntegerTokenizer {
+
+    public:
+
+        /**
+         * Reads as many integers as possible from the given region of memory.
+         * Reading stops (before the corresponding token) when a character that
+         * is neither blank, a digit nor a sign is met, when a number has more
+         * than 9 digits (and may thus not fit in an int), when a sign is not
+         * followed by a digit, or when a number may continue beyond the region.
+         * Such tokens are left to the regular scanning methods.
+         *
+         * @param cursor The first character to read.
+         *        It is updated to the first character that has not been read.
+         * @param end The character right after the last character of the region.
+         * @param values The array in which to store the read values.
+         * @param capacity The maximum number of values to read.
+         *
+         * @return The number of values that have been read.
+         */
+        static std::size_t tokenize(const char *&cursor, const char *end, int *values, std::size_t capacity);
+
+        /**
+         * Gives the name of the implementation selected for the current CPU.
+         *
+         * @return The name of the implementation ("avx2", "sse4.2" or "scalar").
+         */
+        static const char *implementation();
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,111 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file MappedFile.hpp
+ * @brief Provides a read-only memory mapping of a regular file.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_MAPPEDFILE_HPP
+#define AUTIS_MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace Autis {
+
+    /**
+     * The MappedFile class maps the content of a regular file into memory,
+     * so that it can be read without copying it into user-space buffers.
+     * The mapping is released when the object is destroyed.
+     */
+    class MappedFile {
+
+    private:
+
+        /**
+         * The first byte of the mapped content (null if nothing is mapped).
+         */
+        const char *content;
+
+        /**
+         * The number of bytes that are mapped.
+         */
+        std::size_t length;
+
+    public:
+
+        /**
+         * Creates a new MappedFile, which does not map anything yet.
+         */
+        MappedFile();
+
+        /**
+         * Destroys this MappedFile, releasing the mapping (if any).
+         */
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        /**
+         * Maps the file at the given path into memory.
+         * Only non-empty regular files can be mapped: pipes, character devices
+         * and the like cannot.
+         *
+         * @param path The path of the file to map.
+         *
+         * @return Whether the file has been successfully mapped.
+         *         If false is returned, the input should be read as a stream.
+         */
+        bool map(const std::string &path);
+
+        /**
+         * Gives the first byte of the mapped content.
+         *
+         * @return The mapped content.
+         */
+        [[nodiscard]] const char *data() const;
+
+        /**
+         * Gives the number of bytes that are mapped.
+         *
+         * @return The size of the mapped content.
+         */
+        [[nodiscard]] std::size_t size() const;
+
+    private:
+
+        /**
+         * Releases the current mapping (if any).
+         */
+        void unmap();
+
+    };
+
+}
+
+#endif
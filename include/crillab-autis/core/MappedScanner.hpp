@@ -0,0 +1,75 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file MappedScanner.hpp
+ * @brief Allows to read data of various types from a memory-mapped file.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_MAPPEDSCANNER_HPP
+#define AUTIS_MAPPEDSCANNER_HPP
+
+#include "MappedFile.hpp"
+#include "Scanner.hpp"
+
+namespace Autis {
+
+    /**
+     * The MappedScanner specializes Scanner to read data from a file that has
+     * been mapped into memory, or from any other region of memory.
+     * The whole region is directly used as the buffer of the scanner, so that
+     * characters never go through any stream.
+     */
+    class MappedScanner : public Autis::Scanner {
+
+    public:
+
+        /**
+         * Creates a new MappedScanner.
+         *
+         * @param file The mapped file to read from.
+         *        It must remain mapped as long as this scanner is used.
+         */
+        explicit MappedScanner(const Autis::MappedFile &file);
+
+        /**
+         * Creates a new MappedScanner reading a part of an input that is
+         * already in memory.
+         *
+         * @param begin The first character of the part to read.
+         * @param end The character right after the last character to read.
+         */
+        MappedScanner(const char *begin, const char *end);
+
+        /**
+         * Destroys this MappedScanner.
+         */
+        ~MappedScanner() override = default;
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,125 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file MemoryStreamBuffer.hpp
+ * @brief Defines a stream buffer reading directly from a region of memory.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_MEMORYSTREAMBUFFER_HPP
+#define AUTIS_MEMORYSTREAMBUFFER_HPP
+
+#include <streambuf>
+
+namespace Autis {
+
+    /**
+     * The MemoryStreamBuffer is a read-only stream buffer whose get area is a
+     * region of memory owned by someone else.
+     * It allows to expose this region as an input stream without copying it.
+     * Once the region has been read, reading may continue from another stream
+     * buffer.
+     */
+    class MemoryStreamBuffer : public std::streambuf {
+
+    private:
+
+        /**
+         * The stream buffer to read from once the region has been read
+         * (null if there is nothing to read after the region).
+         */
+        std::streambuf *next = nullptr;
+
+    public:
+
+        /**
+         * Creates a new MemoryStreamBuffer, which is empty.
+         */
+        MemoryStreamBuffer() = default;
+
+        /**
+         * Sets the region of memory to read from.
+         *
+         * @param begin The first character of the region.
+         * @param end The character right after the last character of the region.
+         * @param following The stream buffer to read from once the region has
+         *        been read, if any.
+         */
+        void reset(const char *begin, const char *end, std::streambuf *following = nullptr);
+
+    protected:
+
+        /**
+         * Gives the next character to read without consuming it, once the
+         * region has been read.
+         *
+         * @return The next character, or EOF if there is none.
+         */
+        int_type underflow() override;
+
+        /**
+         * Reads the next character, once the region has been read.
+         *
+         * @return The read character, or EOF if there is none.
+         */
+        int_type uflow() override;
+
+        /**
+         * Reads several characters at once.
+         *
+         * @param s The array in which to store the read characters.
+         * @param count The maximum number of characters to read.
+         *
+         * @return The number of characters that have been read.
+         */
+        std::streamsize xsgetn(char_type *s, std::streamsize count) override;
+
+        /**
+         * Moves the reading position relatively to the beginning, the end or
+         * the current position in the region.
+         *
+         * @param off The offset by which to move.
+         * @param dir The position from which the offset is applied.
+         * @param which The area to move in (only the input area is supported).
+         *
+         * @return The new position, or an invalid position on failure.
+         */
+        pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+
+        /**
+         * Moves the reading position to an absolute position in the region.
+         *
+         * @param pos The position to move to.
+         * @param which The area to move in (only the input area is supported).
+         *
+         * @return The new position, or an invalid position on failure.
+         */
+        pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+
+    };
+
+}
+
+#endif
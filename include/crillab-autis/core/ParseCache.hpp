@@ -0,0 +1,204 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file ParseCache.hpp
+ * @brief Stores the instances that have been parsed, keyed by the fingerprint of their input.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_PARSECACHE_HPP
+#define AUTIS_PARSECACHE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+#include "Instance.hpp"
+#include "ParserConfiguration.hpp"
+
+namespace Autis {
+
+    /**
+     * The ParseCache stores snapshots of the instances that have been parsed
+     * in a directory, under the fingerprint of their (raw) input and the
+     * options of the parser that change the instance read from this input.
+     * Parsing an input whose bytes are identical to those of an input that
+     * has already been parsed (even under another name) with the same options
+     * then only requires to read its snapshot back.
+     * The directory may be shared by several threads or processes, and its
+     * size may be bounded, in which case the least recently used snapshots
+     * are removed first.
+     */
+    class ParseCache {
+
+    private:
+
+        /**
+         * The extension of the snapshots stored in the cache.
+         */
+        static constexpr const char *EXTENSION = ".autis";
+
+        /**
+         * The suffix appended to the path of a snapshot while it is written.
+         */
+        static constexpr const char *TEMPORARY_SUFFIX = ".tmp-";
+
+        /**
+         * The time after which a snapshot that is still being written is
+         * considered as left behind by a process that has died.
+         */
+        static constexpr std::chrono::hours TEMPORARY_LIFETIME {1};
+
+        /**
+         * The directory in which the snapshots are stored.
+         */
+        std::filesystem::path directory;
+
+        /**
+         * The maximum number of bytes used by the snapshots in the cache
+         * (0 means that the cache is unbounded).
+         */
+        std::uintmax_t sizeLimit;
+
+        /**
+         * The number of inputs that have been found in the cache.
+         */
+        std::atomic<std::uint64_t> hits;
+
+        /**
+         * The number of inputs that have not been found in the cache.
+         */
+        std::atomic<std::uint64_t> misses;
+
+    public:
+
+        /**
+         * Creates a new ParseCache.
+         * The directory is created if it does not exist.
+         *
+         * @param directory The directory in which the snapshots are stored.
+         * @param sizeLimit The maximum number of bytes used by the snapshots
+         *        in the cache, or 0 for an unbounded cache.
+         */
+        explicit ParseCache(const std::string &directory, std::uintmax_t sizeLimit = 0);
+
+        /**
+         * Looks for the instance read from an input in this cache.
+         * Invalid or outdated snapshots are removed from the cache, and
+         * reported as misses.
+         *
+         * @param fingerprint The fingerprint of the input (see ContentHash).
+         * @param configuration The configuration of the parser reading the
+         *        input.
+         *
+         * @return The instance read from the input, if it has been found.
+         */
+        std::optional<Autis::Instance> find(std::uint64_t fingerprint, const Autis::ParserConfiguration &configuration);
+
+        /**
+         * Stores the instance read from an input in this cache.
+         * Failing to store the instance is not an error: the instance will
+         * simply be parsed again next time.
+         *
+         * @param fingerprint The fingerprint of the input (see ContentHash).
+         * @param configuration The configuration of the parser that has read
+         *        the input.
+         * @param instance The instance read from the input.
+         */
+        void store(std::uint64_t fingerprint, const Autis::ParserConfiguration &configuration,
+                const Autis::Instance &instance);
+
+        /**
+         * Gives the directory in which the snapshots are stored.
+         *
+         * @return The directory of this cache.
+         */
+        [[nodiscard]] const std::filesystem::path &getDirectory() const;
+
+        /**
+         * Gives the maximum number of bytes used by the snapshots in this
+         * cache.
+         *
+         * @return The size limit of this cache, or 0 if it is unbounded.
+         */
+        [[nodiscard]] std::uintmax_t getSizeLimit() const;
+
+        /**
+         * Gives the number of inputs that have been found in this cache.
+         *
+         * @return The number of hits.
+         */
+        [[nodiscard]] std::uint64_t getNumberOfHits() const;
+
+        /**
+         * Gives the number of inputs that have not been found in this cache.
+         *
+         * @return The number of misses.
+         */
+        [[nodiscard]] std::uint64_t getNumberOfMisses() const;
+
+    private:
+
+        /**
+         * Gives the path of the snapshot stored for an input.
+         * This path depends on the options of the parser that change the
+         * instance read from the input (such as the linearization of products),
+         * so that instances read with different options are never mixed up.
+         *
+         * @param fingerprint The fingerprint of the input.
+         * @param configuration The configuration of the parser reading the
+         *        input.
+         *
+         * @return The path of the snapshot.
+         */
+        [[nodiscard]] std::filesystem::path pathOf(std::uint64_t fingerprint,
+                const Autis::ParserConfiguration &configuration) const;
+
+        /**
+         * Removes the temporary files left behind by processes that have died
+         * while writing a snapshot and, if this cache is bounded, removes the
+         * least recently used snapshots until its size fits in its limit.
+         * The snapshots that are being written count in this size, but are
+         * never removed.
+         */
+        void evict();
+
+        /**
+         * Checks whether a file is a snapshot that is being written.
+         *
+         * @param file The path of the file to check.
+         *
+         * @return Whether the file is a temporary snapshot.
+         */
+        [[nodiscard]] static bool isTemporary(const std::filesystem::path &file);
+
+    };
+
+}
+
+#endif
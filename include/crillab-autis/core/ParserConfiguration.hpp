@@ -0,0 +1,207 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file ParserConfiguration.hpp
+ * @brief Gathers the options that tune how inputs are parsed.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_PARSERCONFIGURATION_HPP
+#define AUTIS_PARSERCONFIGURATION_HPP
+
+namespace Autis {
+
+    class ParseCache;
+
+    /**
+     * The ParserConfiguration gathers the options that tune how inputs are
+     * parsed.
+     * Most of these options only change how the problem is read.
+     * The linearization of products and the compression of tuples also change
+     * the problem that is given to the solver, which is why they are part of
+     * the key of the instances stored in a parse cache.
+     */
+    class ParserConfiguration {
+
+    private:
+
+        /**
+         * The number of threads that may be used to parse the input.
+         */
+        unsigned numberOfThreads;
+
+        /**
+         * Whether the input is read on a dedicated thread, while the calling
+         * thread feeds the solver.
+         */
+        bool pipelined;
+
+        /**
+         * The cache in which parsed instances are looked for and stored.
+         */
+        Autis::ParseCache *cache;
+
+        /**
+         * Whether the products of literals appearing in pseudo-Boolean inputs
+         * are replaced by auxiliary variables.
+         */
+        bool linearizingProducts;
+
+        /**
+         * Whether XCSP3 inputs are read by the streaming reader of this
+         * library.
+         */
+        bool streamingXcsp;
+
+        /**
+         * Whether the tuples of the extension constraints of XCSP3 inputs are
+         * stored in compressed tables.
+         */
+        bool compressingTuples;
+
+    public:
+
+        /**
+         * Creates a new ParserConfiguration, with the default options.
+         */
+        ParserConfiguration();
+
+        /**
+         * Sets the number of threads that may be used to parse the input.
+         * A value of 0 means that as many threads as there are hardware
+         * threads may be used.
+         *
+         * @param nbThreads The number of threads to use.
+         */
+        void setNumberOfThreads(unsigned nbThreads);
+
+        /**
+         * Gives the number of threads that may be used to parse the input.
+         *
+         * @return The number of threads to use (at least 1).
+         */
+        [[nodiscard]] unsigned getNumberOfThreads() const;
+
+        /**
+         * Sets whether the input is read on a dedicated thread, while the
+         * calling thread feeds the solver with what has been read.
+         * This is worth it when the solver does significant work each time
+         * a constraint is added.
+         *
+         * @param enabled Whether to read the input in a pipeline.
+         */
+        void setPipelined(bool enabled);
+
+        /**
+         * Checks whether the input is read on a dedicated thread, while the
+         * calling thread feeds the solver.
+         *
+         * @return Whether to read the input in a pipeline.
+         */
+        [[nodiscard]] bool isPipelined() const;
+
+        /**
+         * Sets the cache in which the instances read from files are looked
+         * for before being parsed, and stored after having been parsed.
+         * The cache is not owned by this configuration, and must outlive the
+         * parsing of the inputs.
+         *
+         * @param parseCache The cache to use, or nullptr to disable caching.
+         */
+        void setCache(Autis::ParseCache *parseCache);
+
+        /**
+         * Gives the cache in which parsed instances are looked for and stored.
+         *
+         * @return The cache to use, or nullptr if caching is disabled.
+         */
+        [[nodiscard]] Autis::ParseCache *getCache() const;
+
+        /**
+         * Sets whether the products of literals appearing in pseudo-Boolean
+         * inputs are replaced by auxiliary variables, defined by additional
+         * constraints.
+         * When disabled, non-linear inputs are rejected.
+         * This option is enabled by default.
+         *
+         * @param enabled Whether to linearize the products of literals.
+         */
+        void setLinearizingProducts(bool enabled);
+
+        /**
+         * Checks whether the products of literals appearing in pseudo-Boolean
+         * inputs are replaced by auxiliary variables.
+         *
+         * @return Whether to linearize the products of literals.
+         */
+        [[nodiscard]] bool isLinearizingProducts() const;
+
+        /**
+         * Sets whether XCSP3 inputs are read by the streaming reader of this
+         * library, which only keeps in memory the element being read, instead
+         * of the reader of XCSP3-CPP-Parser.
+         * The streaming reader only supports the most common elements of
+         * XCSP3, and rejects the others.
+         * This option is disabled by default.
+         *
+         * @param enabled Whether to read XCSP3 inputs with the streaming reader.
+         */
+        void setStreamingXcsp(bool enabled);
+
+        /**
+         * Checks whether XCSP3 inputs are read by the streaming reader of this
+         * library.
+         *
+         * @return Whether to read XCSP3 inputs with the streaming reader.
+         */
+        [[nodiscard]] bool isStreamingXcsp() const;
+
+        /**
+         * Sets whether the tuples of the extension constraints of XCSP3 inputs
+         * are stored in compressed tables (i.e., decision diagrams) rather
+         * than as lists of tuples.
+         * This reduces the memory used by large tables, at the price of
+         * sorting their tuples while parsing.
+         * Solvers that do not understand compressed tables still receive the
+         * list of tuples.
+         * This option is disabled by default.
+         *
+         * @param enabled Whether to compress the tables of tuples.
+         */
+        void setCompressingTuples(bool enabled);
+
+        /**
+         * Checks whether the tuples of the extension constraints of XCSP3
+         * inputs are stored in compressed tables.
+         *
+         * @return Whether to compress the tables of tuples.
+         */
+        [[nodiscard]] bool isCompressingTuples() const;
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,150 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file Pipeline.hpp
+ * @brief Provides the pipeline running a producer thread that feeds the calling thread.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_PIPELINE_HPP
+#define AUTIS_PIPELINE_HPP
+
+#include <cstddef>
+#include <exception>
+#include <thread>
+
+#include "SpscQueue.hpp"
+
+namespace Autis {
+
+    /**
+     * The PipelineCancelledException is thrown on the producer thread of a
+     * pipeline when the consumer has stopped, so as to stop the producer too.
+     * It never escapes the pipeline.
+     */
+    class PipelineCancelledException : public std::exception {
+
+    public:
+
+        /**
+         * Gives the description of this exception.
+         *
+         * @return The description of the exception.
+         */
+        [[nodiscard]] const char *what() const noexcept override {
+            return "Pipeline cancelled";
+        }
+
+    };
+
+    /**
+     * Runs a producer on a new thread, which pushes batches into a bounded
+     * queue, while the calling thread consumes these batches.
+     * If the producer fails, the batches it has pushed before are still
+     * consumed, and its exception is then rethrown on the calling thread.
+     * If the consumer fails, the producer is cancelled, and the exception is
+     * rethrown once the producer has stopped.
+     *
+     * @tparam Batch The type of the batches.
+     * @tparam Producer The type of the producer, called with the queue.
+     * @tparam Consumer The type of the consumer, called with each batch.
+     *
+     * @param capacity The maximum number of batches waiting in the queue.
+     * @param produce The function producing the batches.
+     * @param consume The function consuming each batch.
+     */
+    template <typename Batch, typename Producer, typename Consumer>
+    void runPipeline(std::size_t capacity, Producer produce, Consumer consume) {
+        Autis::SpscQueue<Batch> queue(capacity);
+        std::exception_ptr producerError;
+
+        std::thread producer([&queue, &producerError, &produce]() {
+            try {
+                produce(queue);
+
+            } catch (Autis::PipelineCancelledException &) {
+                // The consumer has already failed.
+
+            } catch (...) {
+                producerError = std::current_exception();
+            }
+            queue.close();
+        });
+
+        try {
+            for (Batch batch; queue.pop(batch);) {
+                consume(batch);
+            }
+
+        } catch (...) {
+            queue.cancel();
+            producer.join();
+            throw;
+        }
+
+        producer.join();
+        if (producerError) {
+            std::rethrow_exception(producerError);
+        }
+    }
+
+    /**
+     * Runs a parser in a pipeline: the parser reads the input on a new thread
+     * and gives what it reads to a writer, which pushes it by batches into a
+     * bounded queue, while the calling thread replays these batches.
+     * The batches written before a parse error are still replayed, and the
+     * error is then rethrown on the calling thread.
+     *
+     * @tparam Batch The type of the batches.
+     * @tparam Writer The type of the writer, built from the queue.
+     * @tparam Parse The type of the function parsing the input.
+     * @tparam Replay The type of the function replaying each batch.
+     *
+     * @param capacity The maximum number of batches waiting in the queue.
+     * @param parse The function parsing the input into the writer it is given.
+     * @param replay The function replaying each batch.
+     */
+    template <typename Batch, typename Writer, typename Parse, typename Replay>
+    void runParserPipeline(std::size_t capacity, Parse parse, Replay replay) {
+        runPipeline<Batch>(capacity, [&parse](Autis::SpscQueue<Batch> &queue) {
+            Writer writer(queue);
+            try {
+                parse(writer);
+
+            } catch (Autis::PipelineCancelledException &) {
+                throw;
+
+            } catch (...) {
+                // What has been read before the error is still replayed.
+                writer.flush();
+                throw;
+            }
+            writer.flush();
+        }, replay);
+    }
+
+}
+
+#endif
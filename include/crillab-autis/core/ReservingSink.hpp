@@ -0,0 +1,51 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file ReservingSink.hpp
+ * @brief Defines the concept of the sinks that can use the size of a problem before reading it.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_RESERVINGSINK_HPP
+#define AUTIS_RESERVINGSINK_HPP
+
+#include <concepts>
+
+namespace Autis {
+
+    /**
+     * A ReservingSink is a sink that can be notified of the size of the
+     * problem declared in the header of the input, in the same way as an
+     * IReservationListener.
+     * Parsers notify the sinks that support it as soon as the header is read.
+     */
+    template <typename Sink>
+    concept ReservingSink = requires(Sink &sink, int nbVariables, int nbConstraints) {
+        sink.reserve(nbVariables, nbConstraints);
+    };
+
+}
+
+#endif
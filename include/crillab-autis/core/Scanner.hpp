@@ -31,14 +31,22 @@
 #ifndef AUTIS_SCANNER_HPP
 #define AUTIS_SCANNER_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <istream>
+#include <string_view>
+#include <vector>
 
 #include <crillab-universe/core/UniverseType.hpp>
 
+#include "MemoryStreamBuffer.hpp"
+
 namespace Autis {
 
     /**
      * The Scanner class allows to read data of various types from an input stream.
+     * The characters of the stream are read by blocks into an internal buffer,
+     * in which a cursor is moved as data is read.
      *
      * @version 0.1.0
      */
@@ -46,10 +54,47 @@ namespace Autis {
 
     private:
 
+        /**
+         * The number of characters read from the input stream at once.
+         */
+        static constexpr std::size_t BLOCK_SIZE = 1 << 16;
+
         /**
          * The input stream to read from.
+         * It is null when the scanner reads from a region of memory.
+         */
+        std::istream *input;
+
+        /**
+         * The block in which the characters of the input stream are read.
+         */
+        std::vector<char> block;
+
+        /**
+         * The next character to read.
+         */
+        const char *cursor;
+
+        /**
+         * The character right after the last character that is available
+         * without reading the input stream.
          */
-        std::istream &input;
+        const char *limit;
+
+        /**
+         * Whether an attempt to read past the end of the input has been made.
+         */
+        bool endOfFile;
+
+        /**
+         * The buffer exposing the unread content of the input as a stream.
+         */
+        Autis::MemoryStreamBuffer unreadBuffer;
+
+        /**
+         * The stream reading from the unread buffer.
+         */
+        std::istream unreadStream;
 
     public:
 
@@ -61,11 +106,18 @@ namespace Autis {
         explicit Scanner(std::istream &input);
 
         /**
-         * Gives the input stream from which this scanner reads.
+         * Destroys this Scanner.
+         */
+        virtual ~Scanner() = default;
+
+        /**
+         * Gives an input stream from which the unread content of the input can
+         * be read, starting from the next character to read.
+         * Once this stream has been used, this scanner must not be used anymore.
          *
          * @return The input stream.
          */
-        [[nodiscard]] std::istream &getInput() const;
+        [[nodiscard]] std::istream &getInput();
 
         /**
          * Looks at the next non-blank character in the input stream, but does
@@ -79,6 +131,24 @@ namespace Autis {
          */
         [[nodiscard]] bool look(char &c);
 
+        /**
+         * Looks at the next character in the input stream (be it blank or not),
+         * but does not consume it.
+         *
+         * @param c The variable in which to store the read character.
+         *
+         * @return Whether a character has been read, meaning that EOF has not
+         *         been reached.
+         *         If false is returned, then the content of c is undefined.
+         */
+        [[nodiscard]] bool peek(char &c);
+
+        /**
+         * Consumes the character that has been given by the last call to
+         * peek() or look().
+         */
+        void advance();
+
         /**
          * Reads the next character from the input stream.
          *
@@ -89,11 +159,52 @@ namespace Autis {
         /**
          * Reads the next int value from the input stream.
          * Initial characters that do not form a part of an integer are ignored.
+         * This is the same as readInt32(): numbers that do not fit in an int
+         * are rejected, instead of being silently truncated.
          *
          * @param value The variable in which to store the read value.
+         *
+         * @throws ParseException If no number can be read, or if the read
+         *         number does not fit in an int.
          */
         void read(int &value);
 
+        /**
+         * Reads the next 32-bit integer value from the input stream.
+         * Initial characters that do not form a part of an integer are ignored.
+         *
+         * @param value The variable in which to store the read value.
+         *
+         * @throws ParseException If the read number does not fit in 32 bits.
+         */
+        void readInt32(std::int32_t &value);
+
+        /**
+         * Reads the next 64-bit integer value from the input stream.
+         * Initial characters that do not form a part of an integer are ignored.
+         *
+         * @param value The variable in which to store the read value.
+         *
+         * @throws ParseException If the read number does not fit in 64 bits.
+         */
+        void readInt64(std::int64_t &value);
+
+        /**
+         * Reads the next integer value from the input stream, using native
+         * arithmetic as long as the number fits in 64 bits, and big integer
+         * arithmetic only when it does not.
+         * Initial characters that do not form a part of an integer are ignored.
+         *
+         * @param value The variable in which to store the read value, if it
+         *        fits in 64 bits.
+         * @param bigValue The variable in which to store the read value, if it
+         *        does not fit in 64 bits.
+         *
+         * @return Whether the read value fits in 64 bits, in which case only
+         *         value is set.
+         */
+        [[nodiscard]] bool readInt64(std::int64_t &value, Universe::BigInteger &bigValue);
+
         /**
          * Reads the next big integer value from the input stream.
          * Initial characters that do not form a part of an integer are ignored.
@@ -102,12 +213,72 @@ namespace Autis {
          */
         void readBig(Universe::BigInteger &value);
 
+        /**
+         * Reads as many int values as possible from the characters that are
+         * currently available, using a vectorized tokenizer.
+         * Reading stops at the first token that is not a (small enough)
+         * integer, which is left unconsumed, or when the available characters
+         * are too few to be read efficiently.
+         * Callers must thus fall back to read(int&) when no value is read.
+         *
+         * @param values The array in which to store the read values.
+         * @param capacity The maximum number of values to read.
+         *
+         * @return The number of values that have been read.
+         */
+        std::size_t readIntegers(int *values, std::size_t capacity);
+
         /**
          * Skips the next line in the input stream.
          * All characters are ignored until end-of-line is read.
          */
         void skipLine();
 
+        /**
+         * Looks at the rest of the current line in the input stream, but does
+         * not consume it.
+         * The buffered input is extended as needed to hold the whole line, so
+         * that it lies between getPosition() and getEnd() afterwards.
+         *
+         * @return The rest of the current line, without its end-of-line
+         *         character.
+         *         The returned view remains valid until this scanner reads
+         *         from the input stream.
+         */
+        [[nodiscard]] std::string_view lookLine();
+
+        /**
+         * Checks whether the whole unread part of the input is available in
+         * memory (e.g., because the input is a mapped file).
+         * In this case, this part lies between getPosition() and getEnd().
+         *
+         * @return Whether the unread input is in memory.
+         */
+        [[nodiscard]] bool isInMemory() const;
+
+        /**
+         * Gives the next character to read from the buffered input.
+         *
+         * @return The position of the next character to read.
+         */
+        [[nodiscard]] const char *getPosition() const;
+
+        /**
+         * Gives the end of the buffered input.
+         *
+         * @return The character right after the last buffered character.
+         */
+        [[nodiscard]] const char *getEnd() const;
+
+        /**
+         * Moves forward in the buffered input, considering all the characters
+         * before the given position as read.
+         *
+         * @param position The position of the next character to read, between
+         *        getPosition() and getEnd().
+         */
+        void moveTo(const char *position);
+
         /**
          * Checks whether this scanner has reached end-of-file.
          *
@@ -115,6 +286,49 @@ namespace Autis {
          */
         bool eof();
 
+    protected:
+
+        /**
+         * Creates a new Scanner that reads from a region of memory.
+         *
+         * @param begin The first character of the region.
+         * @param end The character right after the last character of the region.
+         */
+        Scanner(const char *begin, const char *end);
+
+    private:
+
+        /**
+         * Moves to the beginning of the next number in the input stream, and
+         * consumes its sign (if any).
+         *
+         * @return Whether the number is negative.
+         *
+         * @throws ParseException If no number can be read.
+         */
+        bool readSign();
+
+        /**
+         * Reads the digits of a number, as long as its magnitude does not
+         * exceed the given bound.
+         * The first digit that would exceed the bound is not consumed.
+         *
+         * @param bound The maximum magnitude of the number.
+         * @param magnitude The variable in which to store the magnitude.
+         *
+         * @return Whether all the digits of the number have been read.
+         */
+        bool readMagnitude(std::uint64_t bound, std::uint64_t &magnitude);
+
+        /**
+         * Reads the next block of the input stream, once all the characters
+         * that are available have been consumed.
+         *
+         * @return Whether new characters are available.
+         *         If false is returned, EOF has been reached.
+         */
+        bool fill();
+
     };
 
 }
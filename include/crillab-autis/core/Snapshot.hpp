@@ -0,0 +1,354 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file Snapshot.hpp
+ * @brief Stores parsed instances in a compact binary form.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_SNAPSHOT_HPP
+#define AUTIS_SNAPSHOT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <vector>
+
+#include <crillab-universe/core/UniverseType.hpp>
+
+#include "Instance.hpp"
+#include "Scanner.hpp"
+
+namespace Autis {
+
+    /**
+     * The bytes starting every snapshot.
+     * The first one cannot start any text input, so that snapshots can be
+     * recognized by the first character of their content.
+     */
+    inline constexpr char SNAPSHOT_MAGIC[] = {'\x89', 'A', 'U', 'T', 'I', 'S', '\r', '\n'};
+
+    /**
+     * The version of the snapshot format written by this library.
+     * It is increased each time the format changes, so that outdated
+     * snapshots are rejected rather than misread.
+     */
+    inline constexpr std::uint64_t SNAPSHOT_VERSION = 1;
+
+    /**
+     * The SnapshotWriter writes the values of a snapshot to an output stream.
+     * Integers are written as variable-length quantities (LEB128), on which
+     * signed values are first mapped by zigzag encoding, so that small values
+     * only use a few bytes.
+     */
+    class SnapshotWriter {
+
+    private:
+
+        /**
+         * The stream to write the snapshot to.
+         */
+        std::ostream &output;
+
+        /**
+         * The bytes that have not been written to the stream yet.
+         */
+        std::vector<char> buffer;
+
+    public:
+
+        /**
+         * Creates a new SnapshotWriter.
+         *
+         * @param output The stream to write the snapshot to.
+         */
+        explicit SnapshotWriter(std::ostream &output);
+
+        /**
+         * Writes the remaining bytes and destroys this SnapshotWriter.
+         */
+        ~SnapshotWriter();
+
+        /**
+         * Writes a single byte.
+         *
+         * @param value The byte to write.
+         */
+        void writeByte(unsigned char value);
+
+        /**
+         * Writes raw bytes.
+         *
+         * @param bytes The bytes to write.
+         */
+        void writeBytes(std::span<const char> bytes);
+
+        /**
+         * Writes a 64-bit word on exactly 8 bytes, in little-endian order.
+         *
+         * @param value The word to write.
+         */
+        void writeFixed(std::uint64_t value);
+
+        /**
+         * Writes a non-negative integer.
+         *
+         * @param value The integer to write.
+         */
+        void writeUnsigned(std::uint64_t value);
+
+        /**
+         * Writes a (possibly negative) integer.
+         *
+         * @param value The integer to write.
+         */
+        void writeSigned(std::int64_t value);
+
+        /**
+         * Writes a big integer.
+         *
+         * @param value The big integer to write.
+         */
+        void writeBig(const Universe::BigInteger &value);
+
+        /**
+         * Writes a sequence of integers, each of them being written as its
+         * difference with the previous one.
+         * This is particularly compact for the literals of a clause, or the
+         * identifiers of the variables in a scope, which are often close to
+         * each other.
+         *
+         * @tparam T The type of the integers.
+         *
+         * @param values The integers to write.
+         */
+        template <typename T>
+        void writeDeltas(std::span<const T> values) {
+            writeUnsigned(values.size());
+            std::int64_t previous = 0;
+            for (auto value : values) {
+                writeSigned(static_cast<std::int64_t>(value) - previous);
+                previous = static_cast<std::int64_t>(value);
+            }
+        }
+
+        /**
+         * Writes all the bytes that have not been written to the stream yet.
+         */
+        void flush();
+
+    };
+
+    /**
+     * The SnapshotReader reads back the values written by a SnapshotWriter,
+     * directly from the memory in which the snapshot is stored.
+     */
+    class SnapshotReader {
+
+    private:
+
+        /**
+         * The position of the next byte to read.
+         */
+        const char *cursor;
+
+        /**
+         * The end of the snapshot.
+         */
+        const char *end;
+
+    public:
+
+        /**
+         * Creates a new SnapshotReader.
+         *
+         * @param begin The beginning of the snapshot.
+         * @param end The end of the snapshot.
+         */
+        SnapshotReader(const char *begin, const char *end);
+
+        /**
+         * Reads a single byte.
+         *
+         * @return The read byte.
+         *
+         * @throws ParseException If the snapshot is truncated.
+         */
+        unsigned char readByte();
+
+        /**
+         * Reads raw bytes.
+         * The returned bytes remain valid as long as the snapshot is.
+         *
+         * @param size The number of bytes to read.
+         *
+         * @return The read bytes.
+         *
+         * @throws ParseException If the snapshot is truncated.
+         */
+        std::span<const char> readBytes(std::size_t size);
+
+        /**
+         * Reads a 64-bit word written on exactly 8 bytes.
+         *
+         * @return The read word.
+         *
+         * @throws ParseException If the snapshot is truncated.
+         */
+        std::uint64_t readFixed();
+
+        /**
+         * Reads a non-negative integer.
+         *
+         * @return The read integer.
+         *
+         * @throws ParseException If the snapshot is truncated or malformed.
+         */
+        std::uint64_t readUnsigned();
+
+        /**
+         * Reads a (possibly negative) integer.
+         *
+         * @return The read integer.
+         *
+         * @throws ParseException If the snapshot is truncated or malformed.
+         */
+        std::int64_t readSigned();
+
+        /**
+         * Reads a big integer.
+         *
+         * @param value The big integer in which to store the read value.
+         *
+         * @throws ParseException If the snapshot is truncated or malformed.
+         */
+        void readBig(Universe::BigInteger &value);
+
+        /**
+         * Reads a sequence of integers written by SnapshotWriter::writeDeltas().
+         *
+         * @tparam T The type of the integers.
+         *
+         * @param values The vector in which to store the read integers.
+         *        Its previous content is replaced.
+         *
+         * @throws ParseException If the snapshot is truncated or malformed.
+         */
+        template <typename T>
+        void readDeltas(std::vector<T> &values) {
+            auto size = readSize();
+            values.resize(size);
+            std::int64_t previous = 0;
+            for (auto &value : values) {
+                previous += readSigned();
+                value = static_cast<T>(previous);
+            }
+        }
+
+        /**
+         * Reads the size of a sequence, and checks that the snapshot may
+         * contain that many values.
+         *
+         * @return The read size.
+         *
+         * @throws ParseException If the snapshot is truncated or malformed.
+         */
+        std::size_t readSize();
+
+        /**
+         * Checks whether all the bytes of the snapshot have been read.
+         *
+         * @return Whether the end of the snapshot has been reached.
+         */
+        [[nodiscard]] bool eof() const;
+
+    };
+
+    /**
+     * Checks whether the given content is a snapshot.
+     *
+     * @param data The content to check.
+     * @param size The size of the content.
+     *
+     * @return Whether the content starts like a snapshot.
+     */
+    bool isSnapshot(const char *data, std::size_t size);
+
+    /**
+     * Writes a snapshot of an instance, from which the instance can be read
+     * back much faster than from its original input.
+     *
+     * @param instance The instance to write.
+     * @param output The stream to write the snapshot to.
+     * @param fingerprint The fingerprint of the input from which the instance
+     *        has been read (see ContentHash), or 0 if it is unknown.
+     */
+    void writeSnapshot(const Autis::Instance &instance, std::ostream &output, std::uint64_t fingerprint = 0);
+
+    /**
+     * Reads the instance stored in a snapshot.
+     *
+     * @param begin The beginning of the snapshot.
+     * @param end The end of the snapshot.
+     *
+     * @return The instance stored in the snapshot.
+     *
+     * @throws ParseException If the content is not a valid snapshot, or has
+     *         been written by an incompatible version of this library.
+     */
+    Autis::Instance readSnapshot(const char *begin, const char *end);
+
+    /**
+     * Reads the instance stored in the snapshot read by the given scanner.
+     * If the snapshot is in memory (e.g., in a mapped file), it is read from
+     * there directly.
+     *
+     * @param scanner The scanner reading the snapshot.
+     *
+     * @return The instance stored in the snapshot.
+     *
+     * @throws ParseException If the input is not a valid snapshot, or has
+     *         been written by an incompatible version of this library.
+     */
+    Autis::Instance readSnapshot(Autis::Scanner &scanner);
+
+    /**
+     * Gives the fingerprint of the input from which the instance stored in a
+     * snapshot has been read.
+     *
+     * @param begin The beginning of the snapshot.
+     * @param end The end of the snapshot.
+     *
+     * @return The fingerprint recorded in the snapshot (0 if unknown).
+     *
+     * @throws ParseException If the content is not a valid snapshot, or has
+     *         been written by an incompatible version of this library.
+     */
+    std::uint64_t readSnapshotFingerprint(const char *begin, const char *end);
+
+}
+
+#endif
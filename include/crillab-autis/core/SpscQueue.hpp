@@ -0,0 +1,222 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file SpscQueue.hpp
+ * @brief Provides a bounded lock-free queue for one producer and one consumer.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_SPSCQUEUE_HPP
+#define AUTIS_SPSCQUEUE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Autis {
+
+    /**
+     * The SpscQueue is a bounded ring buffer shared by exactly one producer
+     * thread and one consumer thread.
+     * Elements are exchanged without locks: each side only writes its own
+     * index, and a side blocks (without spinning) only when the ring is full
+     * or empty.
+     *
+     * @tparam T The type of the elements in the queue.
+     */
+    template <typename T>
+    class SpscQueue {
+
+    private:
+
+        /**
+         * The slots of the ring, whose number is a power of two.
+         */
+        std::vector<T> slots;
+
+        /**
+         * The mask giving the slot of an index.
+         */
+        std::size_t mask;
+
+        /**
+         * The index of the next element to pop, only written by the consumer.
+         */
+        alignas(64) std::atomic<std::size_t> head;
+
+        /**
+         * The index of the next element to push, only written by the producer.
+         */
+        alignas(64) std::atomic<std::size_t> tail;
+
+        /**
+         * The counter of the events the consumer may be waiting for.
+         */
+        alignas(64) std::atomic<std::uint32_t> producerEvents;
+
+        /**
+         * The counter of the events the producer may be waiting for.
+         */
+        alignas(64) std::atomic<std::uint32_t> consumerEvents;
+
+        /**
+         * Whether the producer will not push any more elements.
+         */
+        std::atomic<bool> closed;
+
+        /**
+         * Whether the consumer will not pop any more elements.
+         */
+        std::atomic<bool> cancelled;
+
+    public:
+
+        /**
+         * Creates a new SpscQueue.
+         *
+         * @param capacity The minimum number of elements the queue may contain
+         *        (it is rounded up to a power of two).
+         */
+        explicit SpscQueue(std::size_t capacity) :
+                slots(std::bit_ceil(std::max(capacity, std::size_t(1)))),
+                mask(slots.size() - 1),
+                head(0),
+                tail(0),
+                producerEvents(0),
+                consumerEvents(0),
+                closed(false),
+                cancelled(false) {
+            // Nothing to do: everything is already initialized.
+        }
+
+        SpscQueue(const SpscQueue &) = delete;
+
+        SpscQueue &operator=(const SpscQueue &) = delete;
+
+        /**
+         * Pushes an element at the end of this queue, waiting for a slot to be
+         * available if the queue is full.
+         * This method must only be called by the producer.
+         *
+         * @param value The element to push.
+         *
+         * @return Whether the element has been pushed, which is not the case
+         *         when the consumer has cancelled the queue.
+         */
+        bool push(T &&value) {
+            std::size_t index = tail.load(std::memory_order_relaxed);
+
+            for (;;) {
+                // The event counter is read first, so that no pop is missed.
+                auto events = consumerEvents.load(std::memory_order_acquire);
+                if (cancelled.load(std::memory_order_acquire)) {
+                    return false;
+                }
+                if ((index - head.load(std::memory_order_acquire)) <= mask) {
+                    break;
+                }
+                consumerEvents.wait(events, std::memory_order_acquire);
+            }
+
+            slots[index & mask] = std::move(value);
+            tail.store(index + 1, std::memory_order_release);
+            signal(producerEvents);
+            return true;
+        }
+
+        /**
+         * Pops the element at the beginning of this queue, waiting for one to
+         * be pushed if the queue is empty.
+         * This method must only be called by the consumer.
+         *
+         * @param value The variable in which to store the popped element.
+         *
+         * @return Whether an element has been popped, which is not the case
+         *         when the queue is empty and closed.
+         */
+        bool pop(T &value) {
+            std::size_t index = head.load(std::memory_order_relaxed);
+
+            for (;;) {
+                // The event counter is read first, so that no push is missed.
+                auto events = producerEvents.load(std::memory_order_acquire);
+                if (tail.load(std::memory_order_acquire) != index) {
+                    break;
+                }
+                if (closed.load(std::memory_order_acquire)) {
+                    // The last elements may have been pushed right before closing.
+                    if (tail.load(std::memory_order_acquire) != index) {
+                        break;
+                    }
+                    return false;
+                }
+                producerEvents.wait(events, std::memory_order_acquire);
+            }
+
+            value = std::move(slots[index & mask]);
+            head.store(index + 1, std::memory_order_release);
+            signal(consumerEvents);
+            return true;
+        }
+
+        /**
+         * Tells the consumer that no more elements will be pushed.
+         * This method must only be called by the producer.
+         */
+        void close() {
+            closed.store(true, std::memory_order_release);
+            signal(producerEvents);
+        }
+
+        /**
+         * Tells the producer that no more elements will be popped.
+         * This method must only be called by the consumer.
+         */
+        void cancel() {
+            cancelled.store(true, std::memory_order_release);
+            signal(consumerEvents);
+        }
+
+    private:
+
+        /**
+         * Wakes up the thread that may be waiting for an event.
+         *
+         * @param events The counter of the events the thread may be waiting for.
+         */
+        static void signal(std::atomic<std::uint32_t> &events) {
+            events.fetch_add(1, std::memory_order_release);
+            events.notify_one();
+        }
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,104 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file ZstdStreamBuffer.hpp
+ * @brief Provides a stream buffer decompressing Zstandard data on the fly.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_ZSTDSTREAMBUFFER_HPP
+#define AUTIS_ZSTDSTREAMBUFFER_HPP
+
+#ifdef AUTIS_WITH_ZSTD
+
+#include <zstd.h>
+
+#include "DecompressionStreamBuffer.hpp"
+
+namespace Autis {
+
+    /**
+     * The ZstdStreamBuffer is a stream buffer decompressing Zstandard data on the fly.
+     * Concatenated Zstandard frames are decompressed one after the other.
+     */
+    class ZstdStreamBuffer : public Autis::DecompressionStreamBuffer {
+
+    private:
+
+        /**
+         * The state of the Zstandard decoder.
+         */
+        ZSTD_DStream *stream;
+
+        /**
+         * The compressed data that has been read but not decompressed yet.
+         */
+        ZSTD_inBuffer input;
+
+        /**
+         * Whether the end of the frame being decompressed has been reached.
+         */
+        bool endOfStream;
+
+    public:
+
+        /**
+         * Creates a new ZstdStreamBuffer.
+         *
+         * @param source The stream buffer from which compressed data is read.
+         */
+        explicit ZstdStreamBuffer(std::streambuf &source);
+
+        /**
+         * Destroys this ZstdStreamBuffer.
+         */
+        ~ZstdStreamBuffer() override;
+
+        ZstdStreamBuffer(const ZstdStreamBuffer &) = delete;
+
+        ZstdStreamBuffer &operator=(const ZstdStreamBuffer &) = delete;
+
+    protected:
+
+        /**
+         * Decompresses the next part of the input.
+         *
+         * @param data The array in which to write the decompressed data.
+         * @param capacity The maximum number of bytes to write.
+         *
+         * @return The number of bytes that have been written, which is 0 only
+         *         when the end of the input has been reached.
+         *
+         * @throws ParseException If the compressed data is corrupted.
+         */
+        std::size_t decompress(char *data, std::size_t capacity) override;
+
+    };
+
+}
+
+#endif
+
+#endif
@@ -31,31 +31,168 @@
 #ifndef AUTIS_PARSER_HPP
 #define AUTIS_PARSER_HPP
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include <crillab-universe/utils/IUniverseSolverFactory.hpp>
 
+#include "Instance.hpp"
+#include "ParserConfiguration.hpp"
+#include "Scanner.hpp"
+
 namespace Autis {
 
     /**
      * Parses the file at the given path to read the formula to solve.
-     * The format of the input file may be CNF, OPB or XCSP3.
+     * The format of the input file may be CNF, WCNF, OPB, WBO or XCSP3, or the input may
+     * be a snapshot written by writeSnapshot().
+     * Regular files are mapped into memory and read directly from there,
+     * while other files (such as pipes) are read as streams.
      *
      * @param path The path of the file to parse.
      * @param listener The listener to notify while parsing.
+     * @param configuration The configuration of the parser.
      */
     Universe::IUniverseSolver *parse(
-            const std::string &path, Universe::IUniverseSolverFactory &listener);
+            const std::string &path, Universe::IUniverseSolverFactory &listener,
+            const Autis::ParserConfiguration &configuration = Autis::ParserConfiguration());
 
     /**
      * Parses the given stream to read the formula to solve.
-     * The format of the input file may be CNF, OPB or XCSP3.
+     * The format of the input file may be CNF, WCNF, OPB, WBO or XCSP3, or the input may
+     * be a snapshot written by writeSnapshot().
      *
      * @param input The input stream to parse.
      * @param factory The listener to notify while parsing.
+     * @param configuration The configuration of the parser.
      */
     Universe::IUniverseSolver *parse(
-            std::istream &input, Universe::IUniverseSolverFactory &factory);
+            std::istream &input, Universe::IUniverseSolverFactory &factory,
+            const Autis::ParserConfiguration &configuration = Autis::ParserConfiguration());
+
+    /**
+     * Parses the input read by the given scanner to read the formula to solve.
+     * The format of the input file may be CNF, WCNF, OPB, WBO or XCSP3, or the input may
+     * be a snapshot written by writeSnapshot().
+     *
+     * @param scanner The scanner reading the input to parse.
+     * @param factory The listener to notify while parsing.
+     * @param configuration The configuration of the parser.
+     */
+    Universe::IUniverseSolver *parse(
+            Autis::Scanner &scanner, Universe::IUniverseSolverFactory &factory,
+            const Autis::ParserConfiguration &configuration = Autis::ParserConfiguration());
+
+    /**
+     * Parses the file at the given path once, and gives the formula it
+     * defines to a portfolio of solvers, each of them being created by one
+     * of the given factories and fed on its own thread.
+     * The format of the input file may be CNF, WCNF, OPB, WBO or XCSP3, or the input may
+     * be a snapshot written by writeSnapshot().
+     *
+     * @param path The path of the file to parse.
+     * @param factories The factories creating the solvers of the portfolio.
+     * @param configuration The configuration of the parser.
+     *
+     * @return The solvers of the portfolio, in the order of their factories.
+     */
+    std::vector<Universe::IUniverseSolver *> parse(
+            const std::string &path, const std::vector<Universe::IUniverseSolverFactory *> &factories,
+            const Autis::ParserConfiguration &configuration = Autis::ParserConfiguration());
+
+    /**
+     * Parses the given stream once, and gives the formula it defines to a
+     * portfolio of solvers, each of them being created by one of the given
+     * factories and fed on its own thread.
+     * The format of the input may be CNF, WCNF, OPB, WBO or XCSP3, or the input may
+     * be a snapshot written by writeSnapshot().
+     *
+     * @param input The input stream to parse.
+     * @param factories The factories creating the solvers of the portfolio.
+     * @param configuration The configuration of the parser.
+     *
+     * @return The solvers of the portfolio, in the order of their factories.
+     */
+    std::vector<Universe::IUniverseSolver *> parse(
+            std::istream &input, const std::vector<Universe::IUniverseSolverFactory *> &factories,
+            const Autis::ParserConfiguration &configuration = Autis::ParserConfiguration());
+
+    /**
+     * Parses the input read by the given scanner once, and gives the formula
+     * it defines to a portfolio of solvers, each of them being created by one
+     * of the given factories and fed on its own thread.
+     * The format of the input may be CNF, WCNF, OPB, WBO or XCSP3, or the input may
+     * be a snapshot written by writeSnapshot().
+     *
+     * @param scanner The scanner reading the input to parse.
+     * @param factories The factories creating the solvers of the portfolio.
+     * @param configuration The configuration of the parser.
+     *
+     * @return The solvers of the portfolio, in the order of their factories.
+     */
+    std::vector<Universe::IUniverseSolver *> parse(
+            Autis::Scanner &scanner, const std::vector<Universe::IUniverseSolverFactory *> &factories,
+            const Autis::ParserConfiguration &configuration = Autis::ParserConfiguration());
+
+    /**
+     * Reads the file at the given path into an instance that does not depend
+     * on any solver, and that may then be replayed into as many solvers as
+     * needed.
+     * The format of the input file may be CNF, WCNF, OPB, WBO or XCSP3, or the input may
+     * be a snapshot written by writeSnapshot().
+     *
+     * @param path The path of the file to read.
+     * @param configuration The configuration of the parser.
+     *
+     * @return The instance defined in the file.
+     */
+    Autis::Instance readInstance(
+            const std::string &path, const Autis::ParserConfiguration &configuration = Autis::ParserConfiguration());
+
+    /**
+     * Reads the given stream into an instance that does not depend on any
+     * solver.
+     * The format of the input may be CNF, WCNF, OPB, WBO or XCSP3, or the input may
+     * be a snapshot written by writeSnapshot().
+     *
+     * @param input The input stream to read.
+     * @param configuration The configuration of the parser.
+     *
+     * @return The instance defined in the input.
+     */
+    Autis::Instance readInstance(
+            std::istream &input, const Autis::ParserConfiguration &configuration = Autis::ParserConfiguration());
+
+    /**
+     * Reads the input read by the given scanner into an instance that does
+     * not depend on any solver.
+     * The format of the input may be CNF, WCNF, OPB, WBO or XCSP3, or the input may
+     * be a snapshot written by writeSnapshot().
+     *
+     * @param scanner The scanner reading the input.
+     * @param configuration The configuration of the parser.
+     *
+     * @return The instance defined in the input.
+     */
+    Autis::Instance readInstance(
+            Autis::Scanner &scanner, const Autis::ParserConfiguration &configuration = Autis::ParserConfiguration());
+
+    /**
+     * Reads the file at the given path, and writes a snapshot of the instance
+     * it defines to another file.
+     * Giving this snapshot to parse() or readInstance() is much faster than
+     * parsing the original file again.
+     *
+     * @param path The path of the file to read.
+     * @param snapshotPath The path of the snapshot to write.
+     * @param configuration The configuration of the parser.
+     *
+     * @return The fingerprint of the file that has been read, which is also
+     *         recorded in the snapshot, and may be used to name it.
+     */
+    std::uint64_t writeSnapshot(const std::string &path, const std::string &snapshotPath,
+            const Autis::ParserConfiguration &configuration = Autis::ParserConfiguration());
 
 }
 
@@ -0,0 +1,678 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file BasicOpbParser.hpp
+ * @brief Provides an OPB parser that is specialized at compile-time for the object receiving the constraints.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_BASICOPBPARSER_HPP
+#define AUTIS_BASICOPBPARSER_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+#include <crillab-except/except.hpp>
+#include <crillab-universe/core/UniverseType.hpp>
+
+#include "../core/Scanner.hpp"
+#include "../core/ReservingSink.hpp"
+#include "CoefficientBuffer.hpp"
+#include "ProductLinearizer.hpp"
+#include "PseudoBooleanSink.hpp"
+#include "RelationalOperator.hpp"
+
+namespace Autis {
+
+    /**
+     * The BasicOpbParser reads inputs written using the OPB format, and gives
+     * the constraints it reads to a sink whose type is known at compile-time.
+     * This allows calls to the sink to be inlined.
+     * Products of literals may be linearized, in which case the sink also
+     * receives the constraints defining their auxiliary variables.
+     *
+     * @tparam Sink The type of the sink receiving the constraints.
+     */
+    template <Autis::PseudoBooleanSink Sink>
+    class BasicOpbParser {
+
+    protected:
+
+        /**
+         * The scanner used to read the input.
+         */
+        Autis::Scanner &scanner;
+
+        /**
+         * The sink receiving the constraints.
+         */
+        Sink &sink;
+
+        /**
+         * The number of variables declared in the input.
+         */
+        int numberOfVariables;
+
+        /**
+         * The number of constraints declared in the input.
+         */
+        int numberOfConstraints;
+
+        /**
+         * Whether the input defines an optimization problem.
+         */
+        bool optimization;
+
+        /**
+         * The literals of the constraint being read.
+         */
+        std::vector<int> literals;
+
+        /**
+         * The coefficients of the constraint being read.
+         */
+        Autis::CoefficientBuffer coefficients;
+
+        /**
+         * The literals of the term being read.
+         */
+        std::vector<int> term;
+
+        /**
+         * The degree of the constraint being read.
+         */
+        Universe::BigInteger degree;
+
+        /**
+         * Whether products of literals are replaced by auxiliary variables
+         * (otherwise, they are rejected).
+         */
+        bool linearizing;
+
+        /**
+         * The linearizer giving the auxiliary variables replacing products.
+         */
+        Autis::ProductLinearizer linearizer;
+
+        /**
+         * The auxiliary variables that have been introduced while reading the
+         * current constraint, and that still have to be defined.
+         */
+        std::vector<int> definitions;
+
+        /**
+         * The literals of the constraint defining an auxiliary variable.
+         */
+        std::vector<int> definitionLiterals;
+
+        /**
+         * The coefficients of the constraint defining an auxiliary variable.
+         */
+        std::vector<Universe::BigInteger> definitionCoefficients;
+
+    public:
+
+        /**
+         * Creates a new BasicOpbParser.
+         *
+         * @param scanner The scanner used to read the input.
+         * @param sink The sink receiving the constraints.
+         * @param linearizing Whether products of literals are replaced by
+         *        auxiliary variables, instead of being rejected.
+         */
+        BasicOpbParser(Autis::Scanner &scanner, Sink &sink, bool linearizing = true);
+
+        /**
+         * Parses the input to read the constraints it contains.
+         *
+         * @throws ParseException If the input is not a well-formed OPB input.
+         */
+        void parse();
+
+        /**
+         * Gives the number of variables declared in the input, to which are
+         * added the auxiliary variables introduced to replace products.
+         *
+         * @return The number of variables.
+         */
+        [[nodiscard]] int getNumberOfVariables() const;
+
+        /**
+         * Gives the number of constraints declared in the input.
+         *
+         * @return The number of constraints.
+         */
+        [[nodiscard]] int getNumberOfConstraints() const;
+
+        /**
+         * Checks whether the input defines an optimization problem.
+         *
+         * @return Whether there is an objective function.
+         */
+        [[nodiscard]] bool isOptimization() const;
+
+    protected:
+
+        /**
+         * Reads the first comment line to get the number of variables and
+         * the number of constraints in the input.
+         */
+        void readMetaData();
+
+        /**
+         * Reads the number of products declared on the rest of the first
+         * comment line, if any.
+         *
+         * @return The number of products declared in the input, or 0 if
+         *         there is none.
+         */
+        int readNumberOfProducts();
+
+        /**
+         * Skips comments from the input.
+         */
+        void skipComments();
+
+        /**
+         * Reads the objective line (if any).
+         */
+        void readObjective();
+
+        /**
+         * Reads a constraint, and gives it to the sink.
+         */
+        void readConstraint();
+
+        /**
+         * Reads the terms, the relational operator and the degree of a
+         * constraint, up to the semi-colon ending it.
+         * The terms and the degree are stored in the buffers of this parser.
+         *
+         * @return The relational operator of the constraint.
+         */
+        Autis::RelationalOperator readConstraintBody();
+
+        /**
+         * Reads a term (either from the objective function or from a constraint).
+         *
+         * @param termCoefficients The buffer to which the coefficient of the
+         *        term is added.
+         * @param termLiterals The vector in which to store the literals of the
+         *        term (if there is more than one, this is a product of literals).
+         */
+        void readTerm(Autis::CoefficientBuffer &termCoefficients, std::vector<int> &termLiterals);
+
+        /**
+         * Gives the variable replacing a product of literals, which will be
+         * defined once the current constraint has been given to the sink.
+         *
+         * @param product The literals of the product.
+         *
+         * @return The literal equivalent to the product.
+         */
+        int linearize(std::vector<int> &product);
+
+        /**
+         * Gives to the sink the constraints defining the auxiliary variables
+         * introduced while reading the current constraint.
+         * An auxiliary variable y replacing the product l1 ... lk is
+         * defined by the constraints l1 + ... + lk + k ~y >= k and
+         * y + ~l1 + ... + ~lk >= 1.
+         */
+        void defineProducts();
+
+        /**
+         * Reads an identifier from the stream and appends it to literals.
+         *
+         * @param literals The current list of read identifiers.
+         *
+         * @return Whether an identifier was read.
+         */
+        bool readIdentifier(std::vector<int> &literals);
+
+        /**
+         * Checks whether a character starts a relational operator, i.e., one
+         * of `>=`, `<=` or `=`.
+         *
+         * @param c The character to check.
+         *
+         * @return Whether the character starts a relational operator.
+         */
+        static bool isRelationalOperator(char c);
+
+        /**
+         * Reads a relational operator from the input stream.
+         *
+         * @return The relational operator that has been read.
+         */
+        Autis::RelationalOperator readRelationalOperator();
+
+        /**
+         * Checks whether the given literal is correct w.r.t. the expected
+         * number of variables.
+         *
+         * @param literal The literal to check.
+         *
+         * @return The given literal.
+         */
+        [[nodiscard]] int checkLiteral(int literal) const;
+
+    };
+
+    template <Autis::PseudoBooleanSink Sink>
+    BasicOpbParser<Sink>::BasicOpbParser(Autis::Scanner &scanner, Sink &sink, bool linearizing) :
+            scanner(scanner),
+            sink(sink),
+            numberOfVariables(0),
+            numberOfConstraints(0),
+            optimization(false),
+            literals(),
+            coefficients(),
+            term(),
+            degree(),
+            linearizing(linearizing),
+            linearizer(),
+            definitions(),
+            definitionLiterals(),
+            definitionCoefficients() {
+        // Nothing to do: everything is already initialized.
+    }
+
+    template <Autis::PseudoBooleanSink Sink>
+    void BasicOpbParser<Sink>::parse() {
+        // Reading the header of the file.
+        readMetaData();
+        skipComments();
+
+        // Reading the objective function.
+        readObjective();
+
+        // Reading the constraints.
+        int nbConstraintsRead = 0;
+        for (char c; scanner.look(c);) {
+            if (c == '*') {
+                // The rest of the line is a comment.
+                skipComments();
+            }
+
+            // Reading the next constraint.
+            readConstraint();
+            nbConstraintsRead++;
+        }
+
+        if (nbConstraintsRead != numberOfConstraints) {
+            // The number of read constraints is not the expected one.
+            throw Except::ParseException("Unexpected number of constraints");
+        }
+    }
+
+    template <Autis::PseudoBooleanSink Sink>
+    int BasicOpbParser<Sink>::getNumberOfVariables() const {
+        return linearizer.getNumberOfVariables();
+    }
+
+    template <Autis::PseudoBooleanSink Sink>
+    int BasicOpbParser<Sink>::getNumberOfConstraints() const {
+        return numberOfConstraints;
+    }
+
+    template <Autis::PseudoBooleanSink Sink>
+    bool BasicOpbParser<Sink>::isOptimization() const {
+        return optimization;
+    }
+
+    template <Autis::PseudoBooleanSink Sink>
+    void BasicOpbParser<Sink>::readMetaData() {
+        // Checking that the first line is a comment.
+        char c = scanner.read();
+        if (c != '*') {
+            throw Except::ParseException("Metadata line expected");
+        }
+
+        // Reading the metadata of the input.
+        scanner.read(numberOfVariables);
+        scanner.read(numberOfConstraints);
+
+        // Ignoring the rest of the line, except for the number of products.
+        auto numberOfProducts = readNumberOfProducts();
+        scanner.skipLine();
+        linearizer.reset(numberOfVariables);
+
+        if constexpr (Autis::ReservingSink<Sink>) {
+            // Each product may introduce a variable, defined by two constraints.
+            std::int64_t nbVariables = numberOfVariables;
+            std::int64_t nbConstraints = numberOfConstraints;
+            if (linearizing) {
+                nbVariables += numberOfProducts;
+                nbConstraints += 2 * static_cast<std::int64_t>(numberOfProducts);
+            }
+
+            // The sink may now allocate what it needs for the problem.
+            constexpr std::int64_t max = std::numeric_limits<int>::max();
+            sink.reserve(static_cast<int>(std::min(nbVariables, max)),
+                    static_cast<int>(std::min(nbConstraints, max)));
+        }
+    }
+
+    template <Autis::PseudoBooleanSink Sink>
+    int BasicOpbParser<Sink>::readNumberOfProducts() {
+        constexpr std::string_view keyword = "#product=";
+        std::size_t matched = 0;
+
+        for (char c; scanner.peek(c) && (c != '\n');) {
+            scanner.advance();
+            if (c == keyword[matched]) {
+                matched++;
+                if (matched == keyword.size()) {
+                    break;
+                }
+
+            } else {
+                matched = (c == keyword[0]) ? 1 : 0;
+            }
+        }
+
+        if (matched < keyword.size()) {
+            // No product is declared.
+            return 0;
+        }
+
+        // The number of products must follow the keyword on the same line.
+        char c;
+        while (scanner.peek(c) && ((c == ' ') || (c == '\t'))) {
+            scanner.advance();
+        }
+        if ((!scanner.peek(c)) || (!std::isdigit(c))) {
+            return 0;
+        }
+        int numberOfProducts;
+        scanner.read(numberOfProducts);
+        return numberOfProducts;
+    }
+
+    template <Autis::PseudoBooleanSink Sink>
+    void BasicOpbParser<Sink>::skipComments() {
+        for (char c; scanner.look(c) && (c == '*');) {
+            scanner.skipLine();
+        }
+    }
+
+    template <Autis::PseudoBooleanSink Sink>
+    void BasicOpbParser<Sink>::readObjective() {
+        // Reading the objective line (if any).
+        char c;
+        if ((!scanner.look(c)) || (c != 'm')) {
+            // There is no objective function.
+            return;
+        }
+
+        // Reading the objective function.
+        if ((scanner.read() != 'm') || (scanner.read() != 'i') || (scanner.read() != 'n') || (scanner.read() != ':')) {
+            // The "min" keyword was expected but is not present.
+            throw Except::ParseException("Keyword `min:' expected");
+        }
+
+        optimization = true;
+        if constexpr (Autis::ObjectiveSink<Sink>) {
+            // The terms are given to the sink as soon as they are read.
+            sink.beginObjective();
+            while (scanner.look(c) && (c != ';')) {
+                if ((c != '-') && (c != '+') && (!std::isdigit(c))) {
+                    // A number should have been here.
+                    throw Except::ParseException("Number expected");
+                }
+
+                // Reading the next term of the objective function.
+                coefficients.clear();
+                readTerm(coefficients, term);
+                if (term.size() == 1) {
+                    // This is a simple term.
+                    sink.addObjectiveTerm(term[0], coefficients.get()[0]);
+
+                } else if (linearizing) {
+                    // This is a product of literals.
+                    sink.addObjectiveTerm(linearize(term), coefficients.get()[0]);
+
+                } else {
+                    throw Except::UnsupportedOperationException("Non linear objective functions are not supported");
+                }
+            }
+
+            // Ending the objective function.
+            // We need to consume the ';' character.
+            if ((!scanner.look(c)) || (c != ';')) {
+                throw Except::ParseException("Semi-colon expected at end of objective function");
+            }
+            (void) scanner.read();
+            sink.endObjective();
+            defineProducts();
+
+        } else {
+            throw Except::UnsupportedOperationException("Objective function not supported");
+        }
+    }
+
+    template <Autis::PseudoBooleanSink Sink>
+    void BasicOpbParser<Sink>::readConstraint() {
+        auto relationalOperator = readConstraintBody();
+
+        // Checking the relational operator to identify the type of the constraint.
+        if (relationalOperator == Autis::RelationalOperator::EXACTLY) {
+            sink.addExactly(literals, coefficients.get(), degree);
+
+        } else if (relationalOperator == Autis::RelationalOperator::AT_LEAST) {
+            sink.addAtLeast(literals, coefficients.get(), degree);
+
+        } else {
+            sink.addAtMost(literals, coefficients.get(), degree);
+        }
+
+        // The products of the constraint can now be defined.
+        defineProducts();
+    }
+
+    template <Autis::PseudoBooleanSink Sink>
+    Autis::RelationalOperator BasicOpbParser<Sink>::readConstraintBody() {
+        // The buffers of the previous constraint are reused.
+        literals.clear();
+        coefficients.clear();
+
+        for (char c; scanner.look(c);) {
+            if (isRelationalOperator(c)) {
+                // This is the relational operator, which ends the terms.
+                break;
+            }
+
+            if ((c != '-') && (c != '+') && (!std::isdigit(c))) {
+                // A number should have been here.
+                throw Except::ParseException("Number expected");
+            }
+
+            // Reading the next term of the constraint.
+            readTerm(coefficients, term);
+            if (term.size() == 1) {
+                // This is a simple term.
+                literals.push_back(term[0]);
+
+            } else if (linearizing) {
+                // This is a product of literals.
+                literals.push_back(linearize(term));
+
+            } else {
+                throw Except::UnsupportedOperationException("Non linear constraints are not supported");
+            }
+        }
+
+        // Reading the relational operator.
+        auto relationalOperator = readRelationalOperator();
+
+        // Reading the degree.
+        scanner.readBig(degree);
+
+        // Looking for the semicolon.
+        char c;
+        if ((!scanner.look(c)) || (c != ';')) {
+            throw Except::ParseException("Semi-colon expected at end of constraint");
+        }
+
+        // Ending the constraint.
+        // We need to consume the ';' character.
+        (void) scanner.read();
+        return relationalOperator;
+    }
+
+    template <Autis::PseudoBooleanSink Sink>
+    void BasicOpbParser<Sink>::readTerm(Autis::CoefficientBuffer &termCoefficients, std::vector<int> &termLiterals) {
+        termCoefficients.read(scanner);
+        termLiterals.clear();
+        while (readIdentifier(termLiterals));
+        if (termLiterals.empty()) {
+            throw Except::ParseException("Literal identifier expected");
+        }
+    }
+
+    template <Autis::PseudoBooleanSink Sink>
+    int BasicOpbParser<Sink>::linearize(std::vector<int> &product) {
+        bool fresh;
+        int literal = linearizer.linearize(product, fresh);
+        if (fresh) {
+            // This product has not been seen before.
+            definitions.push_back(literal);
+        }
+        return literal;
+    }
+
+    template <Autis::PseudoBooleanSink Sink>
+    void BasicOpbParser<Sink>::defineProducts() {
+        for (int variable : definitions) {
+            auto product = linearizer.getProduct(variable);
+            auto size = static_cast<std::int64_t>(product.size());
+
+            // The variable implies all the literals of the product.
+            definitionLiterals.assign(product.begin(), product.end());
+            definitionLiterals.push_back(-variable);
+            definitionCoefficients.resize(product.size() + 1);
+            for (std::size_t i = 0; i < product.size(); i++) {
+                definitionCoefficients[i] = 1;
+            }
+            definitionCoefficients.back() = size;
+            degree = size;
+            sink.addAtLeast(definitionLiterals, definitionCoefficients, degree);
+
+            // The literals of the product imply the variable.
+            definitionLiterals.clear();
+            definitionLiterals.push_back(variable);
+            for (int literal : product) {
+                definitionLiterals.push_back(-literal);
+            }
+            definitionCoefficients.back() = 1;
+            degree = 1;
+            sink.addAtLeast(definitionLiterals, definitionCoefficients, degree);
+        }
+        definitions.clear();
+    }
+
+    template <Autis::PseudoBooleanSink Sink>
+    bool BasicOpbParser<Sink>::readIdentifier(std::vector<int> &literals) {
+        bool negated = false;
+
+        // Reading the first character.
+        char c;
+        if (!scanner.look(c)) {
+            return false;
+        }
+
+        // Checking whether the literal is negated.
+        if (c == '~') {
+            // Consuming the negation.
+            (void) scanner.read();
+            negated = true;
+
+            // Reading the 'x' symbol.
+            if ((!scanner.look(c)) || (c != 'x')) {
+                throw Except::ParseException("Symbol `x' expected");
+            }
+        }
+
+        if (c == 'x') {
+            // Reading the literal identifier.
+            int literal;
+            scanner.read(literal);
+
+            // Adding the literal to the list.
+            literals.push_back(negated ? -checkLiteral(literal) : checkLiteral(literal));
+            return true;
+        }
+
+        return false;
+    }
+
+    template <Autis::PseudoBooleanSink Sink>
+    bool BasicOpbParser<Sink>::isRelationalOperator(char c) {
+        return (c == '>') || (c == '<') || (c == '=');
+    }
+
+    template <Autis::PseudoBooleanSink Sink>
+    Autis::RelationalOperator BasicOpbParser<Sink>::readRelationalOperator() {
+        // Looking at the first character.
+        char c1 = scanner.read();
+
+        if (c1 == '=') {
+            return Autis::RelationalOperator::EXACTLY;
+        }
+
+        // Looking at the second character.
+        char c2 = scanner.read();
+
+        if ((c1 == '>') && (c2 == '=')) {
+            return Autis::RelationalOperator::AT_LEAST;
+        }
+
+        if ((c1 == '<') && (c2 == '=')) {
+            return Autis::RelationalOperator::AT_MOST;
+        }
+
+        throw Except::ParseException("Unrecognized relational operator");
+    }
+
+    template <Autis::PseudoBooleanSink Sink>
+    int BasicOpbParser<Sink>::checkLiteral(int literal) const {
+        // The magnitude of INT_MIN does not fit in an int, so it is never a variable.
+        if ((literal == 0) || (literal == INT_MIN) || (std::abs(literal) > numberOfVariables)) {
+            throw Except::ParseException("An invalid literal has been read");
+        }
+        return literal;
+    }
+
+}
+
+#endif
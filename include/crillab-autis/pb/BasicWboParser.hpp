@@ -0,0 +1,211 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file BasicWboParser.hpp
+ * @brief Provides a WBO parser that is specialized at compile-time for the object receiving the constraints.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_BASICWBOPARSER_HPP
+#define AUTIS_BASICWBOPARSER_HPP
+
+#include <cstdint>
+
+#include <crillab-except/except.hpp>
+
+#include "../core/Scanner.hpp"
+#include "BasicOpbParser.hpp"
+#include "PseudoBooleanSink.hpp"
+#include "RelationalOperator.hpp"
+
+namespace Autis {
+
+    /**
+     * The BasicWboParser reads weighted Boolean optimization problems written
+     * using the WBO format, and gives the constraints it reads to a sink
+     * whose type is known at compile-time.
+     * It reuses the readers of BasicOpbParser for the terms, the relational
+     * operators and the degrees of the constraints.
+     * Hard constraints are given to the sink as soon as they are read, and
+     * so are soft constraints, together with their weight.
+     *
+     * @tparam Sink The type of the sink receiving the constraints.
+     */
+    template <Autis::SoftConstraintSink Sink>
+    class BasicWboParser : public Autis::BasicOpbParser<Sink> {
+
+    public:
+
+        /**
+         * Creates a new BasicWboParser.
+         *
+         * @param scanner The scanner used to read the input.
+         * @param sink The sink receiving the constraints.
+         * @param linearizing Whether products of literals are replaced by
+         *        auxiliary variables, instead of being rejected.
+         */
+        BasicWboParser(Autis::Scanner &scanner, Sink &sink, bool linearizing = true);
+
+        /**
+         * Parses the input to read the constraints it contains.
+         *
+         * @throws ParseException If the input is not a well-formed WBO input.
+         */
+        void parse();
+
+    private:
+
+        /**
+         * Reads the line declaring the top cost of the problem (if any).
+         */
+        void readSoftHeader();
+
+        /**
+         * Reads a soft constraint, and gives it to the sink.
+         */
+        void readSoftConstraint();
+
+        /**
+         * Reads the weight of a soft constraint, written between brackets.
+         *
+         * @return The weight that has been read.
+         */
+        std::int64_t readWeight();
+
+    };
+
+    template <Autis::SoftConstraintSink Sink>
+    BasicWboParser<Sink>::BasicWboParser(Autis::Scanner &scanner, Sink &sink, bool linearizing) :
+            Autis::BasicOpbParser<Sink>(scanner, sink, linearizing) {
+        // Nothing to do: everything is already initialized.
+    }
+
+    template <Autis::SoftConstraintSink Sink>
+    void BasicWboParser<Sink>::parse() {
+        // Reading the header of the file.
+        this->readMetaData();
+        this->skipComments();
+        readSoftHeader();
+
+        // Reading the constraints, which may be either hard or soft.
+        int nbConstraintsRead = 0;
+        for (char c; this->scanner.look(c);) {
+            if (c == '*') {
+                // The rest of the line is a comment.
+                this->skipComments();
+                continue;
+            }
+
+            if (c == '[') {
+                readSoftConstraint();
+
+            } else {
+                this->readConstraint();
+            }
+            nbConstraintsRead++;
+        }
+
+        if (nbConstraintsRead != this->numberOfConstraints) {
+            // The number of read constraints is not the expected one.
+            throw Except::ParseException("Unexpected number of constraints");
+        }
+    }
+
+    template <Autis::SoftConstraintSink Sink>
+    void BasicWboParser<Sink>::readSoftHeader() {
+        // Reading the "soft:" keyword.
+        char c;
+        if ((!this->scanner.look(c)) || (this->scanner.read() != 's') || (this->scanner.read() != 'o')
+                || (this->scanner.read() != 'f') || (this->scanner.read() != 't') || (this->scanner.read() != ':')) {
+            throw Except::ParseException("Keyword `soft:' expected");
+        }
+        this->optimization = true;
+
+        // Reading the top cost, which is optional.
+        if (!this->scanner.look(c)) {
+            throw Except::ParseException("Semi-colon expected at end of soft header");
+        }
+
+        if (c != ';') {
+            std::int64_t topCost;
+            this->scanner.readInt64(topCost);
+            if (topCost <= 0) {
+                throw Except::ParseException("Top cost must be positive");
+            }
+            this->sink.setTopCost(topCost);
+        }
+
+        // Ending the header.
+        // We need to consume the ';' character.
+        if ((!this->scanner.look(c)) || (c != ';')) {
+            throw Except::ParseException("Semi-colon expected at end of soft header");
+        }
+        (void) this->scanner.read();
+    }
+
+    template <Autis::SoftConstraintSink Sink>
+    void BasicWboParser<Sink>::readSoftConstraint() {
+        auto weight = readWeight();
+        auto relationalOperator = this->readConstraintBody();
+
+        // Checking the relational operator to identify the type of the constraint.
+        if (relationalOperator == Autis::RelationalOperator::EXACTLY) {
+            this->sink.addSoftExactly(this->literals, this->coefficients.get(), this->degree, weight);
+
+        } else if (relationalOperator == Autis::RelationalOperator::AT_LEAST) {
+            this->sink.addSoftAtLeast(this->literals, this->coefficients.get(), this->degree, weight);
+
+        } else {
+            this->sink.addSoftAtMost(this->literals, this->coefficients.get(), this->degree, weight);
+        }
+
+        // The products of the constraint can now be defined, as hard constraints.
+        this->defineProducts();
+    }
+
+    template <Autis::SoftConstraintSink Sink>
+    std::int64_t BasicWboParser<Sink>::readWeight() {
+        // Consuming the opening bracket.
+        (void) this->scanner.read();
+
+        // Reading the weight.
+        std::int64_t weight;
+        this->scanner.readInt64(weight);
+        if (weight <= 0) {
+            throw Except::ParseException("Weight of soft constraint must be positive");
+        }
+
+        // Consuming the closing bracket.
+        char c;
+        if ((!this->scanner.look(c)) || (c != ']')) {
+            throw Except::ParseException("Symbol `]' expected after weight");
+        }
+        (void) this->scanner.read();
+        return weight;
+    }
+
+}
+
+#endif
@@ -0,0 +1,237 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file CoefficientBuffer.hpp
+ * @brief Stores the coefficients of a pseudo-Boolean constraint while it is read.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_COEFFICIENTBUFFER_HPP
+#define AUTIS_COEFFICIENTBUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include <utility>
+
+#include <crillab-universe/core/UniverseType.hpp>
+
+#include "../core/Scanner.hpp"
+
+namespace Autis {
+
+    /**
+     * The CoefficientBuffer stores the coefficients of a constraint while it
+     * is being read.
+     * Coefficients are kept as 64-bit integers as long as they all fit, and
+     * are only converted into big integers when one of them does not, or when
+     * they are given to a sink.
+     * The buffer is meant to be reused from one constraint to the next, so
+     * that reading a constraint does not allocate memory once the buffer has
+     * grown large enough.
+     *
+     * @tparam BigInteger The type of the big integers given to the sinks.
+     */
+    template <typename BigInteger>
+    class BasicCoefficientBuffer {
+
+    private:
+
+        /**
+         * The type of the coefficients that fit in 64 bits.
+         * When big integers are native integers, they are used directly, so
+         * that no conversion is ever needed.
+         */
+        using SmallCoefficient = std::conditional_t<std::is_integral_v<BigInteger>,
+                BigInteger, std::int64_t>;
+
+        /**
+         * The coefficients read so far, as long as they all fit in 64 bits.
+         */
+        std::vector<SmallCoefficient> smallCoefficients;
+
+        /**
+         * The coefficients read so far, once one of them does not fit in 64
+         * bits (or once they have been converted).
+         */
+        std::vector<BigInteger> bigCoefficients;
+
+        /**
+         * The big integers that are not used anymore.
+         * They are moved back and forth with the big coefficients, so that
+         * the memory they hold is reused from one constraint to the next.
+         */
+        std::vector<BigInteger> spareCoefficients;
+
+        /**
+         * Whether a coefficient read so far does not fit in 64 bits.
+         */
+        bool wide = false;
+
+        /**
+         * The last coefficient read that does not fit in 64 bits.
+         */
+        BigInteger wideCoefficient;
+
+    public:
+
+        /**
+         * Removes all the coefficients from this buffer.
+         * The memory used by this buffer is kept to be reused.
+         */
+        void clear() {
+            smallCoefficients.clear();
+            recycle();
+            wide = false;
+        }
+
+        /**
+         * Gives the number of coefficients in this buffer.
+         *
+         * @return The number of coefficients.
+         */
+        [[nodiscard]] std::size_t size() const {
+            return wide ? bigCoefficients.size() : smallCoefficients.size();
+        }
+
+        /**
+         * Reads the next coefficient and adds it at the end of this buffer.
+         *
+         * @param scanner The scanner used to read the coefficient.
+         *
+         * @throws ParseException If no coefficient can be read, or if big
+         *         integers are native integers and the coefficient does not
+         *         fit in 64 bits.
+         */
+        void read(Autis::Scanner &scanner) {
+            if constexpr (std::is_integral_v<BigInteger>) {
+                // Big integers cannot hold more than 64 bits anyway.
+                std::int64_t value;
+                scanner.readInt64(value);
+                smallCoefficients.push_back(static_cast<SmallCoefficient>(value));
+
+            } else if (wide) {
+                // Big integer arithmetic is already needed for this constraint.
+                scanner.readBig(wideCoefficient);
+                push(wideCoefficient);
+
+            } else {
+                std::int64_t value;
+                if (scanner.readInt64(value, wideCoefficient)) {
+                    // This is the most common case: the coefficient fits in 64 bits.
+                    smallCoefficients.push_back(value);
+                    return;
+                }
+
+                // From now on, the coefficients are stored as big integers.
+                widen();
+                push(wideCoefficient);
+            }
+        }
+
+        /**
+         * Gives the coefficients in this buffer as big integers.
+         * They are given as a vector, so that they can be given as is to
+         * solvers taking vectors.
+         * The returned coefficients remain valid until this buffer is
+         * modified.
+         *
+         * @return The coefficients in this buffer.
+         */
+        const std::vector<BigInteger> &get() {
+            if constexpr (std::is_integral_v<BigInteger>) {
+                return smallCoefficients;
+
+            } else {
+                if (!wide) {
+                    convert();
+                }
+                return bigCoefficients;
+            }
+        }
+
+    private:
+
+        /**
+         * Converts the coefficients read so far into big integers.
+         */
+        void widen() {
+            convert();
+            wide = true;
+        }
+
+        /**
+         * Converts the coefficients stored as 64-bit integers into big
+         * integers, replacing the big coefficients.
+         */
+        void convert() {
+            recycle();
+            for (auto coefficient : smallCoefficients) {
+                push(coefficient);
+            }
+        }
+
+        /**
+         * Adds a big coefficient at the end of this buffer, reusing a spare big
+         * integer when there is one.
+         *
+         * @param coefficient The coefficient to add.
+         */
+        template <typename T>
+        void push(const T &coefficient) {
+            if (spareCoefficients.empty()) {
+                bigCoefficients.emplace_back(coefficient);
+                return;
+            }
+
+            // Assigning the spare big integer reuses the memory it holds.
+            bigCoefficients.push_back(std::move(spareCoefficients.back()));
+            spareCoefficients.pop_back();
+            bigCoefficients.back() = coefficient;
+        }
+
+        /**
+         * Moves all the big coefficients to the spare big integers, so that
+         * they are not destroyed.
+         */
+        void recycle() {
+            while (!bigCoefficients.empty()) {
+                spareCoefficients.push_back(std::move(bigCoefficients.back()));
+                bigCoefficients.pop_back();
+            }
+        }
+
+    };
+
+    /**
+     * The CoefficientBuffer stores coefficients as the big integers of
+     * Universe.
+     */
+    using CoefficientBuffer = Autis::BasicCoefficientBuffer<Universe::BigInteger>;
+
+}
+
+#endif
@@ -0,0 +1,454 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file ConstraintBatch.hpp
+ * @brief Gathers pseudo-Boolean constraints read by a parser so that they can be given to a sink later.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_CONSTRAINTBATCH_HPP
+#define AUTIS_CONSTRAINTBATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <crillab-except/except.hpp>
+#include <crillab-universe/core/UniverseType.hpp>
+
+#include "../core/ReservingSink.hpp"
+#include "PseudoBooleanSink.hpp"
+#include "RelationalOperator.hpp"
+
+namespace Autis {
+
+    /**
+     * The ConstraintBatch gathers pseudo-Boolean constraints read by a parser,
+     * stored in flat arrays, so that they can be given to a sink later (e.g.,
+     * by another thread).
+     * A batch may also carry the size of the problem declared in the input.
+     * A batch is itself a PseudoBooleanSink (and a ReservingSink, an
+     * ObjectiveSink and a SoftConstraintSink), so that a whole input may be
+     * read into a single batch.
+     * As in OPB inputs, the terms of the objective function always come
+     * before the constraints, and may be split over several batches.
+     * Similarly, the top cost of WBO inputs comes before the constraints.
+     */
+    struct ConstraintBatch {
+
+        /**
+         * Whether this batch carries the size of the problem.
+         */
+        bool reservation = false;
+
+        /**
+         * The number of variables declared in the input, if this batch
+         * carries the size of the problem.
+         */
+        int nbVariables = 0;
+
+        /**
+         * The number of constraints declared in the input, if this batch
+         * carries the size of the problem.
+         */
+        int nbConstraints = 0;
+
+        /**
+         * The literals of the constraints in this batch.
+         */
+        std::vector<int> literals;
+
+        /**
+         * The coefficients of the literals of the constraints in this batch.
+         */
+        std::vector<Universe::BigInteger> coefficients;
+
+        /**
+         * The offsets of the constraints in the arrays of literals and
+         * coefficients, followed by the number of literals.
+         */
+        std::vector<std::size_t> offsets = {0};
+
+        /**
+         * The relational operators of the constraints in this batch.
+         */
+        std::vector<Autis::RelationalOperator> operators;
+
+        /**
+         * The degrees of the constraints in this batch.
+         */
+        std::vector<Universe::BigInteger> degrees;
+
+        /**
+         * The weights of the constraints in this batch, where hard constraints
+         * have a weight of 0.
+         * This vector remains empty as long as all the constraints in this
+         * batch are hard.
+         */
+        std::vector<std::int64_t> weights;
+
+        /**
+         * Whether this batch carries the top cost of the problem.
+         */
+        bool topCostSet = false;
+
+        /**
+         * The top cost of the problem, if this batch carries it.
+         */
+        std::int64_t topCost = 0;
+
+        /**
+         * Whether the objective function starts in this batch.
+         */
+        bool objectiveBegins = false;
+
+        /**
+         * The literals of the terms of the objective function in this batch.
+         */
+        std::vector<int> objectiveLiterals;
+
+        /**
+         * The coefficients of the terms of the objective function in this
+         * batch.
+         */
+        std::vector<Universe::BigInteger> objectiveCoefficients;
+
+        /**
+         * Whether the objective function ends in this batch.
+         */
+        bool objectiveEnds = false;
+
+        /**
+         * Gives the number of constraints in this batch.
+         *
+         * @return The number of constraints.
+         */
+        [[nodiscard]] std::size_t size() const {
+            return operators.size();
+        }
+
+        /**
+         * Checks whether this batch carries nothing.
+         *
+         * @return Whether this batch is empty.
+         */
+        [[nodiscard]] bool empty() const {
+            return (!reservation) && (size() == 0) && (!objectiveBegins) && objectiveLiterals.empty()
+                    && (!objectiveEnds) && (!topCostSet);
+        }
+
+        /**
+         * Records the size of the problem in this batch.
+         *
+         * @param nbVariables The number of variables declared in the input.
+         * @param nbConstraints The number of constraints declared in the input.
+         */
+        void reserve(int nbVariables, int nbConstraints) {
+            reservation = true;
+            this->nbVariables = nbVariables;
+            this->nbConstraints = nbConstraints;
+        }
+
+        /**
+         * Records that the objective function starts in this batch.
+         */
+        void beginObjective() {
+            objectiveBegins = true;
+        }
+
+        /**
+         * Adds a term of the objective function to this batch.
+         *
+         * @param literal The literal of the term.
+         * @param coefficient The coefficient of the literal.
+         */
+        void addObjectiveTerm(int literal, const Universe::BigInteger &coefficient) {
+            objectiveLiterals.push_back(literal);
+            objectiveCoefficients.push_back(coefficient);
+        }
+
+        /**
+         * Records that the objective function ends in this batch.
+         */
+        void endObjective() {
+            objectiveEnds = true;
+        }
+
+        /**
+         * Records the top cost of the problem in this batch.
+         *
+         * @param cost The top cost of the problem.
+         */
+        void setTopCost(std::int64_t cost) {
+            topCostSet = true;
+            topCost = cost;
+        }
+
+        /**
+         * Adds an at-least constraint at the end of this batch.
+         *
+         * @param constraintLiterals The literals of the constraint.
+         * @param constraintCoefficients The coefficients of the literals.
+         * @param degree The degree of the constraint.
+         */
+        void addAtLeast(std::span<const int> constraintLiterals,
+                std::span<const Universe::BigInteger> constraintCoefficients, const Universe::BigInteger &degree) {
+            add(Autis::RelationalOperator::AT_LEAST, constraintLiterals, constraintCoefficients, degree);
+        }
+
+        /**
+         * Adds an at-most constraint at the end of this batch.
+         *
+         * @param constraintLiterals The literals of the constraint.
+         * @param constraintCoefficients The coefficients of the literals.
+         * @param degree The degree of the constraint.
+         */
+        void addAtMost(std::span<const int> constraintLiterals,
+                std::span<const Universe::BigInteger> constraintCoefficients, const Universe::BigInteger &degree) {
+            add(Autis::RelationalOperator::AT_MOST, constraintLiterals, constraintCoefficients, degree);
+        }
+
+        /**
+         * Adds an exactly constraint at the end of this batch.
+         *
+         * @param constraintLiterals The literals of the constraint.
+         * @param constraintCoefficients The coefficients of the literals.
+         * @param degree The degree of the constraint.
+         */
+        void addExactly(std::span<const int> constraintLiterals,
+                std::span<const Universe::BigInteger> constraintCoefficients, const Universe::BigInteger &degree) {
+            add(Autis::RelationalOperator::EXACTLY, constraintLiterals, constraintCoefficients, degree);
+        }
+
+        /**
+         * Adds a constraint at the end of this batch.
+         *
+         * @param relationalOperator The relational operator of the constraint.
+         * @param constraintLiterals The literals of the constraint.
+         * @param constraintCoefficients The coefficients of the literals.
+         * @param degree The degree of the constraint.
+         */
+        void add(Autis::RelationalOperator relationalOperator, std::span<const int> constraintLiterals,
+                std::span<const Universe::BigInteger> constraintCoefficients, const Universe::BigInteger &degree) {
+            literals.insert(literals.end(), constraintLiterals.begin(), constraintLiterals.end());
+            coefficients.insert(coefficients.end(), constraintCoefficients.begin(), constraintCoefficients.end());
+            offsets.push_back(literals.size());
+            operators.push_back(relationalOperator);
+            degrees.push_back(degree);
+            if (!weights.empty()) {
+                // This is a hard constraint.
+                weights.push_back(0);
+            }
+        }
+
+        /**
+         * Adds a soft at-least constraint at the end of this batch.
+         *
+         * @param constraintLiterals The literals of the constraint.
+         * @param constraintCoefficients The coefficients of the literals.
+         * @param degree The degree of the constraint.
+         * @param weight The cost of violating the constraint.
+         */
+        void addSoftAtLeast(std::span<const int> constraintLiterals,
+                std::span<const Universe::BigInteger> constraintCoefficients, const Universe::BigInteger &degree,
+                std::int64_t weight) {
+            addSoft(Autis::RelationalOperator::AT_LEAST, constraintLiterals, constraintCoefficients, degree, weight);
+        }
+
+        /**
+         * Adds a soft at-most constraint at the end of this batch.
+         *
+         * @param constraintLiterals The literals of the constraint.
+         * @param constraintCoefficients The coefficients of the literals.
+         * @param degree The degree of the constraint.
+         * @param weight The cost of violating the constraint.
+         */
+        void addSoftAtMost(std::span<const int> constraintLiterals,
+                std::span<const Universe::BigInteger> constraintCoefficients, const Universe::BigInteger &degree,
+                std::int64_t weight) {
+            addSoft(Autis::RelationalOperator::AT_MOST, constraintLiterals, constraintCoefficients, degree, weight);
+        }
+
+        /**
+         * Adds a soft exactly constraint at the end of this batch.
+         *
+         * @param constraintLiterals The literals of the constraint.
+         * @param constraintCoefficients The coefficients of the literals.
+         * @param degree The degree of the constraint.
+         * @param weight The cost of violating the constraint.
+         */
+        void addSoftExactly(std::span<const int> constraintLiterals,
+                std::span<const Universe::BigInteger> constraintCoefficients, const Universe::BigInteger &degree,
+                std::int64_t weight) {
+            addSoft(Autis::RelationalOperator::EXACTLY, constraintLiterals, constraintCoefficients, degree, weight);
+        }
+
+        /**
+         * Adds a soft constraint at the end of this batch.
+         *
+         * @param relationalOperator The relational operator of the constraint.
+         * @param constraintLiterals The literals of the constraint.
+         * @param constraintCoefficients The coefficients of the literals.
+         * @param degree The degree of the constraint.
+         * @param weight The cost of violating the constraint (which is
+         *        positive).
+         */
+        void addSoft(Autis::RelationalOperator relationalOperator, std::span<const int> constraintLiterals,
+                std::span<const Universe::BigInteger> constraintCoefficients, const Universe::BigInteger &degree,
+                std::int64_t weight) {
+            // The constraints before this one are all hard.
+            weights.resize(size(), 0);
+            add(relationalOperator, constraintLiterals, constraintCoefficients, degree);
+            weights.resize(size(), 0);
+            weights.back() = weight;
+        }
+
+        /**
+         * Gives the content of this batch to a sink.
+         *
+         * @tparam Sink The type of the sink receiving the constraints.
+         *
+         * @param sink The sink receiving the constraints.
+         * @param constraintLiterals A vector that may be used to store the
+         *        literals of a constraint while it is given to the sink.
+         * @param constraintCoefficients A vector that may be used to store the
+         *        coefficients of a constraint while it is given to the sink.
+         */
+        template <Autis::PseudoBooleanSink Sink>
+        void replay(Sink &sink, std::vector<int> &constraintLiterals,
+                std::vector<Universe::BigInteger> &constraintCoefficients) const {
+            if constexpr (Autis::ReservingSink<Sink>) {
+                if (reservation) {
+                    sink.reserve(nbVariables, nbConstraints);
+                }
+            }
+
+            replayObjective(sink);
+            if (topCostSet) {
+                replaySoft(sink, [this](auto &softSink) {
+                    softSink.setTopCost(topCost);
+                });
+            }
+
+            for (std::size_t i = 0; i < size(); i++) {
+                auto length = offsets[i + 1] - offsets[i];
+                auto literalsOfConstraint = std::span<const int>(literals).subspan(offsets[i], length);
+                auto coefficientsOfConstraint =
+                        std::span<const Universe::BigInteger>(coefficients).subspan(offsets[i], length);
+                constraintLiterals.assign(literalsOfConstraint.begin(), literalsOfConstraint.end());
+                constraintCoefficients.assign(coefficientsOfConstraint.begin(), coefficientsOfConstraint.end());
+
+                if ((!weights.empty()) && (weights[i] != 0)) {
+                    // This is a soft constraint.
+                    replaySoft(sink, [&, i](auto &softSink) {
+                        if (operators[i] == Autis::RelationalOperator::EXACTLY) {
+                            softSink.addSoftExactly(constraintLiterals, constraintCoefficients, degrees[i], weights[i]);
+
+                        } else if (operators[i] == Autis::RelationalOperator::AT_LEAST) {
+                            softSink.addSoftAtLeast(constraintLiterals, constraintCoefficients, degrees[i], weights[i]);
+
+                        } else {
+                            softSink.addSoftAtMost(constraintLiterals, constraintCoefficients, degrees[i], weights[i]);
+                        }
+                    });
+
+                } else if (operators[i] == Autis::RelationalOperator::EXACTLY) {
+                    sink.addExactly(constraintLiterals, constraintCoefficients, degrees[i]);
+
+                } else if (operators[i] == Autis::RelationalOperator::AT_LEAST) {
+                    sink.addAtLeast(constraintLiterals, constraintCoefficients, degrees[i]);
+
+                } else {
+                    sink.addAtMost(constraintLiterals, constraintCoefficients, degrees[i]);
+                }
+            }
+        }
+
+    private:
+
+        /**
+         * Gives the part of the objective function in this batch to a sink.
+         *
+         * @tparam Sink The type of the sink receiving the objective function.
+         *
+         * @param sink The sink receiving the objective function.
+         *
+         * @throws UnsupportedOperationException If there is an objective
+         *         function, and the sink cannot receive it.
+         */
+        template <Autis::PseudoBooleanSink Sink>
+        void replayObjective(Sink &sink) const {
+            if ((!objectiveBegins) && objectiveLiterals.empty() && (!objectiveEnds)) {
+                // There is no objective function in this batch.
+                return;
+            }
+
+            if constexpr (Autis::ObjectiveSink<Sink>) {
+                if (objectiveBegins) {
+                    sink.beginObjective();
+                }
+                for (std::size_t i = 0; i < objectiveLiterals.size(); i++) {
+                    sink.addObjectiveTerm(objectiveLiterals[i], objectiveCoefficients[i]);
+                }
+                if (objectiveEnds) {
+                    sink.endObjective();
+                }
+
+            } else {
+                throw Except::UnsupportedOperationException("Objective function not supported");
+            }
+        }
+
+        /**
+         * Gives a part of a weighted Boolean optimization problem in this
+         * batch to a sink.
+         *
+         * @tparam Sink The type of the sink receiving the problem.
+         * @tparam Function The type of the function giving the part of the
+         *         problem to the sink.
+         *
+         * @param sink The sink receiving the problem.
+         * @param function The function giving the part of the problem to the
+         *        sink.
+         *
+         * @throws UnsupportedOperationException If the sink cannot receive
+         *         soft constraints.
+         */
+        template <Autis::PseudoBooleanSink Sink, typename Function>
+        static void replaySoft(Sink &sink, Function function) {
+            if constexpr (Autis::SoftConstraintSink<Sink>) {
+                function(sink);
+
+            } else {
+                throw Except::UnsupportedOperationException("Soft constraints not supported");
+            }
+        }
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,206 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file ConstraintBatchWriter.hpp
+ * @brief Provides a sink filling batches of pseudo-Boolean constraints into a queue.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_CONSTRAINTBATCHWRITER_HPP
+#define AUTIS_CONSTRAINTBATCHWRITER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <crillab-universe/core/UniverseType.hpp>
+
+#include "../core/SpscQueue.hpp"
+#include "ConstraintBatch.hpp"
+#include "RelationalOperator.hpp"
+
+namespace Autis {
+
+    /**
+     * The ConstraintBatchWriter is a PseudoBooleanSink (and a ReservingSink,
+     * an ObjectiveSink and a SoftConstraintSink)
+     * that gathers the constraints it receives into batches, and pushes these
+     * batches into a queue as soon as they are large enough.
+     * It is used on the producer side of a pipelined parse.
+     */
+    class ConstraintBatchWriter {
+
+    private:
+
+        /**
+         * The number of literals from which a batch is pushed into the queue.
+         */
+        static constexpr std::size_t BATCH_SIZE = 1 << 16;
+
+        /**
+         * The queue into which batches are pushed.
+         */
+        Autis::SpscQueue<Autis::ConstraintBatch> &queue;
+
+        /**
+         * The batch that is being filled.
+         */
+        Autis::ConstraintBatch batch;
+
+    public:
+
+        /**
+         * Creates a new ConstraintBatchWriter.
+         *
+         * @param queue The queue into which batches are pushed.
+         */
+        explicit ConstraintBatchWriter(Autis::SpscQueue<Autis::ConstraintBatch> &queue);
+
+        /**
+         * Records the size of the problem, which is pushed before the
+         * constraints that follow.
+         *
+         * @param nbVariables The number of variables declared in the input.
+         * @param nbConstraints The number of constraints declared in the input.
+         */
+        void reserve(int nbVariables, int nbConstraints);
+
+        /**
+         * Adds an at-least constraint to the current batch.
+         *
+         * @param literals The literals of the constraint.
+         * @param coefficients The coefficients of the literals.
+         * @param degree The degree of the constraint.
+         */
+        void addAtLeast(std::span<const int> literals, std::span<const Universe::BigInteger> coefficients,
+                const Universe::BigInteger &degree);
+
+        /**
+         * Adds an at-most constraint to the current batch.
+         *
+         * @param literals The literals of the constraint.
+         * @param coefficients The coefficients of the literals.
+         * @param degree The degree of the constraint.
+         */
+        void addAtMost(std::span<const int> literals, std::span<const Universe::BigInteger> coefficients,
+                const Universe::BigInteger &degree);
+
+        /**
+         * Adds an exactly constraint to the current batch.
+         *
+         * @param literals The literals of the constraint.
+         * @param coefficients The coefficients of the literals.
+         * @param degree The degree of the constraint.
+         */
+        void addExactly(std::span<const int> literals, std::span<const Universe::BigInteger> coefficients,
+                const Universe::BigInteger &degree);
+
+        /**
+         * Records that the objective function starts.
+         */
+        void beginObjective();
+
+        /**
+         * Adds a term of the objective function to the current batch, and
+         * pushes this batch if it is full.
+         *
+         * @param literal The literal of the term.
+         * @param coefficient The coefficient of the literal.
+         *
+         * @throws PipelineCancelledException If the consumer has stopped.
+         */
+        void addObjectiveTerm(int literal, const Universe::BigInteger &coefficient);
+
+        /**
+         * Records that the objective function ends.
+         */
+        void endObjective();
+
+        /**
+         * Records the top cost of the problem, which is pushed before the
+         * constraints that follow.
+         *
+         * @param topCost The top cost of the problem.
+         */
+        void setTopCost(std::int64_t topCost);
+
+        /**
+         * Adds a soft at-least constraint to the current batch.
+         *
+         * @param literals The literals of the constraint.
+         * @param coefficients The coefficients of the literals.
+         * @param degree The degree of the constraint.
+         * @param weight The cost of violating the constraint.
+         */
+        void addSoftAtLeast(std::span<const int> literals, std::span<const Universe::BigInteger> coefficients,
+                const Universe::BigInteger &degree, std::int64_t weight);
+
+        /**
+         * Adds a soft at-most constraint to the current batch.
+         *
+         * @param literals The literals of the constraint.
+         * @param coefficients The coefficients of the literals.
+         * @param degree The degree of the constraint.
+         * @param weight The cost of violating the constraint.
+         */
+        void addSoftAtMost(std::span<const int> literals, std::span<const Universe::BigInteger> coefficients,
+                const Universe::BigInteger &degree, std::int64_t weight);
+
+        /**
+         * Adds a soft exactly constraint to the current batch.
+         *
+         * @param literals The literals of the constraint.
+         * @param coefficients The coefficients of the literals.
+         * @param degree The degree of the constraint.
+         * @param weight The cost of violating the constraint.
+         */
+        void addSoftExactly(std::span<const int> literals, std::span<const Universe::BigInteger> coefficients,
+                const Universe::BigInteger &degree, std::int64_t weight);
+
+        /**
+         * Pushes the current batch into the queue, if it is not empty.
+         *
+         * @throws PipelineCancelledException If the consumer has stopped.
+         */
+        void flush();
+
+    private:
+
+        /**
+         * Adds a constraint to the current batch.
+         *
+         * @param relationalOperator The relational operator of the constraint.
+         * @param literals The literals of the constraint.
+         * @param coefficients The coefficients of the literals.
+         * @param degree The degree of the constraint.
+         */
+        void add(Autis::RelationalOperator relationalOperator, std::span<const int> literals,
+                std::span<const Universe::BigInteger> coefficients, const Universe::BigInteger &degree);
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,79 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file IObjectiveListener.hpp
+ * @brief Receives the terms of the objective function of a pseudo-Boolean problem.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_IOBJECTIVELISTENER_HPP
+#define AUTIS_IOBJECTIVELISTENER_HPP
+
+#include <crillab-universe/core/UniverseType.hpp>
+
+namespace Autis {
+
+    /**
+     * The IObjectiveListener is an optional interface that a pseudo-Boolean
+     * solver may implement to receive the objective function to minimize.
+     * The terms of the objective function are given one at a time while they
+     * are read, so that no copy of the whole function is ever made.
+     * When the solver does not implement it, reading an optimization problem
+     * fails with an UnsupportedOperationException.
+     */
+    class IObjectiveListener {
+
+    public:
+
+        /**
+         * Destroys this IObjectiveListener.
+         */
+        virtual ~IObjectiveListener() = default;
+
+        /**
+         * Notifies this listener that the terms of the objective function are
+         * about to be given.
+         */
+        virtual void beginObjective() = 0;
+
+        /**
+         * Adds a term to the objective function to minimize.
+         *
+         * @param literal The literal of the term.
+         * @param coefficient The coefficient of the literal.
+         */
+        virtual void addObjectiveTerm(int literal, const Universe::BigInteger &coefficient) = 0;
+
+        /**
+         * Notifies this listener that all the terms of the objective function
+         * have been given.
+         */
+        virtual void endObjective() = 0;
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,107 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file ISoftConstraintListener.hpp
+ * @brief Defines the interface of the solvers receiving the soft constraints of WBO inputs.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_ISOFTCONSTRAINTLISTENER_HPP
+#define AUTIS_ISOFTCONSTRAINTLISTENER_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include <crillab-universe/core/UniverseType.hpp>
+
+namespace Autis {
+
+    /**
+     * The ISoftConstraintListener is an optional interface that a
+     * pseudo-Boolean solver may implement to receive the soft constraints of
+     * weighted Boolean optimization (WBO) problems.
+     * Hard constraints are still given through IUniversePseudoBooleanSolver.
+     * When the solver does not implement it, reading a WBO input fails with
+     * an UnsupportedOperationException.
+     */
+    class ISoftConstraintListener {
+
+    public:
+
+        /**
+         * Destroys this ISoftConstraintListener.
+         */
+        virtual ~ISoftConstraintListener() = default;
+
+        /**
+         * Sets the top cost of the problem, i.e., the cost from which a
+         * solution is considered as unacceptable.
+         * This method is only called when the input declares a top cost.
+         *
+         * @param topCost The top cost of the problem.
+         */
+        virtual void setTopCost(std::int64_t topCost) = 0;
+
+        /**
+         * Adds a soft at-least constraint.
+         *
+         * @param literals The literals of the constraint.
+         * @param coefficients The coefficients of the literals.
+         * @param degree The degree of the constraint.
+         * @param weight The cost of violating the constraint.
+         */
+        virtual void addSoftAtLeast(const std::vector<int> &literals,
+                const std::vector<Universe::BigInteger> &coefficients, const Universe::BigInteger &degree,
+                std::int64_t weight) = 0;
+
+        /**
+         * Adds a soft at-most constraint.
+         *
+         * @param literals The literals of the constraint.
+         * @param coefficients The coefficients of the literals.
+         * @param degree The degree of the constraint.
+         * @param weight The cost of violating the constraint.
+         */
+        virtual void addSoftAtMost(const std::vector<int> &literals,
+                const std::vector<Universe::BigInteger> &coefficients, const Universe::BigInteger &degree,
+                std::int64_t weight) = 0;
+
+        /**
+         * Adds a soft exactly constraint.
+         *
+         * @param literals The literals of the constraint.
+         * @param coefficients The coefficients of the literals.
+         * @param degree The degree of the constraint.
+         * @param weight The cost of violating the constraint.
+         */
+        virtual void addSoftExactly(const std::vector<int> &literals,
+                const std::vector<Universe::BigInteger> &coefficients, const Universe::BigInteger &degree,
+                std::int64_t weight) = 0;
+
+    };
+
+}
+
+#endif
@@ -31,96 +31,91 @@
 #ifndef AUTIS_OPBPARSER_HPP
 #define AUTIS_OPBPARSER_HPP
 
-#include <fstream>
-#include <string>
-#include <vector>
+#include <cstddef>
 
 #include <crillab-universe/pb/IUniversePseudoBooleanSolver.hpp>
 
 #include "../core/AbstractParser.hpp"
+#include "../core/IReservationListener.hpp"
+#include "../core/ParserConfiguration.hpp"
+#include "IObjectiveListener.hpp"
 
 namespace Autis {
 
     /**
      * The OpbParser specializes AbstractParser to read inputs written
      * using the OPB format.
+     * It relies on a BasicOpbParser to feed its solver, which is notified of
+     * the size of the problem if it is an IReservationListener.
      */
     class OpbParser : public Autis::AbstractParser {
+
     private:
-        bool optimization;
-    public:
 
         /**
-         * Creates a new OpbParser which uses the given scanner and notifies
-         * the given listener.
-         *
-         * @param scanner The scanner used to read the input stream.
-         * @param solver The solver to feed while parsing the instance.
+         * The maximum number of batches of constraints waiting to be given to
+         * the solver when the input is read in a pipeline.
          */
-        explicit OpbParser(Autis::Scanner &scanner, Universe::IUniversePseudoBooleanSolver *solver);
+        static constexpr std::size_t PIPELINE_CAPACITY = 16;
 
         /**
-         * Destroys this OpbParser.
+         * The solver to feed while parsing, as a pseudo-Boolean solver.
          */
-        ~OpbParser() override = default;
+        Universe::IUniversePseudoBooleanSolver *pbSolver;
 
         /**
-         * Parses the input to read the problem to solve.
+         * The solver as a reservation listener, or null if it is not one.
          */
-        void parse() override;
-
-        bool isOptimization() override;
-
-    private:
+        Autis::IReservationListener *reservationListener;
 
         /**
-         * Reads the first comment line to get the number of variables and
-         * the number of constraints in the input.
+         * The solver as an objective listener, or null if it is not one.
          */
-        void readMetaData();
+        Autis::IObjectiveListener *objectiveListener;
 
         /**
-         * Skips comments from the input.
+         * The configuration of this parser.
          */
-        void skipComments();
+        Autis::ParserConfiguration configuration;
 
         /**
-         * Reads the objective line (if any).
+         * Whether the input defines an optimization problem.
          */
-        void readObjective();
+        bool optimization;
+
+    public:
 
         /**
-         * Reads a constraint.
+         * Creates a new OpbParser which uses the given scanner and notifies
+         * the given listener.
+         *
+         * @param scanner The scanner used to read the input stream.
+         * @param solver The solver to feed while parsing the instance, which
+         *        may be null if the parser is only used to build instances.
+         * @param configuration The configuration of the parser.
          */
-        void readConstraint();
+        explicit OpbParser(Autis::Scanner &scanner, Universe::IUniversePseudoBooleanSolver *solver,
+                const Autis::ParserConfiguration &configuration = Autis::ParserConfiguration());
 
         /**
-         * Reads a term (either from the objective function or from a constraint)
-         * and stores it into coefficient and literals.
-         *
-         * @param coefficient The coefficient of the term.
-         * @param literals The literals of the term (if there is more than one,
-         *        this is a product of literals).
+         * Destroys this OpbParser.
          */
-        void readTerm(Universe::BigInteger &coefficient, std::vector<int> &literals);
+        ~OpbParser() override = default;
 
         /**
-         * Reads an identifier from the stream and appends it to literals.
-         *
-         * @param literals The current list of read identifiers.
-         *
-         * @return Whether an identifier was read.
+         * Parses the input to read the problem to solve.
          */
-        bool readIdentifier(std::vector<int> &literals);
+        void parse() override;
 
         /**
-         * Reads a relational operator from the input stream and stores it into
-         * relationalOperator.
+         * Parses the input to store the constraints it defines in the given
+         * instance, instead of feeding the solver.
          *
-         * @param relationalOperator The reference in which to hold the relational
-         *        operator that has been read.
+         * @param instance The instance in which to store the constraints.
          */
-        void readRelationalOperator(std::string &relationalOperator);
+        void parse(Autis::Instance &instance) override;
+
+        bool isOptimization() override;
 
     protected:
 
@@ -131,6 +126,29 @@ namespace Autis {
          */
         Universe::IUniversePseudoBooleanSolver *getConcreteSolver() override;
 
+    private:
+
+        /**
+         * Parses the input, giving the constraints to the given sink.
+         *
+         * @tparam Sink The type of the sink receiving the constraints.
+         *
+         * @param sink The sink receiving the constraints.
+         */
+        template <typename Sink>
+        void parse(Sink &sink);
+
+        /**
+         * Parses the input on a dedicated thread, while the calling thread
+         * gives the constraints to the given sink.
+         *
+         * @tparam Sink The type of the sink receiving the constraints.
+         *
+         * @param sink The sink receiving the constraints.
+         */
+        template <typename Sink>
+        void parseInPipeline(Sink &sink);
+
     };
 
 }
@@ -0,0 +1,164 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file ProductLinearizer.hpp
+ * @brief Replaces the products of literals appearing in OPB inputs by auxiliary variables.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_PRODUCTLINEARIZER_HPP
+#define AUTIS_PRODUCTLINEARIZER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "../core/Arena.hpp"
+
+namespace Autis {
+
+    /**
+     * The ProductLinearizer associates an auxiliary variable with each
+     * distinct product of literals appearing in a non-linear input.
+     * Products are identified by their sorted sequence of literals, so that
+     * a product appearing several times (possibly with its literals in a
+     * different order) is always replaced by the same variable.
+     * Auxiliary variables are numbered after the variables declared in the
+     * input, in the order in which their products are first seen.
+     */
+    class ProductLinearizer {
+
+    private:
+
+        /**
+         * The marker of the empty slots of the hash table.
+         */
+        static constexpr std::uint32_t EMPTY = UINT32_MAX;
+
+        /**
+         * The number of variables declared in the input.
+         */
+        int numberOfDeclaredVariables;
+
+        /**
+         * The products that have been seen so far, as sorted sequences of
+         * literals.
+         * The auxiliary variable of the i-th product is the variable
+         * numberOfDeclaredVariables + 1 + i.
+         */
+        Autis::Arena<int> products;
+
+        /**
+         * The hash values of the products that have been seen so far.
+         */
+        std::vector<std::uint64_t> hashes;
+
+        /**
+         * The hash table, using open addressing with linear probing, giving
+         * the index of the products that have been seen so far.
+         * Its size is always a power of two.
+         */
+        std::vector<std::uint32_t> table;
+
+    public:
+
+        /**
+         * Creates a new ProductLinearizer.
+         */
+        ProductLinearizer();
+
+        /**
+         * Forgets all the products that have been seen so far, and sets the
+         * number of variables declared in the input.
+         *
+         * @param nbVariables The number of variables declared in the input.
+         */
+        void reset(int nbVariables);
+
+        /**
+         * Gives the variable replacing a product of literals.
+         * The literals of the product are sorted and their duplicates are
+         * removed.
+         * If a single literal remains, this literal is returned as is.
+         *
+         * @param product The literals of the product.
+         * @param fresh Set to whether the returned variable has just been
+         *        introduced, in which case it still needs to be defined.
+         *
+         * @return The literal equivalent to the product.
+         *
+         * @throws ParseException If there are too many products to number
+         *         their variables.
+         */
+        int linearize(std::vector<int> &product, bool &fresh);
+
+        /**
+         * Gives the product that an auxiliary variable replaces.
+         * The product remains valid until a new product is seen.
+         *
+         * @param variable The auxiliary variable.
+         *
+         * @return The sorted literals of the product.
+         */
+        [[nodiscard]] std::span<const int> getProduct(int variable) const;
+
+        /**
+         * Gives the number of auxiliary variables introduced so far.
+         *
+         * @return The number of distinct products that have been seen.
+         */
+        [[nodiscard]] std::size_t size() const;
+
+        /**
+         * Gives the number of variables, including the auxiliary variables
+         * introduced so far.
+         *
+         * @return The number of variables.
+         */
+        [[nodiscard]] int getNumberOfVariables() const;
+
+    private:
+
+        /**
+         * Computes the hash value of a sorted product.
+         *
+         * @param product The literals of the product.
+         *
+         * @return The hash value of the product.
+         */
+        static std::uint64_t hash(std::span<const int> product);
+
+        /**
+         * Doubles the size of the hash table, and puts back all the products
+         * in the new table.
+         */
+        void grow();
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,85 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file PseudoBooleanSink.hpp
+ * @brief Defines the concept of the objects receiving the constraints read by a pseudo-Boolean parser.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_PSEUDOBOOLEANSINK_HPP
+#define AUTIS_PSEUDOBOOLEANSINK_HPP
+
+#include <cstdint>
+#include <span>
+
+#include <crillab-universe/core/UniverseType.hpp>
+
+namespace Autis {
+
+    /**
+     * A PseudoBooleanSink is any object to which pseudo-Boolean constraints
+     * can be given one at a time, as contiguous sequences of literals and
+     * coefficients, together with the degree of the constraint.
+     * The sequences are only valid during the call.
+     */
+    template <typename Sink>
+    concept PseudoBooleanSink = requires(Sink &sink, std::span<const int> literals,
+            std::span<const Universe::BigInteger> coefficients, const Universe::BigInteger &degree) {
+        sink.addAtLeast(literals, coefficients, degree);
+        sink.addAtMost(literals, coefficients, degree);
+        sink.addExactly(literals, coefficients, degree);
+    };
+
+    /**
+     * An ObjectiveSink is a PseudoBooleanSink that may also receive the terms
+     * of an objective function to minimize, one at a time.
+     */
+    template <typename Sink>
+    concept ObjectiveSink = PseudoBooleanSink<Sink> && requires(Sink &sink, int literal,
+            const Universe::BigInteger &coefficient) {
+        sink.beginObjective();
+        sink.addObjectiveTerm(literal, coefficient);
+        sink.endObjective();
+    };
+
+    /**
+     * A SoftConstraintSink is a PseudoBooleanSink that may also receive the
+     * soft constraints of weighted Boolean optimization problems, together
+     * with the top cost of the problem (if any).
+     * As for hard constraints, the sequences are only valid during the call.
+     */
+    template <typename Sink>
+    concept SoftConstraintSink = PseudoBooleanSink<Sink> && requires(Sink &sink, std::span<const int> literals,
+            std::span<const Universe::BigInteger> coefficients, const Universe::BigInteger &degree,
+            std::int64_t weight) {
+        sink.setTopCost(weight);
+        sink.addSoftAtLeast(literals, coefficients, degree, weight);
+        sink.addSoftAtMost(literals, coefficients, degree, weight);
+        sink.addSoftExactly(literals, coefficients, degree, weight);
+    };
+
+}
+
+#endif
@@ -0,0 +1,61 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file RelationalOperator.hpp
+ * @brief Enumerates the relational operators of pseudo-Boolean constraints.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_RELATIONALOPERATOR_HPP
+#define AUTIS_RELATIONALOPERATOR_HPP
+
+namespace Autis {
+
+    /**
+     * The RelationalOperator enumerates the relational operators that may
+     * appear in pseudo-Boolean constraints.
+     */
+    enum class RelationalOperator : unsigned char {
+
+        /**
+         * The operator ">=".
+         */
+        AT_LEAST,
+
+        /**
+         * The operator "<=".
+         */
+        AT_MOST,
+
+        /**
+         * The operator "=".
+         */
+        EXACTLY
+
+    };
+
+}
+
+#endif
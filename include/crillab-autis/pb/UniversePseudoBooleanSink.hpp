@@ -0,0 +1,352 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file UniversePseudoBooleanSink.hpp
+ * @brief Adapts Universe pseudo-Boolean solvers to the PseudoBooleanSink concept.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_UNIVERSEPSEUDOBOOLEANSINK_HPP
+#define AUTIS_UNIVERSEPSEUDOBOOLEANSINK_HPP
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <crillab-except/except.hpp>
+#include <crillab-universe/pb/IUniversePseudoBooleanSolver.hpp>
+
+#include "../core/IReservationListener.hpp"
+#include "IObjectiveListener.hpp"
+#include "ISoftConstraintListener.hpp"
+
+namespace Autis {
+
+    /**
+     * The UniversePseudoBooleanSink is a PseudoBooleanSink giving the
+     * constraints it receives to an IUniversePseudoBooleanSolver.
+     * Constraints given as vectors are not copied.
+     */
+    class UniversePseudoBooleanSink {
+
+    private:
+
+        /**
+         * The solver to which constraints are given.
+         */
+        Universe::IUniversePseudoBooleanSolver *solver;
+
+        /**
+         * The solver as a reservation listener, or null if it is not one.
+         */
+        Autis::IReservationListener *reservationListener;
+
+        /**
+         * The solver as an objective listener, or null if it is not one.
+         */
+        Autis::IObjectiveListener *objectiveListener;
+
+        /**
+         * The solver as a soft constraint listener, or null if it is not one.
+         */
+        Autis::ISoftConstraintListener *softConstraintListener;
+
+    public:
+
+        /**
+         * Creates a new UniversePseudoBooleanSink.
+         *
+         * @param solver The solver to which constraints are given.
+         * @param reservationListener The solver as a reservation listener, if
+         *        it is one.
+         * @param objectiveListener The solver as an objective listener, if it
+         *        is one.
+         * @param softConstraintListener The solver as a soft constraint
+         *        listener, if it is one.
+         */
+        explicit UniversePseudoBooleanSink(Universe::IUniversePseudoBooleanSolver *solver,
+                Autis::IReservationListener *reservationListener = nullptr,
+                Autis::IObjectiveListener *objectiveListener = nullptr,
+                Autis::ISoftConstraintListener *softConstraintListener = nullptr) :
+                solver(solver),
+                reservationListener(reservationListener),
+                objectiveListener(objectiveListener),
+                softConstraintListener(softConstraintListener) {
+            // Nothing to do: everything is already initialized.
+        }
+
+        /**
+         * Notifies the solver of the size of the problem, if it is an
+         * IReservationListener.
+         *
+         * @param nbVariables The number of variables declared in the input.
+         * @param nbConstraints The number of constraints declared in the input.
+         */
+        void reserve(int nbVariables, int nbConstraints) {
+            if (reservationListener != nullptr) {
+                reservationListener->reserve(nbVariables, nbConstraints);
+            }
+        }
+
+        /**
+         * Gives an at-least constraint to the solver.
+         *
+         * @param literals The literals of the constraint.
+         * @param coefficients The coefficients of the literals.
+         * @param degree The degree of the constraint.
+         */
+        void addAtLeast(const std::vector<int> &literals, const std::vector<Universe::BigInteger> &coefficients,
+                const Universe::BigInteger &degree) {
+            solver->addAtLeast(literals, coefficients, degree);
+        }
+
+        /**
+         * Gives an at-least constraint to the solver.
+         *
+         * @param literals The literals of the constraint.
+         * @param coefficients The coefficients of the literals.
+         * @param degree The degree of the constraint.
+         */
+        void addAtLeast(std::span<const int> literals, std::span<const Universe::BigInteger> coefficients,
+                const Universe::BigInteger &degree) {
+            solver->addAtLeast(std::vector<int>(literals.begin(), literals.end()),
+                    std::vector<Universe::BigInteger>(coefficients.begin(), coefficients.end()), degree);
+        }
+
+        /**
+         * Gives an at-most constraint to the solver.
+         *
+         * @param literals The literals of the constraint.
+         * @param coefficients The coefficients of the literals.
+         * @param degree The degree of the constraint.
+         */
+        void addAtMost(const std::vector<int> &literals, const std::vector<Universe::BigInteger> &coefficients,
+                const Universe::BigInteger &degree) {
+            solver->addAtMost(literals, coefficients, degree);
+        }
+
+        /**
+         * Gives an at-most constraint to the solver.
+         *
+         * @param literals The literals of the constraint.
+         * @param coefficients The coefficients of the literals.
+         * @param degree The degree of the constraint.
+         */
+        void addAtMost(std::span<const int> literals, std::span<const Universe::BigInteger> coefficients,
+                const Universe::BigInteger &degree) {
+            solver->addAtMost(std::vector<int>(literals.begin(), literals.end()),
+                    std::vector<Universe::BigInteger>(coefficients.begin(), coefficients.end()), degree);
+        }
+
+        /**
+         * Gives an exactly constraint to the solver.
+         *
+         * @param literals The literals of the constraint.
+         * @param coefficients The coefficients of the literals.
+         * @param degree The degree of the constraint.
+         */
+        void addExactly(const std::vector<int> &literals, const std::vector<Universe::BigInteger> &coefficients,
+                const Universe::BigInteger &degree) {
+            solver->addExactly(literals, coefficients, degree);
+        }
+
+        /**
+         * Gives an exactly constraint to the solver.
+         *
+         * @param literals The literals of the constraint.
+         * @param coefficients The coefficients of the literals.
+         * @param degree The degree of the constraint.
+         */
+        void addExactly(std::span<const int> literals, std::span<const Universe::BigInteger> coefficients,
+                const Universe::BigInteger &degree) {
+            solver->addExactly(std::vector<int>(literals.begin(), literals.end()),
+                    std::vector<Universe::BigInteger>(coefficients.begin(), coefficients.end()), degree);
+        }
+
+        /**
+         * Notifies the solver that the terms of the objective function are
+         * about to be given.
+         *
+         * @throws UnsupportedOperationException If the solver is not an
+         *         IObjectiveListener.
+         */
+        void beginObjective() {
+            if (objectiveListener == nullptr) {
+                throw Except::UnsupportedOperationException("Objective function not supported by the solver");
+            }
+            objectiveListener->beginObjective();
+        }
+
+        /**
+         * Gives a term of the objective function to the solver.
+         *
+         * @param literal The literal of the term.
+         * @param coefficient The coefficient of the literal.
+         */
+        void addObjectiveTerm(int literal, const Universe::BigInteger &coefficient) {
+            objectiveListener->addObjectiveTerm(literal, coefficient);
+        }
+
+        /**
+         * Notifies the solver that all the terms of the objective function
+         * have been given.
+         */
+        void endObjective() {
+            objectiveListener->endObjective();
+        }
+
+        /**
+         * Gives the top cost of the problem to the solver.
+         *
+         * @param topCost The top cost of the problem.
+         *
+         * @throws UnsupportedOperationException If the solver is not an
+         *         ISoftConstraintListener.
+         */
+        void setTopCost(std::int64_t topCost) {
+            getSoftConstraintListener()->setTopCost(topCost);
+        }
+
+        /**
+         * Gives a soft at-least constraint to the solver.
+         *
+         * @param literals The literals of the constraint.
+         * @param coefficients The coefficients of the literals.
+         * @param degree The degree of the constraint.
+         * @param weight The cost of violating the constraint.
+         *
+         * @throws UnsupportedOperationException If the solver is not an
+         *         ISoftConstraintListener.
+         */
+        void addSoftAtLeast(const std::vector<int> &literals, const std::vector<Universe::BigInteger> &coefficients,
+                const Universe::BigInteger &degree, std::int64_t weight) {
+            getSoftConstraintListener()->addSoftAtLeast(literals, coefficients, degree, weight);
+        }
+
+        /**
+         * Gives a soft at-least constraint to the solver.
+         *
+         * @param literals The literals of the constraint.
+         * @param coefficients The coefficients of the literals.
+         * @param degree The degree of the constraint.
+         * @param weight The cost of violating the constraint.
+         *
+         * @throws UnsupportedOperationException If the solver is not an
+         *         ISoftConstraintListener.
+         */
+        void addSoftAtLeast(std::span<const int> literals, std::span<const Universe::BigInteger> coefficients,
+                const Universe::BigInteger &degree, std::int64_t weight) {
+            getSoftConstraintListener()->addSoftAtLeast(std::vector<int>(literals.begin(), literals.end()),
+                    std::vector<Universe::BigInteger>(coefficients.begin(), coefficients.end()), degree, weight);
+        }
+
+        /**
+         * Gives a soft at-most constraint to the solver.
+         *
+         * @param literals The literals of the constraint.
+         * @param coefficients The coefficients of the literals.
+         * @param degree The degree of the constraint.
+         * @param weight The cost of violating the constraint.
+         *
+         * @throws UnsupportedOperationException If the solver is not an
+         *         ISoftConstraintListener.
+         */
+        void addSoftAtMost(const std::vector<int> &literals, const std::vector<Universe::BigInteger> &coefficients,
+                const Universe::BigInteger &degree, std::int64_t weight) {
+            getSoftConstraintListener()->addSoftAtMost(literals, coefficients, degree, weight);
+        }
+
+        /**
+         * Gives a soft at-most constraint to the solver.
+         *
+         * @param literals The literals of the constraint.
+         * @param coefficients The coefficients of the literals.
+         * @param degree The degree of the constraint.
+         * @param weight The cost of violating the constraint.
+         *
+         * @throws UnsupportedOperationException If the solver is not an
+         *         ISoftConstraintListener.
+         */
+        void addSoftAtMost(std::span<const int> literals, std::span<const Universe::BigInteger> coefficients,
+                const Universe::BigInteger &degree, std::int64_t weight) {
+            getSoftConstraintListener()->addSoftAtMost(std::vector<int>(literals.begin(), literals.end()),
+                    std::vector<Universe::BigInteger>(coefficients.begin(), coefficients.end()), degree, weight);
+        }
+
+        /**
+         * Gives a soft exactly constraint to the solver.
+         *
+         * @param literals The literals of the constraint.
+         * @param coefficients The coefficients of the literals.
+         * @param degree The degree of the constraint.
+         * @param weight The cost of violating the constraint.
+         *
+         * @throws UnsupportedOperationException If the solver is not an
+         *         ISoftConstraintListener.
+         */
+        void addSoftExactly(const std::vector<int> &literals, const std::vector<Universe::BigInteger> &coefficients,
+                const Universe::BigInteger &degree, std::int64_t weight) {
+            getSoftConstraintListener()->addSoftExactly(literals, coefficients, degree, weight);
+        }
+
+        /**
+         * Gives a soft exactly constraint to the solver.
+         *
+         * @param literals The literals of the constraint.
+         * @param coefficients The coefficients of the literals.
+         * @param degree The degree of the constraint.
+         * @param weight The cost of violating the constraint.
+         *
+         * @throws UnsupportedOperationException If the solver is not an
+         *         ISoftConstraintListener.
+         */
+        void addSoftExactly(std::span<const int> literals, std::span<const Universe::BigInteger> coefficients,
+                const Universe::BigInteger &degree, std::int64_t weight) {
+            getSoftConstraintListener()->addSoftExactly(std::vector<int>(literals.begin(), literals.end()),
+                    std::vector<Universe::BigInteger>(coefficients.begin(), coefficients.end()), degree, weight);
+        }
+
+    private:
+
+        /**
+         * Gives the solver as a soft constraint listener.
+         *
+         * @return The soft constraint listener.
+         *
+         * @throws UnsupportedOperationException If the solver is not an
+         *         ISoftConstraintListener.
+         */
+        Autis::ISoftConstraintListener *getSoftConstraintListener() {
+            if (softConstraintListener == nullptr) {
+                throw Except::UnsupportedOperationException("Soft constraints not supported by the solver");
+            }
+            return softConstraintListener;
+        }
+
+    };
+
+}
+
+#endif
@@ -31,20 +31,42 @@
 #ifndef AUTIS_AUTISXCSPCALLBACK_HPP
 #define AUTIS_AUTISXCSPCALLBACK_HPP
 
+#include <array>
+#include <cstddef>
+
 #include <crillab-universe/csp/IUniverseCspSolver.hpp>
 #include <crillab-universe//csp/intension/AbstractUniverseIntensionConstraintFactory.hpp>
 #include "XCSP3CoreCallbacks.h"
 
+#include "XcspInstance.hpp"
+
 namespace Autis {
 
 /**
  * The AutisXcspCallback is the callback to be used with the XCSP3 parser to build a
  * Universe solver.
+ * Everything it reads is recorded in an XcspInstance, which is either given to the
+ * solver as soon as it is recorded, or kept to be given to solvers later on.
+ * Each variable receives a dense handle when it is declared, and lists of
+ * variables are recorded as lists of handles, without copying their names.
+ * When the solver does not use these handles, only intension expressions are
+ * recorded, so that their identical subexpressions are shared as when the
+ * instance is replayed: each operation is given to the solver as soon as it
+ * is read.
  */
 class AutisXcspCallback : public XCSP3Core::XCSP3CoreCallbacks {
    private:
     /**
-     * The solver to feed while parsing.
+     * The number of intension nodes above which the expressions already given
+     * to the solver are forgotten.
+     * Identical subexpressions are thus only shared among the expressions
+     * read since they were last forgotten, which keeps the memory used while
+     * feeding a solver bounded, even for large (streamed) inputs.
+     */
+    static constexpr std::size_t MAX_SHARED_INTENSION_NODES = 1 << 16;
+
+    /**
+     * The solver to feed while parsing, or null if the instance is only recorded.
      */
     Universe::IUniverseCspSolver *solver;
 
@@ -53,9 +75,55 @@ class AutisXcspCallback : public XCSP3Core::XCSP3CoreCallbacks {
      */
     Universe::AbstractUniverseIntensionConstraintFactory *intensionFactory;
 
+    /**
+     * The instance in which the operations to give to the solver are recorded.
+     */
+    Autis::XcspInstance pending;
+
+    /**
+     * The instance in which the operations are recorded.
+     */
+    Autis::XcspInstance *instance;
+
     bool optimization;
 
-    std::vector<std::vector<int>> lastTuples;
+    /**
+     * The table of the last extension constraint that has been read, which
+     * is shared with the constraints reusing it.
+     */
+    std::shared_ptr<const Autis::TupleTable> lastTuples;
+
+    /**
+     * The compressed table of the last extension constraint that has been
+     * read, if tables are compressed.
+     */
+    std::shared_ptr<const Autis::CompressedTupleTable> lastCompressedTuples;
+
+    /**
+     * The buffer in which the handles of the variables of a list are
+     * collected before the list is recorded.
+     */
+    std::vector<int> handles;
+
+    /**
+     * Whether the operations are given right away to the solver, without
+     * being recorded.
+     * This is the case when the solver does not use the handles of the
+     * variables, which only exist once the variables have been recorded.
+     */
+    bool direct;
+
+    /**
+     * Whether the tables of the extension constraints are compressed.
+     */
+    bool compressingTuples;
+
+    /**
+     * The intension constraints already given to the solver, indexed by the
+     * nodes of their expressions, which are shared by all the identical
+     * expressions of the input.
+     */
+    Autis::IntensionCache intensions;
 
    private:
     /**
@@ -88,11 +156,27 @@ class AutisXcspCallback : public XCSP3Core::XCSP3CoreCallbacks {
      */
     static AutisXcspCallback *newJavaInstance(Universe::IUniverseCspSolver *solver);
 
+    /**
+     * Creates a new AutisXcspCallback recording the problem it reads in an
+     * instance, instead of feeding a solver.
+     *
+     * @param instance The instance in which to record the problem.
+     */
+    explicit AutisXcspCallback(Autis::XcspInstance &instance);
+
     /**
      * Destroys this AutisXcspCallback.
      */
     virtual ~AutisXcspCallback() = default;
 
+    /**
+     * Sets whether the tuples of the extension constraints are stored in
+     * compressed tables rather than as lists of tuples.
+     *
+     * @param enabled Whether to compress the tables of tuples.
+     */
+    void setCompressingTuples(bool enabled);
+
     /**
      * The callback function related to an integer variable with a range domain
      * See http://xcsp.org/specifications/integers
@@ -1498,6 +1582,155 @@ class AutisXcspCallback : public XCSP3Core::XCSP3CoreCallbacks {
     void buildConstraintExtensionAs(string id, vector<XCSP3Core::XVariable *> list, bool support, bool hasStar) override;
 
 private:
+    /**
+     * Records an operation, and gives it to the solver if there is one.
+     * When the operations are given directly to the solver, the operation is
+     * not recorded at all.
+     *
+     * @tparam Operands The types of the operands of the operation.
+     *
+     * @param operation The operation to record.
+     * @param operands The operands of the operation, as given by the parser.
+     */
+    template <typename... Operands>
+    void add(Autis::CspOperation operation, const Operands &... operands) {
+        if (direct) {
+            std::array<Autis::CspOperand, sizeof...(Operands)> values{toOperand(operands)...};
+            Autis::XcspInstance::give(*solver, operation, values);
+            releaseIntensions();
+            return;
+        }
+
+        instance->add(operation, record(operands)...);
+        if (solver != nullptr) {
+            instance->replay(*solver, *intensionFactory, intensions);
+            instance->clear();
+            releaseIntensions();
+        }
+    }
+
+    /**
+     * Forgets the intension expressions already given to the solver once
+     * there are more than MAX_SHARED_INTENSION_NODES of them.
+     * This must only be called when all the recorded operations have been
+     * given to the solver.
+     */
+    void releaseIntensions();
+
+    /**
+     * Gives the value of an operand that does not need to be converted to
+     * be recorded.
+     *
+     * @tparam T The type of the operand.
+     *
+     * @param value The value of the operand.
+     *
+     * @return The value of the operand.
+     */
+    template <typename T>
+    static const T &record(const T &value) {
+        return value;
+    }
+
+    /**
+     * Records a list of variables.
+     *
+     * @param list The list of variables to record.
+     *
+     * @return The reference of the recorded list.
+     */
+    Autis::VariableListReference record(const std::vector<XCSP3Core::XVariable *> &list) {
+        return toVariableList(list);
+    }
+
+    /**
+     * Records a matrix of variables.
+     *
+     * @param matrix The matrix of variables to record.
+     *
+     * @return The reference of the recorded matrix.
+     */
+    Autis::VariableMatrixReference record(const std::vector<std::vector<XCSP3Core::XVariable *>> &matrix) {
+        return toVariableMatrix(matrix);
+    }
+
+    /**
+     * Records an intension expression.
+     *
+     * @param node The root of the expression to record.
+     *
+     * @return The reference of the recorded expression.
+     */
+    Autis::IntensionReference record(XCSP3Core::Node *node) {
+        return createIntension(node);
+    }
+
+    /**
+     * Records a list of intension expressions.
+     *
+     * @param trees The expressions to record.
+     *
+     * @return The references of the recorded expressions.
+     */
+    std::vector<Autis::IntensionReference> record(const std::vector<XCSP3Core::Tree *> &trees) {
+        return toIntensionConstraintVector(trees);
+    }
+
+    /**
+     * Gives an operand that does not need to be converted to be given to the
+     * solver.
+     *
+     * @tparam T The type of the operand.
+     *
+     * @param value The value of the operand.
+     *
+     * @return The operand to give to the solver.
+     */
+    template <typename T>
+    static Autis::CspOperand toOperand(const T &value) {
+        return value;
+    }
+
+    /**
+     * Gives a list of variables to the solver as the list of their identifiers.
+     *
+     * @param list The list of variables.
+     *
+     * @return The operand to give to the solver.
+     */
+    static Autis::CspOperand toOperand(const std::vector<XCSP3Core::XVariable *> &list);
+
+    /**
+     * Gives a matrix of variables to the solver as the matrix of their
+     * identifiers.
+     *
+     * @param matrix The matrix of variables.
+     *
+     * @return The operand to give to the solver.
+     */
+    static Autis::CspOperand toOperand(const std::vector<std::vector<XCSP3Core::XVariable *>> &matrix);
+
+    /**
+     * Gives an intension expression to the solver as an intension constraint.
+     * The expression is recorded, so that the constraint is shared with all
+     * the identical (sub)expressions given to the solver.
+     *
+     * @param node The root of the expression.
+     *
+     * @return The operand to give to the solver.
+     */
+    Autis::CspOperand toOperand(XCSP3Core::Node *node);
+
+    /**
+     * Gives a list of intension expressions to the solver as intension
+     * constraints, which are shared as for a single expression.
+     *
+     * @param trees The expressions.
+     *
+     * @return The operand to give to the solver.
+     */
+    Autis::CspOperand toOperand(const std::vector<XCSP3Core::Tree *> &trees);
+
     /**
      * Determines the relational operator used in the given condition object.
      *
@@ -1510,31 +1743,41 @@ private:
     static Universe::UniverseRelationalOperator asRelationalOperator(XCSP3Core::OrderType type);
 
     /**
-     * Creates an intension constraint from its tree representation.
+     * Gives the operator applied by a node of an intension expression.
+     *
+     * @param type The type of the node, which is neither a constant nor a
+     *        variable.
+     *
+     * @return The operator of the node.
+     */
+    static Autis::IntensionOperator intensionOperatorOf(XCSP3Core::ExpressionType type);
+
+    /**
+     * Records an intension expression from its tree representation.
      *
-     * @param node The node tocreate an intension constraint from.
+     * @param node The node to record an intension expression from.
      *
-     * @return The created intension constraint.
+     * @return The reference of the recorded expression.
      */
-    Universe::IUniverseIntensionConstraint *createIntension(XCSP3Core::Node *node);
+    Autis::IntensionReference createIntension(XCSP3Core::Node *node);
 
     /**
-     * Converts a std::vector of variables to the std::vector of their names.
+     * Records a std::vector of variables as the list of their handles.
      *
-     * @param list The list of variables to convert.
+     * @param list The list of variables to record.
      *
-     * @return The std::vector of the variable identifiers.
+     * @return The reference of the recorded list.
      */
-    static std::vector<std::string> toStringVector(const std::vector<XCSP3Core::XVariable *> &list);
+    Autis::VariableListReference toVariableList(const std::vector<XCSP3Core::XVariable *> &list);
 
     /**
-     * Converts a std::vector of variables to the std::vector of their names.
+     * Records a matrix of variables as the lists of the handles of its rows.
      *
-     * @param list The list of variables to convert.
+     * @param matrix The matrix of variables to record.
      *
-     * @return The std::vector of the variable identifiers.
+     * @return The reference of the recorded matrix.
      */
-    static std::vector<std::vector<std::string>> toStringMatrix(const std::vector<std::vector<XCSP3Core::XVariable *>> &list);
+    Autis::VariableMatrixReference toVariableMatrix(const std::vector<std::vector<XCSP3Core::XVariable *>> &matrix);
 
     /**
      * Converts a std::vector of integers to a std::vector of big-integers.
@@ -1546,13 +1789,13 @@ private:
     static std::vector<Universe::BigInteger> toBigIntegerVector(const std::vector<int> &integers);
 
     /**
-     * Converts a std::vector of intension constraint trees to a std::vector of IUniverseIntensionConstraint.
+     * Records a std::vector of intension constraint trees as intension expressions.
      *
-     * @param expressions The std::vector of trees to convert.
+     * @param expressions The std::vector of trees to record.
      *
-     * @return The std::vector of intension constraints.
+     * @return The std::vector of the references of the recorded expressions.
      */
-    std::vector<Universe::IUniverseIntensionConstraint *> toIntensionConstraintVector(
+    std::vector<Autis::IntensionReference> toIntensionConstraintVector(
         const std::vector<XCSP3Core::Tree *> &expressions);
 
     /**
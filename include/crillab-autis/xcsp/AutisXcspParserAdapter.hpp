@@ -36,6 +36,7 @@
 #include  <crillab-universe/csp/IUniverseCspSolver.hpp>
 
 #include "../core/AbstractParser.hpp"
+#include "../core/ParserConfiguration.hpp"
 #include "AutisXcspCallback.hpp"
 
 #include "AutisXcspCallback.hpp"
@@ -50,11 +51,21 @@ namespace Autis {
 
     private:
 
+        /**
+         * The solver to feed while parsing, as a CSP solver.
+         */
+        Universe::IUniverseCspSolver *cspSolver;
+
         /**
          * The callback to use when parsing the input instance.
          */
         XCSP3Core::XCSP3CoreCallbacks *callback;
 
+        /**
+         * The configuration of this parser.
+         */
+        Autis::ParserConfiguration configuration;
+
         bool optimization;
 
     public:
@@ -63,17 +74,28 @@ namespace Autis {
          * Creates a new AutisXCSPParserAdapter.
          *
          * @param scanner The scanner to use to read the input instance.
-         * @param solver The solver to feed while parsing the instance.
+         * @param solver The solver to feed while parsing the instance, which
+         *        may be null if the parser is only used to build instances.
          * @param callback The callback to use when parsing the input instance.
+         * @param configuration The configuration of the parser.
          */
         explicit AutisXCSPParserAdapter(Autis::Scanner &scanner, Universe::IUniverseCspSolver *solver,
-                XCSP3Core::XCSP3CoreCallbacks *callback = nullptr);
+                XCSP3Core::XCSP3CoreCallbacks *callback = nullptr,
+                const Autis::ParserConfiguration &configuration = Autis::ParserConfiguration());
 
         /**
          * Parses the input to read the problem to solve.
          */
         void parse() override;
 
+        /**
+         * Parses the input to store the problem it defines in the given
+         * instance, instead of feeding the solver.
+         *
+         * @param instance The instance in which to store the problem.
+         */
+        void parse(Autis::Instance &instance) override;
+
         bool isOptimization() override;
 
     protected:
@@ -93,6 +115,17 @@ namespace Autis {
          */
         Universe::IUniverseCspSolver *getConcreteSolver() override;
 
+    private:
+
+        /**
+         * Reads the input, notifying the given callback of what is read.
+         * The reader of XCSP3-CPP-Parser is used, unless the configuration
+         * of this parser enables the streaming reader.
+         *
+         * @param cb The callback to notify while reading the input.
+         */
+        void parse(XCSP3Core::XCSP3CoreCallbacks &cb);
+
     };
 
 }
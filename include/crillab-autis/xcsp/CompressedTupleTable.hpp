@@ -0,0 +1,231 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file CompressedTupleTable.hpp
+ * @brief Stores the tuples of an extension constraint as a multi-valued decision diagram.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_COMPRESSEDTUPLETABLE_HPP
+#define AUTIS_COMPRESSEDTUPLETABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "TupleTable.hpp"
+
+namespace Autis {
+
+    /**
+     * The CompressedTupleTable stores the tuples of an extension constraint
+     * as a reduced multi-valued decision diagram (MDD).
+     * The tuples are sorted and deduplicated, and then merged into a prefix
+     * trie whose identical sub-tries are shared, so that tables with a lot
+     * of structure take much less memory than their list of tuples.
+     * The nodes of the diagram are stored level by level, from the last
+     * column of the table to the first, and the edges of a node are stored
+     * contiguously: the edges of a level hold the values of one column.
+     * Stars are kept as edges labelled with TupleTable::STAR.
+     * Like TupleTable, a CompressedTupleTable is immutable once created, and
+     * is shared between the constraints that use it.
+     */
+    class CompressedTupleTable {
+
+    public:
+
+        /**
+         * The identifier of the terminal node of the diagrams, which ends
+         * all the paths representing tuples.
+         */
+        static constexpr std::uint32_t TERMINAL = 0;
+
+    private:
+
+        /**
+         * The number of values in each tuple.
+         */
+        std::size_t arity;
+
+        /**
+         * The number of (distinct) tuples in this table.
+         */
+        std::size_t nbTuples;
+
+        /**
+         * Whether the tuples contain stars.
+         */
+        bool star;
+
+        /**
+         * The identifier of the root node of the diagram.
+         */
+        std::uint32_t root;
+
+        /**
+         * The offsets of the edges of each node, so that the edges of node i
+         * are those between nodeOffsets[i] and nodeOffsets[i + 1].
+         */
+        std::vector<std::size_t> nodeOffsets;
+
+        /**
+         * The values labelling the edges of the diagram.
+         */
+        std::vector<int> edgeValues;
+
+        /**
+         * The nodes targeted by the edges of the diagram.
+         */
+        std::vector<std::uint32_t> edgeTargets;
+
+    public:
+
+        /**
+         * Creates a new CompressedTupleTable from the representation of its
+         * diagram.
+         *
+         * @param arity The number of values in each tuple.
+         * @param nbTuples The number of tuples represented by the diagram.
+         * @param hasStar Whether the tuples contain stars.
+         * @param root The identifier of the root node of the diagram.
+         * @param nodeOffsets The offsets of the edges of each node.
+         * @param edgeValues The values labelling the edges.
+         * @param edgeTargets The nodes targeted by the edges.
+         *
+         * @throws IllegalArgumentException If the diagram is malformed.
+         */
+        CompressedTupleTable(std::size_t arity, std::size_t nbTuples, bool hasStar, std::uint32_t root,
+                std::vector<std::size_t> nodeOffsets, std::vector<int> edgeValues,
+                std::vector<std::uint32_t> edgeTargets);
+
+        /**
+         * Creates a shared CompressedTupleTable containing the given tuples.
+         * The tuples are sorted with a radix sort, and duplicate tuples are
+         * removed.
+         *
+         * @param tuples The tuples to store, which must all have the same
+         *        size.
+         * @param hasStar Whether the tuples contain stars.
+         *
+         * @return The created table.
+         *
+         * @throws IllegalArgumentException If the tuples do not all have the
+         *         same size.
+         */
+        static std::shared_ptr<const Autis::CompressedTupleTable> of(
+                const std::vector<std::vector<int>> &tuples, bool hasStar);
+
+        /**
+         * Gives the number of values in each tuple of this table.
+         *
+         * @return The arity of the tuples.
+         */
+        [[nodiscard]] std::size_t getArity() const;
+
+        /**
+         * Gives the number of distinct tuples in this table.
+         *
+         * @return The number of tuples.
+         */
+        [[nodiscard]] std::size_t size() const;
+
+        /**
+         * Checks whether the tuples of this table contain stars.
+         *
+         * @return Whether the tuples contain stars.
+         */
+        [[nodiscard]] bool hasStar() const;
+
+        /**
+         * Gives the identifier of the root node of the diagram.
+         *
+         * @return The root node of the diagram.
+         */
+        [[nodiscard]] std::uint32_t getRoot() const;
+
+        /**
+         * Gives the number of nodes in the diagram, including the terminal
+         * node.
+         *
+         * @return The number of nodes.
+         */
+        [[nodiscard]] std::size_t getNumberOfNodes() const;
+
+        /**
+         * Gives the values labelling the edges leaving a node.
+         *
+         * @param node The identifier of the node.
+         *
+         * @return The values of the edges of the node.
+         */
+        [[nodiscard]] std::span<const int> getValues(std::uint32_t node) const;
+
+        /**
+         * Gives the nodes targeted by the edges leaving a node, in the same
+         * order as their values.
+         *
+         * @param node The identifier of the node.
+         *
+         * @return The targets of the edges of the node.
+         */
+        [[nodiscard]] std::span<const std::uint32_t> getTargets(std::uint32_t node) const;
+
+        /**
+         * Gives the offsets of the edges of each node of the diagram.
+         *
+         * @return The offsets of the edges.
+         */
+        [[nodiscard]] std::span<const std::size_t> getNodeOffsets() const;
+
+        /**
+         * Gives the values labelling all the edges of the diagram.
+         *
+         * @return The values of the edges.
+         */
+        [[nodiscard]] std::span<const int> getEdgeValues() const;
+
+        /**
+         * Gives the nodes targeted by all the edges of the diagram.
+         *
+         * @return The targets of the edges.
+         */
+        [[nodiscard]] std::span<const std::uint32_t> getEdgeTargets() const;
+
+        /**
+         * Enumerates the tuples of this table into an uncompressed table, for
+         * the solvers that do not understand the compressed representation.
+         * The tuples are enumerated in lexicographic order, stars first.
+         *
+         * @return The uncompressed table.
+         */
+        [[nodiscard]] std::shared_ptr<const Autis::TupleTable> decompress() const;
+
+    };
+
+}
+
+#endif
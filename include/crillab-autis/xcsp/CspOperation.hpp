@@ -0,0 +1,619 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file CspOperation.hpp
+ * @brief Enumerates the operations recorded in an XCSP3 instance.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_CSPOPERATION_HPP
+#define AUTIS_CSPOPERATION_HPP
+
+namespace Autis {
+
+    /**
+     * The CspOperation enumerates the operations that may be recorded in an
+     * XcspInstance.
+     * Each operation corresponds to an overload of a method of
+     * IUniverseCspSolver, and its operands are recorded in the same order as
+     * the parameters of this overload.
+     */
+    enum class CspOperation : unsigned char {
+
+        /**
+         * The operation newVariable(id, minValue, maxValue).
+         */
+        NEW_VARIABLE_RANGE,
+
+        /**
+         * The operation newVariable(id, values).
+         */
+        NEW_VARIABLE_VALUES,
+
+        /**
+         * The operation addAllDifferent(list).
+         */
+        ALL_DIFFERENT,
+
+        /**
+         * The operation addIntension(tree).
+         */
+        INTENSION,
+
+        /**
+         * The operation addSupport(variable, tuples, hasStar).
+         */
+        UNARY_SUPPORT,
+
+        /**
+         * The operation addConflicts(variable, tuples, hasStar).
+         */
+        UNARY_CONFLICTS,
+
+        /**
+         * The operation addSupport(list, tuples, hasStar).
+         */
+        SUPPORT,
+
+        /**
+         * The operation addConflicts(list, tuples, hasStar).
+         */
+        CONFLICTS,
+
+        /**
+         * The operation addSum(list, operator, rightHandSide).
+         */
+        SUM,
+
+        /**
+         * The operation addSum(list, coeffs, operator, rightHandSide).
+         */
+        SUM_WITH_COEFFICIENTS,
+
+        /**
+         * The operation addSumWithVariableCoefficients(list, coeffs, operator, rightHandSide).
+         */
+        SUM_WITH_VARIABLE_COEFFICIENTS,
+
+        /**
+         * The operation addSumIntension(trees, operator, rightHandSide).
+         */
+        SUM_INTENSION,
+
+        /**
+         * The operation addSumIntension(trees, coefs, operator, rightHandSide).
+         */
+        SUM_INTENSION_WITH_COEFFICIENTS,
+
+        /**
+         * The operation addPrimitive(x, arithmeticOperator, k, operator, y).
+         */
+        PRIMITIVE_ARITHMETIC_CONSTANT,
+
+        /**
+         * The operation addPrimitive(x, operator, k).
+         */
+        PRIMITIVE,
+
+        /**
+         * The operation addPrimitive(x, setOperator, min, max).
+         */
+        PRIMITIVE_IN_RANGE,
+
+        /**
+         * The operation addPrimitive(x, arithmeticOperator, y, operator, z).
+         */
+        PRIMITIVE_ARITHMETIC,
+
+        /**
+         * The operation addAllDifferentIntension(list).
+         */
+        ALL_DIFFERENT_INTENSION,
+
+        /**
+         * The operation addAllDifferent(list, except).
+         */
+        ALL_DIFFERENT_EXCEPT,
+
+        /**
+         * The operation addAllDifferentList(lists).
+         */
+        ALL_DIFFERENT_LIST,
+
+        /**
+         * The operation addAllDifferentMatrix(matrix).
+         */
+        ALL_DIFFERENT_MATRIX,
+
+        /**
+         * The operation addAllEqual(list).
+         */
+        ALL_EQUAL,
+
+        /**
+         * The operation addAllEqualIntension(list).
+         */
+        ALL_EQUAL_INTENSION,
+
+        /**
+         * The operation addNotAllEqual(list).
+         */
+        NOT_ALL_EQUAL,
+
+        /**
+         * The operation addOrdered(list, operator).
+         */
+        ORDERED,
+
+        /**
+         * The operation addOrderedWithConstantLength(list, lengths, operator).
+         */
+        ORDERED_WITH_CONSTANT_LENGTH,
+
+        /**
+         * The operation addLex(lists, operator).
+         */
+        LEX,
+
+        /**
+         * The operation addLexMatrix(matrix, operator).
+         */
+        LEX_MATRIX,
+
+        /**
+         * The operation addAtMost(list, value, k).
+         */
+        AT_MOST,
+
+        /**
+         * The operation addAtLeast(list, value, k).
+         */
+        AT_LEAST,
+
+        /**
+         * The operation addExactly(list, value, k).
+         */
+        EXACTLY,
+
+        /**
+         * The operation addExactly(list, value, x).
+         */
+        EXACTLY_VARIABLE,
+
+        /**
+         * The operation addAmong(list, values, k).
+         */
+        AMONG,
+
+        /**
+         * The operation addCountWithConstantValues(list, values, operator, rightHandSide).
+         */
+        COUNT_WITH_CONSTANT_VALUES,
+
+        /**
+         * The operation addCountWithVariableValues(list, values, operator, rightHandSide).
+         */
+        COUNT_WITH_VARIABLE_VALUES,
+
+        /**
+         * The operation addCountIntensionWithConstantValues(trees, values, operator, rightHandSide).
+         */
+        COUNT_INTENSION_WITH_CONSTANT_VALUES,
+
+        /**
+         * The operation addNValuesExcept(list, operator, rightHandSide, except).
+         */
+        N_VALUES_EXCEPT,
+
+        /**
+         * The operation addNValuesIntension(trees, operator, rightHandSide).
+         */
+        N_VALUES_INTENSION,
+
+        /**
+         * The operation addNValues(list, operator, rightHandSide).
+         */
+        N_VALUES,
+
+        /**
+         * The operation addCardinalityWithConstantValuesAndConstantCounts(list, values, occurs, closed).
+         */
+        CARDINALITY_WITH_CONSTANT_VALUES_AND_CONSTANT_COUNTS,
+
+        /**
+         * The operation addCardinalityWithConstantValuesAndVariableCounts(list, values, occurs, closed).
+         */
+        CARDINALITY_WITH_CONSTANT_VALUES_AND_VARIABLE_COUNTS,
+
+        /**
+         * The operation addCardinalityWithConstantValuesAndConstantIntervalCounts(list, values, occursMin, occursMax, closed).
+         */
+        CARDINALITY_WITH_CONSTANT_VALUES_AND_CONSTANT_INTERVAL_COUNTS,
+
+        /**
+         * The operation addCardinalityWithVariableValuesAndConstantCounts(list, values, occurs, closed).
+         */
+        CARDINALITY_WITH_VARIABLE_VALUES_AND_CONSTANT_COUNTS,
+
+        /**
+         * The operation addCardinalityWithVariableValuesAndVariableCounts(list, values, occurs, closed).
+         */
+        CARDINALITY_WITH_VARIABLE_VALUES_AND_VARIABLE_COUNTS,
+
+        /**
+         * The operation addCardinalityWithVariableValuesAndConstantIntervalCounts(list, values, occursMin, occursMax, closed).
+         */
+        CARDINALITY_WITH_VARIABLE_VALUES_AND_CONSTANT_INTERVAL_COUNTS,
+
+        /**
+         * The operation addMinimum(list, operator, rightHandSide).
+         */
+        MINIMUM,
+
+        /**
+         * The operation addMinimumIntension(list, operator, rightHandSide).
+         */
+        MINIMUM_INTENSION,
+
+        /**
+         * The operation addMaximum(list, operator, rightHandSide).
+         */
+        MAXIMUM,
+
+        /**
+         * The operation addMaximumIntension(list, operator, rightHandSide).
+         */
+        MAXIMUM_INTENSION,
+
+        /**
+         * The operation addElement(list, operator, value).
+         */
+        ELEMENT_CONSTANT,
+
+        /**
+         * The operation addElement(list, startIndex, index, operator, rightHandSide).
+         */
+        ELEMENT_WITH_INDEX,
+
+        /**
+         * The operation addElementMatrix(matrix, startRowIndex, rowIndex, startColIndex, colIndex, operator, value).
+         */
+        ELEMENT_MATRIX_VARIABLE,
+
+        /**
+         * The operation addElementMatrix(matrix, startRowIndex, rowIndex, startColIndex, colIndex, operator, value).
+         */
+        ELEMENT_MATRIX_CONSTANT,
+
+        /**
+         * The operation addElementConstantMatrix(matrix, startRowIndex, rowIndex, startColIndex, colIndex, operator, value).
+         */
+        ELEMENT_CONSTANT_MATRIX,
+
+        /**
+         * The operation addElement(list, operator, value).
+         */
+        ELEMENT_VARIABLE,
+
+        /**
+         * The operation addChannel(list, startIndex).
+         */
+        CHANNEL,
+
+        /**
+         * The operation addChannel(list1, startIndex1, list2, startIndex2).
+         */
+        CHANNEL_BETWEEN_LISTS,
+
+        /**
+         * The operation addChannel(list, startIndex, value).
+         */
+        CHANNEL_WITH_VALUE,
+
+        /**
+         * The operation addNoOverlap(origins, lengths, zeroIgnored).
+         */
+        NO_OVERLAP,
+
+        /**
+         * The operation addNoOverlapVariableLength(origins, lengths, zeroIgnored).
+         */
+        NO_OVERLAP_VARIABLE_LENGTH,
+
+        /**
+         * The operation addMultiDimensionalNoOverlap(origins, lengths, zeroIgnored).
+         */
+        MULTI_DIMENSIONAL_NO_OVERLAP,
+
+        /**
+         * The operation addMultiDimensionalNoOverlapVariableLength(origins, lengths, zeroIgnored).
+         */
+        MULTI_DIMENSIONAL_NO_OVERLAP_VARIABLE_LENGTH,
+
+        /**
+         * The operation addCumulativeConstantLengthsConstantHeights(origins, lengths, heights, operator, rightHandSide).
+         */
+        CUMULATIVE_CONSTANT_LENGTHS_CONSTANT_HEIGHTS,
+
+        /**
+         * The operation addCumulativeConstantLengthsVariableHeights(origins, lengths, varHeights, operator, rightHandSide).
+         */
+        CUMULATIVE_CONSTANT_LENGTHS_VARIABLE_HEIGHTS,
+
+        /**
+         * The operation addCumulativeVariableLengthsConstantHeights(origins, lengths, heights, operator, rightHandSide).
+         */
+        CUMULATIVE_VARIABLE_LENGTHS_CONSTANT_HEIGHTS,
+
+        /**
+         * The operation addCumulativeConstantLengthsConstantHeights(origins, lengths, ends, heights, operator, rightHandSide).
+         */
+        CUMULATIVE_CONSTANT_LENGTHS_CONSTANT_HEIGHTS_WITH_ENDS,
+
+        /**
+         * The operation addCumulativeConstantLengthsVariableHeights(origins, lengths, ends, varHeights, operator, rightHandSide).
+         */
+        CUMULATIVE_CONSTANT_LENGTHS_VARIABLE_HEIGHTS_WITH_ENDS,
+
+        /**
+         * The operation addCumulativeVariableLengthsVariableHeights(origins, lengths, ends, heights, operator, rightHandSide).
+         */
+        CUMULATIVE_VARIABLE_LENGTHS_VARIABLE_HEIGHTS_WITH_ENDS,
+
+        /**
+         * The operation addCumulativeVariableLengthsConstantHeights(origins, lengths, ends, heights, operator, rightHandSide).
+         */
+        CUMULATIVE_VARIABLE_LENGTHS_CONSTANT_HEIGHTS_WITH_ENDS,
+
+        /**
+         * The operation addCumulativeVariableLengthsVariableHeights(origins, lengths, heights, operator, rightHandSide).
+         */
+        CUMULATIVE_VARIABLE_LENGTHS_VARIABLE_HEIGHTS,
+
+        /**
+         * The operation addInstantiation(list, values).
+         */
+        INSTANTIATION,
+
+        /**
+         * The operation addClause(positive, negative).
+         */
+        CLAUSE,
+
+        /**
+         * The operation minimizeVariable(x).
+         */
+        MINIMIZE_VARIABLE,
+
+        /**
+         * The operation maximizeVariable(x).
+         */
+        MAXIMIZE_VARIABLE,
+
+        /**
+         * The operation minimizeMaximum(list).
+         */
+        MINIMIZE_MAXIMUM,
+
+        /**
+         * The operation minimizeMinimum(list).
+         */
+        MINIMIZE_MINIMUM,
+
+        /**
+         * The operation minimizeNValues(list).
+         */
+        MINIMIZE_N_VALUES,
+
+        /**
+         * The operation minimizeSum(list).
+         */
+        MINIMIZE_SUM,
+
+        /**
+         * The operation minimizeProduct(list).
+         */
+        MINIMIZE_PRODUCT,
+
+        /**
+         * The operation maximizeMaximum(list).
+         */
+        MAXIMIZE_MAXIMUM,
+
+        /**
+         * The operation maximizeMinimum(list).
+         */
+        MAXIMIZE_MINIMUM,
+
+        /**
+         * The operation maximizeNValues(list).
+         */
+        MAXIMIZE_N_VALUES,
+
+        /**
+         * The operation maximizeSum(list).
+         */
+        MAXIMIZE_SUM,
+
+        /**
+         * The operation maximizeProduct(list).
+         */
+        MAXIMIZE_PRODUCT,
+
+        /**
+         * The operation minimizeExpressionMaximum(trees).
+         */
+        MINIMIZE_EXPRESSION_MAXIMUM,
+
+        /**
+         * The operation minimizeExpressionMinimum(trees).
+         */
+        MINIMIZE_EXPRESSION_MINIMUM,
+
+        /**
+         * The operation minimizeExpressionNValues(trees).
+         */
+        MINIMIZE_EXPRESSION_N_VALUES,
+
+        /**
+         * The operation minimizeExpressionSum(trees).
+         */
+        MINIMIZE_EXPRESSION_SUM,
+
+        /**
+         * The operation minimizeExpressionProduct(trees).
+         */
+        MINIMIZE_EXPRESSION_PRODUCT,
+
+        /**
+         * The operation maximizeExpressionMaximum(trees).
+         */
+        MAXIMIZE_EXPRESSION_MAXIMUM,
+
+        /**
+         * The operation maximizeExpressionMinimum(trees).
+         */
+        MAXIMIZE_EXPRESSION_MINIMUM,
+
+        /**
+         * The operation maximizeExpressionNValues(trees).
+         */
+        MAXIMIZE_EXPRESSION_N_VALUES,
+
+        /**
+         * The operation maximizeExpressionSum(trees).
+         */
+        MAXIMIZE_EXPRESSION_SUM,
+
+        /**
+         * The operation maximizeExpressionProduct(trees).
+         */
+        MAXIMIZE_EXPRESSION_PRODUCT,
+
+        /**
+         * The operation minimizeMaximum(list, coefs).
+         */
+        MINIMIZE_MAXIMUM_WITH_COEFFICIENTS,
+
+        /**
+         * The operation minimizeMinimum(list, coefs).
+         */
+        MINIMIZE_MINIMUM_WITH_COEFFICIENTS,
+
+        /**
+         * The operation minimizeNValues(list, coefs).
+         */
+        MINIMIZE_N_VALUES_WITH_COEFFICIENTS,
+
+        /**
+         * The operation minimizeSum(list, coefs).
+         */
+        MINIMIZE_SUM_WITH_COEFFICIENTS,
+
+        /**
+         * The operation minimizeProduct(list, coefs).
+         */
+        MINIMIZE_PRODUCT_WITH_COEFFICIENTS,
+
+        /**
+         * The operation maximizeMaximum(list, coefs).
+         */
+        MAXIMIZE_MAXIMUM_WITH_COEFFICIENTS,
+
+        /**
+         * The operation maximizeMinimum(list, coefs).
+         */
+        MAXIMIZE_MINIMUM_WITH_COEFFICIENTS,
+
+        /**
+         * The operation maximizeNValues(list, coefs).
+         */
+        MAXIMIZE_N_VALUES_WITH_COEFFICIENTS,
+
+        /**
+         * The operation maximizeSum(list, coefs).
+         */
+        MAXIMIZE_SUM_WITH_COEFFICIENTS,
+
+        /**
+         * The operation maximizeProduct(list, coefs).
+         */
+        MAXIMIZE_PRODUCT_WITH_COEFFICIENTS,
+
+        /**
+         * The operation minimizeExpressionMaximum(trees, coefs).
+         */
+        MINIMIZE_EXPRESSION_MAXIMUM_WITH_COEFFICIENTS,
+
+        /**
+         * The operation minimizeExpressionMinimum(trees, coefs).
+         */
+        MINIMIZE_EXPRESSION_MINIMUM_WITH_COEFFICIENTS,
+
+        /**
+         * The operation minimizeExpressionNValues(trees, coefs).
+         */
+        MINIMIZE_EXPRESSION_N_VALUES_WITH_COEFFICIENTS,
+
+        /**
+         * The operation minimizeExpressionSum(trees, coefs).
+         */
+        MINIMIZE_EXPRESSION_SUM_WITH_COEFFICIENTS,
+
+        /**
+         * The operation minimizeExpressionProduct(trees, coefs).
+         */
+        MINIMIZE_EXPRESSION_PRODUCT_WITH_COEFFICIENTS,
+
+        /**
+         * The operation maximizeExpressionMaximum(trees, coefs).
+         */
+        MAXIMIZE_EXPRESSION_MAXIMUM_WITH_COEFFICIENTS,
+
+        /**
+         * The operation maximizeExpressionMinimum(trees, coefs).
+         */
+        MAXIMIZE_EXPRESSION_MINIMUM_WITH_COEFFICIENTS,
+
+        /**
+         * The operation maximizeExpressionNValues(trees, coefs).
+         */
+        MAXIMIZE_EXPRESSION_N_VALUES_WITH_COEFFICIENTS,
+
+        /**
+         * The operation maximizeExpressionSum(trees, coefs).
+         */
+        MAXIMIZE_EXPRESSION_SUM_WITH_COEFFICIENTS,
+
+        /**
+         * The operation maximizeExpressionProduct(trees, coefs).
+         */
+        MAXIMIZE_EXPRESSION_PRODUCT_WITH_COEFFICIENTS
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,82 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file ICompressedTableListener.hpp
+ * @brief Defines an interface for solvers receiving compressed tables of tuples.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_ICOMPRESSEDTABLELISTENER_HPP
+#define AUTIS_ICOMPRESSEDTABLELISTENER_HPP
+
+#include <memory>
+#include <span>
+
+#include "CompressedTupleTable.hpp"
+#include "IVariableHandleListener.hpp"
+
+namespace Autis {
+
+    /**
+     * The ICompressedTableListener is an optional interface that a CSP solver
+     * may implement to receive the extension constraints whose tuples have
+     * been compressed directly as decision diagrams, instead of as lists of
+     * tuples.
+     * Tables are only compressed when ParserConfiguration enables it.
+     */
+    class ICompressedTableListener : public Autis::IVariableHandleListener {
+
+    public:
+
+        using IVariableHandleListener::addSupport;
+        using IVariableHandleListener::addConflicts;
+
+        /**
+         * Adds an extension constraint whose allowed tuples are compressed.
+         * The table may be shared with other constraints: solvers that need it
+         * after this call should keep their own reference to it.
+         *
+         * @param variables The handles of the variables of the constraint.
+         * @param tuples The allowed tuples.
+         */
+        virtual void addSupport(std::span<const int> variables,
+                const std::shared_ptr<const Autis::CompressedTupleTable> &tuples) = 0;
+
+        /**
+         * Adds an extension constraint whose forbidden tuples are compressed.
+         * The table may be shared with other constraints: solvers that need it
+         * after this call should keep their own reference to it.
+         *
+         * @param variables The handles of the variables of the constraint.
+         * @param tuples The forbidden tuples.
+         */
+        virtual void addConflicts(std::span<const int> variables,
+                const std::shared_ptr<const Autis::CompressedTupleTable> &tuples) = 0;
+
+    };
+
+}
+
+#endif
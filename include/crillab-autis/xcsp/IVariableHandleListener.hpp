@@ -0,0 +1,134 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file IVariableHandleListener.hpp
+ * @brief Defines an optional interface for CSP solvers identifying variables by handles.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_IVARIABLEHANDLELISTENER_HPP
+#define AUTIS_IVARIABLEHANDLELISTENER_HPP
+
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <crillab-universe/core/UniverseType.hpp>
+#include <crillab-universe/csp/IUniverseCspSolver.hpp>
+
+#include "TupleTable.hpp"
+
+namespace Autis {
+
+    /**
+     * The IVariableHandleListener is an optional interface that a CSP solver
+     * may implement to receive the most common constraints with their
+     * variables identified by handles, instead of by their names.
+     * The handles of the variables are dense: they are assigned from 0, in
+     * the order in which the variables are given to newVariable().
+     * The other constraints are still given through IUniverseCspSolver.
+     */
+    class IVariableHandleListener {
+
+    public:
+
+        /**
+         * Destroys this IVariableHandleListener.
+         */
+        virtual ~IVariableHandleListener() = default;
+
+        /**
+         * Adds an all-different constraint.
+         *
+         * @param variables The handles of the variables of the constraint.
+         */
+        virtual void addAllDifferent(std::span<const int> variables) = 0;
+
+        /**
+         * Adds an all-equal constraint.
+         *
+         * @param variables The handles of the variables of the constraint.
+         */
+        virtual void addAllEqual(std::span<const int> variables) = 0;
+
+        /**
+         * Adds an extension constraint listing the allowed tuples.
+         *
+         * The table may be shared with other constraints: solvers that need it
+         * after this call should keep their own reference to it.
+         *
+         * @param variables The handles of the variables of the constraint.
+         * @param tuples The allowed tuples.
+         */
+        virtual void addSupport(std::span<const int> variables,
+                const std::shared_ptr<const Autis::TupleTable> &tuples) = 0;
+
+        /**
+         * Adds an extension constraint listing the forbidden tuples.
+         *
+         * The table may be shared with other constraints: solvers that need it
+         * after this call should keep their own reference to it.
+         *
+         * @param variables The handles of the variables of the constraint.
+         * @param tuples The forbidden tuples.
+         */
+        virtual void addConflicts(std::span<const int> variables,
+                const std::shared_ptr<const Autis::TupleTable> &tuples) = 0;
+
+        /**
+         * Adds a sum constraint whose right-hand side is a constant.
+         *
+         * @param variables The handles of the variables of the sum.
+         * @param op The relational operator of the constraint.
+         * @param rhs The right-hand side of the constraint.
+         */
+        virtual void addSum(std::span<const int> variables, Universe::UniverseRelationalOperator op,
+                const Universe::BigInteger &rhs) = 0;
+
+        /**
+         * Adds a weighted sum constraint whose right-hand side is a constant.
+         *
+         * @param variables The handles of the variables of the sum.
+         * @param coefficients The coefficients of the variables.
+         * @param op The relational operator of the constraint.
+         * @param rhs The right-hand side of the constraint.
+         */
+        virtual void addSum(std::span<const int> variables, const std::vector<Universe::BigInteger> &coefficients,
+                Universe::UniverseRelationalOperator op, const Universe::BigInteger &rhs) = 0;
+
+        /**
+         * Adds a primitive constraint comparing a variable with a constant.
+         *
+         * @param variable The handle of the variable.
+         * @param op The relational operator of the constraint.
+         * @param value The constant to compare the variable with.
+         */
+        virtual void addPrimitive(int variable, Universe::UniverseRelationalOperator op, int value) = 0;
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,176 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file IntensionOperator.hpp
+ * @brief Enumerates the operators of intension expressions.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_INTENSIONOPERATOR_HPP
+#define AUTIS_INTENSIONOPERATOR_HPP
+
+namespace Autis {
+
+    /**
+     * The IntensionOperator enumerates the operators that may appear in the
+     * nodes of the intension expressions recorded in an XcspInstance.
+     */
+    enum class IntensionOperator : unsigned char {
+
+        /**
+         * An integer constant.
+         */
+        CONSTANT,
+
+        /**
+         * A variable.
+         */
+        VARIABLE,
+
+        /**
+         * The absolute value of an expression.
+         */
+        ABS,
+
+        /**
+         * The opposite of an expression.
+         */
+        NEG,
+
+        /**
+         * The square of an expression.
+         */
+        SQR,
+
+        /**
+         * The negation of a Boolean expression.
+         */
+        NOT,
+
+        /**
+         * The distance between two expressions.
+         */
+        DIST,
+
+        /**
+         * The (integer) division of two expressions.
+         */
+        DIV,
+
+        /**
+         * The remainder of the division of two expressions.
+         */
+        MOD,
+
+        /**
+         * The power of an expression by another.
+         */
+        POW,
+
+        /**
+         * The difference of two expressions.
+         */
+        SUB,
+
+        /**
+         * The implication between two Boolean expressions.
+         */
+        IMP,
+
+        /**
+         * The comparison "<" between two expressions.
+         */
+        LT,
+
+        /**
+         * The comparison "<=" between two expressions.
+         */
+        LE,
+
+        /**
+         * The comparison ">=" between two expressions.
+         */
+        GE,
+
+        /**
+         * The comparison ">" between two expressions.
+         */
+        GT,
+
+        /**
+         * The comparison "!=" between two expressions.
+         */
+        NE,
+
+        /**
+         * The sum of expressions.
+         */
+        ADD,
+
+        /**
+         * The product of expressions.
+         */
+        MULT,
+
+        /**
+         * The minimum of expressions.
+         */
+        MIN,
+
+        /**
+         * The maximum of expressions.
+         */
+        MAX,
+
+        /**
+         * The equality of expressions.
+         */
+        EQ,
+
+        /**
+         * The conjunction of Boolean expressions.
+         */
+        AND,
+
+        /**
+         * The disjunction of Boolean expressions.
+         */
+        OR,
+
+        /**
+         * The parity of Boolean expressions.
+         */
+        XOR,
+
+        /**
+         * The equivalence of Boolean expressions.
+         */
+        IFF
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,165 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file TupleTable.hpp
+ * @brief Stores the tuples of an extension constraint, shared between constraints.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_TUPLETABLE_HPP
+#define AUTIS_TUPLETABLE_HPP
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <crillab-universe/core/UniverseType.hpp>
+
+namespace Autis {
+
+    /**
+     * The TupleTable stores the tuples of an extension constraint.
+     * A table is immutable once created, and is shared (through a shared
+     * pointer) between all the constraints that use it, so that tables
+     * reused by several constraints are stored only once.
+     * The tuples are stored contiguously, with one int per value.
+     */
+    class TupleTable {
+
+    public:
+
+        /**
+         * The value representing a star in a tuple, i.e., any value.
+         */
+        static constexpr int STAR = std::numeric_limits<int>::max();
+
+    private:
+
+        /**
+         * The number of values in each tuple.
+         */
+        std::size_t arity;
+
+        /**
+         * The number of tuples in this table.
+         */
+        std::size_t nbTuples;
+
+        /**
+         * The values of the tuples, stored one tuple after the other.
+         */
+        std::vector<int> values;
+
+        /**
+         * Whether the tuples contain stars.
+         */
+        bool star;
+
+    public:
+
+        /**
+         * Creates a new TupleTable.
+         *
+         * @param arity The number of values in each tuple.
+         * @param nbTuples The number of tuples in the table.
+         * @param values The values of the tuples, stored one tuple after the
+         *        other.
+         * @param hasStar Whether the tuples contain stars.
+         *
+         * @throws IllegalArgumentException If the number of values does not
+         *         match the size of the table.
+         */
+        TupleTable(std::size_t arity, std::size_t nbTuples, std::vector<int> values, bool hasStar);
+
+        /**
+         * Creates a shared TupleTable containing the given tuples.
+         *
+         * @param arity The number of variables in the scope of the table,
+         *        which is also its arity when there is no tuple.
+         * @param tuples The tuples to store, which must all have this
+         *        size.
+         * @param hasStar Whether the tuples contain stars.
+         *
+         * @return The created table.
+         *
+         * @throws IllegalArgumentException If the tuples do not all have the
+         *         given size.
+         */
+        static std::shared_ptr<const Autis::TupleTable> of(
+                std::size_t arity, const std::vector<std::vector<int>> &tuples, bool hasStar);
+
+        /**
+         * Gives the number of values in each tuple of this table.
+         *
+         * @return The arity of the tuples.
+         */
+        [[nodiscard]] std::size_t getArity() const;
+
+        /**
+         * Gives the number of tuples in this table.
+         *
+         * @return The number of tuples.
+         */
+        [[nodiscard]] std::size_t size() const;
+
+        /**
+         * Checks whether the tuples of this table contain stars.
+         *
+         * @return Whether the tuples contain stars.
+         */
+        [[nodiscard]] bool hasStar() const;
+
+        /**
+         * Gives a tuple of this table.
+         *
+         * @param index The index of the tuple.
+         *
+         * @return The values of the tuple.
+         */
+        [[nodiscard]] std::span<const int> operator[](std::size_t index) const;
+
+        /**
+         * Gives all the values of this table, stored one tuple after the
+         * other.
+         *
+         * @return The values of the tuples.
+         */
+        [[nodiscard]] std::span<const int> getValues() const;
+
+        /**
+         * Builds a copy of the tuples of this table as big integers, as
+         * expected by IUniverseCspSolver.
+         *
+         * @return The tuples of this table.
+         */
+        [[nodiscard]] std::vector<std::vector<Universe::BigInteger>> toBigIntegerMatrix() const;
+
+    };
+
+}
+
+#endif
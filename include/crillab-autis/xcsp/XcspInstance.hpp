@@ -0,0 +1,702 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file XcspInstance.hpp
+ * @brief Stores an XCSP3 instance in a solver-neutral form.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_XCSPINSTANCE_HPP
+#define AUTIS_XCSPINSTANCE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include <crillab-universe/core/UniverseType.hpp>
+#include <crillab-universe/csp/IUniverseCspSolver.hpp>
+#include <crillab-universe/csp/intension/AbstractUniverseIntensionConstraintFactory.hpp>
+
+#include "../core/Arena.hpp"
+#include "CompressedTupleTable.hpp"
+#include "CspOperation.hpp"
+#include "IntensionOperator.hpp"
+#include "TupleTable.hpp"
+
+namespace Autis {
+
+    class ICompressedTableListener;
+    class IVariableHandleListener;
+    class SnapshotReader;
+    class SnapshotWriter;
+
+    /**
+     * The IntensionReference identifies an intension expression that has
+     * been recorded in an XcspInstance.
+     */
+    struct IntensionReference {
+
+        /**
+         * The index of the root node of the expression.
+         */
+        std::size_t node;
+
+    };
+
+    /**
+     * The VariableListReference identifies a list of variables that has been
+     * recorded in an XcspInstance.
+     */
+    struct VariableListReference {
+
+        /**
+         * The index of the list of the handles of the variables.
+         */
+        std::size_t list;
+
+    };
+
+    /**
+     * The VariableMatrixReference identifies a matrix of variables that has
+     * been recorded in an XcspInstance.
+     */
+    struct VariableMatrixReference {
+
+        /**
+         * The index of the list of the rows of the matrix.
+         */
+        std::size_t rows;
+
+    };
+
+    /**
+     * The IntensionCache remembers the intension constraints that have been
+     * created for the expressions of an XcspInstance, indexed by the nodes of
+     * the expressions.
+     */
+    using IntensionCache = std::vector<Universe::IUniverseIntensionConstraint *>;
+
+    /**
+     * The CspOperand is the value of an operand given to a solver without
+     * having been recorded, i.e., one of the types of the parameters of the
+     * methods of IUniverseCspSolver.
+     */
+    using CspOperand = std::variant<int, bool, Universe::UniverseRelationalOperator,
+            Universe::UniverseArithmeticOperator, Universe::UniverseSetBelongingOperator, std::string,
+            std::vector<std::string>, std::vector<std::vector<std::string>>, std::vector<int>,
+            std::vector<Universe::BigInteger>, std::vector<std::vector<Universe::BigInteger>>,
+            std::shared_ptr<const Autis::TupleTable>, std::shared_ptr<const Autis::CompressedTupleTable>,
+            Universe::IUniverseIntensionConstraint *, std::vector<Universe::IUniverseIntensionConstraint *>>;
+
+    /**
+     * The XcspInstance records the variables, constraints and objective
+     * functions of an XCSP3 instance as a sequence of operations, so that they
+     * can be given to any number of CSP solvers later on.
+     * The operands of all operations are stored in flat arrays: identifiers
+     * are interned, and lists, matrices and intension expressions are stored
+     * in arenas.
+     * Each variable is identified by a dense handle, which is the index of its
+     * interned name, so that lists of variables are stored as lists of
+     * handles and their names are only built when a solver needs them.
+     * Intension expressions are hash-consed: structurally identical
+     * subexpressions are recorded as a single node, so that the expressions
+     * of an instance form a DAG.
+     */
+    class XcspInstance {
+
+    private:
+
+        /**
+         * The OperandType enumerates the types of the operands that may be
+         * recorded, so that each operand can be checked when it is read.
+         */
+        enum class OperandType : unsigned char {
+            INTEGER,
+            BOOLEAN,
+            RELATIONAL_OPERATOR,
+            ARITHMETIC_OPERATOR,
+            SET_BELONGING_OPERATOR,
+            NAME,
+            NAMES,
+            NAME_MATRIX,
+            INTEGERS,
+            BIG_INTEGERS,
+            BIG_INTEGER_MATRIX,
+            INTENSION,
+            INTENSIONS,
+            TUPLES,
+            COMPRESSED_TUPLES
+        };
+
+        /**
+         * The Reader reads back the operands of the recorded operations.
+         */
+        class Reader;
+
+        /**
+         * The OperandList reads the operands of an operation that has not
+         * been recorded, in the same way as the Reader does.
+         */
+        class OperandList;
+
+        /**
+         * The operations recorded in this instance.
+         */
+        std::vector<Autis::CspOperation> operations;
+
+        /**
+         * The types of the operands of the recorded operations.
+         */
+        std::vector<OperandType> operandTypes;
+
+        /**
+         * The operands of the recorded operations, in the order of the
+         * operations.
+         * Depending on its type, an operand is either a value, or an index in
+         * one of the arenas of this instance.
+         */
+        std::vector<std::int64_t> operands;
+
+        /**
+         * The identifiers appearing in this instance.
+         */
+        Autis::Arena<char> names;
+
+        /**
+         * The indices of the identifiers in the arena of names.
+         */
+        std::unordered_map<std::string, std::int64_t> nameIndices;
+
+        /**
+         * The lists of indices (of rows or nodes) appearing in this
+         * instance.
+         */
+        Autis::Arena<std::int64_t> indices;
+
+        /**
+         * The lists of integers and of handles of variables appearing in this
+         * instance.
+         */
+        Autis::Arena<int> integers;
+
+        /**
+         * The lists of big integers appearing in this instance.
+         */
+        Autis::Arena<Universe::BigInteger> bigIntegers;
+
+        /**
+         * The operators of the nodes of the intension expressions.
+         */
+        std::vector<Autis::IntensionOperator> nodeOperators;
+
+        /**
+         * The values of the nodes of the intension expressions, i.e., the
+         * value of a constant, the index of the name of a variable, or the
+         * index of the list of children of any other node.
+         */
+        std::vector<std::int64_t> nodeValues;
+
+        /**
+         * The lists of children of the nodes of the intension expressions.
+         */
+        Autis::Arena<std::int64_t> nodeChildren;
+
+        /**
+         * The indices of the nodes of the intension expressions, by hash of
+         * their operator and operands.
+         */
+        std::unordered_multimap<std::uint64_t, std::size_t> nodeIndices;
+
+        /**
+         * The tables of tuples appearing in this instance, which are shared
+         * with the callers that have recorded them.
+         */
+        std::vector<std::shared_ptr<const Autis::TupleTable>> tables;
+
+        /**
+         * The compressed tables of tuples appearing in this instance, which
+         * are shared with the callers that have recorded them.
+         */
+        std::vector<std::shared_ptr<const Autis::CompressedTupleTable>> compressedTables;
+
+    public:
+
+        /**
+         * Creates a new, empty, XcspInstance.
+         */
+        XcspInstance();
+
+        /**
+         * Records an operation in this instance.
+         *
+         * @tparam Operands The types of the operands of the operation.
+         *
+         * @param operation The operation to record.
+         * @param operandValues The operands of the operation, given in the same
+         *        order as to the corresponding method of IUniverseCspSolver.
+         */
+        template <typename... Operands>
+        void add(Autis::CspOperation operation, const Operands &... operandValues) {
+            operations.push_back(operation);
+            (write(operandValues), ...);
+        }
+
+        /**
+         * Gives the handle of a variable.
+         * Handles are assigned from 0, in the order in which the variables are
+         * first seen, i.e., when they are declared.
+         *
+         * @param name The identifier of the variable.
+         *
+         * @return The handle of the variable.
+         */
+        int variable(const std::string &name);
+
+        /**
+         * Records a list of variables.
+         *
+         * @param handles The handles of the variables.
+         *
+         * @return The reference of the recorded list.
+         */
+        Autis::VariableListReference variables(std::span<const int> handles);
+
+        /**
+         * Records a matrix of variables.
+         *
+         * @param rows The rows of the matrix, which have already been recorded
+         *        by variables().
+         *
+         * @return The reference of the recorded matrix.
+         */
+        Autis::VariableMatrixReference variableMatrix(const std::vector<Autis::VariableListReference> &rows);
+
+        /**
+         * Gives the number of variables that have a handle in this instance.
+         *
+         * @return The number of variables.
+         */
+        [[nodiscard]] std::size_t getNumberOfVariables() const;
+
+        /**
+         * Gives the identifier of a variable.
+         * The returned view remains valid until a new variable is seen.
+         *
+         * @param handle The handle of the variable.
+         *
+         * @return The identifier of the variable.
+         */
+        [[nodiscard]] std::string_view getVariableName(int handle) const;
+
+        /**
+         * Records a constant appearing in an intension expression.
+         * This method, as well as intensionVariable() and intension(),
+         * returns the node already recorded for an identical expression, if
+         * any.
+         *
+         * @param value The value of the constant.
+         *
+         * @return The reference of the recorded expression.
+         */
+        Autis::IntensionReference intensionConstant(long value);
+
+        /**
+         * Records a variable appearing in an intension expression.
+         *
+         * @param name The identifier of the variable.
+         *
+         * @return The reference of the recorded expression.
+         */
+        Autis::IntensionReference intensionVariable(const std::string &name);
+
+        /**
+         * Records an intension expression applying an operator to already
+         * recorded expressions.
+         *
+         * @param intensionOperator The operator of the expression.
+         * @param children The operands of the operator.
+         *
+         * @return The reference of the recorded expression.
+         */
+        Autis::IntensionReference intension(Autis::IntensionOperator intensionOperator,
+                const std::vector<Autis::IntensionReference> &children);
+
+        /**
+         * Gives the number of nodes of the intension expressions recorded in
+         * this instance, which are shared by identical subexpressions.
+         *
+         * @return The number of intension nodes.
+         */
+        [[nodiscard]] std::size_t getNumberOfIntensionNodes() const;
+
+        /**
+         * Gives the number of operations recorded in this instance.
+         *
+         * @return The number of operations.
+         */
+        [[nodiscard]] std::size_t size() const;
+
+        /**
+         * Gives all the recorded operations to a solver, in the order in
+         * which they have been recorded.
+         * If the solver is an IVariableHandleListener, the constraints it
+         * supports are given to it with the handles of their variables.
+         * Compressed tables are only given as such to the solvers that are
+         * ICompressedTableListeners, and are decompressed for the others.
+         *
+         * @param solver The solver to give the operations to.
+         * @param intensionFactory The factory to use to create the intension
+         *        constraints of the solver.
+         */
+        void replay(Universe::IUniverseCspSolver &solver,
+                Universe::AbstractUniverseIntensionConstraintFactory &intensionFactory) const;
+
+        /**
+         * Gives all the recorded operations to a solver, as replay() does.
+         * Each intension expression is created once, and then shared by all
+         * the expressions containing it: solvers must not assume that they
+         * are the only owner of the intension constraints they receive.
+         * The intension constraints that are created are stored in the given
+         * cache, so that they are also shared with the operations recorded
+         * later and replayed with the same cache.
+         *
+         * @param solver The solver to give the operations to.
+         * @param intensionFactory The factory to use to create the intension
+         *        constraints of the solver, which must be the same as for all
+         *        the previous uses of the cache.
+         * @param intensions The cache of the intension constraints created
+         *        for the expressions of this instance.
+         */
+        void replay(Universe::IUniverseCspSolver &solver,
+                Universe::AbstractUniverseIntensionConstraintFactory &intensionFactory,
+                Autis::IntensionCache &intensions) const;
+
+        /**
+         * Gives the intension constraint represented by a recorded expression,
+         * in the same way as replay() does.
+         * The constraint is only created if the cache does not already hold
+         * it, and is stored in the cache otherwise, together with the
+         * constraints of its subexpressions.
+         *
+         * @param expression The reference of the recorded expression.
+         * @param intensionFactory The factory to use to create the intension
+         *        constraints of the solver, which must be the same as for all
+         *        the previous uses of the cache.
+         * @param intensions The cache of the intension constraints created
+         *        for the expressions of this instance.
+         *
+         * @return The intension constraint.
+         */
+        Universe::IUniverseIntensionConstraint *intensionConstraint(Autis::IntensionReference expression,
+                Universe::AbstractUniverseIntensionConstraintFactory &intensionFactory,
+                Autis::IntensionCache &intensions) const;
+
+        /**
+         * Gives an operation to a solver without recording it, in the same
+         * way as replay() gives a recorded operation to a solver that is not
+         * an IVariableHandleListener.
+         *
+         * @param solver The solver to give the operation to.
+         * @param operation The operation to give to the solver.
+         * @param operands The operands of the operation, in the order in which
+         *        they would have been recorded.
+         *        They are moved to the solver.
+         *
+         * @throws IllegalArgumentException If the operands do not match the
+         *         operation.
+         */
+        static void give(Universe::IUniverseCspSolver &solver, Autis::CspOperation operation,
+                std::span<Autis::CspOperand> operands);
+
+        /**
+         * Creates the intension constraint applying an operator to other
+         * intension constraints.
+         *
+         * @param intensionFactory The factory to use to create the constraint.
+         * @param intensionOperator The operator of the constraint, which is
+         *        neither a constant nor a variable.
+         * @param children The operands of the operator.
+         *
+         * @return The created intension constraint.
+         *
+         * @throws IllegalArgumentException If the operator is unknown.
+         */
+        static Universe::IUniverseIntensionConstraint *createIntension(
+                Universe::AbstractUniverseIntensionConstraintFactory &intensionFactory,
+                Autis::IntensionOperator intensionOperator,
+                std::vector<Universe::IUniverseIntensionConstraint *> &children);
+
+        /**
+         * Removes all the operations that have been recorded in this instance.
+         * The variables and the intension expressions that have been seen are
+         * kept, so that their handles and nodes remain valid, and the memory
+         * used by this instance is kept to be reused.
+         */
+        void clear();
+
+        /**
+         * Removes all the intension expressions that have been recorded in
+         * this instance, so that the expressions recorded afterwards are no
+         * longer shared with them.
+         * This must only be done when no recorded operation refers to these
+         * expressions (e.g., after clear()), and the caches of the intension
+         * constraints created for this instance must be cleared as well.
+         */
+        void clearIntensions();
+
+        /**
+         * Writes everything that has been recorded in this instance to a
+         * snapshot.
+         *
+         * @param writer The writer of the snapshot.
+         */
+        void save(Autis::SnapshotWriter &writer) const;
+
+        /**
+         * Reads back what has been written to a snapshot by save().
+         * This instance must be empty.
+         *
+         * @param reader The reader of the snapshot.
+         *
+         * @throws ParseException If the snapshot is malformed.
+         */
+        void load(Autis::SnapshotReader &reader);
+
+    private:
+
+        /**
+         * Checks that the operands and the nodes of this instance only refer
+         * to values that exist in its arenas, once it has been loaded from a
+         * snapshot.
+         *
+         * @throws ParseException If an operand or a node is invalid.
+         */
+        void checkReferences() const;
+
+        /**
+         * Gives an operation to a solver using the handles of its variables,
+         * if the operation is one of those supported by IVariableHandleListener.
+         *
+         * @param operation The operation to give to the solver.
+         * @param reader The reader of the operands of the operation.
+         * @param solver The solver to give the operation to.
+         * @param handleListener The solver, as an IVariableHandleListener.
+         * @param tableListener The solver, as an ICompressedTableListener, or
+         *        null if it is not one.
+         *
+         * @return Whether the operation has been given to the solver.
+         */
+        static bool replay(Autis::CspOperation operation, Reader &reader, Universe::IUniverseCspSolver &solver,
+                Autis::IVariableHandleListener &handleListener, Autis::ICompressedTableListener *tableListener);
+
+        /**
+         * Gives an operation to a solver, using the identifiers of its
+         * variables.
+         *
+         * @tparam Source The type of the source of the operands, which is
+         *         either a Reader or an OperandList.
+         *
+         * @param operation The operation to give to the solver.
+         * @param source The source of the operands of the operation.
+         * @param solver The solver to give the operation to.
+         *
+         * @throws IllegalArgumentException If the operation is unknown.
+         */
+        template <typename Source>
+        static void give(Autis::CspOperation operation, Source &source, Universe::IUniverseCspSolver &solver);
+
+        /**
+         * Records an integer operand.
+         *
+         * @param value The value of the operand.
+         */
+        void write(int value);
+
+        /**
+         * Records a Boolean operand.
+         *
+         * @param value The value of the operand.
+         */
+        void write(bool value);
+
+        /**
+         * Records a relational operator.
+         *
+         * @param value The operator to record.
+         */
+        void write(Universe::UniverseRelationalOperator value);
+
+        /**
+         * Records an arithmetic operator.
+         *
+         * @param value The operator to record.
+         */
+        void write(Universe::UniverseArithmeticOperator value);
+
+        /**
+         * Records a set-belonging operator.
+         *
+         * @param value The operator to record.
+         */
+        void write(Universe::UniverseSetBelongingOperator value);
+
+        /**
+         * Records the identifier of a variable.
+         *
+         * @param value The identifier to record.
+         */
+        void write(const std::string &value);
+
+        /**
+         * Records a list of identifiers of variables.
+         *
+         * @param value The identifiers to record.
+         */
+        void write(const std::vector<std::string> &value);
+
+        /**
+         * Records a matrix of identifiers of variables.
+         *
+         * @param value The identifiers to record.
+         */
+        void write(const std::vector<std::vector<std::string>> &value);
+
+        /**
+         * Records a list of variables.
+         *
+         * @param value The reference of the list to record.
+         */
+        void write(Autis::VariableListReference value);
+
+        /**
+         * Records a matrix of variables.
+         *
+         * @param value The reference of the matrix to record.
+         */
+        void write(Autis::VariableMatrixReference value);
+
+        /**
+         * Records a list of integers.
+         *
+         * @param value The integers to record.
+         */
+        void write(const std::vector<int> &value);
+
+        /**
+         * Records a list of big integers.
+         *
+         * @param value The big integers to record.
+         */
+        void write(const std::vector<Universe::BigInteger> &value);
+
+        /**
+         * Records a matrix of big integers.
+         *
+         * @param value The big integers to record.
+         */
+        void write(const std::vector<std::vector<Universe::BigInteger>> &value);
+
+        /**
+         * Records a reference to an intension expression.
+         *
+         * @param value The reference to record.
+         */
+        void write(Autis::IntensionReference value);
+
+        /**
+         * Records a list of references to intension expressions.
+         *
+         * @param value The references to record.
+         */
+        void write(const std::vector<Autis::IntensionReference> &value);
+
+        /**
+         * Records a table of tuples.
+         * The table is not copied: it is shared with the caller.
+         *
+         * @param value The table to record.
+         */
+        void write(const std::shared_ptr<const Autis::TupleTable> &value);
+
+        /**
+         * Records a compressed table of tuples.
+         * The table is not copied: it is shared with the caller.
+         *
+         * @param value The table to record.
+         */
+        void write(const std::shared_ptr<const Autis::CompressedTupleTable> &value);
+
+        /**
+         * Records an operand.
+         *
+         * @param type The type of the operand.
+         * @param value The value of the operand.
+         */
+        void write(OperandType type, std::int64_t value);
+
+        /**
+         * Gives the index of an identifier, which is added to the arena of
+         * names if it has not been seen before.
+         *
+         * @param name The identifier to intern.
+         *
+         * @return The index of the identifier.
+         */
+        std::int64_t intern(const std::string &name);
+
+        /**
+         * Adds the handles of a list of identifiers to the arena of integers.
+         *
+         * @param list The identifiers to add.
+         *
+         * @return The index of the list in the arena of integers.
+         */
+        std::size_t internAll(const std::vector<std::string> &list);
+
+        /**
+         * Gives the node of an intension expression, which is recorded if no
+         * identical node has been recorded before.
+         *
+         * @param intensionOperator The operator of the node.
+         * @param value The value of the node, if it is a constant or a
+         *        variable.
+         * @param children The children of the node, if it is an operator.
+         *
+         * @return The reference of the node.
+         */
+        Autis::IntensionReference internNode(Autis::IntensionOperator intensionOperator, std::int64_t value,
+                std::span<const std::int64_t> children);
+
+    };
+
+}
+
+#endif
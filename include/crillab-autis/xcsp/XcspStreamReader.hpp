@@ -0,0 +1,284 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file XcspStreamReader.hpp
+ * @brief Defines a streaming reader for XCSP3 inputs, built on libxml2.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef AUTIS_XCSPSTREAMREADER_HPP
+#define AUTIS_XCSPSTREAMREADER_HPP
+
+#include <istream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "XCSP3CoreCallbacks.h"
+
+struct _xmlTextReader;
+
+namespace Autis {
+
+    /**
+     * The XcspStreamReader reads XCSP3 inputs with the xmlTextReader interface
+     * of libxml2, and notifies an XCSP3 callback each time a variable, a
+     * constraint or an objective has been read.
+     * Only the element being read is kept in memory: the constraints of a
+     * group are notified one argument list at a time, between the
+     * notifications of the beginning and of the end of the group.
+     * Instances and blocks are notified in the same way.
+     * The most common elements of XCSP3 are supported; reading any other
+     * element fails with an UnsupportedOperationException.
+     */
+    class XcspStreamReader {
+
+    private:
+
+        /**
+         * The Element is a small tree representing an element of the input,
+         * with its attributes, its text and its child elements.
+         */
+        struct Element;
+
+        /**
+         * The Section enumerates the sections of an XCSP3 instance in which
+         * elements are read.
+         */
+        enum class Section {
+            NONE,
+            VARIABLES,
+            CONSTRAINTS,
+            OBJECTIVES
+        };
+
+        /**
+         * The input stream to read from.
+         */
+        std::istream &input;
+
+        /**
+         * The callback to notify while reading the input.
+         */
+        XCSP3Core::XCSP3CoreCallbacks &callback;
+
+        /**
+         * The libxml2 reader used to read the input.
+         */
+        _xmlTextReader *reader;
+
+        /**
+         * The sizes of the arrays of variables that have been declared.
+         */
+        std::unordered_map<std::string, std::vector<int>> arraySizes;
+
+        /**
+         * The domain shared by the variables given to the callback, which
+         * only identifies variables by their names.
+         */
+        XCSP3Core::XDomainInteger domain;
+
+        /**
+         * The variables given to the callback for the element being read.
+         */
+        std::vector<std::unique_ptr<XCSP3Core::XVariable>> variables;
+
+        /**
+         * The expressions given to the callback for the element being read.
+         */
+        std::vector<std::unique_ptr<XCSP3Core::Tree>> trees;
+
+        /**
+         * Whether the tuples of the last extension constraint contain stars.
+         */
+        bool lastTuplesHaveStars;
+
+        /**
+         * Whether the input defines an optimization problem.
+         */
+        bool optimization;
+
+    public:
+
+        /**
+         * Creates a new XcspStreamReader.
+         *
+         * @param input The input stream to read from.
+         * @param callback The callback to notify while reading the input.
+         */
+        XcspStreamReader(std::istream &input, XCSP3Core::XCSP3CoreCallbacks &callback);
+
+        /**
+         * Reads the whole input, notifying the callback of what it defines.
+         *
+         * @throws ParseException If the input is not a well-formed XCSP3
+         *         instance.
+         * @throws UnsupportedOperationException If the input uses an element
+         *         that is not supported.
+         */
+        void read();
+
+        /**
+         * Checks whether the input defines an optimization problem.
+         * This method must be called after read().
+         *
+         * @return Whether the input defines an optimization problem.
+         */
+        [[nodiscard]] bool isOptimization() const;
+
+    private:
+
+        /**
+         * Moves to the next node of the input.
+         *
+         * @return Whether there is such a node.
+         *
+         * @throws ParseException If the input is not well-formed.
+         */
+        bool next();
+
+        /**
+         * Reads the element starting at the current node, along with all
+         * its descendants.
+         *
+         * @return The read element.
+         */
+        Element readElement();
+
+        /**
+         * Skips the element starting at the current node, along with all its
+         * descendants.
+         */
+        void skipElement();
+
+        /**
+         * Reads a group of constraints, notifying each of its instantiations
+         * as soon as its arguments have been read.
+         */
+        void readGroup();
+
+        /**
+         * Notifies the callback of the variables declared by an element.
+         *
+         * @param element The element declaring the variables.
+         */
+        void readVariables(const Element &element);
+
+        /**
+         * Notifies the callback of the constraint defined by an element.
+         *
+         * @param element The element defining the constraint.
+         * @param reuseTuples Whether the tuples of an extension constraint are
+         *        the same as those of the previous one.
+         */
+        void readConstraint(const Element &element, bool reuseTuples = false);
+
+        /**
+         * Notifies the callback of an extension constraint.
+         *
+         * @param id The identifier of the constraint.
+         * @param element The element defining the constraint.
+         * @param reuseTuples Whether the tuples are the same as those of the
+         *        previous extension constraint.
+         */
+        void readExtension(const std::string &id, const Element &element, bool reuseTuples);
+
+        /**
+         * Notifies the callback of a sum constraint.
+         *
+         * @param id The identifier of the constraint.
+         * @param element The element defining the constraint.
+         */
+        void readSum(const std::string &id, const Element &element);
+
+        /**
+         * Notifies the callback of an all-different constraint.
+         *
+         * @param id The identifier of the constraint.
+         * @param element The element defining the constraint.
+         */
+        void readAllDifferent(const std::string &id, const Element &element);
+
+        /**
+         * Notifies the callback of the objective function defined by an
+         * element.
+         *
+         * @param element The element defining the objective function.
+         */
+        void readObjective(const Element &element);
+
+        /**
+         * Gives the names of the variables appearing in a list, in which
+         * compact forms such as x[] or x[1..3][] are expanded.
+         *
+         * @param text The text of the list.
+         *
+         * @return The names of the variables.
+         */
+        std::vector<std::string> expand(const std::string &text) const;
+
+        /**
+         * Gives the variables appearing in a list, to be given to the callback.
+         *
+         * @param text The text of the list.
+         *
+         * @return The variables of the list.
+         */
+        std::vector<XCSP3Core::XVariable *> toVariables(const std::string &text);
+
+        /**
+         * Gives the variable with the given name, to be given to the callback.
+         *
+         * @param name The name of the variable.
+         *
+         * @return The variable.
+         */
+        XCSP3Core::XVariable *toVariable(const std::string &name);
+
+        /**
+         * Gives the expressions appearing in a list, to be given to the
+         * callback.
+         *
+         * @param text The text of the list.
+         *
+         * @return The expressions of the list.
+         */
+        std::vector<XCSP3Core::Tree *> toTrees(const std::string &text);
+
+        /**
+         * Gives the rows of a matrix of variables.
+         *
+         * @param text The text of the matrix.
+         *
+         * @return The variables of the matrix, row by row.
+         */
+        std::vector<std::vector<XCSP3Core::XVariable *>> toMatrix(const std::string &text);
+
+    };
+
+}
+
+#endif
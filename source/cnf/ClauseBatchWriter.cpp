@@ -0,0 +1,82 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file ClauseBatchWriter.cpp
+ * @brief Provides a sink filling batches of clauses into a queue.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <utility>
+
+#include "crillab-autis/cnf/ClauseBatchWriter.hpp"
+#include "crillab-autis/core/Pipeline.hpp"
+
+using namespace Autis;
+using namespace std;
+
+ClauseBatchWriter::ClauseBatchWriter(SpscQueue<ClauseBatch> &queue) :
+        queue(queue),
+        batch() {
+    // Nothing to do: everything is already initialized.
+}
+
+void ClauseBatchWriter::reserve(int nbVariables, int nbConstraints) {
+    // The size must be given before the clauses that follow.
+    flush();
+    batch.reserve(nbVariables, nbConstraints);
+}
+
+void ClauseBatchWriter::addClause(span<const int> clause) {
+    batch.addClause(clause);
+    if (batch.literals.size() >= BATCH_SIZE) {
+        flush();
+    }
+}
+
+void ClauseBatchWriter::addSoftClause(span<const int> clause, int64_t weight) {
+    batch.addSoftClause(clause, weight);
+    if (batch.literals.size() >= BATCH_SIZE) {
+        flush();
+    }
+}
+
+void ClauseBatchWriter::addClauses(span<const int32_t> literals, span<const size_t> offsets) {
+    batch.addClauses(literals, offsets);
+    if (batch.literals.size() >= BATCH_SIZE) {
+        flush();
+    }
+}
+
+void ClauseBatchWriter::flush() {
+    if ((!batch.reservation) && (batch.size() == 0)) {
+        // There is nothing to push.
+        return;
+    }
+
+    if (!queue.push(std::move(batch))) {
+        throw PipelineCancelledException();
+    }
+    batch = ClauseBatch();
+}
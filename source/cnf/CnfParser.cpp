@@ -28,71 +28,77 @@
  * @license This project is released under the GNU LGPL3 License.
  */
 
-#include <crillab-except/except.hpp>
+#include <vector>
 
+#include "crillab-autis/cnf/BasicCnfParser.hpp"
+#include "crillab-autis/cnf/ClauseBatch.hpp"
+#include "crillab-autis/cnf/ClauseBatchWriter.hpp"
 #include "crillab-autis/cnf/CnfParser.hpp"
+#include "crillab-autis/cnf/UniverseClauseSink.hpp"
+#include "crillab-autis/core/Instance.hpp"
+#include "crillab-autis/core/Pipeline.hpp"
 
 using namespace Autis;
-using namespace Except;
 using namespace std;
 using namespace Universe;
 
-CnfParser::CnfParser(Scanner &scanner, IUniverseSatSolver *solver) :
-        AbstractParser(scanner, solver) {
+CnfParser::CnfParser(Scanner &scanner, IUniverseSatSolver *solver, const ParserConfiguration &configuration) :
+        AbstractParser(scanner, solver),
+        satSolver(solver),
+        batchListener(dynamic_cast<IClauseBatchListener *>(solver)),
+        reservationListener(dynamic_cast<IReservationListener *>(solver)),
+        configuration(configuration) {
     // Nothing to do: everything already initialized.
 }
 
 void CnfParser::parse() {
-    vector<int> clause;
-    bool inClause = false;
-    int nbClausesRead = 0;
-
-    for (char next; scanner.look(next);) {
-        if (next == 'c') {
-            // This is a comment to skip.
-            scanner.skipLine();
+    if (batchListener != nullptr) {
+        // The clauses are given to the solver by batches.
+        UniverseClauseBatchSink sink(batchListener, reservationListener);
+        parse(sink);
 
-        } else if (next == 'p') {
-            // This is the problem description line.
-            scanner.read(numberOfVariables);
-            scanner.read(numberOfConstraints);
-            scanner.skipLine();
+    } else {
+        // The clauses are given to the solver one at a time.
+        UniverseClauseSink sink(satSolver, reservationListener);
+        parse(sink);
+    }
+}
 
-        } else {
-            // There is a literal to read.
-            int literal = 0;
-            scanner.read(literal);
+void CnfParser::parse(Instance &instance) {
+    parse(instance.getClauses());
+}
 
-            if (!inClause) {
-                // This is a new clause to read.
-                clause.clear();
-                inClause = true;
-                nbClausesRead++;
-            }
+template <typename Sink>
+void CnfParser::parse(Sink &sink) {
+    if (configuration.isPipelined()) {
+        // The input is read on another thread.
+        parseInPipeline(sink);
+        return;
+    }
 
-            if (literal == 0) {
-                // This is the end of a clause.
-                getConcreteSolver()->addClause(clause);
-                inClause = false;
+    BasicCnfParser<Sink> parser(scanner, sink, configuration);
+    parser.parse();
+    numberOfVariables = parser.getNumberOfVariables();
+    numberOfConstraints = parser.getNumberOfConstraints();
+}
 
-            } else {
-                // The literal is added if and only if it is correct.
-                clause.push_back(checkLiteral(literal));
-            }
-        }
-    }
+template <typename Sink>
+void CnfParser::parseInPipeline(Sink &sink) {
+    vector<int> clause;
 
-    if (inClause) {
-        // The last clause has not been added.
-        getConcreteSolver()->addClause(clause);
-    }
+    runParserPipeline<ClauseBatch, ClauseBatchWriter>(PIPELINE_CAPACITY, [this](ClauseBatchWriter &writer) {
+        // Reading the input and pushing the clauses by batches.
+        BasicCnfParser<ClauseBatchWriter> parser(scanner, writer, configuration);
+        parser.parse();
+        numberOfVariables = parser.getNumberOfVariables();
+        numberOfConstraints = parser.getNumberOfConstraints();
 
-    if (nbClausesRead != numberOfConstraints) {
-        // The number of read clauses is not the expected one.
-        throw ParseException("Unexpected number of clauses");
-    }
+    }, [&sink, &clause](ClauseBatch &batch) {
+        // Giving the clauses to the solver, in the order of the input.
+        batch.replay(sink, clause);
+    });
 }
 
 IUniverseSatSolver *CnfParser::getConcreteSolver() {
-    return dynamic_cast<IUniverseSatSolver *>(AbstractParser::getConcreteSolver());
+    return satSolver;
 }
@@ -0,0 +1,109 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file WcnfParser.cpp
+ * @brief Defines the parser for parsing MaxSAT problems (in the WCNF format).
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <vector>
+
+#include "crillab-autis/cnf/BasicWcnfParser.hpp"
+#include "crillab-autis/cnf/ClauseBatch.hpp"
+#include "crillab-autis/cnf/ClauseBatchWriter.hpp"
+#include "crillab-autis/cnf/UniverseClauseSink.hpp"
+#include "crillab-autis/cnf/WcnfParser.hpp"
+#include "crillab-autis/core/Instance.hpp"
+#include "crillab-autis/core/Pipeline.hpp"
+
+using namespace Autis;
+using namespace std;
+using namespace Universe;
+
+WcnfParser::WcnfParser(Scanner &scanner, IUniverseSatSolver *solver, const ParserConfiguration &configuration) :
+        AbstractParser(scanner, solver),
+        satSolver(solver),
+        batchListener(dynamic_cast<IClauseBatchListener *>(solver)),
+        reservationListener(dynamic_cast<IReservationListener *>(solver)),
+        softClauseListener(dynamic_cast<ISoftClauseListener *>(solver)),
+        configuration(configuration) {
+    // Nothing to do: everything already initialized.
+}
+
+void WcnfParser::parse() {
+    if (batchListener != nullptr) {
+        // The clauses are given to the solver by batches.
+        UniverseClauseBatchSink sink(batchListener, reservationListener, softClauseListener);
+        parse(sink);
+
+    } else {
+        // The clauses are given to the solver one at a time.
+        UniverseClauseSink sink(satSolver, reservationListener, softClauseListener);
+        parse(sink);
+    }
+}
+
+void WcnfParser::parse(Instance &instance) {
+    parse(instance.getClauses());
+}
+
+template <typename Sink>
+void WcnfParser::parse(Sink &sink) {
+    if (configuration.isPipelined()) {
+        // The input is read on another thread.
+        parseInPipeline(sink);
+        return;
+    }
+
+    BasicWcnfParser<Sink> parser(scanner, sink);
+    parser.parse();
+    numberOfVariables = parser.getNumberOfVariables();
+    numberOfConstraints = parser.getNumberOfConstraints();
+}
+
+template <typename Sink>
+void WcnfParser::parseInPipeline(Sink &sink) {
+    vector<int> clause;
+
+    runParserPipeline<ClauseBatch, ClauseBatchWriter>(PIPELINE_CAPACITY, [this](ClauseBatchWriter &writer) {
+        // Reading the input and pushing the clauses by batches.
+        BasicWcnfParser<ClauseBatchWriter> parser(scanner, writer);
+        parser.parse();
+        numberOfVariables = parser.getNumberOfVariables();
+        numberOfConstraints = parser.getNumberOfConstraints();
+
+    }, [&sink, &clause](ClauseBatch &batch) {
+        // Giving the clauses to the solver, in the order of the input.
+        batch.replay(sink, clause);
+    });
+}
+
+IUniverseSatSolver *WcnfParser::getConcreteSolver() {
+    return satSolver;
+}
+
+bool WcnfParser::isOptimization() {
+    return true;
+}
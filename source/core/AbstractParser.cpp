@@ -28,6 +28,9 @@
  * @license This project is released under the GNU LGPL3 License.
  */
 
+#include <climits>
+#include <cstdlib>
+
 #include <crillab-except/except.hpp>
 
 #include "crillab-autis/core/AbstractParser.hpp"
@@ -46,8 +49,8 @@ AbstractParser::AbstractParser(Scanner &scanner, IUniverseSolver *solver) :
 }
 
 int AbstractParser::checkLiteral(int literal) const {
-    int variable = abs(literal);
-    if ((variable == 0) || (variable > numberOfVariables)) {
+    // The magnitude of INT_MIN does not fit in an int, so it is never a variable.
+    if ((literal == 0) || (literal == INT_MIN) || (abs(literal) > numberOfVariables)) {
         throw ParseException("An invalid literal has been read");
     }
     return literal;
@@ -0,0 +1,101 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file Bzip2StreamBuffer.cpp
+ * @brief Provides a stream buffer decompressing bzip2 data on the fly.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifdef AUTIS_WITH_BZIP2
+
+#include <crillab-except/except.hpp>
+
+#include "crillab-autis/core/Bzip2StreamBuffer.hpp"
+
+using namespace Autis;
+using namespace Except;
+using namespace std;
+
+Bzip2StreamBuffer::Bzip2StreamBuffer(streambuf &source) :
+        DecompressionStreamBuffer(source),
+        stream(),
+        endOfStream(false) {
+    if (BZ2_bzDecompressInit(&stream, 0, 0) != BZ_OK) {
+        throw ParseException("Could not initialize bzip2 decompression");
+    }
+}
+
+Bzip2StreamBuffer::~Bzip2StreamBuffer() {
+    BZ2_bzDecompressEnd(&stream);
+}
+
+size_t Bzip2StreamBuffer::decompress(char *data, size_t capacity) {
+    stream.next_out = data;
+    stream.avail_out = static_cast<unsigned int>(capacity);
+
+    while (stream.avail_out == capacity) {
+        if (stream.avail_in == 0) {
+            // All the compressed data read so far has been consumed.
+            const char *compressed;
+            size_t size;
+            if (!readCompressed(compressed, size)) {
+                if (!endOfStream) {
+                    throw ParseException("Unexpected end of bzip2 input");
+                }
+                break;
+            }
+            stream.next_in = const_cast<char *>(compressed);
+            stream.avail_in = static_cast<unsigned int>(size);
+        }
+
+        if (endOfStream) {
+            // Another stream follows the one that has been decompressed.
+            // The decoder has to be restarted, preserving the pending input.
+            bz_stream pending = stream;
+            BZ2_bzDecompressEnd(&stream);
+            stream = bz_stream();
+            if (BZ2_bzDecompressInit(&stream, 0, 0) != BZ_OK) {
+                throw ParseException("Could not initialize bzip2 decompression");
+            }
+            stream.next_in = pending.next_in;
+            stream.avail_in = pending.avail_in;
+            stream.next_out = pending.next_out;
+            stream.avail_out = pending.avail_out;
+            endOfStream = false;
+        }
+
+        int status = BZ2_bzDecompress(&stream);
+        if (status == BZ_STREAM_END) {
+            endOfStream = true;
+
+        } else if (status != BZ_OK) {
+            throw ParseException("Corrupted bzip2 input");
+        }
+    }
+
+    return capacity - stream.avail_out;
+}
+
+#endif
@@ -0,0 +1,250 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file ContentHash.cpp
+ * @brief Computes a fingerprint of the content of an input.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include <crillab-except/except.hpp>
+
+#include "crillab-autis/core/ContentHash.hpp"
+#include "crillab-autis/core/MappedFile.hpp"
+
+using namespace Autis;
+using namespace Except;
+using namespace std;
+
+namespace {
+
+    /**
+     * The primes used by the XXH64 algorithm.
+     */
+    constexpr uint64_t PRIME1 = 0x9E3779B185EBCA87ULL;
+    constexpr uint64_t PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+    constexpr uint64_t PRIME3 = 0x165667B19E3779F9ULL;
+    constexpr uint64_t PRIME4 = 0x85EBCA77C2B2AE63ULL;
+    constexpr uint64_t PRIME5 = 0x27D4EB2F165667C5ULL;
+
+    /**
+     * Rotates the bits of a 64-bit word to the left.
+     *
+     * @param value The word to rotate.
+     * @param shift The number of bits to rotate.
+     *
+     * @return The rotated word.
+     */
+    inline uint64_t rotate(uint64_t value, int shift) {
+        return (value << shift) | (value >> (64 - shift));
+    }
+
+    /**
+     * Reads a little-endian 64-bit word, whatever the endianness of the host.
+     *
+     * @param data The bytes to read.
+     *
+     * @return The read word.
+     */
+    inline uint64_t load64(const unsigned char *data) {
+        uint64_t value = 0;
+        for (int i = 7; i >= 0; i--) {
+            value = (value << 8) | data[i];
+        }
+        return value;
+    }
+
+    /**
+     * Reads a little-endian 32-bit word, whatever the endianness of the host.
+     *
+     * @param data The bytes to read.
+     *
+     * @return The read word.
+     */
+    inline uint64_t load32(const unsigned char *data) {
+        uint64_t value = 0;
+        for (int i = 3; i >= 0; i--) {
+            value = (value << 8) | data[i];
+        }
+        return value;
+    }
+
+    /**
+     * Mixes a 64-bit word into an accumulator.
+     *
+     * @param accumulator The accumulator to update.
+     * @param input The word to mix.
+     *
+     * @return The updated accumulator.
+     */
+    inline uint64_t round(uint64_t accumulator, uint64_t input) {
+        accumulator += input * PRIME2;
+        accumulator = rotate(accumulator, 31);
+        return accumulator * PRIME1;
+    }
+
+    /**
+     * Merges an accumulator into the final hash.
+     *
+     * @param hash The hash to update.
+     * @param accumulator The accumulator to merge.
+     *
+     * @return The updated hash.
+     */
+    inline uint64_t merge(uint64_t hash, uint64_t accumulator) {
+        hash ^= round(0, accumulator);
+        return (hash * PRIME1) + PRIME4;
+    }
+
+    /**
+     * Processes a complete stripe of bytes.
+     *
+     * @param accumulators The accumulators to update.
+     * @param stripe The bytes of the stripe.
+     */
+    inline void consume(uint64_t *accumulators, const unsigned char *stripe) {
+        accumulators[0] = round(accumulators[0], load64(stripe));
+        accumulators[1] = round(accumulators[1], load64(stripe + 8));
+        accumulators[2] = round(accumulators[2], load64(stripe + 16));
+        accumulators[3] = round(accumulators[3], load64(stripe + 24));
+    }
+
+}
+
+ContentHash::ContentHash() :
+        accumulators{PRIME1 + PRIME2, PRIME2, 0, 0 - PRIME1},
+        pending(),
+        nbPending(0),
+        length(0) {
+    // Nothing to do: everything is already initialized.
+}
+
+void ContentHash::update(const char *data, size_t size) {
+    auto bytes = reinterpret_cast<const unsigned char *>(data);
+    auto end = bytes + size;
+    length += size;
+
+    if (nbPending > 0) {
+        // Completing the pending stripe first.
+        auto nbCopied = min(size, STRIPE_SIZE - nbPending);
+        memcpy(pending + nbPending, bytes, nbCopied);
+        nbPending += nbCopied;
+        bytes += nbCopied;
+        if (nbPending < STRIPE_SIZE) {
+            return;
+        }
+        consume(accumulators, pending);
+        nbPending = 0;
+    }
+
+    // Processing the complete stripes directly from the input.
+    for (; static_cast<size_t>(end - bytes) >= STRIPE_SIZE; bytes += STRIPE_SIZE) {
+        consume(accumulators, bytes);
+    }
+
+    // Keeping the remaining bytes for later.
+    nbPending = static_cast<size_t>(end - bytes);
+    memcpy(pending, bytes, nbPending);
+}
+
+uint64_t ContentHash::digest() const {
+    uint64_t hash;
+    if (length >= STRIPE_SIZE) {
+        hash = rotate(accumulators[0], 1) + rotate(accumulators[1], 7)
+                + rotate(accumulators[2], 12) + rotate(accumulators[3], 18);
+        for (auto accumulator : accumulators) {
+            hash = merge(hash, accumulator);
+        }
+    } else {
+        hash = PRIME5;
+    }
+    hash += length;
+
+    // Mixing the bytes of the incomplete stripe.
+    const unsigned char *bytes = pending;
+    const unsigned char *end = pending + nbPending;
+    for (; end - bytes >= 8; bytes += 8) {
+        hash ^= round(0, load64(bytes));
+        hash = (rotate(hash, 27) * PRIME1) + PRIME4;
+    }
+    if (end - bytes >= 4) {
+        hash ^= load32(bytes) * PRIME1;
+        hash = (rotate(hash, 23) * PRIME2) + PRIME3;
+        bytes += 4;
+    }
+    for (; bytes < end; bytes++) {
+        hash ^= (*bytes) * PRIME5;
+        hash = rotate(hash, 11) * PRIME1;
+    }
+
+    // Making sure that every bit of the input affects every bit of the hash.
+    hash ^= hash >> 33;
+    hash *= PRIME2;
+    hash ^= hash >> 29;
+    hash *= PRIME3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+uint64_t ContentHash::of(const char *data, size_t size) {
+    ContentHash hash;
+    hash.update(data, size);
+    return hash.digest();
+}
+
+uint64_t ContentHash::ofFile(const string &path) {
+    MappedFile file;
+    if (file.map(path)) {
+        // The file is a regular file: it is hashed directly from memory.
+        return of(file.data(), file.size());
+    }
+
+    ifstream stream(path, ios::binary);
+    if (!stream) {
+        throw ParseException("Could not open " + path);
+    }
+
+    // The file is hashed block by block.
+    ContentHash hash;
+    char block[1 << 16];
+    streamsize nbRead;
+    while ((nbRead = stream.rdbuf()->sgetn(block, sizeof(block))) > 0) {
+        hash.update(block, static_cast<size_t>(nbRead));
+    }
+    return hash.digest();
+}
+
+string ContentHash::toString(uint64_t fingerprint) {
+    static constexpr char DIGITS[] = "0123456789abcdef";
+    string representation(16, '0');
+    for (size_t i = representation.size(); i > 0; i--) {
+        representation[i - 1] = DIGITS[fingerprint & 0xF];
+        fingerprint >>= 4;
+    }
+    return representation;
+}
@@ -0,0 +1,144 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file DecompressionStreamBuffer.cpp
+ * @brief Provides the base class of the stream buffers decompressing their input on the fly.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <cstring>
+
+#include <crillab-except/except.hpp>
+
+#include "crillab-autis/core/Bzip2StreamBuffer.hpp"
+#include "crillab-autis/core/DecompressionStreamBuffer.hpp"
+#include "crillab-autis/core/GzipStreamBuffer.hpp"
+#include "crillab-autis/core/XzStreamBuffer.hpp"
+#include "crillab-autis/core/ZstdStreamBuffer.hpp"
+
+using namespace Autis;
+using namespace Except;
+using namespace std;
+
+namespace {
+
+    /**
+     * Checks whether a header starts with the given magic number.
+     *
+     * @param header The header to check.
+     * @param size The size of the header.
+     * @param magic The magic number to look for.
+     * @param length The length of the magic number.
+     *
+     * @return Whether the header starts with the magic number.
+     */
+    bool startsWith(const char *header, size_t size, const char *magic, size_t length) {
+        return (size >= length) && (memcmp(header, magic, length) == 0);
+    }
+
+}
+
+CompressionFormat DecompressionStreamBuffer::detect(const char *header, size_t size) {
+    if (startsWith(header, size, "\x1F\x8B", 2)) {
+        return CompressionFormat::GZIP;
+    }
+
+    if (startsWith(header, size, "\xFD" "7zXZ\x00", 6)) {
+        return CompressionFormat::XZ;
+    }
+
+    if (startsWith(header, size, "BZh", 3)) {
+        return CompressionFormat::BZIP2;
+    }
+
+    if (startsWith(header, size, "\x28\xB5\x2F\xFD", 4)) {
+        return CompressionFormat::ZSTD;
+    }
+
+    return CompressionFormat::NONE;
+}
+
+unique_ptr<DecompressionStreamBuffer> DecompressionStreamBuffer::create(CompressionFormat format, streambuf &source) {
+    switch (format) {
+        case CompressionFormat::GZIP:
+#ifdef AUTIS_WITH_ZLIB
+            return make_unique<GzipStreamBuffer>(source);
+#else
+            throw UnsupportedOperationException("gzip compressed inputs are not supported");
+#endif
+
+        case CompressionFormat::XZ:
+#ifdef AUTIS_WITH_LZMA
+            return make_unique<XzStreamBuffer>(source);
+#else
+            throw UnsupportedOperationException("xz compressed inputs are not supported");
+#endif
+
+        case CompressionFormat::BZIP2:
+#ifdef AUTIS_WITH_BZIP2
+            return make_unique<Bzip2StreamBuffer>(source);
+#else
+            throw UnsupportedOperationException("bzip2 compressed inputs are not supported");
+#endif
+
+        case CompressionFormat::ZSTD:
+#ifdef AUTIS_WITH_ZSTD
+            return make_unique<ZstdStreamBuffer>(source);
+#else
+            throw UnsupportedOperationException("zstd compressed inputs are not supported");
+#endif
+
+        default:
+            throw IllegalArgumentException("Input is not compressed");
+    }
+}
+
+DecompressionStreamBuffer::DecompressionStreamBuffer(streambuf &source) :
+        source(source),
+        compressed(BUFFER_SIZE),
+        decompressed(BUFFER_SIZE) {
+    // Nothing to do: the get area is empty until the first underflow.
+}
+
+bool DecompressionStreamBuffer::readCompressed(const char *&data, size_t &size) {
+    auto nbRead = source.sgetn(compressed.data(), static_cast<streamsize>(compressed.size()));
+    data = compressed.data();
+    size = (nbRead > 0) ? static_cast<size_t>(nbRead) : 0;
+    return size > 0;
+}
+
+streambuf::int_type DecompressionStreamBuffer::underflow() {
+    if (gptr() < egptr()) {
+        return traits_type::to_int_type(*gptr());
+    }
+
+    size_t size = decompress(decompressed.data(), decompressed.size());
+    if (size == 0) {
+        return traits_type::eof();
+    }
+
+    setg(decompressed.data(), decompressed.data(), decompressed.data() + size);
+    return traits_type::to_int_type(*gptr());
+}
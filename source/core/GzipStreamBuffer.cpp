@@ -0,0 +1,92 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file GzipStreamBuffer.cpp
+ * @brief Provides a stream buffer decompressing gzip data on the fly.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifdef AUTIS_WITH_ZLIB
+
+#include <crillab-except/except.hpp>
+
+#include "crillab-autis/core/GzipStreamBuffer.hpp"
+
+using namespace Autis;
+using namespace Except;
+using namespace std;
+
+GzipStreamBuffer::GzipStreamBuffer(streambuf &source) :
+        DecompressionStreamBuffer(source),
+        stream(),
+        endOfStream(false) {
+    // Adding 32 to the window size enables the detection of gzip and zlib headers.
+    if (inflateInit2(&stream, 15 + 32) != Z_OK) {
+        throw ParseException("Could not initialize gzip decompression");
+    }
+}
+
+GzipStreamBuffer::~GzipStreamBuffer() {
+    inflateEnd(&stream);
+}
+
+size_t GzipStreamBuffer::decompress(char *data, size_t capacity) {
+    stream.next_out = reinterpret_cast<Bytef *>(data);
+    stream.avail_out = static_cast<uInt>(capacity);
+
+    while (stream.avail_out == capacity) {
+        if (stream.avail_in == 0) {
+            // All the compressed data read so far has been consumed.
+            const char *compressed;
+            size_t size;
+            if (!readCompressed(compressed, size)) {
+                if (!endOfStream) {
+                    throw ParseException("Unexpected end of gzip input");
+                }
+                break;
+            }
+            stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(compressed));
+            stream.avail_in = static_cast<uInt>(size);
+        }
+
+        if (endOfStream) {
+            // Another member follows the one that has been decompressed.
+            inflateReset(&stream);
+            endOfStream = false;
+        }
+
+        int status = inflate(&stream, Z_NO_FLUSH);
+        if (status == Z_STREAM_END) {
+            endOfStream = true;
+
+        } else if ((status != Z_OK) && (status != Z_BUF_ERROR)) {
+            throw ParseException("Corrupted gzip input");
+        }
+    }
+
+    return capacity - stream.avail_out;
+}
+
+#endif
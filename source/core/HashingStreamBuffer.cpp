@@ -0,0 +1,64 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file HashingStreamBuffer.cpp
+ * @brief Computes the fingerprint of a stream while it is being read.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include "crillab-autis/core/HashingStreamBuffer.hpp"
+
+using namespace Autis;
+using namespace std;
+
+HashingStreamBuffer::HashingStreamBuffer(streambuf &source) :
+        source(source),
+        block(BLOCK_SIZE),
+        hash() {
+    setg(block.data(), block.data(), block.data());
+}
+
+uint64_t HashingStreamBuffer::finish() {
+    // The bytes of the current block have already been hashed.
+    while (underflow() != traits_type::eof()) {
+        setg(eback(), egptr(), egptr());
+    }
+    return hash.digest();
+}
+
+streambuf::int_type HashingStreamBuffer::underflow() {
+    if (gptr() < egptr()) {
+        return traits_type::to_int_type(*gptr());
+    }
+
+    auto nbRead = source.sgetn(block.data(), static_cast<streamsize>(block.size()));
+    if (nbRead <= 0) {
+        return traits_type::eof();
+    }
+
+    hash.update(block.data(), static_cast<size_t>(nbRead));
+    setg(block.data(), block.data(), block.data() + nbRead);
+    return traits_type::to_int_type(*gptr());
+}
@@ -0,0 +1,210 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file Instance.cpp
+ * @brief Implements the storage of problems in a solver-neutral form.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include <crillab-except/except.hpp>
+#include <crillab-universe/csp/IUniverseCspSolver.hpp>
+#include <crillab-universe/csp/UniverseJavaCspSolver.hpp>
+#include <crillab-universe/csp/intension/UniverseIntensionConstraintFactory.hpp>
+#include <crillab-universe/csp/intension/UniverseJavaIntensionConstraintFactory.hpp>
+#include <crillab-universe/pb/IUniversePseudoBooleanSolver.hpp>
+#include <crillab-universe/sat/IUniverseSatSolver.hpp>
+
+#include "crillab-autis/cnf/IClauseBatchListener.hpp"
+#include "crillab-autis/cnf/ISoftClauseListener.hpp"
+#include "crillab-autis/cnf/UniverseClauseSink.hpp"
+#include "crillab-autis/core/IReservationListener.hpp"
+#include "crillab-autis/core/Instance.hpp"
+#include "crillab-autis/pb/IObjectiveListener.hpp"
+#include "crillab-autis/pb/ISoftConstraintListener.hpp"
+#include "crillab-autis/pb/UniversePseudoBooleanSink.hpp"
+
+using namespace Autis;
+using namespace Except;
+using namespace std;
+using namespace Universe;
+
+namespace {
+
+    /**
+     * Checks whether a solver is implemented in Java, and must thus only be
+     * used from threads attached to the JVM.
+     *
+     * @param solver The solver to check.
+     *
+     * @return Whether the solver is a Java solver.
+     */
+    bool isJavaSolver(IUniverseSolver &solver) {
+        return dynamic_cast<UniverseJavaCspSolver *>(&solver) != nullptr;
+    }
+
+}
+
+Instance::Instance(InstanceType type) :
+        type(type),
+        clauses(),
+        constraints(),
+        cspInstance() {
+    // Nothing to do: everything is already initialized.
+}
+
+InstanceType Instance::getType() const {
+    return type;
+}
+
+ClauseBatch &Instance::getClauses() {
+    return clauses;
+}
+
+const ClauseBatch &Instance::getClauses() const {
+    return clauses;
+}
+
+ConstraintBatch &Instance::getConstraints() {
+    return constraints;
+}
+
+const ConstraintBatch &Instance::getConstraints() const {
+    return constraints;
+}
+
+XcspInstance &Instance::getCspInstance() {
+    return cspInstance;
+}
+
+const XcspInstance &Instance::getCspInstance() const {
+    return cspInstance;
+}
+
+void Instance::replay(IUniverseSolver &solver) const {
+    auto reservationListener = dynamic_cast<IReservationListener *>(&solver);
+
+    if (type == InstanceType::SAT) {
+        auto satSolver = dynamic_cast<IUniverseSatSolver *>(&solver);
+        if (satSolver == nullptr) {
+            throw IllegalArgumentException("The solver cannot solve SAT problems");
+        }
+
+        vector<int> clause;
+        auto batchListener = dynamic_cast<IClauseBatchListener *>(&solver);
+        auto softClauseListener = dynamic_cast<ISoftClauseListener *>(&solver);
+        if (batchListener != nullptr) {
+            // The clauses are given to the solver as a single batch.
+            UniverseClauseBatchSink sink(batchListener, reservationListener, softClauseListener);
+            clauses.replay(sink, clause);
+
+        } else {
+            // The clauses are given to the solver one at a time.
+            UniverseClauseSink sink(satSolver, reservationListener, softClauseListener);
+            clauses.replay(sink, clause);
+        }
+
+    } else if (type == InstanceType::PSEUDO_BOOLEAN) {
+        auto pbSolver = dynamic_cast<IUniversePseudoBooleanSolver *>(&solver);
+        if (pbSolver == nullptr) {
+            throw IllegalArgumentException("The solver cannot solve pseudo-Boolean problems");
+        }
+
+        vector<int> literals;
+        vector<BigInteger> coefficients;
+        UniversePseudoBooleanSink sink(pbSolver, reservationListener, dynamic_cast<IObjectiveListener *>(&solver),
+                dynamic_cast<ISoftConstraintListener *>(&solver));
+        constraints.replay(sink, literals, coefficients);
+
+    } else {
+        auto cspSolver = dynamic_cast<IUniverseCspSolver *>(&solver);
+        if (cspSolver == nullptr) {
+            throw IllegalArgumentException("The solver cannot solve CSP problems");
+        }
+
+        if (!isJavaSolver(*cspSolver)) {
+            // The solver is not a Java solver: using native intension constraints.
+            UniverseIntensionConstraintFactory intensionFactory;
+            cspInstance.replay(*cspSolver, intensionFactory);
+
+        } else {
+            // The solver is a Java solver: using Java intension constraints.
+            UniverseJavaIntensionConstraintFactory intensionFactory;
+            cspInstance.replay(*cspSolver, intensionFactory);
+        }
+    }
+}
+
+void Instance::replay(const vector<IUniverseSolver *> &solvers) const {
+    // Java solvers must be fed on the calling thread, which is attached to the JVM.
+    vector<size_t> local;
+    vector<size_t> threaded;
+    for (size_t i = 0; i < solvers.size(); i++) {
+        if (isJavaSolver(*solvers[i])) {
+            local.push_back(i);
+        } else {
+            threaded.push_back(i);
+        }
+    }
+
+    if (local.empty() && (!threaded.empty())) {
+        // There is no need for another thread to feed the last solver.
+        local.push_back(threaded.back());
+        threaded.pop_back();
+    }
+
+    // The errors must outlive the threads, which are joined when destroyed.
+    vector<exception_ptr> errors(solvers.size());
+    {
+        vector<jthread> threads;
+        threads.reserve(threaded.size());
+        for (auto i : threaded) {
+            threads.emplace_back([this, &solvers, &errors, i]() {
+                try {
+                    replay(*solvers[i]);
+                } catch (...) {
+                    errors[i] = current_exception();
+                }
+            });
+        }
+
+        for (auto i : local) {
+            try {
+                replay(*solvers[i]);
+            } catch (...) {
+                errors[i] = current_exception();
+            }
+        }
+    }
+
+    for (auto &error : errors) {
+        if (error) {
+            rethrow_exception(error);
+        }
+    }
+}
@@ -0,0 +1,364 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file IntegerTokenizer.cpp
+ * @brief Provides a vectorized tokenizer for runs of integers separated by blanks.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#include "crillab-autis/core/IntegerTokenizer.hpp"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#define AUTIS_X86_TOKENIZER
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define AUTIS_TARGET(isa)
+#else
+#define AUTIS_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+using namespace Autis;
+using namespace std;
+
+namespace {
+
+    /**
+     * The number of characters classified at once.
+     */
+    constexpr ptrdiff_t WINDOW_SIZE = 64;
+
+    /**
+     * The maximum number of digits of a number read by the tokenizer.
+     * Any number having at most that many digits fits in an int.
+     */
+    constexpr unsigned MAX_DIGITS = 9;
+
+    /**
+     * The type of the functions computing, for each of the 64 characters of
+     * a window, whether it is a digit, a blank or a sign.
+     */
+    using Classifier = void (*)(const char *, uint64_t &, uint64_t &, uint64_t &);
+
+    /**
+     * Classifies the characters of a window without vector instructions.
+     *
+     * @param window The first character of the window.
+     * @param digits The mask of the digits in the window.
+     * @param blanks The mask of the blank characters in the window.
+     * @param signs The mask of the sign characters in the window.
+     */
+    void classifyScalar(const char *window, uint64_t &digits, uint64_t &blanks, uint64_t &signs) {
+        digits = blanks = signs = 0;
+        for (unsigned i = 0; i < WINDOW_SIZE; i++) {
+            auto c = static_cast<unsigned char>(window[i]);
+            auto bit = uint64_t(1) << i;
+            digits |= (static_cast<unsigned char>(c - '0') < 10) ? bit : 0;
+            blanks |= ((c == ' ') || (static_cast<unsigned char>(c - '\t') < 5)) ? bit : 0;
+            signs |= ((c == '-') || (c == '+')) ? bit : 0;
+        }
+    }
+
+#ifdef AUTIS_X86_TOKENIZER
+
+    /**
+     * Classifies the characters of a window using SSE instructions.
+     *
+     * @param window The first character of the window.
+     * @param digits The mask of the digits in the window.
+     * @param blanks The mask of the blank characters in the window.
+     * @param signs The mask of the sign characters in the window.
+     */
+    AUTIS_TARGET("sse4.2")
+    void classifySse(const char *window, uint64_t &digits, uint64_t &blanks, uint64_t &signs) {
+        const __m128i zero = _mm_set1_epi8('0');
+        const __m128i nine = _mm_set1_epi8(9);
+        const __m128i tab = _mm_set1_epi8('\t');
+        const __m128i four = _mm_set1_epi8(4);
+        const __m128i space = _mm_set1_epi8(' ');
+        const __m128i minus = _mm_set1_epi8('-');
+        const __m128i plus = _mm_set1_epi8('+');
+
+        digits = blanks = signs = 0;
+        for (unsigned i = 0; i < WINDOW_SIZE; i += 16) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(window + i));
+
+            // A character is a digit iff (c - '0') <= 9 as an unsigned byte.
+            __m128i d = _mm_sub_epi8(chunk, zero);
+            __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(d, nine), d);
+
+            // A character is blank iff it is a space or (c - '\t') <= 4.
+            __m128i t = _mm_sub_epi8(chunk, tab);
+            __m128i isBlank = _mm_or_si128(_mm_cmpeq_epi8(_mm_min_epu8(t, four), t), _mm_cmpeq_epi8(chunk, space));
+
+            __m128i isSign = _mm_or_si128(_mm_cmpeq_epi8(chunk, minus), _mm_cmpeq_epi8(chunk, plus));
+
+            digits |= uint64_t(static_cast<uint16_t>(_mm_movemask_epi8(isDigit))) << i;
+            blanks |= uint64_t(static_cast<uint16_t>(_mm_movemask_epi8(isBlank))) << i;
+            signs |= uint64_t(static_cast<uint16_t>(_mm_movemask_epi8(isSign))) << i;
+        }
+    }
+
+    /**
+     * Classifies the characters of a window using AVX2 instructions.
+     *
+     * @param window The first character of the window.
+     * @param digits The mask of the digits in the window.
+     * @param blanks The mask of the blank characters in the window.
+     * @param signs The mask of the sign characters in the window.
+     */
+    AUTIS_TARGET("avx2")
+    void classifyAvx2(const char *window, uint64_t &digits, uint64_t &blanks, uint64_t &signs) {
+        const __m256i zero = _mm256_set1_epi8('0');
+        const __m256i nine = _mm256_set1_epi8(9);
+        const __m256i tab = _mm256_set1_epi8('\t');
+        const __m256i four = _mm256_set1_epi8(4);
+        const __m256i space = _mm256_set1_epi8(' ');
+        const __m256i minus = _mm256_set1_epi8('-');
+        const __m256i plus = _mm256_set1_epi8('+');
+
+        digits = blanks = signs = 0;
+        for (unsigned i = 0; i < WINDOW_SIZE; i += 32) {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(window + i));
+
+            __m256i d = _mm256_sub_epi8(chunk, zero);
+            __m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(d, nine), d);
+
+            __m256i t = _mm256_sub_epi8(chunk, tab);
+            __m256i isBlank = _mm256_or_si256(
+                    _mm256_cmpeq_epi8(_mm256_min_epu8(t, four), t), _mm256_cmpeq_epi8(chunk, space));
+
+            __m256i isSign = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, minus), _mm256_cmpeq_epi8(chunk, plus));
+
+            digits |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(isDigit))) << i;
+            blanks |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(isBlank))) << i;
+            signs |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(isSign))) << i;
+        }
+    }
+
+    /**
+     * Checks whether the CPU supports the given instruction set.
+     *
+     * @param avx2 Whether to check for AVX2 (instead of SSE4.2).
+     *
+     * @return Whether the instruction set is supported.
+     */
+    bool supports(bool avx2) {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 0);
+        int maxLeaf = info[0];
+        if (avx2) {
+            if (maxLeaf < 7) {
+                return false;
+            }
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+        }
+        __cpuid(info, 1);
+        return (info[2] & (1 << 20)) != 0;
+#else
+        __builtin_cpu_init();
+        return avx2 ? __builtin_cpu_supports("avx2") : __builtin_cpu_supports("sse4.2");
+#endif
+    }
+
+#endif
+
+    /**
+     * Gives the position of the first bit set in the mask, starting from the
+     * given position.
+     *
+     * @param mask The mask to look into.
+     * @param from The position from which to look (which must be below 64).
+     *
+     * @return The position of the bit, or 64 if there is none.
+     */
+    inline unsigned nextSet(uint64_t mask, unsigned from) {
+        uint64_t shifted = mask >> from;
+        return (shifted == 0) ? WINDOW_SIZE : (from + static_cast<unsigned>(countr_zero(shifted)));
+    }
+
+    /**
+     * Converts a sequence of digits into the number it represents.
+     *
+     * @param digits The first digit of the number.
+     * @param length The number of digits (between 1 and 9).
+     * @param end The character right after the last character that may be read.
+     *
+     * @return The value of the number.
+     */
+    inline int convert(const char *digits, unsigned length, const char *end) {
+        if constexpr (endian::native == endian::little) {
+            if (digits + 8 <= end) {
+                // Converting (up to) 8 digits at once, the most significant
+                // digit being stored at the lowest address.
+                // Shifting the chunk fills it with leading zeros.
+                uint64_t chunk;
+                memcpy(&chunk, digits, sizeof(chunk));
+                chunk <<= 8 * (8 - ((length < 8) ? length : 8));
+                chunk = ((chunk & 0x0F0F0F0F0F0F0F0FULL) * 2561) >> 8;
+                chunk = ((chunk & 0x00FF00FF00FF00FFULL) * 6553601) >> 16;
+                chunk = ((chunk & 0x0000FFFF0000FFFFULL) * 42949672960001ULL) >> 32;
+                auto value = static_cast<int>(chunk);
+                return (length <= 8) ? value : ((10 * value) + (digits[8] - '0'));
+            }
+        }
+
+        int value = 0;
+        for (unsigned i = 0; i < length; i++) {
+            value = (10 * value) + (digits[i] - '0');
+        }
+        return value;
+    }
+
+    /**
+     * Reads as many integers as possible from the given region of memory.
+     *
+     * @tparam classify The function used to classify the characters.
+     *
+     * @param cursor The first character to read, updated as values are read.
+     * @param end The character right after the last character of the region.
+     * @param values The array in which to store the read values.
+     * @param capacity The maximum number of values to read.
+     *
+     * @return The number of values that have been read.
+     */
+    template <Classifier classify>
+    size_t tokenize(const char *&cursor, const char *end, int *values, size_t capacity) {
+        size_t count = 0;
+        const char *window = cursor;
+
+        while ((count < capacity) && ((end - window) >= WINDOW_SIZE)) {
+            uint64_t digits, blanks, signs;
+            classify(window, digits, blanks, signs);
+
+            unsigned position = 0;
+            while (count < capacity) {
+                // Skipping blank characters.
+                unsigned start = nextSet(~blanks, position);
+                if (start == WINDOW_SIZE) {
+                    // The rest of the window is blank.
+                    position = WINDOW_SIZE;
+                    break;
+                }
+
+                // Reading the sign of the number, if any.
+                unsigned first = start;
+                bool negative = false;
+                if (((signs >> start) & 1) != 0) {
+                    negative = (window[start] == '-');
+                    first++;
+
+                } else if (((digits >> start) & 1) == 0) {
+                    // This token is not a number.
+                    cursor = window + start;
+                    return count;
+                }
+
+                // Looking for the end of the number.
+                unsigned stop = (first == WINDOW_SIZE) ? WINDOW_SIZE : nextSet(~digits, first);
+                if (stop == WINDOW_SIZE) {
+                    if (start == 0) {
+                        // The token is too long to be read by the tokenizer.
+                        cursor = window;
+                        return count;
+                    }
+
+                    // The number may continue in the next window.
+                    position = start;
+                    break;
+                }
+
+                unsigned length = stop - first;
+                if ((length == 0) || (length > MAX_DIGITS)) {
+                    // This is either a lone sign, or a number that may not fit in an int.
+                    cursor = window + start;
+                    return count;
+                }
+
+                // Storing the value of the number.
+                int value = convert(window + first, length, end);
+                values[count++] = negative ? -value : value;
+                position = stop;
+            }
+
+            window += position;
+            cursor = window;
+        }
+
+        return count;
+    }
+
+    /**
+     * The type of the tokenizing functions.
+     */
+    using Tokenizer = size_t (*)(const char *&, const char *, int *, size_t);
+
+    /**
+     * The tokenizer selected for the current CPU, with its name.
+     */
+    struct Implementation {
+        Tokenizer tokenizer;
+        const char *name;
+    };
+
+    /**
+     * Selects the best tokenizer for the current CPU.
+     *
+     * @return The selected implementation.
+     */
+    Implementation select() {
+#ifdef AUTIS_X86_TOKENIZER
+        if (supports(true)) {
+            return {tokenize<classifyAvx2>, "avx2"};
+        }
+
+        if (supports(false)) {
+            return {tokenize<classifySse>, "sse4.2"};
+        }
+#endif
+        return {tokenize<classifyScalar>, "scalar"};
+    }
+
+    /**
+     * The tokenizer to use, which is selected once and for all.
+     */
+    const Implementation selected = select();
+
+}
+
+size_t IntegerTokenizer::tokenize(const char *&cursor, const char *end, int *values, size_t capacity) {
+    return selected.tokenizer(cursor, end, values, capacity);
+}
+
+const char *IntegerTokenizer::implementation() {
+    return selected.name;
+}
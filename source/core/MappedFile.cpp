@@ -0,0 +1,157 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file MappedFile.cpp
+ * @brief Provides a read-only memory mapping of a regular file.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include "crillab-autis/core/MappedFile.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace Autis;
+using namespace std;
+
+MappedFile::MappedFile() :
+        content(nullptr),
+        length(0) {
+    // Nothing to do: everything is already initialized.
+}
+
+MappedFile::~MappedFile() {
+    unmap();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::map(const string &path) {
+    unmap();
+
+    // Opening the file for reading.
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    // Only non-empty regular files can be mapped.
+    LARGE_INTEGER fileSize;
+    if ((GetFileType(file) != FILE_TYPE_DISK) || (!GetFileSizeEx(file, &fileSize)) || (fileSize.QuadPart <= 0)) {
+        CloseHandle(file);
+        return false;
+    }
+
+    // Mapping the whole file.
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) {
+        return false;
+    }
+
+    void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (view == nullptr) {
+        return false;
+    }
+
+    content = static_cast<const char *>(view);
+    length = static_cast<size_t>(fileSize.QuadPart);
+    return true;
+}
+
+void MappedFile::unmap() {
+    if (content != nullptr) {
+        UnmapViewOfFile(content);
+        content = nullptr;
+        length = 0;
+    }
+}
+
+#else
+
+bool MappedFile::map(const string &path) {
+    unmap();
+
+    // Other files than regular files are not even opened: opening a pipe
+    // waits for a writer, whose content would be lost when closing it.
+    struct stat status {};
+    if ((stat(path.c_str(), &status) != 0) || (!S_ISREG(status.st_mode))) {
+        return false;
+    }
+
+    // Opening the file for reading.
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    // Only non-empty regular files can be mapped.
+    if ((fstat(fd, &status) != 0) || (!S_ISREG(status.st_mode)) || (status.st_size <= 0)) {
+        close(fd);
+        return false;
+    }
+
+    // Mapping the whole file (the descriptor is not needed afterwards).
+    auto size = static_cast<size_t>(status.st_size);
+    void *address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) {
+        return false;
+    }
+
+    // The file is read from the beginning to the end.
+    madvise(address, size, MADV_SEQUENTIAL);
+
+    content = static_cast<const char *>(address);
+    length = size;
+    return true;
+}
+
+void MappedFile::unmap() {
+    if (content != nullptr) {
+        munmap(const_cast<char *>(content), length);
+        content = nullptr;
+        length = 0;
+    }
+}
+
+#endif
+
+const char *MappedFile::data() const {
+    return content;
+}
+
+size_t MappedFile::size() const {
+    return length;
+}
@@ -0,0 +1,101 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file MemoryStreamBuffer.cpp
+ * @brief Defines a stream buffer reading directly from a region of memory.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "crillab-autis/core/MemoryStreamBuffer.hpp"
+
+using namespace Autis;
+using namespace std;
+
+void MemoryStreamBuffer::reset(const char *begin, const char *end, streambuf *following) {
+    // The region is never written: the const-cast only satisfies streambuf.
+    auto first = const_cast<char *>(begin);
+    setg(first, first, const_cast<char *>(end));
+    next = following;
+}
+
+streambuf::int_type MemoryStreamBuffer::underflow() {
+    if (gptr() < egptr()) {
+        return traits_type::to_int_type(*gptr());
+    }
+    return (next == nullptr) ? traits_type::eof() : next->sgetc();
+}
+
+streambuf::int_type MemoryStreamBuffer::uflow() {
+    if (gptr() < egptr()) {
+        auto c = traits_type::to_int_type(*gptr());
+        gbump(1);
+        return c;
+    }
+    return (next == nullptr) ? traits_type::eof() : next->sbumpc();
+}
+
+streamsize MemoryStreamBuffer::xsgetn(char_type *s, streamsize count) {
+    // Reading first from the region.
+    streamsize available = min(count, static_cast<streamsize>(egptr() - gptr()));
+    memcpy(s, gptr(), static_cast<size_t>(available));
+    setg(eback(), gptr() + available, egptr());
+
+    if ((available == count) || (next == nullptr)) {
+        return available;
+    }
+
+    // Reading the remaining characters from the following buffer.
+    return available + next->sgetn(s + available, count - available);
+}
+
+streambuf::pos_type MemoryStreamBuffer::seekoff(off_type off, ios_base::seekdir dir, ios_base::openmode which) {
+    if ((which & ios_base::in) == 0) {
+        return {off_type(-1)};
+    }
+
+    char *base;
+    if (dir == ios_base::beg) {
+        base = eback();
+    } else if (dir == ios_base::cur) {
+        base = gptr();
+    } else {
+        base = egptr();
+    }
+
+    char *target = base + off;
+    if ((target < eback()) || (target > egptr())) {
+        return {off_type(-1)};
+    }
+
+    setg(eback(), target, egptr());
+    return {target - eback()};
+}
+
+streambuf::pos_type MemoryStreamBuffer::seekpos(pos_type pos, ios_base::openmode which) {
+    return seekoff(off_type(pos), ios_base::beg, which);
+}
@@ -0,0 +1,212 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file ParseCache.cpp
+ * @brief Stores the instances that have been parsed, keyed by the fingerprint of their input.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include <crillab-except/except.hpp>
+
+#include "crillab-autis/core/ContentHash.hpp"
+#include "crillab-autis/core/MappedFile.hpp"
+#include "crillab-autis/core/ParseCache.hpp"
+#include "crillab-autis/core/Snapshot.hpp"
+
+using namespace Autis;
+using namespace Except;
+using namespace std;
+using namespace std::filesystem;
+
+ParseCache::ParseCache(const string &directory, uintmax_t sizeLimit) :
+        directory(directory),
+        sizeLimit(sizeLimit),
+        hits(0),
+        misses(0) {
+    create_directories(this->directory);
+}
+
+optional<Instance> ParseCache::find(uint64_t fingerprint, const ParserConfiguration &configuration) {
+    auto snapshot = pathOf(fingerprint, configuration);
+    MappedFile file;
+    if (!file.map(snapshot.string())) {
+        // The input has never been parsed (or its snapshot has been evicted).
+        misses++;
+        return nullopt;
+    }
+
+    try {
+        auto end = file.data() + file.size();
+        if (readSnapshotFingerprint(file.data(), end) != fingerprint) {
+            throw ParseException("Snapshot does not match its input");
+        }
+        auto instance = readSnapshot(file.data(), end);
+
+        // The snapshot is marked as recently used.
+        error_code error;
+        last_write_time(snapshot, file_time_type::clock::now(), error);
+        hits++;
+        return instance;
+
+    } catch (ParseException &) {
+        // The snapshot cannot be used: it will be replaced.
+        error_code error;
+        remove(snapshot, error);
+        misses++;
+        return nullopt;
+    }
+}
+
+void ParseCache::store(uint64_t fingerprint, const ParserConfiguration &configuration, const Instance &instance) {
+    auto snapshot = pathOf(fingerprint, configuration);
+
+    // The snapshot is written to a temporary file first, so that other
+    // processes never see an incomplete snapshot.
+    random_device random;
+    auto temporary = snapshot;
+    temporary += TEMPORARY_SUFFIX + ContentHash::toString((uint64_t(random()) << 32) | random());
+
+    try {
+        ofstream output(temporary, ios::binary);
+        writeSnapshot(instance, output, fingerprint);
+        output.close();
+        if (!output) {
+            error_code error;
+            remove(temporary, error);
+            return;
+        }
+
+    } catch (...) {
+        // The stream is closed here, so that the file can be removed.
+        error_code error;
+        remove(temporary, error);
+        throw;
+    }
+
+    error_code error;
+    rename(temporary, snapshot, error);
+    if (error) {
+        remove(temporary, error);
+        return;
+    }
+
+    evict();
+}
+
+const path &ParseCache::getDirectory() const {
+    return directory;
+}
+
+uintmax_t ParseCache::getSizeLimit() const {
+    return sizeLimit;
+}
+
+uint64_t ParseCache::getNumberOfHits() const {
+    return hits;
+}
+
+uint64_t ParseCache::getNumberOfMisses() const {
+    return misses;
+}
+
+path ParseCache::pathOf(uint64_t fingerprint, const ParserConfiguration &configuration) const {
+    // Only the options that change the instance are taken into account.
+    unsigned options = (configuration.isLinearizingProducts() ? 1U : 0U)
+            | (configuration.isCompressingTuples() ? 2U : 0U)
+            | (configuration.isStreamingXcsp() ? 4U : 0U);
+    return directory / (ContentHash::toString(fingerprint) + "-" + to_string(options) + EXTENSION);
+}
+
+void ParseCache::evict() {
+    // Listing the snapshots in the cache, with their last use.
+    // Other processes may modify the directory meanwhile: errors are ignored.
+    error_code error;
+    vector<tuple<file_time_type, uintmax_t, path>> snapshots;
+    uintmax_t totalSize = 0;
+    auto staleTime = file_time_type::clock::now() - TEMPORARY_LIFETIME;
+    for (directory_iterator it(directory, error), end; (!error) && (it != end); it.increment(error)) {
+        bool temporary = isTemporary(it->path());
+        if ((!temporary) && (it->path().extension() != EXTENSION)) {
+            continue;
+        }
+
+        // Each query is checked on its own, so that no error is overwritten.
+        bool regular = it->is_regular_file(error);
+        if ((error) || (!regular)) {
+            error.clear();
+            continue;
+        }
+        auto size = it->file_size(error);
+        if (error) {
+            error.clear();
+            continue;
+        }
+        auto time = it->last_write_time(error);
+        if (error) {
+            error.clear();
+            continue;
+        }
+
+        if (temporary) {
+            if (time < staleTime) {
+                // The process writing this file has died before renaming it.
+                remove(it->path(), error);
+                error.clear();
+            } else {
+                // The file is being written: it still uses space in the cache.
+                totalSize += size;
+            }
+            continue;
+        }
+
+        snapshots.emplace_back(time, size, it->path());
+        totalSize += size;
+    }
+
+    if ((sizeLimit == 0) || (totalSize <= sizeLimit)) {
+        return;
+    }
+
+    // Removing the least recently used snapshots first.
+    sort(snapshots.begin(), snapshots.end());
+    for (auto &[time, size, snapshot] : snapshots) {
+        if (totalSize <= sizeLimit) {
+            break;
+        }
+        if (remove(snapshot, error)) {
+            totalSize -= size;
+        }
+    }
+}
+
+bool ParseCache::isTemporary(const path &file) {
+    return file.filename().string().find(string(EXTENSION) + TEMPORARY_SUFFIX) != string::npos;
+}
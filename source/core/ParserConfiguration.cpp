@@ -0,0 +1,98 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file ParserConfiguration.cpp
+ * @brief Gathers the options that tune how inputs are parsed.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <thread>
+
+#include "crillab-autis/core/ParserConfiguration.hpp"
+
+using namespace Autis;
+using namespace std;
+
+ParserConfiguration::ParserConfiguration() :
+        numberOfThreads(1),
+        pipelined(false),
+        cache(nullptr),
+        linearizingProducts(true),
+        streamingXcsp(false),
+        compressingTuples(false) {
+    // Nothing to do: everything is already initialized.
+}
+
+void ParserConfiguration::setNumberOfThreads(unsigned nbThreads) {
+    if (nbThreads == 0) {
+        // Using all the hardware threads, if their number is known.
+        nbThreads = thread::hardware_concurrency();
+    }
+    numberOfThreads = (nbThreads == 0) ? 1 : nbThreads;
+}
+
+unsigned ParserConfiguration::getNumberOfThreads() const {
+    return numberOfThreads;
+}
+
+void ParserConfiguration::setPipelined(bool enabled) {
+    pipelined = enabled;
+}
+
+bool ParserConfiguration::isPipelined() const {
+    return pipelined;
+}
+
+void ParserConfiguration::setCache(ParseCache *parseCache) {
+    cache = parseCache;
+}
+
+ParseCache *ParserConfiguration::getCache() const {
+    return cache;
+}
+
+void ParserConfiguration::setLinearizingProducts(bool enabled) {
+    linearizingProducts = enabled;
+}
+
+bool ParserConfiguration::isLinearizingProducts() const {
+    return linearizingProducts;
+}
+
+void ParserConfiguration::setStreamingXcsp(bool enabled) {
+    streamingXcsp = enabled;
+}
+
+bool ParserConfiguration::isStreamingXcsp() const {
+    return streamingXcsp;
+}
+
+void ParserConfiguration::setCompressingTuples(bool enabled) {
+    compressingTuples = enabled;
+}
+
+bool ParserConfiguration::isCompressingTuples() const {
+    return compressingTuples;
+}
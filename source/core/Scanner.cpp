@@ -28,11 +28,12 @@
  * @license This project is released under the GNU LGPL3 License.
  */
 
-#include <cctype>
-#include <limits>
+#include <algorithm>
+#include <cstring>
 
 #include <crillab-except/except.hpp>
 
+#include "crillab-autis/core/IntegerTokenizer.hpp"
 #include "crillab-autis/core/Scanner.hpp"
 
 using namespace Autis;
@@ -40,82 +41,278 @@ using namespace Except;
 using namespace std;
 using namespace Universe;
 
+namespace {
+
+    /**
+     * Checks whether the given character is a blank character.
+     * This is equivalent to isspace() in the "C" locale, without any call.
+     *
+     * @param c The character to check.
+     *
+     * @return Whether the character is blank.
+     */
+    inline bool isBlank(char c) {
+        return (c == ' ') || ((c >= '\t') && (c <= '\r'));
+    }
+
+    /**
+     * Checks whether the given character is a decimal digit.
+     *
+     * @param c The character to check.
+     *
+     * @return Whether the character is a digit.
+     */
+    inline bool isDigit(char c) {
+        return static_cast<unsigned char>(c - '0') < 10;
+    }
+
+}
+
 Scanner::Scanner(istream &input) :
-        input(input) {
+        input(&input),
+        block(BLOCK_SIZE),
+        cursor(block.data()),
+        limit(block.data()),
+        endOfFile(false),
+        unreadBuffer(),
+        unreadStream(&unreadBuffer) {
     // Nothing to do: everything is already initialized.
 }
 
-istream &Scanner::getInput() const {
-    return input;
+Scanner::Scanner(const char *begin, const char *end) :
+        input(nullptr),
+        block(),
+        cursor(begin),
+        limit(end),
+        endOfFile(false),
+        unreadBuffer(),
+        unreadStream(&unreadBuffer) {
+    // Nothing to do: everything is already initialized.
+}
+
+istream &Scanner::getInput() {
+    // The buffered characters must be read before those remaining in the stream.
+    unreadBuffer.reset(cursor, limit, (input == nullptr) ? nullptr : input->rdbuf());
+    unreadStream.clear();
+    return unreadStream;
+}
+
+bool Scanner::fill() {
+    if (input != nullptr) {
+        // Reading the next block from the stream.
+        auto nbRead = input->rdbuf()->sgetn(block.data(), static_cast<streamsize>(block.size()));
+        if (nbRead > 0) {
+            cursor = block.data();
+            limit = cursor + nbRead;
+            return true;
+        }
+    }
+
+    // There is nothing more to read.
+    endOfFile = true;
+    return false;
 }
 
 bool Scanner::look(char &c) {
     do {
-        // Reading the next character.
-        c = read();
-    } while (!eof() && isspace(c));
+        // Skipping blank characters.
+        while ((cursor < limit) && isBlank(*cursor)) {
+            cursor++;
+        }
 
-    if (eof()) {
-        // There is no more character to read.
+        if (cursor < limit) {
+            // The character is not consumed.
+            c = *cursor;
+            return true;
+        }
+    } while (fill());
+
+    // There is no more character to read.
+    return false;
+}
+
+bool Scanner::peek(char &c) {
+    if ((cursor == limit) && (!fill())) {
         return false;
     }
 
-    // Putting back the read character, which will be consumed later on.
-    input.putback(c);
+    c = *cursor;
     return true;
 }
 
+void Scanner::advance() {
+    cursor++;
+}
+
 char Scanner::read() {
-    return (char) input.get();
+    if ((cursor == limit) && (!fill())) {
+        // Mimicking the behavior of a stream reaching its end.
+        return static_cast<char>(char_traits<char>::eof());
+    }
+
+    return *(cursor++);
 }
 
 void Scanner::read(int &value) {
-    BigInteger longValue = 0LL;
-    readBig(longValue);
-    value = (int) longValue;
+    int32_t intValue;
+    readInt32(intValue);
+    value = intValue;
+}
+
+void Scanner::readInt32(int32_t &value) {
+    bool negative = readSign();
+    uint64_t magnitude;
+    if (!readMagnitude(negative ? (uint64_t(INT32_MAX) + 1) : INT32_MAX, magnitude)) {
+        throw ParseException("Number does not fit in 32 bits");
+    }
+    value = static_cast<int32_t>(negative ? (0 - magnitude) : magnitude);
+}
+
+void Scanner::readInt64(int64_t &value) {
+    bool negative = readSign();
+    uint64_t magnitude;
+    if (!readMagnitude(negative ? (uint64_t(INT64_MAX) + 1) : INT64_MAX, magnitude)) {
+        throw ParseException("Number does not fit in 64 bits");
+    }
+    value = static_cast<int64_t>(negative ? (0 - magnitude) : magnitude);
+}
+
+bool Scanner::readInt64(int64_t &value, BigInteger &bigValue) {
+    bool negative = readSign();
+    uint64_t magnitude;
+    if (readMagnitude(negative ? (uint64_t(INT64_MAX) + 1) : INT64_MAX, magnitude)) {
+        // This is the most common case: the number fits in 64 bits.
+        value = static_cast<int64_t>(negative ? (0 - magnitude) : magnitude);
+        return true;
+    }
+
+    // The number is too big: the remaining digits need big integer arithmetic.
+    // The magnitude is split so that it is never converted as a negative value.
+    bigValue = static_cast<int64_t>(magnitude / 10);
+    bigValue = 10 * bigValue + static_cast<int64_t>(magnitude % 10);
+    char c;
+    for (; peek(c) && isDigit(c); advance()) {
+        bigValue = 10 * bigValue + (c - '0');
+    }
+    if (negative) {
+        bigValue = -bigValue;
+    }
+    return false;
 }
 
 void Scanner::readBig(BigInteger &value) {
+    int64_t smallValue;
+    if (readInt64(smallValue, value)) {
+        value = smallValue;
+    }
+}
+
+bool Scanner::readSign() {
     char c;
-    int sign = 1;
+    bool negative = false;
 
     // Moving to the next eligible character.
-    do {
-        c = read();
-    } while ((!eof()) && (!isdigit(c)) && (c != '+') && (c != '-'));
+    while (peek(c) && (!isDigit(c)) && (c != '+') && (c != '-')) {
+        advance();
+    }
 
     // Considering the sign of the number.
-    if (c == '-') {
+    if (eof()) {
+        throw ParseException("Non-digit character found while looking for a number");
+
+    } else if (c == '-') {
         // The number is negative.
-        sign = -1;
-        c = read();
+        negative = true;
+        advance();
 
     } else if (c == '+') {
         // This sign is simply ignored.
-        c = read();
+        advance();
     }
 
     // Making sure that at least one digit is present in the number.
-    if (eof() || !isdigit(c)) {
+    if ((!peek(c)) || (!isDigit(c))) {
         throw ParseException("Non-digit character found while looking for a number");
     }
 
-    // Computing the value of the number.
-    for (value = 0; (!eof()) && (isdigit(c)); c = read()) {
-        value = 10 * value + (c - '0');
-    }
-    value *= sign;
+    return negative;
+}
 
-    if (!eof()) {
-        // The last (non-digit) character is put back.
-        input.putback(c);
+bool Scanner::readMagnitude(uint64_t bound, uint64_t &magnitude) {
+    char c;
+
+    // Computing the magnitude of the number.
+    // The last (non-digit) character is not consumed.
+    for (magnitude = 0; peek(c) && isDigit(c); advance()) {
+        auto digit = static_cast<uint64_t>(c - '0');
+        if (magnitude > ((bound - digit) / 10)) {
+            // Adding this digit would exceed the bound.
+            return false;
+        }
+        magnitude = 10 * magnitude + digit;
     }
+
+    return true;
+}
+
+size_t Scanner::readIntegers(int *values, size_t capacity) {
+    return IntegerTokenizer::tokenize(cursor, limit, values, capacity);
 }
 
 void Scanner::skipLine() {
-    input.ignore(numeric_limits<streamsize>::max(), '\n');
+    do {
+        // Looking for the end of the line among the available characters.
+        auto endOfLine = static_cast<const char *>(memchr(cursor, '\n', static_cast<size_t>(limit - cursor)));
+        if (endOfLine != nullptr) {
+            cursor = endOfLine + 1;
+            return;
+        }
+        cursor = limit;
+    } while (fill());
+}
+
+string_view Scanner::lookLine() {
+    auto endOfLine = find(cursor, limit, '\n');
+    while ((endOfLine == limit) && (input != nullptr)) {
+        // Moving the beginning of the line to the front of the block, which grows if it is full.
+        auto size = static_cast<size_t>(limit - cursor);
+        memmove(block.data(), cursor, size);
+        if (size == block.size()) {
+            block.resize(2 * block.size());
+        }
+        cursor = block.data();
+        limit = cursor + size;
+        endOfLine = limit;
+
+        // Reading the next characters after the beginning of the line.
+        auto nbRead = input->rdbuf()->sgetn(block.data() + size, static_cast<streamsize>(block.size() - size));
+        if (nbRead <= 0) {
+            // The line ends with the input.
+            break;
+        }
+        limit += nbRead;
+        endOfLine = find(cursor + size, limit, '\n');
+    }
+
+    return {cursor, endOfLine};
+}
+
+bool Scanner::isInMemory() const {
+    return input == nullptr;
+}
+
+const char *Scanner::getPosition() const {
+    return cursor;
+}
+
+const char *Scanner::getEnd() const {
+    return limit;
+}
+
+void Scanner::moveTo(const char *position) {
+    cursor = position;
 }
 
 bool Scanner::eof() {
-    return input.eof();
+    return endOfFile;
 }
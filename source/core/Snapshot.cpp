@@ -0,0 +1,471 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file Snapshot.cpp
+ * @brief Stores parsed instances in a compact binary form.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <cstring>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+#include <crillab-except/except.hpp>
+
+#include "crillab-autis/core/Snapshot.hpp"
+
+using namespace Autis;
+using namespace Except;
+using namespace std;
+using namespace Universe;
+
+namespace {
+
+    /**
+     * The number of bytes to buffer before writing them to the stream.
+     */
+    constexpr size_t WRITE_BLOCK_SIZE = 1 << 16;
+
+    /**
+     * Writes a big integer.
+     *
+     * @tparam Big The type of the big integer.
+     *
+     * @param writer The writer to write the big integer with.
+     * @param value The big integer to write.
+     */
+    template <typename Big>
+    void writeBigInteger(SnapshotWriter &writer, const Big &value) {
+        if constexpr (is_integral_v<Big>) {
+            // Big integers are native integers.
+            writer.writeSigned(static_cast<int64_t>(value));
+
+        } else {
+            // Big integers are written in decimal, as they are read from inputs.
+            ostringstream decimal;
+            decimal << value;
+            auto digits = decimal.str();
+            writer.writeUnsigned(digits.size());
+            writer.writeBytes(digits);
+        }
+    }
+
+    /**
+     * Reads a big integer.
+     *
+     * @tparam Big The type of the big integer.
+     *
+     * @param reader The reader to read the big integer with.
+     * @param value The big integer in which to store the read value.
+     */
+    template <typename Big>
+    void readBigInteger(SnapshotReader &reader, Big &value) {
+        if constexpr (is_integral_v<Big>) {
+            // Big integers are native integers.
+            value = static_cast<Big>(reader.readSigned());
+
+        } else {
+            // Big integers are written in decimal.
+            auto digits = reader.readBytes(reader.readSize());
+            auto digit = digits.begin();
+            bool negative = (digit != digits.end()) && (*digit == '-');
+            if (negative) {
+                digit++;
+            }
+
+            value = 0;
+            for (; digit != digits.end(); digit++) {
+                value = 10 * value + (*digit - '0');
+            }
+            if (negative) {
+                value = -value;
+            }
+        }
+    }
+
+    /**
+     * Writes the clauses of a SAT instance.
+     *
+     * @param writer The writer to write the clauses with.
+     * @param clauses The clauses to write.
+     */
+    void writeClauses(SnapshotWriter &writer, const ClauseBatch &clauses) {
+        writer.writeByte(clauses.reservation ? 1 : 0);
+        writer.writeSigned(clauses.nbVariables);
+        writer.writeSigned(clauses.nbConstraints);
+
+        // The weights are only written when there are soft clauses, hard clauses having a weight of 0.
+        writer.writeUnsigned(clauses.size());
+        writer.writeByte(clauses.weights.empty() ? 0 : 1);
+        for (size_t i = 0; i < clauses.size(); i++) {
+            if (!clauses.weights.empty()) {
+                writer.writeUnsigned(static_cast<uint64_t>(clauses.weights[i]));
+            }
+            writer.writeDeltas(span<const int32_t>(
+                    clauses.literals.data() + clauses.offsets[i], clauses.offsets[i + 1] - clauses.offsets[i]));
+        }
+    }
+
+    /**
+     * Reads the clauses of a SAT instance.
+     *
+     * @param reader The reader to read the clauses with.
+     * @param clauses The batch in which to store the clauses.
+     */
+    void readClauses(SnapshotReader &reader, ClauseBatch &clauses) {
+        auto reservation = reader.readByte() != 0;
+        auto nbVariables = static_cast<int>(reader.readSigned());
+        auto nbClauses = static_cast<int>(reader.readSigned());
+        if (reservation) {
+            clauses.reserve(nbVariables, nbClauses);
+        }
+
+        vector<int32_t> clause;
+        auto size = reader.readSize();
+        auto weighted = reader.readByte() != 0;
+        for (size_t i = 0; i < size; i++) {
+            uint64_t weight = 0;
+            if (weighted) {
+                weight = reader.readUnsigned();
+                if (weight > static_cast<uint64_t>(INT64_MAX)) {
+                    throw ParseException("Invalid weight in snapshot");
+                }
+            }
+
+            reader.readDeltas(clause);
+            if (weight == 0) {
+                clauses.addClause(clause);
+
+            } else {
+                clauses.addSoftClause(clause, static_cast<int64_t>(weight));
+            }
+        }
+    }
+
+    /**
+     * Writes the constraints of a pseudo-Boolean instance.
+     *
+     * @param writer The writer to write the constraints with.
+     * @param constraints The constraints to write.
+     */
+    void writeConstraints(SnapshotWriter &writer, const ConstraintBatch &constraints) {
+        writer.writeByte(constraints.reservation ? 1 : 0);
+        writer.writeSigned(constraints.nbVariables);
+        writer.writeSigned(constraints.nbConstraints);
+
+        // The objective function is written before the constraints, as in OPB inputs.
+        writer.writeByte(constraints.objectiveBegins ? 1 : 0);
+        writer.writeByte(constraints.objectiveEnds ? 1 : 0);
+        writer.writeDeltas(span<const int>(constraints.objectiveLiterals));
+        for (const auto &coefficient : constraints.objectiveCoefficients) {
+            writer.writeBig(coefficient);
+        }
+        writer.writeByte(constraints.topCostSet ? 1 : 0);
+        writer.writeSigned(constraints.topCost);
+
+        // Hard constraints are written with a weight of 0.
+        writer.writeUnsigned(constraints.size());
+        for (size_t i = 0; i < constraints.size(); i++) {
+            auto begin = constraints.offsets[i];
+            auto end = constraints.offsets[i + 1];
+            writer.writeByte(static_cast<unsigned char>(constraints.operators[i]));
+            writer.writeUnsigned(constraints.weights.empty() ? 0 : static_cast<uint64_t>(constraints.weights[i]));
+            writer.writeBig(constraints.degrees[i]);
+            writer.writeDeltas(span<const int>(constraints.literals.data() + begin, end - begin));
+            for (auto j = begin; j < end; j++) {
+                writer.writeBig(constraints.coefficients[j]);
+            }
+        }
+    }
+
+    /**
+     * Reads the constraints of a pseudo-Boolean instance.
+     *
+     * @param reader The reader to read the constraints with.
+     * @param constraints The batch in which to store the constraints.
+     */
+    void readConstraints(SnapshotReader &reader, ConstraintBatch &constraints) {
+        auto reservation = reader.readByte() != 0;
+        auto nbVariables = static_cast<int>(reader.readSigned());
+        auto nbConstraints = static_cast<int>(reader.readSigned());
+        if (reservation) {
+            constraints.reserve(nbVariables, nbConstraints);
+        }
+
+        constraints.objectiveBegins = reader.readByte() != 0;
+        constraints.objectiveEnds = reader.readByte() != 0;
+        reader.readDeltas(constraints.objectiveLiterals);
+        constraints.objectiveCoefficients.resize(constraints.objectiveLiterals.size());
+        for (auto &coefficient : constraints.objectiveCoefficients) {
+            reader.readBig(coefficient);
+        }
+        auto topCostSet = reader.readByte() != 0;
+        auto topCost = reader.readSigned();
+        if (topCostSet) {
+            constraints.setTopCost(topCost);
+        }
+
+        vector<int> literals;
+        vector<BigInteger> coefficients;
+        BigInteger degree;
+        auto size = reader.readSize();
+        for (size_t i = 0; i < size; i++) {
+            auto relationalOperator = reader.readByte();
+            if (relationalOperator > static_cast<unsigned char>(RelationalOperator::EXACTLY)) {
+                throw ParseException("Invalid relational operator in snapshot");
+            }
+            auto weight = reader.readUnsigned();
+            if (weight > static_cast<uint64_t>(INT64_MAX)) {
+                throw ParseException("Invalid weight in snapshot");
+            }
+            reader.readBig(degree);
+            reader.readDeltas(literals);
+            coefficients.resize(literals.size());
+            for (auto &coefficient : coefficients) {
+                reader.readBig(coefficient);
+            }
+            if (weight == 0) {
+                constraints.add(static_cast<RelationalOperator>(relationalOperator), literals, coefficients, degree);
+
+            } else {
+                constraints.addSoft(static_cast<RelationalOperator>(relationalOperator), literals, coefficients,
+                        degree, static_cast<int64_t>(weight));
+            }
+        }
+    }
+
+    /**
+     * Reads the header of a snapshot, and checks that it can be read by this
+     * version of the library.
+     *
+     * @param reader The reader to read the header with.
+     *
+     * @return The fingerprint recorded in the snapshot.
+     */
+    uint64_t readHeader(SnapshotReader &reader) {
+        auto magic = reader.readBytes(sizeof(SNAPSHOT_MAGIC));
+        if (memcmp(magic.data(), SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) {
+            throw ParseException("Input is not a snapshot");
+        }
+
+        if (reader.readUnsigned() != SNAPSHOT_VERSION) {
+            throw ParseException("Unsupported snapshot version");
+        }
+
+        return reader.readFixed();
+    }
+
+}
+
+SnapshotWriter::SnapshotWriter(ostream &output) :
+        output(output),
+        buffer() {
+    buffer.reserve(WRITE_BLOCK_SIZE + 16);
+}
+
+SnapshotWriter::~SnapshotWriter() {
+    flush();
+}
+
+void SnapshotWriter::writeByte(unsigned char value) {
+    buffer.push_back(static_cast<char>(value));
+    if (buffer.size() >= WRITE_BLOCK_SIZE) {
+        flush();
+    }
+}
+
+void SnapshotWriter::writeBytes(span<const char> bytes) {
+    buffer.insert(buffer.end(), bytes.begin(), bytes.end());
+    if (buffer.size() >= WRITE_BLOCK_SIZE) {
+        flush();
+    }
+}
+
+void SnapshotWriter::writeFixed(uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        buffer.push_back(static_cast<char>(value & 0xFF));
+        value >>= 8;
+    }
+}
+
+void SnapshotWriter::writeUnsigned(uint64_t value) {
+    // Each byte holds 7 bits of the value, and tells whether more bytes follow.
+    while (value >= 0x80) {
+        buffer.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    writeByte(static_cast<unsigned char>(value));
+}
+
+void SnapshotWriter::writeSigned(int64_t value) {
+    // Zigzag encoding maps 0, -1, 1, -2, 2... to 0, 1, 2, 3, 4...
+    auto bits = static_cast<uint64_t>(value);
+    writeUnsigned((bits << 1) ^ (0 - (bits >> 63)));
+}
+
+void SnapshotWriter::writeBig(const BigInteger &value) {
+    writeBigInteger(*this, value);
+}
+
+void SnapshotWriter::flush() {
+    output.write(buffer.data(), static_cast<streamsize>(buffer.size()));
+    buffer.clear();
+}
+
+SnapshotReader::SnapshotReader(const char *begin, const char *end) :
+        cursor(begin),
+        end(end) {
+    // Nothing to do: everything is already initialized.
+}
+
+unsigned char SnapshotReader::readByte() {
+    if (cursor == end) {
+        throw ParseException("Snapshot is truncated");
+    }
+    return static_cast<unsigned char>(*(cursor++));
+}
+
+span<const char> SnapshotReader::readBytes(size_t size) {
+    if (static_cast<size_t>(end - cursor) < size) {
+        throw ParseException("Snapshot is truncated");
+    }
+    span<const char> bytes(cursor, size);
+    cursor += size;
+    return bytes;
+}
+
+uint64_t SnapshotReader::readFixed() {
+    auto bytes = readBytes(8);
+    uint64_t value = 0;
+    for (size_t i = bytes.size(); i > 0; i--) {
+        value = (value << 8) | static_cast<unsigned char>(bytes[i - 1]);
+    }
+    return value;
+}
+
+uint64_t SnapshotReader::readUnsigned() {
+    uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        uint64_t byte = readByte();
+        value |= (byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    throw ParseException("Invalid integer in snapshot");
+}
+
+int64_t SnapshotReader::readSigned() {
+    auto bits = readUnsigned();
+    return static_cast<int64_t>((bits >> 1) ^ (0 - (bits & 1)));
+}
+
+void SnapshotReader::readBig(BigInteger &value) {
+    readBigInteger(*this, value);
+}
+
+size_t SnapshotReader::readSize() {
+    auto size = readUnsigned();
+    if (size > static_cast<uint64_t>(end - cursor)) {
+        // Each value takes at least one byte.
+        throw ParseException("Snapshot is truncated");
+    }
+    return static_cast<size_t>(size);
+}
+
+bool SnapshotReader::eof() const {
+    return cursor == end;
+}
+
+bool Autis::isSnapshot(const char *data, size_t size) {
+    return (size >= sizeof(SNAPSHOT_MAGIC)) && (memcmp(data, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) == 0);
+}
+
+void Autis::writeSnapshot(const Instance &instance, ostream &output, uint64_t fingerprint) {
+    SnapshotWriter writer(output);
+    writer.writeBytes(span<const char>(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)));
+    writer.writeUnsigned(SNAPSHOT_VERSION);
+    writer.writeFixed(fingerprint);
+    writer.writeByte(static_cast<unsigned char>(instance.getType()));
+
+    if (instance.getType() == InstanceType::SAT) {
+        writeClauses(writer, instance.getClauses());
+
+    } else if (instance.getType() == InstanceType::PSEUDO_BOOLEAN) {
+        writeConstraints(writer, instance.getConstraints());
+
+    } else {
+        instance.getCspInstance().save(writer);
+    }
+
+    writer.flush();
+}
+
+Instance Autis::readSnapshot(const char *begin, const char *end) {
+    SnapshotReader reader(begin, end);
+    readHeader(reader);
+
+    auto type = reader.readByte();
+    if (type > static_cast<unsigned char>(InstanceType::CSP)) {
+        throw ParseException("Invalid instance type in snapshot");
+    }
+
+    Instance instance(static_cast<InstanceType>(type));
+
+    if (instance.getType() == InstanceType::SAT) {
+        readClauses(reader, instance.getClauses());
+
+    } else if (instance.getType() == InstanceType::PSEUDO_BOOLEAN) {
+        readConstraints(reader, instance.getConstraints());
+
+    } else {
+        instance.getCspInstance().load(reader);
+    }
+
+    if (!reader.eof()) {
+        throw ParseException("Unexpected data at the end of the snapshot");
+    }
+
+    return instance;
+}
+
+Instance Autis::readSnapshot(Scanner &scanner) {
+    if (scanner.isInMemory()) {
+        // The snapshot is read where it is stored (e.g., in a mapped file).
+        return readSnapshot(scanner.getPosition(), scanner.getEnd());
+    }
+
+    // The snapshot is read from a stream: it is loaded into memory first.
+    auto &input = scanner.getInput();
+    vector<char> content((istreambuf_iterator<char>(input)), istreambuf_iterator<char>());
+    return readSnapshot(content.data(), content.data() + content.size());
+}
+
+uint64_t Autis::readSnapshotFingerprint(const char *begin, const char *end) {
+    SnapshotReader reader(begin, end);
+    return readHeader(reader);
+}
@@ -0,0 +1,91 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file XzStreamBuffer.cpp
+ * @brief Provides a stream buffer decompressing xz data on the fly.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifdef AUTIS_WITH_LZMA
+
+#include <cstdint>
+
+#include <crillab-except/except.hpp>
+
+#include "crillab-autis/core/XzStreamBuffer.hpp"
+
+using namespace Autis;
+using namespace Except;
+using namespace std;
+
+XzStreamBuffer::XzStreamBuffer(streambuf &source) :
+        DecompressionStreamBuffer(source),
+        stream(LZMA_STREAM_INIT),
+        endOfStream(false) {
+    if (lzma_stream_decoder(&stream, UINT64_MAX, LZMA_CONCATENATED) != LZMA_OK) {
+        throw ParseException("Could not initialize xz decompression");
+    }
+}
+
+XzStreamBuffer::~XzStreamBuffer() {
+    lzma_end(&stream);
+}
+
+size_t XzStreamBuffer::decompress(char *data, size_t capacity) {
+    stream.next_out = reinterpret_cast<uint8_t *>(data);
+    stream.avail_out = capacity;
+
+    // With concatenated streams, the decoder needs to be told explicitly when
+    // the input is over.
+    lzma_action action = LZMA_RUN;
+    while ((stream.avail_out == capacity) && (!endOfStream)) {
+        if ((stream.avail_in == 0) && (action == LZMA_RUN)) {
+            // All the compressed data read so far has been consumed.
+            const char *compressed;
+            size_t size;
+            if (readCompressed(compressed, size)) {
+                stream.next_in = reinterpret_cast<const uint8_t *>(compressed);
+                stream.avail_in = size;
+            } else {
+                action = LZMA_FINISH;
+            }
+        }
+
+        lzma_ret status = lzma_code(&stream, action);
+        if (status == LZMA_STREAM_END) {
+            endOfStream = true;
+
+        } else if ((status == LZMA_BUF_ERROR) && (action == LZMA_FINISH)) {
+            throw ParseException("Unexpected end of xz input");
+
+        } else if (status != LZMA_OK) {
+            throw ParseException("Corrupted xz input");
+        }
+    }
+
+    return capacity - stream.avail_out;
+}
+
+#endif
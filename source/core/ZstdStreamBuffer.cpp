@@ -0,0 +1,83 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file ZstdStreamBuffer.cpp
+ * @brief Provides a stream buffer decompressing Zstandard data on the fly.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifdef AUTIS_WITH_ZSTD
+
+#include <crillab-except/except.hpp>
+
+#include "crillab-autis/core/ZstdStreamBuffer.hpp"
+
+using namespace Autis;
+using namespace Except;
+using namespace std;
+
+ZstdStreamBuffer::ZstdStreamBuffer(streambuf &source) :
+        DecompressionStreamBuffer(source),
+        stream(ZSTD_createDStream()),
+        input({nullptr, 0, 0}),
+        endOfStream(true) {
+    if (stream == nullptr) {
+        throw ParseException("Could not initialize zstd decompression");
+    }
+}
+
+ZstdStreamBuffer::~ZstdStreamBuffer() {
+    ZSTD_freeDStream(stream);
+}
+
+size_t ZstdStreamBuffer::decompress(char *data, size_t capacity) {
+    ZSTD_outBuffer output = {data, capacity, 0};
+
+    while (output.pos == 0) {
+        if (input.pos == input.size) {
+            // All the compressed data read so far has been consumed.
+            const char *compressed;
+            size_t size;
+            if (!readCompressed(compressed, size)) {
+                if (!endOfStream) {
+                    throw ParseException("Unexpected end of zstd input");
+                }
+                break;
+            }
+            input = {compressed, size, 0};
+        }
+
+        // The decoder moves from one frame to the next by itself.
+        size_t status = ZSTD_decompressStream(stream, &output, &input);
+        if (ZSTD_isError(status)) {
+            throw ParseException("Corrupted zstd input");
+        }
+        endOfStream = (status == 0);
+    }
+
+    return output.pos;
+}
+
+#endif
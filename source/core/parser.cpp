@@ -30,10 +30,26 @@
 
 #include <crillab-except/except.hpp>
 
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <string_view>
+#include <vector>
+
 #include "crillab-autis/cnf/CnfParser.hpp"
+#include "crillab-autis/cnf/WcnfParser.hpp"
+#include "crillab-autis/core/ContentHash.hpp"
+#include "crillab-autis/core/DecompressionStreamBuffer.hpp"
+#include "crillab-autis/core/HashingStreamBuffer.hpp"
+#include "crillab-autis/core/MappedFile.hpp"
+#include "crillab-autis/core/MappedScanner.hpp"
+#include "crillab-autis/core/MemoryStreamBuffer.hpp"
+#include "crillab-autis/core/ParseCache.hpp"
 #include "crillab-autis/core/parser.hpp"
 #include "crillab-autis/core/Scanner.hpp"
+#include "crillab-autis/core/Snapshot.hpp"
 #include "crillab-autis/pb/OpbParser.hpp"
+#include "crillab-autis/pb/WboParser.hpp"
 #include "crillab-autis/xcsp/AutisXcspParserAdapter.hpp"
 
 using namespace Autis;
@@ -41,13 +57,283 @@ using namespace Except;
 using namespace std;
 using namespace Universe;
 
-IUniverseSolver *Autis::parse(const string &path, IUniverseSolverFactory &listener) {
-    ifstream input(path);
-    return parse(input, listener);
+namespace {
+
+    /**
+     * Gives a scanner reading the (decompressed) content of a mapped file to
+     * the given function.
+     *
+     * @tparam Function The type of the function to apply.
+     *
+     * @param file The mapped file to read.
+     * @param function The function to apply to the scanner.
+     *
+     * @return The value returned by the function.
+     */
+    template <typename Function>
+    auto withScanner(const MappedFile &file, Function function) {
+        auto format = DecompressionStreamBuffer::detect(file.data(), file.size());
+        if (format == CompressionFormat::NONE) {
+            // The file is read directly from memory.
+            MappedScanner scanner(file);
+            return function(scanner);
+        }
+
+        // The file is compressed: it is decompressed while being read.
+        MemoryStreamBuffer compressed;
+        compressed.reset(file.data(), file.data() + file.size());
+        auto decompressed = DecompressionStreamBuffer::create(format, compressed);
+        istream input(decompressed.get());
+        Scanner scanner(input);
+        return function(scanner);
+    }
+
+    /**
+     * Gives a scanner reading the (decompressed) content of a stream buffer
+     * to the given function.
+     *
+     * @tparam Function The type of the function to apply.
+     *
+     * @param stream The stream buffer to read.
+     * @param function The function to apply to the scanner.
+     *
+     * @return The value returned by the function.
+     */
+    template <typename Function>
+    auto withScanner(streambuf &stream, Function function) {
+        // The first bytes are read to recognize the compression format, and
+        // then read again before the rest of the stream.
+        char header[DecompressionStreamBuffer::MAGIC_SIZE];
+        auto size = max(stream.sgetn(header, sizeof(header)), streamsize(0));
+        MemoryStreamBuffer content;
+        content.reset(header, header + size, &stream);
+
+        auto format = DecompressionStreamBuffer::detect(header, static_cast<size_t>(size));
+        if (format == CompressionFormat::NONE) {
+            istream input(&content);
+            Scanner scanner(input);
+            return function(scanner);
+        }
+
+        // The stream is compressed: it is decompressed while being read.
+        auto decompressed = DecompressionStreamBuffer::create(format, content);
+        istream input(decompressed.get());
+        Scanner scanner(input);
+        return function(scanner);
+    }
+
+    /**
+     * Opens the file at the given path, and gives a scanner reading its
+     * (decompressed) content to the given function.
+     * Regular files are mapped into memory and read directly from there,
+     * while other files (such as pipes) are read as streams.
+     *
+     * @tparam Function The type of the function to apply.
+     *
+     * @param path The path of the file to read.
+     * @param function The function to apply to the scanner.
+     *
+     * @return The value returned by the function.
+     */
+    template <typename Function>
+    auto withScanner(const string &path, Function function) {
+        MappedFile file;
+        if (file.map(path)) {
+            // The file is a regular file: it is read directly from memory.
+            return withScanner(file, function);
+        }
+
+        // The file cannot be mapped (e.g., it is a pipe): it is read as a stream.
+        ifstream stream(path, ios::binary);
+        return withScanner(*stream.rdbuf(), function);
+    }
+
+    /**
+     * Checks whether an input starting with a comment uses the WBO format
+     * rather than the OPB format, i.e., whether its first line declares soft
+     * constraints.
+     *
+     * @param scanner The scanner reading the input.
+     *
+     * @return Whether the input uses the WBO format.
+     */
+    bool isWbo(Scanner &scanner) {
+        return scanner.lookLine().find("#soft=") != string_view::npos;
+    }
+
+    /**
+     * Checks whether an input uses the WCNF format rather than the CNF
+     * format, i.e., whether its first line that is not a comment is either
+     * a "p wcnf" line (legacy format), or a clause prefixed by "h" or by a
+     * weight (format used since 2022).
+     * The comments preceding this line are consumed, as both formats ignore
+     * them anyway.
+     *
+     * @param scanner The scanner reading the input.
+     *
+     * @return Whether the input uses the WCNF format.
+     */
+    bool isWcnf(Scanner &scanner) {
+        for (char c; scanner.look(c);) {
+            if (c == 'c') {
+                // Comments are skipped.
+                scanner.skipLine();
+
+            } else if (c == 'p') {
+                // The problem line tells the format.
+                return scanner.lookLine().find("wcnf") != string_view::npos;
+
+            } else {
+                // Clauses start with their weight, or with "h" if they are hard.
+                return (c == 'h') || isdigit(static_cast<unsigned char>(c));
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Reads the file at the given path into an instance, and computes the
+     * fingerprint of its (raw) content while doing so.
+     * If the configuration has a cache, the instance is looked for in this
+     * cache first, and stored there after having been read.
+     *
+     * @param path The path of the file to read.
+     * @param configuration The configuration of the parser.
+     * @param fingerprint The fingerprint of the file, computed by this function.
+     *
+     * @return The instance defined in the file.
+     */
+    Instance readFingerprintedInstance(const string &path, const ParserConfiguration &configuration,
+            uint64_t &fingerprint) {
+        auto cache = configuration.getCache();
+        auto read = [&](Scanner &scanner) {
+            return readInstance(scanner, configuration);
+        };
+
+        MappedFile file;
+        if (file.map(path)) {
+            // The fingerprint is computed before parsing, so that the instance can be found.
+            fingerprint = ContentHash::of(file.data(), file.size());
+            if (cache != nullptr) {
+                if (auto cached = cache->find(fingerprint, configuration)) {
+                    return std::move(*cached);
+                }
+            }
+
+            auto instance = withScanner(file, read);
+            if (cache != nullptr) {
+                cache->store(fingerprint, configuration, instance);
+            }
+            return instance;
+        }
+
+        // The file can only be read once (e.g., it is a pipe): its fingerprint
+        // is computed while it is parsed.
+        ifstream stream(path, ios::binary);
+        HashingStreamBuffer hashing(*stream.rdbuf());
+        auto instance = withScanner(hashing, read);
+        fingerprint = hashing.finish();
+        if (cache != nullptr) {
+            cache->store(fingerprint, configuration, instance);
+        }
+        return instance;
+    }
+
+    /**
+     * Creates a solver able to solve the given instance.
+     *
+     * @param instance The instance to solve.
+     * @param factory The factory creating the solver.
+     *
+     * @return The created solver.
+     */
+    IUniverseSolver *createSolver(const Instance &instance, IUniverseSolverFactory &factory) {
+        if (instance.getType() == InstanceType::SAT) {
+            return factory.createSatSolver();
+        }
+
+        if (instance.getType() == InstanceType::PSEUDO_BOOLEAN) {
+            return factory.createPseudoBooleanSolver();
+        }
+
+        return factory.createCspSolver();
+    }
+
+    /**
+     * Creates a solver, and gives it the given instance.
+     * If an error occurs, the solver is destroyed.
+     *
+     * @param instance The instance to give to the solver.
+     * @param factory The factory creating the solver.
+     *
+     * @return The solver fed with the instance.
+     */
+    IUniverseSolver *feed(const Instance &instance, IUniverseSolverFactory &factory) {
+        auto solver = createSolver(instance, factory);
+        try {
+            instance.replay(*solver);
+
+        } catch (...) {
+            delete solver;
+            throw;
+        }
+        return solver;
+    }
+
+    /**
+     * Creates the solvers of a portfolio, and gives them the given instance.
+     * If an error occurs, the solvers that have been created are destroyed.
+     *
+     * @param instance The instance to give to the solvers.
+     * @param factories The factories creating the solvers of the portfolio.
+     *
+     * @return The solvers of the portfolio, in the order of their factories.
+     */
+    vector<IUniverseSolver *> feedPortfolio(
+            const Instance &instance, const vector<IUniverseSolverFactory *> &factories) {
+        vector<IUniverseSolver *> solvers;
+        solvers.reserve(factories.size());
+
+        try {
+            for (auto factory : factories) {
+                solvers.push_back(createSolver(instance, *factory));
+            }
+
+            instance.replay(solvers);
+
+        } catch (...) {
+            for (auto solver : solvers) {
+                delete solver;
+            }
+            throw;
+        }
+
+        return solvers;
+    }
+
+}
+
+IUniverseSolver *Autis::parse(const string &path, IUniverseSolverFactory &listener,
+        const ParserConfiguration &configuration) {
+    if (configuration.getCache() != nullptr) {
+        // The instance is read through the cache.
+        uint64_t fingerprint;
+        return feed(readFingerprintedInstance(path, configuration, fingerprint), listener);
+    }
+
+    return withScanner(path, [&](Scanner &scanner) {
+        return parse(scanner, listener, configuration);
+    });
 }
 
-Universe::IUniverseSolver *Autis::parse(istream &input, IUniverseSolverFactory &factory) {
+Universe::IUniverseSolver *Autis::parse(istream &input, IUniverseSolverFactory &factory,
+        const ParserConfiguration &configuration) {
     Scanner scanner(input);
+    return parse(scanner, factory, configuration);
+}
+
+Universe::IUniverseSolver *Autis::parse(Scanner &scanner, IUniverseSolverFactory &factory,
+        const ParserConfiguration &configuration) {
     AbstractParser *parser;
     IUniverseSolver *solver;
     char c;
@@ -57,20 +343,35 @@ Universe::IUniverseSolver *Autis::parse(istream &input, IUniverseSolverFactory &
         throw ParseException("Input is empty");
     }
 
-    if ((c == 'c') || (c == 'p')) {
+    if (c == SNAPSHOT_MAGIC[0]) {
+        // The input is a snapshot of an instance that has already been read.
+        return feed(readSnapshot(scanner), factory);
+    }
+
+    if (isWcnf(scanner)) {
+        // The input uses the WCNF format.
+        solver = factory.createSatSolver();
+        parser = new WcnfParser(scanner, dynamic_cast<IUniverseSatSolver *>(solver), configuration);
+
+    } else if ((c == 'c') || (c == 'p')) {
         // The input uses the CNF format.
         solver = factory.createSatSolver();
-        parser = new CnfParser(scanner, dynamic_cast<IUniverseSatSolver *>(solver));
+        parser = new CnfParser(scanner, dynamic_cast<IUniverseSatSolver *>(solver), configuration);
+
+    } else if ((c == '*') && isWbo(scanner)) {
+        // The input uses the WBO format.
+        solver = factory.createPseudoBooleanSolver();
+        parser = new WboParser(scanner, dynamic_cast<IUniversePseudoBooleanSolver *>(solver), configuration);
 
     } else if (c == '*') {
         // The input uses the OPB format.
         solver = factory.createPseudoBooleanSolver();
-        parser = new OpbParser(scanner, dynamic_cast<IUniversePseudoBooleanSolver *>(solver));
+        parser = new OpbParser(scanner, dynamic_cast<IUniversePseudoBooleanSolver *>(solver), configuration);
 
     } else if (c == '<') {
         // The input uses the XCSP3 format.
         solver = factory.createCspSolver();
-        parser = new AutisXCSPParserAdapter(scanner, dynamic_cast<IUniverseCspSolver *>(solver));
+        parser = new AutisXCSPParserAdapter(scanner, dynamic_cast<IUniverseCspSolver *>(solver), nullptr, configuration);
 
     } else {
         // The format is not recognized.
@@ -81,3 +382,105 @@ Universe::IUniverseSolver *Autis::parse(istream &input, IUniverseSolverFactory &
     delete parser;
     return solver;
 }
+
+vector<IUniverseSolver *> Autis::parse(const string &path, const vector<IUniverseSolverFactory *> &factories,
+        const ParserConfiguration &configuration) {
+    return feedPortfolio(readInstance(path, configuration), factories);
+}
+
+vector<IUniverseSolver *> Autis::parse(istream &input, const vector<IUniverseSolverFactory *> &factories,
+        const ParserConfiguration &configuration) {
+    return feedPortfolio(readInstance(input, configuration), factories);
+}
+
+vector<IUniverseSolver *> Autis::parse(Scanner &scanner, const vector<IUniverseSolverFactory *> &factories,
+        const ParserConfiguration &configuration) {
+    return feedPortfolio(readInstance(scanner, configuration), factories);
+}
+
+Instance Autis::readInstance(const string &path, const ParserConfiguration &configuration) {
+    if (configuration.getCache() != nullptr) {
+        // The instance is read through the cache.
+        uint64_t fingerprint;
+        return readFingerprintedInstance(path, configuration, fingerprint);
+    }
+
+    return withScanner(path, [&](Scanner &scanner) {
+        return readInstance(scanner, configuration);
+    });
+}
+
+Instance Autis::readInstance(istream &input, const ParserConfiguration &configuration) {
+    Scanner scanner(input);
+    return readInstance(scanner, configuration);
+}
+
+Instance Autis::readInstance(Scanner &scanner, const ParserConfiguration &configuration) {
+    char c;
+    if (!scanner.look(c)) {
+        // The input stream is empty.
+        throw ParseException("Input is empty");
+    }
+
+    if (c == SNAPSHOT_MAGIC[0]) {
+        // The input is a snapshot of an instance that has already been read.
+        return readSnapshot(scanner);
+    }
+
+    if (isWcnf(scanner)) {
+        // The input uses the WCNF format.
+        Instance instance(InstanceType::SAT);
+        WcnfParser parser(scanner, nullptr, configuration);
+        parser.parse(instance);
+        return instance;
+    }
+
+    if ((c == 'c') || (c == 'p')) {
+        // The input uses the CNF format.
+        Instance instance(InstanceType::SAT);
+        CnfParser parser(scanner, nullptr, configuration);
+        parser.parse(instance);
+        return instance;
+    }
+
+    if ((c == '*') && isWbo(scanner)) {
+        // The input uses the WBO format.
+        Instance instance(InstanceType::PSEUDO_BOOLEAN);
+        WboParser parser(scanner, nullptr, configuration);
+        parser.parse(instance);
+        return instance;
+    }
+
+    if (c == '*') {
+        // The input uses the OPB format.
+        Instance instance(InstanceType::PSEUDO_BOOLEAN);
+        OpbParser parser(scanner, nullptr, configuration);
+        parser.parse(instance);
+        return instance;
+    }
+
+    if (c == '<') {
+        // The input uses the XCSP3 format.
+        Instance instance(InstanceType::CSP);
+        AutisXCSPParserAdapter parser(scanner, nullptr, nullptr, configuration);
+        parser.parse(instance);
+        return instance;
+    }
+
+    // The format is not recognized.
+    throw ParseException("Could not determine input type");
+}
+
+uint64_t Autis::writeSnapshot(const string &path, const string &snapshotPath,
+        const ParserConfiguration &configuration) {
+    // The input is read only once, so that it may be a pipe.
+    uint64_t fingerprint;
+    auto instance = readFingerprintedInstance(path, configuration, fingerprint);
+
+    ofstream output(snapshotPath, ios::binary);
+    if (!output) {
+        throw ParseException("Could not create " + snapshotPath);
+    }
+    writeSnapshot(instance, output, fingerprint);
+    return fingerprint;
+}
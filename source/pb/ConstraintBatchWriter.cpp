@@ -0,0 +1,128 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file ConstraintBatchWriter.cpp
+ * @brief Provides a sink filling batches of pseudo-Boolean constraints into a queue.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <utility>
+
+#include "crillab-autis/core/Pipeline.hpp"
+#include "crillab-autis/pb/ConstraintBatchWriter.hpp"
+
+using namespace Autis;
+using namespace std;
+using namespace Universe;
+
+ConstraintBatchWriter::ConstraintBatchWriter(SpscQueue<ConstraintBatch> &queue) :
+        queue(queue),
+        batch() {
+    // Nothing to do: everything is already initialized.
+}
+
+void ConstraintBatchWriter::reserve(int nbVariables, int nbConstraints) {
+    // The size must be given before the constraints that follow.
+    flush();
+    batch.reserve(nbVariables, nbConstraints);
+}
+
+void ConstraintBatchWriter::addAtLeast(span<const int> literals, span<const BigInteger> coefficients,
+        const BigInteger &degree) {
+    add(RelationalOperator::AT_LEAST, literals, coefficients, degree);
+}
+
+void ConstraintBatchWriter::addAtMost(span<const int> literals, span<const BigInteger> coefficients,
+        const BigInteger &degree) {
+    add(RelationalOperator::AT_MOST, literals, coefficients, degree);
+}
+
+void ConstraintBatchWriter::addExactly(span<const int> literals, span<const BigInteger> coefficients,
+        const BigInteger &degree) {
+    add(RelationalOperator::EXACTLY, literals, coefficients, degree);
+}
+
+void ConstraintBatchWriter::beginObjective() {
+    batch.beginObjective();
+}
+
+void ConstraintBatchWriter::addObjectiveTerm(int literal, const BigInteger &coefficient) {
+    batch.addObjectiveTerm(literal, coefficient);
+    if (batch.objectiveLiterals.size() >= BATCH_SIZE) {
+        flush();
+    }
+}
+
+void ConstraintBatchWriter::endObjective() {
+    batch.endObjective();
+}
+
+void ConstraintBatchWriter::setTopCost(int64_t topCost) {
+    batch.setTopCost(topCost);
+}
+
+void ConstraintBatchWriter::addSoftAtLeast(span<const int> literals, span<const BigInteger> coefficients,
+        const BigInteger &degree, int64_t weight) {
+    batch.addSoftAtLeast(literals, coefficients, degree, weight);
+    if (batch.literals.size() >= BATCH_SIZE) {
+        flush();
+    }
+}
+
+void ConstraintBatchWriter::addSoftAtMost(span<const int> literals, span<const BigInteger> coefficients,
+        const BigInteger &degree, int64_t weight) {
+    batch.addSoftAtMost(literals, coefficients, degree, weight);
+    if (batch.literals.size() >= BATCH_SIZE) {
+        flush();
+    }
+}
+
+void ConstraintBatchWriter::addSoftExactly(span<const int> literals, span<const BigInteger> coefficients,
+        const BigInteger &degree, int64_t weight) {
+    batch.addSoftExactly(literals, coefficients, degree, weight);
+    if (batch.literals.size() >= BATCH_SIZE) {
+        flush();
+    }
+}
+
+void ConstraintBatchWriter::flush() {
+    if (batch.empty()) {
+        // There is nothing to push.
+        return;
+    }
+
+    if (!queue.push(std::move(batch))) {
+        throw PipelineCancelledException();
+    }
+    batch = ConstraintBatch();
+}
+
+void ConstraintBatchWriter::add(RelationalOperator relationalOperator, span<const int> literals,
+        span<const BigInteger> coefficients, const BigInteger &degree) {
+    batch.add(relationalOperator, literals, coefficients, degree);
+    if (batch.literals.size() >= BATCH_SIZE) {
+        flush();
+    }
+}
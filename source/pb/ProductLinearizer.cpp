@@ -0,0 +1,122 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file ProductLinearizer.cpp
+ * @brief Replaces the products of literals appearing in OPB inputs by auxiliary variables.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <algorithm>
+#include <climits>
+
+#include <crillab-except/except.hpp>
+
+#include "crillab-autis/core/ContentHash.hpp"
+#include "crillab-autis/pb/ProductLinearizer.hpp"
+
+using namespace Autis;
+using namespace Except;
+using namespace std;
+
+ProductLinearizer::ProductLinearizer() :
+        numberOfDeclaredVariables(0),
+        products(),
+        hashes(),
+        table(16, EMPTY) {
+    // Nothing to do: everything is already initialized.
+}
+
+void ProductLinearizer::reset(int nbVariables) {
+    numberOfDeclaredVariables = nbVariables;
+    products.clear();
+    hashes.clear();
+    fill(table.begin(), table.end(), EMPTY);
+}
+
+int ProductLinearizer::linearize(vector<int> &product, bool &fresh) {
+    // Normalizing the product, so that equal products have the same literals.
+    sort(product.begin(), product.end());
+    product.erase(unique(product.begin(), product.end()), product.end());
+    fresh = false;
+    if (product.size() == 1) {
+        // This is not a product anymore.
+        return product[0];
+    }
+
+    // Looking for the product in the table.
+    auto value = hash(product);
+    auto mask = table.size() - 1;
+    auto slot = static_cast<size_t>(value) & mask;
+    for (; table[slot] != EMPTY; slot = (slot + 1) & mask) {
+        auto index = table[slot];
+        if ((hashes[index] == value) && ranges::equal(products[index], product)) {
+            // The product has already been seen.
+            return numberOfDeclaredVariables + 1 + static_cast<int>(index);
+        }
+    }
+
+    // This is a new product, which needs a new variable.
+    if (products.size() >= static_cast<size_t>(INT_MAX - numberOfDeclaredVariables)) {
+        throw ParseException("Too many products to linearize");
+    }
+    auto index = static_cast<uint32_t>(products.add(product));
+    hashes.push_back(value);
+    table[slot] = index;
+    if (2 * products.size() > table.size()) {
+        // Keeping the load factor of the table below 1/2.
+        grow();
+    }
+
+    fresh = true;
+    return numberOfDeclaredVariables + 1 + static_cast<int>(index);
+}
+
+span<const int> ProductLinearizer::getProduct(int variable) const {
+    return products[static_cast<size_t>(variable - numberOfDeclaredVariables - 1)];
+}
+
+size_t ProductLinearizer::size() const {
+    return products.size();
+}
+
+int ProductLinearizer::getNumberOfVariables() const {
+    return numberOfDeclaredVariables + static_cast<int>(products.size());
+}
+
+uint64_t ProductLinearizer::hash(span<const int> product) {
+    return ContentHash::of(reinterpret_cast<const char *>(product.data()), product.size_bytes());
+}
+
+void ProductLinearizer::grow() {
+    table.assign(2 * table.size(), EMPTY);
+    auto mask = table.size() - 1;
+    for (size_t index = 0; index < hashes.size(); index++) {
+        auto slot = static_cast<size_t>(hashes[index]) & mask;
+        while (table[slot] != EMPTY) {
+            slot = (slot + 1) & mask;
+        }
+        table[slot] = static_cast<uint32_t>(index);
+    }
+}
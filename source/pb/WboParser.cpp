@@ -0,0 +1,102 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file WboParser.cpp
+ * @brief Defines the parser for parsing weighted Boolean optimization problems (in the WBO format).
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <vector>
+
+#include "crillab-autis/core/Instance.hpp"
+#include "crillab-autis/core/Pipeline.hpp"
+#include "crillab-autis/pb/BasicWboParser.hpp"
+#include "crillab-autis/pb/ConstraintBatch.hpp"
+#include "crillab-autis/pb/ConstraintBatchWriter.hpp"
+#include "crillab-autis/pb/UniversePseudoBooleanSink.hpp"
+#include "crillab-autis/pb/WboParser.hpp"
+
+using namespace Autis;
+using namespace std;
+using namespace Universe;
+
+WboParser::WboParser(Scanner &scanner, IUniversePseudoBooleanSolver *solver,
+        const ParserConfiguration &configuration) :
+        AbstractParser(scanner, solver),
+        pbSolver(solver),
+        reservationListener(dynamic_cast<IReservationListener *>(solver)),
+        softConstraintListener(dynamic_cast<ISoftConstraintListener *>(solver)),
+        configuration(configuration) {
+    // Nothing to do: everything is already initialized.
+}
+
+void WboParser::parse() {
+    UniversePseudoBooleanSink sink(pbSolver, reservationListener, nullptr, softConstraintListener);
+    parse(sink);
+}
+
+void WboParser::parse(Instance &instance) {
+    parse(instance.getConstraints());
+}
+
+template <typename Sink>
+void WboParser::parse(Sink &sink) {
+    if (configuration.isPipelined()) {
+        // The input is read on another thread.
+        parseInPipeline(sink);
+        return;
+    }
+
+    BasicWboParser<Sink> parser(scanner, sink, configuration.isLinearizingProducts());
+    parser.parse();
+    numberOfVariables = parser.getNumberOfVariables();
+    numberOfConstraints = parser.getNumberOfConstraints();
+}
+
+template <typename Sink>
+void WboParser::parseInPipeline(Sink &sink) {
+    vector<int> literals;
+    vector<BigInteger> coefficients;
+
+    runParserPipeline<ConstraintBatch, ConstraintBatchWriter>(PIPELINE_CAPACITY, [this](ConstraintBatchWriter &writer) {
+        // Reading the input and pushing the constraints by batches.
+        BasicWboParser<ConstraintBatchWriter> parser(scanner, writer, configuration.isLinearizingProducts());
+        parser.parse();
+        numberOfVariables = parser.getNumberOfVariables();
+        numberOfConstraints = parser.getNumberOfConstraints();
+
+    }, [&sink, &literals, &coefficients](ConstraintBatch &batch) {
+        // Giving the constraints to the solver, in the order of the input.
+        batch.replay(sink, literals, coefficients);
+    });
+}
+
+IUniversePseudoBooleanSolver *WboParser::getConcreteSolver() {
+    return pbSolver;
+}
+
+bool WboParser::isOptimization() {
+    return true;
+}
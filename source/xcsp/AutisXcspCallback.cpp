@@ -34,6 +34,8 @@
 #include <crillab-universe/csp/intension/UniverseIntensionConstraintFactory.hpp>
 #include <crillab-universe/csp/intension/UniverseJavaIntensionConstraintFactory.hpp>
 
+#include "crillab-autis/xcsp/IVariableHandleListener.hpp"
+
 #ifdef INTEGER
 #undef INTEGER
 #endif
@@ -46,7 +48,24 @@ using namespace XCSP3Core;
 
 AutisXcspCallback::AutisXcspCallback(IUniverseCspSolver *solver,
                                      AbstractUniverseIntensionConstraintFactory *intensionFactory) : solver(solver),
-                                                                                                     intensionFactory(intensionFactory) {
+                                                                                                     intensionFactory(intensionFactory),
+                                                                                                     pending(),
+                                                                                                     instance(&pending),
+                                                                                                     handles(),
+                                                                                                     direct((solver != nullptr) && (dynamic_cast<IVariableHandleListener *>(solver) == nullptr)),
+                                                                                                     compressingTuples(false),
+                                                                                                     intensions() {
+    intensionUsingString = false;
+}
+
+AutisXcspCallback::AutisXcspCallback(XcspInstance &instance) : solver(nullptr),
+                                                               intensionFactory(nullptr),
+                                                               pending(),
+                                                               instance(&instance),
+                                                               handles(),
+                                                               direct(false),
+                                                               compressingTuples(false),
+                                                               intensions() {
     intensionUsingString = false;
 }
 
@@ -59,19 +78,19 @@ AutisXcspCallback *AutisXcspCallback::newJavaInstance(IUniverseCspSolver *solver
 }
 
 void AutisXcspCallback::buildVariableInteger(string id, int minValue, int maxValue) {
-    solver->newVariable(id, minValue, maxValue);
+    add(CspOperation::NEW_VARIABLE_RANGE, id, minValue, maxValue);
 }
 
 void AutisXcspCallback::buildVariableInteger(string id, vector<int> &values) {
-    solver->newVariable(id, values);
+    add(CspOperation::NEW_VARIABLE_VALUES, id, values);
 }
 
 void AutisXcspCallback::buildConstraintAlldifferent(string id, vector<XVariable *> &list) {
-    solver->addAllDifferent(toStringVector(list));
+    add(CspOperation::ALL_DIFFERENT, list);
 }
 
 void AutisXcspCallback::buildConstraintIntension(string id, Tree *tree) {
-    solver->addIntension(createIntension(tree->root));
+    add(CspOperation::INTENSION, tree->root);
 }
 
 void AutisXcspCallback::buildConstraintExtension(
@@ -82,35 +101,48 @@ void AutisXcspCallback::buildConstraintExtension(
     }
 
     if (support) {
-        solver->addSupport(variable->id, toBigIntegerVector(tuples),hasStar);
+        add(CspOperation::UNARY_SUPPORT, variable->id, toBigIntegerVector(tuples), hasStar);
     } else {
-        solver->addConflicts(variable->id, toBigIntegerVector(tuples),hasStar);
+        add(CspOperation::UNARY_CONFLICTS, variable->id, toBigIntegerVector(tuples), hasStar);
     }
 }
 
 void AutisXcspCallback::buildConstraintExtension(
         string id, vector<XVariable *> list, vector<vector<int>> &tuples, bool support, bool hasStar) {
-    lastTuples=tuples;
-
-    if (support) {
-        solver->addSupport(toStringVector(list), toBigIntegerMatrix(tuples),hasStar);
+    if (compressingTuples) {
+        lastCompressedTuples = CompressedTupleTable::of(tuples, hasStar);
+        lastTuples = nullptr;
     } else {
-        solver->addConflicts(toStringVector(list), toBigIntegerMatrix(tuples),hasStar);
+        lastTuples = TupleTable::of(list.size(), tuples, hasStar);
+        lastCompressedTuples = nullptr;
     }
+    buildConstraintExtensionAs(id, list, support, hasStar);
 }
 
-
 void AutisXcspCallback::buildConstraintExtensionAs(string id, vector<XVariable *> list, bool support, bool hasStar) {
-    buildConstraintExtension(id,list,lastTuples,support,hasStar);
+    auto operation = support ? CspOperation::SUPPORT : CspOperation::CONFLICTS;
+
+    // The table is shared by all the constraints using it.
+    if (lastCompressedTuples != nullptr) {
+        add(operation, list, lastCompressedTuples);
+    } else if (lastTuples != nullptr) {
+        add(operation, list, lastTuples);
+    } else {
+        throw IllegalArgumentException("No tuples to reuse for constraint " + id);
+    }
+}
+
+void AutisXcspCallback::setCompressingTuples(bool enabled) {
+    compressingTuples = enabled;
 }
 
 void AutisXcspCallback::buildConstraintSum(
         string id, vector<XVariable *> &list, XCondition &cond) {
     if (cond.operandType == XCSP3Core::INTEGER) {
-        solver->addSum(toStringVector(list), operatorOf(cond), cond.val);
+        add(CspOperation::SUM, list, operatorOf(cond), cond.val);
 
     } else if (cond.operandType == XCSP3Core::VARIABLE) {
-        solver->addSum(toStringVector(list), operatorOf(cond), cond.var);
+        add(CspOperation::SUM, list, operatorOf(cond), cond.var);
 
     } else {
         throw UnsupportedOperationException("Unsupported condition type");
@@ -120,10 +152,12 @@ void AutisXcspCallback::buildConstraintSum(
 void AutisXcspCallback::buildConstraintSum(
         string id, vector<XVariable *> &list, vector<int> &coeffs, XCondition &cond) {
     if (cond.operandType == XCSP3Core::INTEGER) {
-        solver->addSum(toStringVector(list), toBigIntegerVector(coeffs), operatorOf(cond), cond.val);
+        add(CspOperation::SUM_WITH_COEFFICIENTS,
+                list, toBigIntegerVector(coeffs), operatorOf(cond), cond.val);
 
     } else if (cond.operandType == XCSP3Core::VARIABLE) {
-        solver->addSum(toStringVector(list), toBigIntegerVector(coeffs), operatorOf(cond), cond.var);
+        add(CspOperation::SUM_WITH_COEFFICIENTS,
+                list, toBigIntegerVector(coeffs), operatorOf(cond), cond.var);
 
     } else {
         throw UnsupportedOperationException("Unsupported condition type");
@@ -133,12 +167,12 @@ void AutisXcspCallback::buildConstraintSum(
 void AutisXcspCallback::buildConstraintSum(
         string id, vector<XVariable *> &list, vector<XVariable *> &coeffs, XCondition &cond) {
     if (cond.operandType == XCSP3Core::INTEGER) {
-        solver->addSumWithVariableCoefficients(
-                toStringVector(list), toStringVector(coeffs), operatorOf(cond), cond.val);
+        add(CspOperation::SUM_WITH_VARIABLE_COEFFICIENTS,
+                list, coeffs, operatorOf(cond), cond.val);
 
     } else if (cond.operandType == XCSP3Core::VARIABLE) {
-        solver->addSumWithVariableCoefficients(
-                toStringVector(list), toStringVector(coeffs), operatorOf(cond), cond.var);
+        add(CspOperation::SUM_WITH_VARIABLE_COEFFICIENTS,
+                list, coeffs, operatorOf(cond), cond.var);
 
     } else {
         throw UnsupportedOperationException("Unsupported condition type");
@@ -148,12 +182,10 @@ void AutisXcspCallback::buildConstraintSum(
 void AutisXcspCallback::buildConstraintSum(
         string id, vector<Tree *> &trees, XCondition &cond) {
     if (cond.operandType == XCSP3Core::INTEGER) {
-        solver->addSumIntension(
-                toIntensionConstraintVector(trees), operatorOf(cond), cond.val);
+        add(CspOperation::SUM_INTENSION, trees, operatorOf(cond), cond.val);
 
     } else if (cond.operandType == XCSP3Core::VARIABLE) {
-        solver->addSumIntension(
-                toIntensionConstraintVector(trees), operatorOf(cond), cond.var);
+        add(CspOperation::SUM_INTENSION, trees, operatorOf(cond), cond.var);
 
     } else {
         throw UnsupportedOperationException("Unsupported condition type");
@@ -163,12 +195,12 @@ void AutisXcspCallback::buildConstraintSum(
 void AutisXcspCallback::buildConstraintSum(
         string id, vector<Tree *> &trees, vector<int> &coefs, XCondition &cond) {
     if (cond.operandType == XCSP3Core::INTEGER) {
-        solver->addSumIntension(
-                toIntensionConstraintVector(trees), toBigIntegerVector(coefs), operatorOf(cond), cond.val);
+        add(CspOperation::SUM_INTENSION_WITH_COEFFICIENTS,
+                trees, toBigIntegerVector(coefs), operatorOf(cond), cond.val);
 
     } else if (cond.operandType == XCSP3Core::VARIABLE) {
-        solver->addSumIntension(
-                toIntensionConstraintVector(trees), toBigIntegerVector(coefs), operatorOf(cond), cond.var);
+        add(CspOperation::SUM_INTENSION_WITH_COEFFICIENTS,
+                trees, toBigIntegerVector(coefs), operatorOf(cond), cond.var);
 
     } else {
         throw UnsupportedOperationException("Unsupported condition type");
@@ -180,15 +212,15 @@ void AutisXcspCallback::buildObjectiveMaximize(
     if (type == ExpressionObjective::LEX_O) {
         throw UnsupportedOperationException("LEX objective are not supported");
     } else if (type == ExpressionObjective::MAXIMUM_O) {
-        solver->maximizeMaximum(toStringVector(list), toBigIntegerVector(coefs));
+        add(CspOperation::MAXIMIZE_MAXIMUM_WITH_COEFFICIENTS, list, toBigIntegerVector(coefs));
     } else if (type == ExpressionObjective::MINIMUM_O) {
-        solver->maximizeMinimum(toStringVector(list), toBigIntegerVector(coefs));
+        add(CspOperation::MAXIMIZE_MINIMUM_WITH_COEFFICIENTS, list, toBigIntegerVector(coefs));
     } else if (type == ExpressionObjective::NVALUES_O) {
-        solver->maximizeNValues(toStringVector(list), toBigIntegerVector(coefs));
+        add(CspOperation::MAXIMIZE_N_VALUES_WITH_COEFFICIENTS, list, toBigIntegerVector(coefs));
     } else if (type == ExpressionObjective::SUM_O) {
-        solver->maximizeSum(toStringVector(list), toBigIntegerVector(coefs));
+        add(CspOperation::MAXIMIZE_SUM_WITH_COEFFICIENTS, list, toBigIntegerVector(coefs));
     } else if (type == ExpressionObjective::PRODUCT_O) {
-        solver->maximizeProduct(toStringVector(list), toBigIntegerVector(coefs));
+        add(CspOperation::MAXIMIZE_PRODUCT_WITH_COEFFICIENTS, list, toBigIntegerVector(coefs));
     }
 }
 
@@ -211,186 +243,128 @@ UniverseRelationalOperator AutisXcspCallback::operatorOf(XCondition &cond) {
     }
 }
 
-IUniverseIntensionConstraint *AutisXcspCallback::createIntension(Node *node) {
+IntensionOperator AutisXcspCallback::intensionOperatorOf(ExpressionType type) {
+    switch (type) {
+        case ExpressionType::OABS:
+            return IntensionOperator::ABS;
+        case ExpressionType::OADD:
+            return IntensionOperator::ADD;
+        case ExpressionType::ODIST:
+            return IntensionOperator::DIST;
+        case ExpressionType::ODIV:
+            return IntensionOperator::DIV;
+        case ExpressionType::OMAX:
+            return IntensionOperator::MAX;
+        case ExpressionType::OMIN:
+            return IntensionOperator::MIN;
+        case ExpressionType::OMOD:
+            return IntensionOperator::MOD;
+        case ExpressionType::OMUL:
+            return IntensionOperator::MULT;
+        case ExpressionType::ONEG:
+            return IntensionOperator::NEG;
+        case ExpressionType::OPOW:
+            return IntensionOperator::POW;
+        case ExpressionType::OSQR:
+            return IntensionOperator::SQR;
+        case ExpressionType::OSUB:
+            return IntensionOperator::SUB;
+        case ExpressionType::OIFF:
+            return IntensionOperator::IFF;
+        case ExpressionType::OAND:
+            return IntensionOperator::AND;
+        case ExpressionType::OIMP:
+            return IntensionOperator::IMP;
+        case ExpressionType::ONOT:
+            return IntensionOperator::NOT;
+        case ExpressionType::OOR:
+            return IntensionOperator::OR;
+        case ExpressionType::OXOR:
+            return IntensionOperator::XOR;
+        case ExpressionType::OLT:
+            return IntensionOperator::LT;
+        case ExpressionType::OLE:
+            return IntensionOperator::LE;
+        case ExpressionType::OEQ:
+            return IntensionOperator::EQ;
+        case ExpressionType::ONE:
+            return IntensionOperator::NE;
+        case ExpressionType::OGE:
+            return IntensionOperator::GE;
+        case ExpressionType::OGT:
+            return IntensionOperator::GT;
+        default:
+            throw IllegalArgumentException("Unknown operator");
+    }
+}
+
+IntensionReference AutisXcspCallback::createIntension(Node *node) {
     if (node->type == ExpressionType::ODECIMAL) {
-        return intensionFactory->constant((long)((NodeConstant *)node)->val);
+        return instance->intensionConstant((long)((NodeConstant *)node)->val);
     }
 
     if (node->type == ExpressionType::OVAR) {
-        return intensionFactory->variable(((NodeVariable *)node)->var);
+        return instance->intensionVariable(((NodeVariable *)node)->var);
     }
 
-    switch (node->type) {
-        case ExpressionType::OABS: {
-            auto child = createIntension(node->parameters[0]);
-            return intensionFactory->abs(child);
-        }
-
-        case ExpressionType::OADD: {
-            vector<IUniverseIntensionConstraint *> constrs;
-            for (auto child : node->parameters) {
-                constrs.push_back(createIntension(child));
-            }
-            return intensionFactory->add(constrs);
-        }
-
-        case ExpressionType::ODIST: {
-            auto child1 = createIntension(node->parameters[0]);
-            auto child2 = createIntension(node->parameters[1]);
-            return intensionFactory->dist(child1, child2);
-        }
-
-        case ExpressionType::ODIV: {
-            auto child1 = createIntension(node->parameters[0]);
-            auto child2 = createIntension(node->parameters[1]);
-            return intensionFactory->div(child1, child2);
-        }
-
-        case ExpressionType::OMAX: {
-            vector<IUniverseIntensionConstraint *> constrs;
-            for (auto child : node->parameters) {
-                constrs.push_back(createIntension(child));
-            }
-            return intensionFactory->max(constrs);
-        }
-
-        case ExpressionType::OMIN: {
-            vector<IUniverseIntensionConstraint *> constrs;
-            for (auto child : node->parameters) {
-                constrs.push_back(createIntension(child));
-            }
-            return intensionFactory->min(constrs);
-        }
-
-        case ExpressionType::OMOD: {
-            auto child1 = createIntension(node->parameters[0]);
-            auto child2 = createIntension(node->parameters[1]);
-            return intensionFactory->mod(child1, child2);
-        }
-
-        case ExpressionType::OMUL: {
-            vector<IUniverseIntensionConstraint *> constrs;
-            for (auto child : node->parameters) {
-                constrs.push_back(createIntension(child));
-            }
-            return intensionFactory->mult(constrs);
-        }
-
-        case ExpressionType::ONEG: {
-            auto child = createIntension(node->parameters[0]);
-            return intensionFactory->neg(child);
-        }
-
-        case ExpressionType::OPOW: {
-            auto child1 = createIntension(node->parameters[0]);
-            auto child2 = createIntension(node->parameters[1]);
-            return intensionFactory->pow(child1, child2);
-        }
-
-        case ExpressionType::OSQR: {
-            auto child = createIntension(node->parameters[0]);
-            return intensionFactory->sqr(child);
-        }
-
-        case ExpressionType::OSUB: {
-            auto child1 = createIntension(node->parameters[0]);
-            auto child2 = createIntension(node->parameters[1]);
-            return intensionFactory->sub(child1, child2);
-        }
-
-        case ExpressionType::OIFF: {
-            vector<IUniverseIntensionConstraint *> constrs;
-            for (auto child : node->parameters) {
-                constrs.push_back(createIntension(child));
-            }
-            return intensionFactory->equiv(constrs);
-        }
-
-        case ExpressionType::OAND: {
-            vector<IUniverseIntensionConstraint *> constrs;
-            for (auto child : node->parameters) {
-                constrs.push_back(createIntension(child));
-            }
-            return intensionFactory->conjunction(constrs);
-        }
-
-        case ExpressionType::OIMP: {
-            auto child1 = createIntension(node->parameters[0]);
-            auto child2 = createIntension(node->parameters[1]);
-            return intensionFactory->impl(child1, child2);
-        }
-
-        case ExpressionType::ONOT: {
-            auto child = createIntension(node->parameters[0]);
-            return intensionFactory->negation(child);
-        }
-
-        case ExpressionType::OOR: {
-            vector<IUniverseIntensionConstraint *> constrs;
-            for (auto child : node->parameters) {
-                constrs.push_back(createIntension(child));
-            }
-            return intensionFactory->disjunction(constrs);
-        }
-
-        case ExpressionType::OXOR: {
-            vector<IUniverseIntensionConstraint *> constrs;
-            for (auto child : node->parameters) {
-                constrs.push_back(createIntension(child));
-            }
-            return intensionFactory->parity(constrs);
-        }
-
-        case ExpressionType::OLT: {
-            auto child1 = createIntension(node->parameters[0]);
-            auto child2 = createIntension(node->parameters[1]);
-            return intensionFactory->lt(child1, child2);
-        }
-
-        case ExpressionType::OLE: {
-            auto child1 = createIntension(node->parameters[0]);
-            auto child2 = createIntension(node->parameters[1]);
-            return intensionFactory->le(child1, child2);
-        }
+    auto intensionOperator = intensionOperatorOf(node->type);
+    vector<IntensionReference> children;
+    children.reserve(node->parameters.size());
+    for (auto child : node->parameters) {
+        children.push_back(createIntension(child));
+    }
+    return instance->intension(intensionOperator, children);
+}
 
-        case ExpressionType::OEQ: {
-            vector<IUniverseIntensionConstraint *> constrs;
-            for (auto child : node->parameters) {
-                constrs.push_back(createIntension(child));
-            }
-            return intensionFactory->eq(constrs);
-        }
+void AutisXcspCallback::releaseIntensions() {
+    if (instance->getNumberOfIntensionNodes() > MAX_SHARED_INTENSION_NODES) {
+        instance->clearIntensions();
+        intensions.clear();
+    }
+}
 
-        case ExpressionType::ONE: {
-            auto child1 = createIntension(node->parameters[0]);
-            auto child2 = createIntension(node->parameters[1]);
-            return intensionFactory->neq(child1, child2);
-        }
+CspOperand AutisXcspCallback::toOperand(const vector<XVariable *> &list) {
+    vector<string> identifiers;
+    identifiers.reserve(list.size());
+    for (auto variable : list) {
+        identifiers.push_back(variable->id);
+    }
+    return identifiers;
+}
 
-        case ExpressionType::OGE: {
-            auto child1 = createIntension(node->parameters[0]);
-            auto child2 = createIntension(node->parameters[1]);
-            return intensionFactory->ge(child1, child2);
+CspOperand AutisXcspCallback::toOperand(const vector<vector<XVariable *>> &matrix) {
+    vector<vector<string>> identifiers;
+    identifiers.reserve(matrix.size());
+    for (auto &row : matrix) {
+        auto &names = identifiers.emplace_back();
+        names.reserve(row.size());
+        for (auto variable : row) {
+            names.push_back(variable->id);
         }
+    }
+    return identifiers;
+}
 
-        case ExpressionType::OGT: {
-            auto child1 = createIntension(node->parameters[0]);
-            auto child2 = createIntension(node->parameters[1]);
-            return intensionFactory->gt(child1, child2);
-        }
+CspOperand AutisXcspCallback::toOperand(Node *node) {
+    return instance->intensionConstraint(createIntension(node), *intensionFactory, intensions);
+}
 
-        default: {
-            throw IllegalArgumentException("Unknown operator");
-        }
+CspOperand AutisXcspCallback::toOperand(const vector<Tree *> &trees) {
+    vector<IUniverseIntensionConstraint *> constraints;
+    constraints.reserve(trees.size());
+    for (auto tree : trees) {
+        auto expression = createIntension(tree->root);
+        constraints.push_back(instance->intensionConstraint(expression, *intensionFactory, intensions));
     }
+    return constraints;
 }
 
-vector<string> AutisXcspCallback::toStringVector(const vector<XVariable *> &list) {
-    vector<string> vars;
+VariableListReference AutisXcspCallback::toVariableList(const vector<XVariable *> &list) {
+    handles.clear();
     for (auto variable : list) {
-        vars.push_back(variable->id);
+        handles.push_back(instance->variable(variable->id));
     }
-    return vars;
+    return instance->variables(handles);
 }
 
 vector<BigInteger> AutisXcspCallback::toBigIntegerVector(const vector<int> &integers) {
@@ -401,9 +375,8 @@ vector<BigInteger> AutisXcspCallback::toBigIntegerVector(const vector<int> &inte
     return list;
 }
 
-vector<IUniverseIntensionConstraint *> AutisXcspCallback::toIntensionConstraintVector(
-        const vector<Tree *> &expressions) {
-    vector<IUniverseIntensionConstraint *> lists;
+vector<IntensionReference> AutisXcspCallback::toIntensionConstraintVector(const vector<Tree *> &expressions) {
+    vector<IntensionReference> lists;
     for (auto expr : expressions) {
         lists.push_back(createIntension(expr->root));
     }
@@ -418,112 +391,118 @@ vector<vector<BigInteger>> AutisXcspCallback::toBigIntegerMatrix(const vector<ve
     return lists;
 }
 
-vector<vector<string>> AutisXcspCallback::toStringMatrix(const vector<vector<XCSP3Core::XVariable *>> &matrix) {
-    vector<vector<string>> lists;
-    for (auto &i : matrix) {
-        lists.push_back(toStringVector(i));
+VariableMatrixReference AutisXcspCallback::toVariableMatrix(const vector<vector<XCSP3Core::XVariable *>> &matrix) {
+    vector<VariableListReference> rows;
+    rows.reserve(matrix.size());
+    for (auto &row : matrix) {
+        rows.push_back(toVariableList(row));
     }
-    return lists;
+    return instance->variableMatrix(rows);
 }
 
 void AutisXcspCallback::buildConstraintPrimitive(std::string id, XCSP3Core::OrderType op, XCSP3Core::XVariable *x, int k,
                                                  XCSP3Core::XVariable *y) {
-    solver->addPrimitive(x->id, UniverseArithmeticOperator::ADD, k, asRelationalOperator(op), y->id);
+    add(CspOperation::PRIMITIVE_ARITHMETIC_CONSTANT,
+            x->id, UniverseArithmeticOperator::ADD, k, asRelationalOperator(op), y->id);
 }
 
 void AutisXcspCallback::buildConstraintPrimitive(std::string id, XCSP3Core::OrderType op, XCSP3Core::XVariable *x, int k) {
-    solver->addPrimitive(x->id, asRelationalOperator(op), k);
+    add(CspOperation::PRIMITIVE, x->id, asRelationalOperator(op), k);
 }
 
 void AutisXcspCallback::buildConstraintPrimitive(std::string id, XCSP3Core::XVariable *x, bool in, int min, int max) {
-    solver->addPrimitive(x->id, in ? UniverseSetBelongingOperator::IN : UniverseSetBelongingOperator::NOT_IN, min, max);
+    add(CspOperation::PRIMITIVE_IN_RANGE,
+            x->id, in ? UniverseSetBelongingOperator::IN : UniverseSetBelongingOperator::NOT_IN, min, max);
 }
 
 void AutisXcspCallback::buildConstraintMult(std::string id, XCSP3Core::XVariable *x, XCSP3Core::XVariable *y,
                                             XCSP3Core::XVariable *z) {
-    solver->addPrimitive(x->id, UniverseArithmeticOperator::MULT, y->id, UniverseRelationalOperator::EQ, z->id);
+    add(CspOperation::PRIMITIVE_ARITHMETIC,
+            x->id, UniverseArithmeticOperator::MULT, y->id, UniverseRelationalOperator::EQ, z->id);
 }
 
 void AutisXcspCallback::buildConstraintAlldifferent(std::string id, vector<XCSP3Core::Tree *> &list) {
-    solver->addAllDifferentIntension(toIntensionConstraintVector(list));
+    add(CspOperation::ALL_DIFFERENT_INTENSION, list);
 }
 
 void AutisXcspCallback::buildConstraintAlldifferentExcept(std::string id, vector<XCSP3Core::XVariable *> &list,
                                                           vector<int> &except) {
-    solver->addAllDifferent(toStringVector(list), toBigIntegerVector(except));
+    add(CspOperation::ALL_DIFFERENT_EXCEPT, list, toBigIntegerVector(except));
 }
 
 void AutisXcspCallback::buildConstraintAlldifferentList(std::string id, vector<std::vector<XCSP3Core::XVariable *>> &lists) {
-    solver->addAllDifferentList(toStringMatrix(lists));
+    add(CspOperation::ALL_DIFFERENT_LIST, lists);
 }
 
 void AutisXcspCallback::buildConstraintAlldifferentMatrix(std::string id,
                                                           vector<std::vector<XCSP3Core::XVariable *>> &matrix) {
-    solver->addAllDifferentMatrix(toStringMatrix(matrix));
+    add(CspOperation::ALL_DIFFERENT_MATRIX, matrix);
 }
 
 void AutisXcspCallback::buildConstraintAllEqual(std::string id, vector<XCSP3Core::XVariable *> &list) {
-    solver->addAllEqual(toStringVector(list));
+    add(CspOperation::ALL_EQUAL, list);
 }
 
 void AutisXcspCallback::buildConstraintAllEqual(std::string id, vector<XCSP3Core::Tree *> &list) {
-    solver->addAllEqualIntension(toIntensionConstraintVector(list));
+    add(CspOperation::ALL_EQUAL_INTENSION, list);
 }
 
 void AutisXcspCallback::buildConstraintNotAllEqual(std::string id, vector<XCSP3Core::XVariable *> &list) {
-    solver->addNotAllEqual(toStringVector(list));
+    add(CspOperation::NOT_ALL_EQUAL, list);
 }
 
 void AutisXcspCallback::buildConstraintOrdered(std::string id, vector<XCSP3Core::XVariable *> &list,
                                                XCSP3Core::OrderType order) {
-    solver->addOrdered(toStringVector(list), asRelationalOperator(order));
+    add(CspOperation::ORDERED, list, asRelationalOperator(order));
 }
 
 void AutisXcspCallback::buildConstraintOrdered(std::string id, vector<XCSP3Core::XVariable *> &list, vector<int> &lengths,
                                                XCSP3Core::OrderType order) {
-    solver->addOrderedWithConstantLength(toStringVector(list), toBigIntegerVector(lengths),
-                                         asRelationalOperator(order));
+    add(CspOperation::ORDERED_WITH_CONSTANT_LENGTH,
+            list, toBigIntegerVector(lengths), asRelationalOperator(order));
 }
 
 void AutisXcspCallback::buildConstraintLex(std::string id, vector<std::vector<XCSP3Core::XVariable *>> &lists,
                                            XCSP3Core::OrderType order) {
-    solver->addLex(toStringMatrix(lists), asRelationalOperator(order));
+    add(CspOperation::LEX, lists, asRelationalOperator(order));
 }
 
 void AutisXcspCallback::buildConstraintLexMatrix(std::string id, vector<std::vector<XCSP3Core::XVariable *>> &matrix,
                                                  XCSP3Core::OrderType order) {
-    solver->addLexMatrix(toStringMatrix(matrix), asRelationalOperator(order));
+    add(CspOperation::LEX_MATRIX, matrix, asRelationalOperator(order));
 }
 
 void AutisXcspCallback::buildConstraintAtMost(std::string id, vector<XCSP3Core::XVariable *> &list, int value, int k) {
-    solver->addAtMost(toStringVector(list), value, k);
+    add(CspOperation::AT_MOST, list, value, k);
 }
 
 void AutisXcspCallback::buildConstraintAtLeast(std::string id, vector<XCSP3Core::XVariable *> &list, int value, int k) {
-    solver->addAtLeast(toStringVector(list), value, k);
+    add(CspOperation::AT_LEAST, list, value, k);
 }
 
 void AutisXcspCallback::buildConstraintExactlyK(std::string id, vector<XCSP3Core::XVariable *> &list, int value, int k) {
-    solver->addExactly(toStringVector(list), value, k);
+    add(CspOperation::EXACTLY, list, value, k);
 }
 
 void AutisXcspCallback::buildConstraintExactlyVariable(std::string id, vector<XCSP3Core::XVariable *> &list, int value,
                                                        XCSP3Core::XVariable *x) {
-    solver->addExactly(toStringVector(list), value, x->id);
+    add(CspOperation::EXACTLY_VARIABLE, list, value, x->id);
 }
 
 void AutisXcspCallback::buildConstraintAmong(std::string id, vector<XCSP3Core::XVariable *> &list, vector<int> &values,
                                              int k) {
-    solver->addAmong(toStringVector(list), toBigIntegerVector(values), k);
+    add(CspOperation::AMONG, list, toBigIntegerVector(values), k);
 }
 
 void AutisXcspCallback::buildConstraintCount(std::string id, vector<XCSP3Core::XVariable *> &list, vector<int> &values,
                                              XCondition &xc) {
     if (xc.operandType == XCSP3Core::INTEGER) {
-        solver->addCountWithConstantValues(toStringVector(list), toBigIntegerVector(values), operatorOf(xc), xc.val);
+        add(CspOperation::COUNT_WITH_CONSTANT_VALUES,
+                list, toBigIntegerVector(values), operatorOf(xc), xc.val);
 
     } else if (xc.operandType == XCSP3Core::VARIABLE) {
-        solver->addCountWithConstantValues(toStringVector(list), toBigIntegerVector(values), operatorOf(xc), xc.var);
+        add(CspOperation::COUNT_WITH_CONSTANT_VALUES,
+                list, toBigIntegerVector(values), operatorOf(xc), xc.var);
 
     } else {
         throw UnsupportedOperationException("Unsupported condition type");
@@ -533,10 +512,12 @@ void AutisXcspCallback::buildConstraintCount(std::string id, vector<XCSP3Core::X
 void AutisXcspCallback::buildConstraintCount(std::string id, vector<XCSP3Core::XVariable *> &list,
                                              vector<XCSP3Core::XVariable *> &values, XCondition &xc) {
     if (xc.operandType == XCSP3Core::INTEGER) {
-        solver->addCountWithVariableValues(toStringVector(list), toStringVector(list), operatorOf(xc), xc.val);
+        add(CspOperation::COUNT_WITH_VARIABLE_VALUES,
+                list, list, operatorOf(xc), xc.val);
 
     } else if (xc.operandType == XCSP3Core::VARIABLE) {
-        solver->addCountWithVariableValues(toStringVector(list), toStringVector(list), operatorOf(xc), xc.var);
+        add(CspOperation::COUNT_WITH_VARIABLE_VALUES,
+                list, list, operatorOf(xc), xc.var);
 
     } else {
         throw UnsupportedOperationException("Unsupported condition type");
@@ -546,10 +527,12 @@ void AutisXcspCallback::buildConstraintCount(std::string id, vector<XCSP3Core::X
 void AutisXcspCallback::buildConstraintCount(std::string id, vector<XCSP3Core::Tree *> &trees, vector<int> &values,
                                              XCondition &xc) {
     if (xc.operandType == XCSP3Core::INTEGER) {
-        solver->addCountIntensionWithConstantValues(toIntensionConstraintVector(trees), toBigIntegerVector(values), operatorOf(xc), xc.val);
+        add(CspOperation::COUNT_INTENSION_WITH_CONSTANT_VALUES,
+                trees, toBigIntegerVector(values), operatorOf(xc), xc.val);
 
     } else if (xc.operandType == XCSP3Core::VARIABLE) {
-        solver->addCountIntensionWithConstantValues(toIntensionConstraintVector(trees), toBigIntegerVector(values), operatorOf(xc), xc.var);
+        add(CspOperation::COUNT_INTENSION_WITH_CONSTANT_VALUES,
+                trees, toBigIntegerVector(values), operatorOf(xc), xc.var);
 
     } else {
         throw UnsupportedOperationException("Unsupported condition type");
@@ -559,10 +542,10 @@ void AutisXcspCallback::buildConstraintCount(std::string id, vector<XCSP3Core::T
 void AutisXcspCallback::buildConstraintNValues(std::string id, vector<XCSP3Core::XVariable *> &list, vector<int> &except,
                                                XCondition &xc) {
     if (xc.operandType == XCSP3Core::INTEGER) {
-        solver->addNValuesExcept(toStringVector(list), operatorOf(xc), xc.val, toBigIntegerVector(except));
+        add(CspOperation::N_VALUES_EXCEPT, list, operatorOf(xc), xc.val, toBigIntegerVector(except));
 
     } else if (xc.operandType == XCSP3Core::VARIABLE) {
-        solver->addNValuesExcept(toStringVector(list), operatorOf(xc), xc.var, toBigIntegerVector(except));
+        add(CspOperation::N_VALUES_EXCEPT, list, operatorOf(xc), xc.var, toBigIntegerVector(except));
 
     } else {
         throw UnsupportedOperationException("Unsupported condition type");
@@ -571,10 +554,10 @@ void AutisXcspCallback::buildConstraintNValues(std::string id, vector<XCSP3Core:
 
 void AutisXcspCallback::buildConstraintNValues(std::string id, vector<XCSP3Core::Tree *> &trees, XCondition &xc) {
     if (xc.operandType == XCSP3Core::INTEGER) {
-        solver->addNValuesIntension(toIntensionConstraintVector(trees), operatorOf(xc), xc.val);
+        add(CspOperation::N_VALUES_INTENSION, trees, operatorOf(xc), xc.val);
 
     } else if (xc.operandType == XCSP3Core::VARIABLE) {
-        solver->addNValuesIntension(toIntensionConstraintVector(trees), operatorOf(xc), xc.var);
+        add(CspOperation::N_VALUES_INTENSION, trees, operatorOf(xc), xc.var);
 
     } else {
         throw UnsupportedOperationException("Unsupported condition type");
@@ -583,10 +566,10 @@ void AutisXcspCallback::buildConstraintNValues(std::string id, vector<XCSP3Core:
 
 void AutisXcspCallback::buildConstraintNValues(std::string id, vector<XCSP3Core::XVariable *> &list, XCondition &xc) {
     if (xc.operandType == XCSP3Core::INTEGER) {
-        solver->addNValues(toStringVector(list), operatorOf(xc), xc.val);
+        add(CspOperation::N_VALUES, list, operatorOf(xc), xc.val);
 
     } else if (xc.operandType == XCSP3Core::VARIABLE) {
-        solver->addNValues(toStringVector(list), operatorOf(xc), xc.var);
+        add(CspOperation::N_VALUES, list, operatorOf(xc), xc.var);
 
     } else {
         throw UnsupportedOperationException("Unsupported condition type");
@@ -595,15 +578,15 @@ void AutisXcspCallback::buildConstraintNValues(std::string id, vector<XCSP3Core:
 
 void AutisXcspCallback::buildConstraintCardinality(std::string id, vector<XCSP3Core::XVariable *> &list,
                                                    std::vector<int> values, vector<int> &occurs, bool closed) {
-    solver->addCardinalityWithConstantValuesAndConstantCounts(toStringVector(list), toBigIntegerVector(values),
-                                                              toBigIntegerVector(occurs), closed);
+    add(CspOperation::CARDINALITY_WITH_CONSTANT_VALUES_AND_CONSTANT_COUNTS,
+            list, toBigIntegerVector(values), toBigIntegerVector(occurs), closed);
 }
 
 void AutisXcspCallback::buildConstraintCardinality(std::string id, vector<XCSP3Core::XVariable *> &list,
                                                    std::vector<int> values, vector<XCSP3Core::XVariable *> &occurs,
                                                    bool closed) {
-    solver->addCardinalityWithConstantValuesAndVariableCounts(toStringVector(list), toBigIntegerVector(values),
-                                                              toStringVector(occurs), closed);
+    add(CspOperation::CARDINALITY_WITH_CONSTANT_VALUES_AND_VARIABLE_COUNTS,
+            list, toBigIntegerVector(values), occurs, closed);
 }
 
 void AutisXcspCallback::buildConstraintCardinality(std::string id, vector<XCSP3Core::XVariable *> &list,
@@ -615,22 +598,22 @@ void AutisXcspCallback::buildConstraintCardinality(std::string id, vector<XCSP3C
         occursMin.push_back(interval.min);
         occursMax.push_back(interval.max);
     }
-    solver->addCardinalityWithConstantValuesAndConstantIntervalCounts(toStringVector(list), toBigIntegerVector(values),
-                                                                      occursMin, occursMax, closed);
+    add(CspOperation::CARDINALITY_WITH_CONSTANT_VALUES_AND_CONSTANT_INTERVAL_COUNTS,
+            list, toBigIntegerVector(values), occursMin, occursMax, closed);
 }
 
 void AutisXcspCallback::buildConstraintCardinality(std::string id, vector<XCSP3Core::XVariable *> &list,
                                                    std::vector<XCSP3Core::XVariable *> values, vector<int> &occurs,
                                                    bool closed) {
-    solver->addCardinalityWithVariableValuesAndConstantCounts(toStringVector(list), toStringVector(values),
-                                                              toBigIntegerVector(occurs), closed);
+    add(CspOperation::CARDINALITY_WITH_VARIABLE_VALUES_AND_CONSTANT_COUNTS,
+            list, values, toBigIntegerVector(occurs), closed);
 }
 
 void AutisXcspCallback::buildConstraintCardinality(std::string id, vector<XCSP3Core::XVariable *> &list,
                                                    std::vector<XCSP3Core::XVariable *> values,
                                                    vector<XCSP3Core::XVariable *> &occurs, bool closed) {
-    solver->addCardinalityWithVariableValuesAndVariableCounts(toStringVector(list), toStringVector(values),
-                                                              toStringVector(occurs), closed);
+    add(CspOperation::CARDINALITY_WITH_VARIABLE_VALUES_AND_VARIABLE_COUNTS,
+            list, values, occurs, closed);
 }
 
 void AutisXcspCallback::buildConstraintCardinality(std::string id, vector<XCSP3Core::XVariable *> &list,
@@ -642,16 +625,16 @@ void AutisXcspCallback::buildConstraintCardinality(std::string id, vector<XCSP3C
         occursMin.push_back(interval.min);
         occursMax.push_back(interval.max);
     }
-    solver->addCardinalityWithVariableValuesAndConstantIntervalCounts(toStringVector(list), toStringVector(values),
-                                                                      occursMin, occursMax, closed);
+    add(CspOperation::CARDINALITY_WITH_VARIABLE_VALUES_AND_CONSTANT_INTERVAL_COUNTS,
+            list, values, occursMin, occursMax, closed);
 }
 
 void AutisXcspCallback::buildConstraintMinimum(std::string id, vector<XCSP3Core::XVariable *> &list, XCondition &xc) {
     if (xc.operandType == XCSP3Core::INTEGER) {
-        solver->addMinimum(toStringVector(list), operatorOf(xc), xc.val);
+        add(CspOperation::MINIMUM, list, operatorOf(xc), xc.val);
 
     } else if (xc.operandType == XCSP3Core::VARIABLE) {
-        solver->addMinimum(toStringVector(list), operatorOf(xc), xc.var);
+        add(CspOperation::MINIMUM, list, operatorOf(xc), xc.var);
 
     } else {
         throw UnsupportedOperationException("Unsupported condition type");
@@ -660,10 +643,10 @@ void AutisXcspCallback::buildConstraintMinimum(std::string id, vector<XCSP3Core:
 
 void AutisXcspCallback::buildConstraintMinimum(std::string id, vector<XCSP3Core::Tree *> &list, XCondition &xc) {
     if (xc.operandType == XCSP3Core::INTEGER) {
-        solver->addMinimumIntension(toIntensionConstraintVector(list), operatorOf(xc), xc.val);
+        add(CspOperation::MINIMUM_INTENSION, list, operatorOf(xc), xc.val);
 
     } else if (xc.operandType == XCSP3Core::VARIABLE) {
-        solver->addMinimumIntension(toIntensionConstraintVector(list), operatorOf(xc), xc.var);
+        add(CspOperation::MINIMUM_INTENSION, list, operatorOf(xc), xc.var);
 
     } else {
         throw UnsupportedOperationException("Unsupported condition type");
@@ -672,10 +655,10 @@ void AutisXcspCallback::buildConstraintMinimum(std::string id, vector<XCSP3Core:
 
 void AutisXcspCallback::buildConstraintMaximum(std::string id, vector<XCSP3Core::XVariable *> &list, XCondition &xc) {
     if (xc.operandType == XCSP3Core::INTEGER) {
-        solver->addMaximum(toStringVector(list), operatorOf(xc), xc.val);
+        add(CspOperation::MAXIMUM, list, operatorOf(xc), xc.val);
 
     } else if (xc.operandType == XCSP3Core::VARIABLE) {
-        solver->addMaximum(toStringVector(list), operatorOf(xc), xc.var);
+        add(CspOperation::MAXIMUM, list, operatorOf(xc), xc.var);
 
     } else {
         throw UnsupportedOperationException("Unsupported condition type");
@@ -684,10 +667,10 @@ void AutisXcspCallback::buildConstraintMaximum(std::string id, vector<XCSP3Core:
 
 void AutisXcspCallback::buildConstraintMaximum(std::string id, vector<XCSP3Core::Tree *> &list, XCondition &xc) {
     if (xc.operandType == XCSP3Core::INTEGER) {
-        solver->addMaximumIntension(toIntensionConstraintVector(list), operatorOf(xc), xc.val);
+        add(CspOperation::MAXIMUM_INTENSION, list, operatorOf(xc), xc.val);
 
     } else if (xc.operandType == XCSP3Core::VARIABLE) {
-        solver->addMaximumIntension(toIntensionConstraintVector(list), operatorOf(xc), xc.var);
+        add(CspOperation::MAXIMUM_INTENSION, list, operatorOf(xc), xc.var);
 
     } else {
         throw UnsupportedOperationException("Unsupported condition type");
@@ -695,16 +678,18 @@ void AutisXcspCallback::buildConstraintMaximum(std::string id, vector<XCSP3Core:
 }
 
 void AutisXcspCallback::buildConstraintElement(std::string id, vector<XCSP3Core::XVariable *> &list, int value) {
-    solver->addElement(toStringVector(list),Universe::UniverseRelationalOperator::EQ, value);
+    add(CspOperation::ELEMENT_CONSTANT, list, Universe::UniverseRelationalOperator::EQ, value);
 }
 
 void AutisXcspCallback::buildConstraintElement(std::string id, vector<XCSP3Core::XVariable *> &list,
                                                XCSP3Core::XVariable *index, int startIndex, XCondition &xc) {
     if (xc.operandType == XCSP3Core::INTEGER) {
-        solver->addElement(toStringVector(list), startIndex, index->id, asRelationalOperator(xc.op), xc.val);
+        add(CspOperation::ELEMENT_WITH_INDEX,
+                list, startIndex, index->id, asRelationalOperator(xc.op), xc.val);
 
     } else if (xc.operandType == XCSP3Core::VARIABLE) {
-        solver->addElement(toStringVector(list), startIndex, index->id,asRelationalOperator(xc.op), xc.var);
+        add(CspOperation::ELEMENT_WITH_INDEX,
+                list, startIndex, index->id, asRelationalOperator(xc.op), xc.var);
 
     } else {
         throw UnsupportedOperationException("Unsupported condition type");
@@ -714,7 +699,9 @@ void AutisXcspCallback::buildConstraintElement(std::string id, vector<XCSP3Core:
 void AutisXcspCallback::buildConstraintElement(std::string id, vector<std::vector<XCSP3Core::XVariable *>> &matrix,
                                                int startRowIndex, XCSP3Core::XVariable *rowIndex, int startColIndex,
                                                XCSP3Core::XVariable *colIndex, XCSP3Core::XVariable *value) {
-    solver->addElementMatrix(toStringMatrix(matrix), startRowIndex, rowIndex->id, startColIndex, colIndex->id,Universe::UniverseRelationalOperator::EQ, value->id);
+    add(CspOperation::ELEMENT_MATRIX_VARIABLE,
+            matrix, startRowIndex, rowIndex->id, startColIndex, colIndex->id,
+            Universe::UniverseRelationalOperator::EQ, value->id);
 }
 
 
@@ -722,64 +709,71 @@ void AutisXcspCallback::buildConstraintElement(std::string id, vector<std::vecto
 void AutisXcspCallback::buildConstraintElement(std::string id, vector<std::vector<XCSP3Core::XVariable *>> &matrix,
                                                int startRowIndex, XCSP3Core::XVariable *rowIndex, int startColIndex,
                                                XCSP3Core::XVariable *colIndex, int value) {
-    solver->addElementMatrix(toStringMatrix(matrix), startRowIndex, rowIndex->id, startColIndex, colIndex->id, Universe::UniverseRelationalOperator::EQ,value);
+    add(CspOperation::ELEMENT_MATRIX_CONSTANT,
+            matrix, startRowIndex, rowIndex->id, startColIndex, colIndex->id,
+            Universe::UniverseRelationalOperator::EQ, value);
 }
 
 void AutisXcspCallback::buildConstraintElement(std::string id, vector<std::vector<int>> &matrix, int startRowIndex,
                                                XCSP3Core::XVariable *rowIndex, int startColIndex,
                                                XCSP3Core::XVariable *colIndex, XCSP3Core::XVariable *value) {
-    solver->addElementConstantMatrix(toBigIntegerMatrix(matrix), startRowIndex, rowIndex->id, startColIndex, colIndex->id, Universe::UniverseRelationalOperator::EQ,value->id);
+    add(CspOperation::ELEMENT_CONSTANT_MATRIX,
+            toBigIntegerMatrix(matrix), startRowIndex, rowIndex->id, startColIndex, colIndex->id,
+            Universe::UniverseRelationalOperator::EQ, value->id);
 }
 
 void AutisXcspCallback::buildConstraintElement(std::string id, vector<XCSP3Core::XVariable *> &list,
                                                XCSP3Core::XVariable *value) {
-    solver->addElement(toStringVector(list), Universe::UniverseRelationalOperator::EQ,value->id);
+    add(CspOperation::ELEMENT_VARIABLE, list, Universe::UniverseRelationalOperator::EQ, value->id);
 }
 
 void AutisXcspCallback::buildConstraintChannel(std::string id, vector<XCSP3Core::XVariable *> &list, int startIndex) {
-    solver->addChannel(toStringVector(list), startIndex);
+    add(CspOperation::CHANNEL, list, startIndex);
 }
 
 void AutisXcspCallback::buildConstraintChannel(std::string id, vector<XCSP3Core::XVariable *> &list1, int startIndex1,
                                                vector<XCSP3Core::XVariable *> &list2, int startIndex2) {
-    solver->addChannel(toStringVector(list1), startIndex1, toStringVector(list2), startIndex2);
+    add(CspOperation::CHANNEL_BETWEEN_LISTS, list1, startIndex1, list2, startIndex2);
 }
 
 void AutisXcspCallback::buildConstraintChannel(std::string id, vector<XCSP3Core::XVariable *> &list, int startIndex,
                                                XCSP3Core::XVariable *value) {
-    solver->addChannel(toStringVector(list), startIndex, value->id);
+    add(CspOperation::CHANNEL_WITH_VALUE, list, startIndex, value->id);
 }
 
 void AutisXcspCallback::buildConstraintNoOverlap(std::string id, vector<XCSP3Core::XVariable *> &origins,
                                                  vector<int> &lengths, bool zeroIgnored) {
-    solver->addNoOverlap(toStringVector(origins), toBigIntegerVector(lengths), zeroIgnored);
+    add(CspOperation::NO_OVERLAP, origins, toBigIntegerVector(lengths), zeroIgnored);
 }
 
 void AutisXcspCallback::buildConstraintNoOverlap(std::string id, vector<XCSP3Core::XVariable *> &origins,
                                                  vector<XCSP3Core::XVariable *> &lengths, bool zeroIgnored) {
-    solver->addNoOverlapVariableLength(toStringVector(origins), toStringVector(lengths), zeroIgnored);
+    add(CspOperation::NO_OVERLAP_VARIABLE_LENGTH, origins, lengths, zeroIgnored);
 }
 
 void AutisXcspCallback::buildConstraintNoOverlap(std::string id, vector<std::vector<XCSP3Core::XVariable *>> &origins,
                                                  vector<std::vector<int>> &lengths, bool zeroIgnored) {
-    solver->addMultiDimensionalNoOverlap(toStringMatrix(origins), toBigIntegerMatrix(lengths), zeroIgnored);
+    add(CspOperation::MULTI_DIMENSIONAL_NO_OVERLAP, origins, toBigIntegerMatrix(lengths), zeroIgnored);
 }
 
 void AutisXcspCallback::buildConstraintNoOverlap(std::string id, vector<std::vector<XCSP3Core::XVariable *>> &origins,
                                                  vector<std::vector<XCSP3Core::XVariable *>> &lengths,
                                                  bool zeroIgnored) {
-    solver->addMultiDimensionalNoOverlapVariableLength(toStringMatrix(origins), toStringMatrix(lengths), zeroIgnored);
+    add(CspOperation::MULTI_DIMENSIONAL_NO_OVERLAP_VARIABLE_LENGTH,
+            origins, lengths, zeroIgnored);
 }
 
 void AutisXcspCallback::buildConstraintCumulative(std::string id, vector<XCSP3Core::XVariable *> &origins,
                                                   vector<int> &lengths, vector<int> &heights, XCondition &xc) {
     if (xc.operandType == XCSP3Core::INTEGER) {
-        solver->addCumulativeConstantLengthsConstantHeights(toStringVector(origins), toBigIntegerVector(lengths),
-                                                            toBigIntegerVector(heights), operatorOf(xc), xc.val);
+        add(CspOperation::CUMULATIVE_CONSTANT_LENGTHS_CONSTANT_HEIGHTS,
+                origins, toBigIntegerVector(lengths), toBigIntegerVector(heights), operatorOf(xc),
+                xc.val);
 
     } else if (xc.operandType == XCSP3Core::VARIABLE) {
-        solver->addCumulativeConstantLengthsConstantHeights(toStringVector(origins), toBigIntegerVector(lengths),
-                                                            toBigIntegerVector(heights), operatorOf(xc), xc.var);
+        add(CspOperation::CUMULATIVE_CONSTANT_LENGTHS_CONSTANT_HEIGHTS,
+                origins, toBigIntegerVector(lengths), toBigIntegerVector(heights), operatorOf(xc),
+                xc.var);
 
     } else {
         throw UnsupportedOperationException("Unsupported condition type");
@@ -790,12 +784,14 @@ void AutisXcspCallback::buildConstraintCumulative(std::string id, vector<XCSP3Co
                                                   vector<int> &lengths, vector<XCSP3Core::XVariable *> &varHeights,
                                                   XCondition &xc) {
     if (xc.operandType == XCSP3Core::INTEGER) {
-        solver->addCumulativeConstantLengthsVariableHeights(toStringVector(origins), toBigIntegerVector(lengths),
-                                                            toStringVector(varHeights), operatorOf(xc), xc.val);
+        add(CspOperation::CUMULATIVE_CONSTANT_LENGTHS_VARIABLE_HEIGHTS,
+                origins, toBigIntegerVector(lengths), varHeights, operatorOf(xc),
+                xc.val);
 
     } else if (xc.operandType == XCSP3Core::VARIABLE) {
-        solver->addCumulativeConstantLengthsVariableHeights(toStringVector(origins), toBigIntegerVector(lengths),
-                                                            toStringVector(varHeights), operatorOf(xc), xc.var);
+        add(CspOperation::CUMULATIVE_CONSTANT_LENGTHS_VARIABLE_HEIGHTS,
+                origins, toBigIntegerVector(lengths), varHeights, operatorOf(xc),
+                xc.var);
 
     } else {
         throw UnsupportedOperationException("Unsupported condition type");
@@ -806,12 +802,12 @@ void AutisXcspCallback::buildConstraintCumulative(std::string id, vector<XCSP3Co
                                                   vector<XCSP3Core::XVariable *> &lengths, vector<int> &heights,
                                                   XCondition &xc) {
     if (xc.operandType == XCSP3Core::INTEGER) {
-        solver->addCumulativeVariableLengthsConstantHeights(toStringVector(origins), toStringVector(lengths),
-                                                            toBigIntegerVector(heights), operatorOf(xc), xc.val);
+        add(CspOperation::CUMULATIVE_VARIABLE_LENGTHS_CONSTANT_HEIGHTS,
+                origins, lengths, toBigIntegerVector(heights), operatorOf(xc), xc.val);
 
     } else if (xc.operandType == XCSP3Core::VARIABLE) {
-        solver->addCumulativeVariableLengthsConstantHeights(toStringVector(origins), toStringVector(lengths),
-                                                            toBigIntegerVector(heights), operatorOf(xc), xc.var);
+        add(CspOperation::CUMULATIVE_VARIABLE_LENGTHS_CONSTANT_HEIGHTS,
+                origins, lengths, toBigIntegerVector(heights), operatorOf(xc), xc.var);
 
     } else {
         throw UnsupportedOperationException("Unsupported condition type");
@@ -822,12 +818,14 @@ void AutisXcspCallback::buildConstraintCumulative(std::string id, vector<XCSP3Co
                                                   vector<int> &lengths, vector<int> &heights,
                                                   vector<XCSP3Core::XVariable *> &ends, XCondition &xc) {
     if (xc.operandType == XCSP3Core::INTEGER) {
-        solver->addCumulativeConstantLengthsConstantHeights(toStringVector(origins), toBigIntegerVector(lengths), toStringVector(ends),
-                                                            toBigIntegerVector(heights), operatorOf(xc), xc.val);
+        add(CspOperation::CUMULATIVE_CONSTANT_LENGTHS_CONSTANT_HEIGHTS_WITH_ENDS,
+                origins, toBigIntegerVector(lengths), ends, toBigIntegerVector(heights),
+                operatorOf(xc), xc.val);
 
     } else if (xc.operandType == XCSP3Core::VARIABLE) {
-        solver->addCumulativeConstantLengthsConstantHeights(toStringVector(origins), toBigIntegerVector(lengths), toStringVector(ends),
-                                                            toBigIntegerVector(heights), operatorOf(xc), xc.var);
+        add(CspOperation::CUMULATIVE_CONSTANT_LENGTHS_CONSTANT_HEIGHTS_WITH_ENDS,
+                origins, toBigIntegerVector(lengths), ends, toBigIntegerVector(heights),
+                operatorOf(xc), xc.var);
 
     } else {
         throw UnsupportedOperationException("Unsupported condition type");
@@ -838,12 +836,14 @@ void AutisXcspCallback::buildConstraintCumulative(std::string id, vector<XCSP3Co
                                                   vector<int> &lengths, vector<XCSP3Core::XVariable *> &varHeights,
                                                   vector<XCSP3Core::XVariable *> &ends, XCondition &xc) {
     if (xc.operandType == XCSP3Core::INTEGER) {
-        solver->addCumulativeConstantLengthsVariableHeights(toStringVector(origins), toBigIntegerVector(lengths), toStringVector(ends),
-                                                            toStringVector(varHeights), operatorOf(xc), xc.val);
+        add(CspOperation::CUMULATIVE_CONSTANT_LENGTHS_VARIABLE_HEIGHTS_WITH_ENDS,
+                origins, toBigIntegerVector(lengths), ends, varHeights,
+                operatorOf(xc), xc.val);
 
     } else if (xc.operandType == XCSP3Core::VARIABLE) {
-        solver->addCumulativeConstantLengthsVariableHeights(toStringVector(origins), toBigIntegerVector(lengths), toStringVector(ends),
-                                                            toStringVector(varHeights), operatorOf(xc), xc.var);
+        add(CspOperation::CUMULATIVE_CONSTANT_LENGTHS_VARIABLE_HEIGHTS_WITH_ENDS,
+                origins, toBigIntegerVector(lengths), ends, varHeights,
+                operatorOf(xc), xc.var);
 
     } else {
         throw UnsupportedOperationException("Unsupported condition type");
@@ -855,12 +855,14 @@ void AutisXcspCallback::buildConstraintCumulative(std::string id, vector<XCSP3Co
                                                   vector<XCSP3Core::XVariable *> &heights,
                                                   vector<XCSP3Core::XVariable *> &ends, XCondition &xc) {
     if (xc.operandType == XCSP3Core::INTEGER) {
-        solver->addCumulativeVariableLengthsVariableHeights(toStringVector(origins), toStringVector(lengths), toStringVector(ends),
-                                                            toStringVector(heights), operatorOf(xc), xc.val);
+        add(CspOperation::CUMULATIVE_VARIABLE_LENGTHS_VARIABLE_HEIGHTS_WITH_ENDS,
+                origins, lengths, ends, heights,
+                operatorOf(xc), xc.val);
 
     } else if (xc.operandType == XCSP3Core::VARIABLE) {
-        solver->addCumulativeVariableLengthsVariableHeights(toStringVector(origins), toStringVector(lengths), toStringVector(ends),
-                                                            toStringVector(heights), operatorOf(xc), xc.var);
+        add(CspOperation::CUMULATIVE_VARIABLE_LENGTHS_VARIABLE_HEIGHTS_WITH_ENDS,
+                origins, lengths, ends, heights,
+                operatorOf(xc), xc.var);
 
     } else {
         throw UnsupportedOperationException("Unsupported condition type");
@@ -871,12 +873,14 @@ void AutisXcspCallback::buildConstraintCumulative(std::string id, vector<XCSP3Co
                                                   vector<XCSP3Core::XVariable *> &lengths, vector<int> &heights,
                                                   vector<XCSP3Core::XVariable *> &ends, XCondition &xc) {
     if (xc.operandType == XCSP3Core::INTEGER) {
-        solver->addCumulativeVariableLengthsConstantHeights(toStringVector(origins), toStringVector(lengths), toStringVector(ends),
-                                                            toBigIntegerVector(heights), operatorOf(xc), xc.val);
+        add(CspOperation::CUMULATIVE_VARIABLE_LENGTHS_CONSTANT_HEIGHTS_WITH_ENDS,
+                origins, lengths, ends, toBigIntegerVector(heights),
+                operatorOf(xc), xc.val);
 
     } else if (xc.operandType == XCSP3Core::VARIABLE) {
-        solver->addCumulativeVariableLengthsConstantHeights(toStringVector(origins), toStringVector(lengths), toStringVector(ends),
-                                                            toBigIntegerVector(heights), operatorOf(xc), xc.var);
+        add(CspOperation::CUMULATIVE_VARIABLE_LENGTHS_CONSTANT_HEIGHTS_WITH_ENDS,
+                origins, lengths, ends, toBigIntegerVector(heights),
+                operatorOf(xc), xc.var);
 
     } else {
         throw UnsupportedOperationException("Unsupported condition type");
@@ -887,12 +891,12 @@ void AutisXcspCallback::buildConstraintCumulative(std::string id, vector<XCSP3Co
                                                   vector<XCSP3Core::XVariable *> &lengths,
                                                   vector<XCSP3Core::XVariable *> &heights, XCondition &xc) {
     if (xc.operandType == XCSP3Core::INTEGER) {
-        solver->addCumulativeVariableLengthsVariableHeights(toStringVector(origins), toStringVector(lengths),
-                                                            toStringVector(heights), operatorOf(xc), xc.val);
+        add(CspOperation::CUMULATIVE_VARIABLE_LENGTHS_VARIABLE_HEIGHTS,
+                origins, lengths, heights, operatorOf(xc), xc.val);
 
     } else if (xc.operandType == XCSP3Core::VARIABLE) {
-        solver->addCumulativeVariableLengthsVariableHeights(toStringVector(origins), toStringVector(lengths),
-                                                            toStringVector(heights), operatorOf(xc), xc.var);
+        add(CspOperation::CUMULATIVE_VARIABLE_LENGTHS_VARIABLE_HEIGHTS,
+                origins, lengths, heights, operatorOf(xc), xc.var);
 
     } else {
         throw UnsupportedOperationException("Unsupported condition type");
@@ -901,20 +905,20 @@ void AutisXcspCallback::buildConstraintCumulative(std::string id, vector<XCSP3Co
 
 void AutisXcspCallback::buildConstraintInstantiation(std::string id, vector<XCSP3Core::XVariable *> &list,
                                                      vector<int> &values) {
-    solver->addInstantiation(toStringVector(list), toBigIntegerVector(values));
+    add(CspOperation::INSTANTIATION, list, toBigIntegerVector(values));
 }
 
 void AutisXcspCallback::buildConstraintClause(std::string id, vector<XCSP3Core::XVariable *> &positive,
                                               vector<XCSP3Core::XVariable *> &negative) {
-    solver->addClause(toStringVector(positive), toStringVector(negative));
+    add(CspOperation::CLAUSE, positive, negative);
 }
 
 void AutisXcspCallback::buildObjectiveMinimizeVariable(XCSP3Core::XVariable *x) {
-    solver->minimizeVariable(x->id);
+    add(CspOperation::MINIMIZE_VARIABLE, x->id);
 }
 
 void AutisXcspCallback::buildObjectiveMaximizeVariable(XCSP3Core::XVariable *x) {
-    solver->maximizeVariable(x->id);
+    add(CspOperation::MAXIMIZE_VARIABLE, x->id);
 }
 
 void AutisXcspCallback::buildObjectiveMinimize(XCSP3Core::ExpressionObjective type, vector<XCSP3Core::XVariable *> &list,
@@ -922,15 +926,15 @@ void AutisXcspCallback::buildObjectiveMinimize(XCSP3Core::ExpressionObjective ty
     if (type == ExpressionObjective::LEX_O) {
         throw UnsupportedOperationException("LEX objective are not supported");
     } else if (type == ExpressionObjective::MAXIMUM_O) {
-        solver->minimizeMaximum(toStringVector(list), toBigIntegerVector(coefs));
+        add(CspOperation::MINIMIZE_MAXIMUM_WITH_COEFFICIENTS, list, toBigIntegerVector(coefs));
     } else if (type == ExpressionObjective::MINIMUM_O) {
-        solver->minimizeMinimum(toStringVector(list), toBigIntegerVector(coefs));
+        add(CspOperation::MINIMIZE_MINIMUM_WITH_COEFFICIENTS, list, toBigIntegerVector(coefs));
     } else if (type == ExpressionObjective::NVALUES_O) {
-        solver->minimizeNValues(toStringVector(list), toBigIntegerVector(coefs));
+        add(CspOperation::MINIMIZE_N_VALUES_WITH_COEFFICIENTS, list, toBigIntegerVector(coefs));
     } else if (type == ExpressionObjective::SUM_O) {
-        solver->minimizeSum(toStringVector(list), toBigIntegerVector(coefs));
+        add(CspOperation::MINIMIZE_SUM_WITH_COEFFICIENTS, list, toBigIntegerVector(coefs));
     } else if (type == ExpressionObjective::PRODUCT_O) {
-        solver->minimizeProduct(toStringVector(list), toBigIntegerVector(coefs));
+        add(CspOperation::MINIMIZE_PRODUCT_WITH_COEFFICIENTS, list, toBigIntegerVector(coefs));
     }
 }
 
@@ -938,15 +942,15 @@ void AutisXcspCallback::buildObjectiveMinimize(XCSP3Core::ExpressionObjective ty
     if (type == ExpressionObjective::LEX_O) {
         throw UnsupportedOperationException("LEX objective are not supported");
     } else if (type == ExpressionObjective::MAXIMUM_O) {
-        solver->minimizeMaximum(toStringVector(list));
+        add(CspOperation::MINIMIZE_MAXIMUM, list);
     } else if (type == ExpressionObjective::MINIMUM_O) {
-        solver->minimizeMinimum(toStringVector(list));
+        add(CspOperation::MINIMIZE_MINIMUM, list);
     } else if (type == ExpressionObjective::NVALUES_O) {
-        solver->minimizeNValues(toStringVector(list));
+        add(CspOperation::MINIMIZE_N_VALUES, list);
     } else if (type == ExpressionObjective::SUM_O) {
-        solver->minimizeSum(toStringVector(list));
+        add(CspOperation::MINIMIZE_SUM, list);
     } else if (type == ExpressionObjective::PRODUCT_O) {
-        solver->minimizeProduct(toStringVector(list));
+        add(CspOperation::MINIMIZE_PRODUCT, list);
     }
 }
 
@@ -954,15 +958,15 @@ void AutisXcspCallback::buildObjectiveMaximize(XCSP3Core::ExpressionObjective ty
     if (type == ExpressionObjective::LEX_O) {
         throw UnsupportedOperationException("LEX objective are not supported");
     } else if (type == ExpressionObjective::MAXIMUM_O) {
-        solver->maximizeMaximum(toStringVector(list));
+        add(CspOperation::MAXIMIZE_MAXIMUM, list);
     } else if (type == ExpressionObjective::MINIMUM_O) {
-        solver->maximizeMinimum(toStringVector(list));
+        add(CspOperation::MAXIMIZE_MINIMUM, list);
     } else if (type == ExpressionObjective::NVALUES_O) {
-        solver->maximizeNValues(toStringVector(list));
+        add(CspOperation::MAXIMIZE_N_VALUES, list);
     } else if (type == ExpressionObjective::SUM_O) {
-        solver->maximizeSum(toStringVector(list));
+        add(CspOperation::MAXIMIZE_SUM, list);
     } else if (type == ExpressionObjective::PRODUCT_O) {
-        solver->maximizeProduct(toStringVector(list));
+        add(CspOperation::MAXIMIZE_PRODUCT, list);
     }
 }
 
@@ -971,15 +975,20 @@ void AutisXcspCallback::buildObjectiveMinimize(XCSP3Core::ExpressionObjective ty
     if (type == ExpressionObjective::LEX_O) {
         throw UnsupportedOperationException("LEX objective are not supported");
     } else if (type == ExpressionObjective::MAXIMUM_O) {
-        solver->minimizeExpressionMaximum(toIntensionConstraintVector(trees), toBigIntegerVector(coefs));
+        add(CspOperation::MINIMIZE_EXPRESSION_MAXIMUM_WITH_COEFFICIENTS,
+                trees, toBigIntegerVector(coefs));
     } else if (type == ExpressionObjective::MINIMUM_O) {
-        solver->minimizeExpressionMinimum(toIntensionConstraintVector(trees), toBigIntegerVector(coefs));
+        add(CspOperation::MINIMIZE_EXPRESSION_MINIMUM_WITH_COEFFICIENTS,
+                trees, toBigIntegerVector(coefs));
     } else if (type == ExpressionObjective::NVALUES_O) {
-        solver->minimizeExpressionNValues(toIntensionConstraintVector(trees), toBigIntegerVector(coefs));
+        add(CspOperation::MINIMIZE_EXPRESSION_N_VALUES_WITH_COEFFICIENTS,
+                trees, toBigIntegerVector(coefs));
     } else if (type == ExpressionObjective::SUM_O) {
-        solver->minimizeExpressionSum(toIntensionConstraintVector(trees), toBigIntegerVector(coefs));
+        add(CspOperation::MINIMIZE_EXPRESSION_SUM_WITH_COEFFICIENTS,
+                trees, toBigIntegerVector(coefs));
     } else if (type == ExpressionObjective::PRODUCT_O) {
-        solver->minimizeExpressionProduct(toIntensionConstraintVector(trees), toBigIntegerVector(coefs));
+        add(CspOperation::MINIMIZE_EXPRESSION_PRODUCT_WITH_COEFFICIENTS,
+                trees, toBigIntegerVector(coefs));
     }
 }
 
@@ -988,15 +997,20 @@ void AutisXcspCallback::buildObjectiveMaximize(XCSP3Core::ExpressionObjective ty
     if (type == ExpressionObjective::LEX_O) {
         throw UnsupportedOperationException("LEX objective are not supported");
     } else if (type == ExpressionObjective::MAXIMUM_O) {
-        solver->maximizeExpressionMaximum(toIntensionConstraintVector(trees), toBigIntegerVector(coefs));
+        add(CspOperation::MAXIMIZE_EXPRESSION_MAXIMUM_WITH_COEFFICIENTS,
+                trees, toBigIntegerVector(coefs));
     } else if (type == ExpressionObjective::MINIMUM_O) {
-        solver->maximizeExpressionMinimum(toIntensionConstraintVector(trees), toBigIntegerVector(coefs));
+        add(CspOperation::MAXIMIZE_EXPRESSION_MINIMUM_WITH_COEFFICIENTS,
+                trees, toBigIntegerVector(coefs));
     } else if (type == ExpressionObjective::NVALUES_O) {
-        solver->maximizeExpressionNValues(toIntensionConstraintVector(trees), toBigIntegerVector(coefs));
+        add(CspOperation::MAXIMIZE_EXPRESSION_N_VALUES_WITH_COEFFICIENTS,
+                trees, toBigIntegerVector(coefs));
     } else if (type == ExpressionObjective::SUM_O) {
-        solver->maximizeExpressionSum(toIntensionConstraintVector(trees), toBigIntegerVector(coefs));
+        add(CspOperation::MAXIMIZE_EXPRESSION_SUM_WITH_COEFFICIENTS,
+                trees, toBigIntegerVector(coefs));
     } else if (type == ExpressionObjective::PRODUCT_O) {
-        solver->maximizeExpressionProduct(toIntensionConstraintVector(trees), toBigIntegerVector(coefs));
+        add(CspOperation::MAXIMIZE_EXPRESSION_PRODUCT_WITH_COEFFICIENTS,
+                trees, toBigIntegerVector(coefs));
     }
 }
 
@@ -1004,15 +1018,15 @@ void AutisXcspCallback::buildObjectiveMinimize(XCSP3Core::ExpressionObjective ty
     if (type == ExpressionObjective::LEX_O) {
         throw UnsupportedOperationException("LEX objective are not supported");
     } else if (type == ExpressionObjective::MAXIMUM_O) {
-        solver->minimizeExpressionMaximum(toIntensionConstraintVector(trees));
+        add(CspOperation::MINIMIZE_EXPRESSION_MAXIMUM, trees);
     } else if (type == ExpressionObjective::MINIMUM_O) {
-        solver->minimizeExpressionMinimum(toIntensionConstraintVector(trees));
+        add(CspOperation::MINIMIZE_EXPRESSION_MINIMUM, trees);
     } else if (type == ExpressionObjective::NVALUES_O) {
-        solver->minimizeExpressionNValues(toIntensionConstraintVector(trees));
+        add(CspOperation::MINIMIZE_EXPRESSION_N_VALUES, trees);
     } else if (type == ExpressionObjective::SUM_O) {
-        solver->minimizeExpressionSum(toIntensionConstraintVector(trees));
+        add(CspOperation::MINIMIZE_EXPRESSION_SUM, trees);
     } else if (type == ExpressionObjective::PRODUCT_O) {
-        solver->minimizeExpressionProduct(toIntensionConstraintVector(trees));
+        add(CspOperation::MINIMIZE_EXPRESSION_PRODUCT, trees);
     }
 }
 
@@ -1020,15 +1034,15 @@ void AutisXcspCallback::buildObjectiveMaximize(XCSP3Core::ExpressionObjective ty
     if (type == ExpressionObjective::LEX_O) {
         throw UnsupportedOperationException("LEX objective are not supported");
     } else if (type == ExpressionObjective::MAXIMUM_O) {
-        solver->maximizeExpressionMaximum(toIntensionConstraintVector(trees));
+        add(CspOperation::MAXIMIZE_EXPRESSION_MAXIMUM, trees);
     } else if (type == ExpressionObjective::MINIMUM_O) {
-        solver->maximizeExpressionMinimum(toIntensionConstraintVector(trees));
+        add(CspOperation::MAXIMIZE_EXPRESSION_MINIMUM, trees);
     } else if (type == ExpressionObjective::NVALUES_O) {
-        solver->maximizeExpressionNValues(toIntensionConstraintVector(trees));
+        add(CspOperation::MAXIMIZE_EXPRESSION_N_VALUES, trees);
     } else if (type == ExpressionObjective::SUM_O) {
-        solver->maximizeExpressionSum(toIntensionConstraintVector(trees));
+        add(CspOperation::MAXIMIZE_EXPRESSION_SUM, trees);
     } else if (type == ExpressionObjective::PRODUCT_O) {
-        solver->maximizeExpressionProduct(toIntensionConstraintVector(trees));
+        add(CspOperation::MAXIMIZE_EXPRESSION_PRODUCT, trees);
     }
 }
 
@@ -31,16 +31,22 @@
 #include "crillab-autis/xcsp/AutisXcspParserAdapter.hpp"
 
 #include <crillab-universe/csp/UniverseJavaCspSolver.hpp>
+#include "crillab-autis/core/Instance.hpp"
 #include "crillab-autis/xcsp/AutisXcspCallback.hpp"
+#include "crillab-autis/xcsp/XcspStreamReader.hpp"
 #include "XCSP3CoreParser.h"
 
 using namespace Autis;
 using namespace Universe;
 using namespace XCSP3Core;
 
-AutisXCSPParserAdapter::AutisXCSPParserAdapter(
-    Scanner &scanner, IUniverseCspSolver *solver, XCSP3CoreCallbacks *callback) : AbstractParser(scanner, solver),
-                                                                                  callback(callback) {
+AutisXCSPParserAdapter::AutisXCSPParserAdapter(Scanner &scanner, IUniverseCspSolver *solver,
+        XCSP3CoreCallbacks *callback, const ParserConfiguration &configuration) :
+        AbstractParser(scanner, solver),
+        cspSolver(solver),
+        callback(callback),
+        configuration(configuration),
+        optimization(false) {
     // Nothing to do: everything is already initialized.
 }
 
@@ -48,14 +54,30 @@ void AutisXCSPParserAdapter::parse() {
     if (callback == nullptr) {
         // Inferring the most appropriate callback to use.
         AutisXcspCallback *cb = getCallback();
-        XCSP3CoreParser parser(cb);
-        parser.parse(scanner.getInput());
-        optimization = parser.isOptimization();
+        cb->setCompressingTuples(configuration.isCompressingTuples());
+        parse(*cb);
         delete cb;
 
     } else {
         // Using the specified callback to parse the input.
-        XCSP3CoreParser parser(callback);
+        parse(*callback);
+    }
+}
+
+void AutisXCSPParserAdapter::parse(Instance &instance) {
+    AutisXcspCallback cb(instance.getCspInstance());
+    cb.setCompressingTuples(configuration.isCompressingTuples());
+    parse(cb);
+}
+
+void AutisXCSPParserAdapter::parse(XCSP3CoreCallbacks &cb) {
+    if (configuration.isStreamingXcsp()) {
+        XcspStreamReader reader(scanner.getInput(), cb);
+        reader.read();
+        optimization = reader.isOptimization();
+
+    } else {
+        XCSP3CoreParser parser(&cb);
         parser.parse(scanner.getInput());
         optimization = parser.isOptimization();
     }
@@ -75,7 +97,7 @@ Autis::AutisXcspCallback *AutisXCSPParserAdapter::getCallback() {
 }
 
 IUniverseCspSolver *AutisXCSPParserAdapter::getConcreteSolver() {
-    return dynamic_cast<IUniverseCspSolver *>(AbstractParser::getConcreteSolver());
+    return cspSolver;
 }
 
 bool AutisXCSPParserAdapter::isOptimization() {
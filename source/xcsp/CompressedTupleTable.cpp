@@ -0,0 +1,324 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file CompressedTupleTable.cpp
+ * @brief Stores the tuples of an extension constraint as a multi-valued decision diagram.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+#include <crillab-except/except.hpp>
+
+#include "crillab-autis/core/ContentHash.hpp"
+#include "crillab-autis/xcsp/CompressedTupleTable.hpp"
+
+using namespace Autis;
+using namespace Except;
+using namespace std;
+
+namespace {
+
+    /**
+     * Computes the key used to sort a value of a column, so that stars come
+     * first and the other values keep their order.
+     *
+     * @param value The value to compute the key of.
+     * @param min The smallest value (other than a star) of the column.
+     *
+     * @return The key of the value.
+     */
+    inline uint64_t keyOf(int value, int64_t min) {
+        if (value == TupleTable::STAR) {
+            return 0;
+        }
+        return static_cast<uint64_t>(static_cast<int64_t>(value) - min) + 1;
+    }
+
+    /**
+     * Sorts tuples in lexicographic order with a least-significant-digit
+     * radix sort, processing the columns from the last to the first.
+     * Only the bytes of the keys that may be non-zero are processed, so that
+     * columns with small domains are sorted in a single pass.
+     *
+     * @param tuples The tuples to sort.
+     * @param arity The size of each tuple.
+     *
+     * @return The indices of the tuples, in sorted order.
+     */
+    vector<uint32_t> radixSort(const vector<vector<int>> &tuples, size_t arity) {
+        vector<uint32_t> order(tuples.size());
+        iota(order.begin(), order.end(), 0);
+        vector<uint32_t> buffer(tuples.size());
+        vector<uint64_t> keys(tuples.size());
+
+        for (auto column = arity; column-- > 0;) {
+            auto min = numeric_limits<int64_t>::max();
+            for (auto &tuple : tuples) {
+                if (tuple[column] != TupleTable::STAR) {
+                    min = std::min(min, static_cast<int64_t>(tuple[column]));
+                }
+            }
+
+            uint64_t maxKey = 0;
+            for (size_t i = 0; i < tuples.size(); i++) {
+                keys[i] = keyOf(tuples[i][column], min);
+                maxKey = max(maxKey, keys[i]);
+            }
+
+            // Each pass is a stable counting sort on one byte of the keys.
+            for (unsigned shift = 0; (shift < 64) && ((maxKey >> shift) != 0); shift += 8) {
+                array<size_t, 257> counts{};
+                for (auto index : order) {
+                    counts[((keys[index] >> shift) & 0xFF) + 1]++;
+                }
+                partial_sum(counts.begin(), counts.end(), counts.begin());
+                for (auto index : order) {
+                    buffer[counts[(keys[index] >> shift) & 0xFF]++] = index;
+                }
+                order.swap(buffer);
+            }
+        }
+
+        return order;
+    }
+
+    /**
+     * Computes the hash of the edges of a node.
+     *
+     * @param values The values labelling the edges.
+     * @param targets The nodes targeted by the edges.
+     *
+     * @return The hash of the edges.
+     */
+    uint64_t hashOf(span<const int> values, span<const uint32_t> targets) {
+        ContentHash hash;
+        hash.update(reinterpret_cast<const char *>(values.data()), values.size_bytes());
+        hash.update(reinterpret_cast<const char *>(targets.data()), targets.size_bytes());
+        return hash.digest();
+    }
+
+}
+
+CompressedTupleTable::CompressedTupleTable(size_t arity, size_t nbTuples, bool hasStar, uint32_t root,
+        vector<size_t> nodeOffsets, vector<int> edgeValues, vector<uint32_t> edgeTargets) :
+        arity(arity),
+        nbTuples(nbTuples),
+        star(hasStar),
+        root(root),
+        nodeOffsets(move(nodeOffsets)),
+        edgeValues(move(edgeValues)),
+        edgeTargets(move(edgeTargets)) {
+    auto &offsets = this->nodeOffsets;
+    if ((offsets.size() < 2) || (offsets.front() != 0) || !is_sorted(offsets.begin(), offsets.end())
+            || (offsets.back() != this->edgeValues.size()) || (offsets.back() != this->edgeTargets.size())) {
+        throw IllegalArgumentException("Malformed edges in compressed table");
+    }
+
+    auto nbNodes = getNumberOfNodes();
+    auto invalid = [nbNodes](uint32_t node) { return node >= nbNodes; };
+    if (invalid(root) || any_of(this->edgeTargets.begin(), this->edgeTargets.end(), invalid)) {
+        throw IllegalArgumentException("Malformed nodes in compressed table");
+    }
+}
+
+shared_ptr<const CompressedTupleTable> CompressedTupleTable::of(const vector<vector<int>> &tuples, bool hasStar) {
+    auto arity = tuples.empty() ? 0 : tuples[0].size();
+    for (auto &tuple : tuples) {
+        if (tuple.size() != arity) {
+            throw IllegalArgumentException("Tuples of different sizes in the same table");
+        }
+    }
+    if ((arity == 0) && !tuples.empty()) {
+        throw IllegalArgumentException("Empty tuples cannot be compressed");
+    }
+    if (tuples.size() > numeric_limits<uint32_t>::max()) {
+        throw IllegalArgumentException("Too many tuples to be compressed");
+    }
+
+    // Removing the duplicate tuples once they are sorted, while computing the
+    // first column in which each tuple differs from the previous one.
+    vector<const int *> sorted;
+    vector<size_t> firstDifferences;
+    for (auto index : radixSort(tuples, arity)) {
+        auto tuple = tuples[index].data();
+        size_t column = 0;
+        if (!sorted.empty()) {
+            auto previous = sorted.back();
+            while ((column < arity) && (tuple[column] == previous[column])) {
+                column++;
+            }
+            if (column == arity) {
+                continue;
+            }
+        }
+        sorted.push_back(tuple);
+        firstDifferences.push_back(column);
+    }
+
+    // The terminal node has no edges.
+    vector<size_t> nodeOffsets = {0, 0};
+    vector<int> edgeValues;
+    vector<uint32_t> edgeTargets;
+    if (sorted.empty()) {
+        nodeOffsets.push_back(0);
+        return make_shared<const CompressedTupleTable>(
+                arity, 0, hasStar, 1, move(nodeOffsets), move(edgeValues), move(edgeTargets));
+    }
+
+    // The prefix trie of the tuples is built from the last column to the
+    // first, so that the children of a node are already reduced when the
+    // node is built, and identical nodes are merged as soon as they appear.
+    // A node of a level starts at each tuple differing from the previous one
+    // before this level, and the node starting at a tuple of the next level
+    // is the target of the edge of this tuple.
+    vector<uint32_t> children(sorted.size(), TERMINAL);
+    unordered_multimap<uint64_t, uint32_t> uniqueNodes;
+    for (auto level = arity; level-- > 0;) {
+        uniqueNodes.clear();
+        for (size_t begin = 0; begin < sorted.size();) {
+            auto firstEdge = edgeValues.size();
+            auto end = begin;
+            do {
+                if ((end == begin) || (firstDifferences[end] <= level)) {
+                    edgeValues.push_back(sorted[end][level]);
+                    edgeTargets.push_back(children[end]);
+                }
+                end++;
+            } while ((end < sorted.size()) && (firstDifferences[end] >= level));
+
+            // Looking for an identical node built before.
+            auto values = span<const int>(edgeValues).subspan(firstEdge);
+            auto targets = span<const uint32_t>(edgeTargets).subspan(firstEdge);
+            auto hash = hashOf(values, targets);
+            auto node = static_cast<uint32_t>(nodeOffsets.size() - 1);
+            auto [first, last] = uniqueNodes.equal_range(hash);
+            for (auto it = first; it != last; ++it) {
+                auto offset = nodeOffsets[it->second];
+                auto size = nodeOffsets[it->second + 1] - offset;
+                if ((size == values.size())
+                        && ranges::equal(values, span<const int>(edgeValues).subspan(offset, size))
+                        && ranges::equal(targets, span<const uint32_t>(edgeTargets).subspan(offset, size))) {
+                    node = it->second;
+                    break;
+                }
+            }
+
+            if (node == nodeOffsets.size() - 1) {
+                // The node is a new one.
+                if (node == numeric_limits<uint32_t>::max()) {
+                    throw IllegalArgumentException("Too many nodes in compressed table");
+                }
+                nodeOffsets.push_back(edgeValues.size());
+                uniqueNodes.emplace(hash, node);
+            } else {
+                edgeValues.resize(firstEdge);
+                edgeTargets.resize(firstEdge);
+            }
+
+            children[begin] = node;
+            begin = end;
+        }
+    }
+
+    edgeValues.shrink_to_fit();
+    edgeTargets.shrink_to_fit();
+    nodeOffsets.shrink_to_fit();
+    return make_shared<const CompressedTupleTable>(arity, sorted.size(), hasStar, children[0],
+            move(nodeOffsets), move(edgeValues), move(edgeTargets));
+}
+
+size_t CompressedTupleTable::getArity() const {
+    return arity;
+}
+
+size_t CompressedTupleTable::size() const {
+    return nbTuples;
+}
+
+bool CompressedTupleTable::hasStar() const {
+    return star;
+}
+
+uint32_t CompressedTupleTable::getRoot() const {
+    return root;
+}
+
+size_t CompressedTupleTable::getNumberOfNodes() const {
+    return nodeOffsets.size() - 1;
+}
+
+span<const int> CompressedTupleTable::getValues(uint32_t node) const {
+    auto begin = nodeOffsets[node];
+    return span<const int>(edgeValues).subspan(begin, nodeOffsets[node + 1] - begin);
+}
+
+span<const uint32_t> CompressedTupleTable::getTargets(uint32_t node) const {
+    auto begin = nodeOffsets[node];
+    return span<const uint32_t>(edgeTargets).subspan(begin, nodeOffsets[node + 1] - begin);
+}
+
+span<const size_t> CompressedTupleTable::getNodeOffsets() const {
+    return nodeOffsets;
+}
+
+span<const int> CompressedTupleTable::getEdgeValues() const {
+    return edgeValues;
+}
+
+span<const uint32_t> CompressedTupleTable::getEdgeTargets() const {
+    return edgeTargets;
+}
+
+shared_ptr<const TupleTable> CompressedTupleTable::decompress() const {
+    vector<int> values;
+    values.reserve(nbTuples * arity);
+    vector<int> tuple(arity);
+
+    // Each path from the root to the terminal node is a tuple.
+    auto enumerate = [&](auto &self, uint32_t node, size_t level) -> void {
+        if (level == arity) {
+            values.insert(values.end(), tuple.begin(), tuple.end());
+            return;
+        }
+
+        auto nodeValues = getValues(node);
+        auto targets = getTargets(node);
+        for (size_t i = 0; i < nodeValues.size(); i++) {
+            tuple[level] = nodeValues[i];
+            self(self, targets[i], level + 1);
+        }
+    };
+    if (nbTuples > 0) {
+        enumerate(enumerate, root, 0);
+    }
+
+    auto nbPaths = (arity == 0) ? 0 : values.size() / arity;
+    return make_shared<const TupleTable>(arity, nbPaths, move(values), star);
+}
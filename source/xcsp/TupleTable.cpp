@@ -0,0 +1,90 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file TupleTable.cpp
+ * @brief Stores the tuples of an extension constraint, shared between constraints.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <crillab-except/except.hpp>
+
+#include "crillab-autis/xcsp/TupleTable.hpp"
+
+using namespace Autis;
+using namespace Except;
+using namespace std;
+using namespace Universe;
+
+TupleTable::TupleTable(size_t arity, size_t nbTuples, vector<int> values, bool hasStar) :
+        arity(arity),
+        nbTuples(nbTuples),
+        values(move(values)),
+        star(hasStar) {
+    if (this->values.size() != arity * nbTuples) {
+        throw IllegalArgumentException("Tuples do not match the size of the table");
+    }
+}
+
+shared_ptr<const TupleTable> TupleTable::of(size_t arity, const vector<vector<int>> &tuples, bool hasStar) {
+    vector<int> values;
+    values.reserve(arity * tuples.size());
+    for (auto &tuple : tuples) {
+        if (tuple.size() != arity) {
+            throw IllegalArgumentException("Tuples not matching the arity of the table");
+        }
+        values.insert(values.end(), tuple.begin(), tuple.end());
+    }
+    return make_shared<const TupleTable>(arity, tuples.size(), move(values), hasStar);
+}
+
+size_t TupleTable::getArity() const {
+    return arity;
+}
+
+size_t TupleTable::size() const {
+    return nbTuples;
+}
+
+bool TupleTable::hasStar() const {
+    return star;
+}
+
+span<const int> TupleTable::operator[](size_t index) const {
+    return span<const int>(values).subspan(index * arity, arity);
+}
+
+span<const int> TupleTable::getValues() const {
+    return values;
+}
+
+vector<vector<BigInteger>> TupleTable::toBigIntegerMatrix() const {
+    vector<vector<BigInteger>> matrix;
+    matrix.reserve(nbTuples);
+    for (size_t i = 0; i < nbTuples; i++) {
+        auto tuple = (*this)[i];
+        matrix.emplace_back(tuple.begin(), tuple.end());
+    }
+    return matrix;
+}
@@ -0,0 +1,1806 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file XcspInstance.cpp
+ * @brief Implements the storage of XCSP3 instances in a solver-neutral form.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <variant>
+
+#include <crillab-except/except.hpp>
+
+#include "crillab-autis/core/ContentHash.hpp"
+#include "crillab-autis/core/Snapshot.hpp"
+#include "crillab-autis/xcsp/ICompressedTableListener.hpp"
+#include "crillab-autis/xcsp/XcspInstance.hpp"
+
+using namespace Autis;
+using namespace Except;
+using namespace std;
+using namespace Universe;
+
+namespace {
+
+    /**
+     * The types of the operands given to the methods of IUniverseCspSolver.
+     */
+    using Name = string;
+    using Names = vector<string>;
+    using NameMatrix = vector<vector<string>>;
+    using Integers = vector<int>;
+    using BigIntegers = vector<BigInteger>;
+    using BigIntegerMatrix = vector<vector<BigInteger>>;
+    using Tuples = shared_ptr<const TupleTable>;
+    using CompressedTuples = shared_ptr<const CompressedTupleTable>;
+    using Variables = span<const int>;
+    using Intension = IUniverseIntensionConstraint *;
+    using Intensions = vector<IUniverseIntensionConstraint *>;
+    using Relation = UniverseRelationalOperator;
+    using Arithmetic = UniverseArithmeticOperator;
+    using SetBelonging = UniverseSetBelongingOperator;
+
+    /**
+     * The handle of a variable, read instead of its name when the solver is
+     * an IVariableHandleListener.
+     */
+    struct Variable {
+        int handle;
+    };
+
+    /**
+     * The right-hand side of a condition, which is either an integer or a
+     * variable.
+     */
+    using Condition = variant<int, string>;
+
+    /**
+     * The tuples of an extension constraint, which are either compressed or
+     * not.
+     */
+    using Table = variant<Tuples, CompressedTuples>;
+
+    /**
+     * Gives the uncompressed tuples of an extension constraint.
+     *
+     * @param table The tuples of the constraint.
+     *
+     * @return The uncompressed tuples.
+     */
+    Tuples toTuples(const Table &table) {
+        if (auto compressed = get_if<CompressedTuples>(&table)) {
+            return (*compressed)->decompress();
+        }
+        return get<Tuples>(table);
+    }
+
+    /**
+     * Computes the hash of a node of an intension expression.
+     *
+     * @param intensionOperator The operator of the node.
+     * @param value The value of the node, if it is a constant or a variable.
+     * @param children The children of the node, if it is an operator.
+     *
+     * @return The hash of the node.
+     */
+    uint64_t hashOf(IntensionOperator intensionOperator, int64_t value, span<const int64_t> children) {
+        ContentHash hash;
+        auto code = static_cast<char>(intensionOperator);
+        hash.update(&code, 1);
+        if ((intensionOperator == IntensionOperator::CONSTANT) || (intensionOperator == IntensionOperator::VARIABLE)) {
+            hash.update(reinterpret_cast<const char *>(&value), sizeof(value));
+        } else if (!children.empty()) {
+            hash.update(reinterpret_cast<const char *>(children.data()), children.size_bytes());
+        }
+        return hash.digest();
+    }
+
+    /**
+     * Checks whether a value read from a snapshot is a valid index.
+     *
+     * @param value The value to check.
+     * @param size The number of elements that may be indexed.
+     *
+     * @return Whether the value is an index between 0 and size - 1.
+     */
+    bool isIndex(int64_t value, size_t size) {
+        return (value >= 0) && (static_cast<uint64_t>(value) < size);
+    }
+
+    /**
+     * Invokes a function on the given operands, after having replaced each
+     * condition by its actual value.
+     *
+     * @param function The function to invoke.
+     */
+    template <typename Function>
+    void invoke(Function &&function) {
+        function();
+    }
+
+    /**
+     * Invokes a function on the given operands, after having replaced each
+     * condition by its actual value.
+     *
+     * @param function The function to invoke.
+     * @param first The first operand.
+     * @param others The other operands.
+     */
+    template <typename Function, typename First, typename... Others>
+    void invoke(Function &&function, First &first, Others &... others) {
+        if constexpr (is_same_v<First, Condition>) {
+            visit([&](auto &value) {
+                invoke([&](auto &... remaining) { function(value, remaining...); }, others...);
+            }, first);
+
+        } else {
+            invoke([&](auto &... remaining) { function(first, remaining...); }, others...);
+        }
+    }
+
+}
+
+/**
+ * The Reader reads back the operands of the operations recorded in an
+ * XcspInstance, in the order in which they have been recorded.
+ */
+class XcspInstance::Reader {
+
+private:
+
+    /**
+     * The instance to read the operands from.
+     */
+    const XcspInstance &instance;
+
+    /**
+     * The factory used to create intension constraints.
+     */
+    AbstractUniverseIntensionConstraintFactory &intensionFactory;
+
+    /**
+     * The intension constraints already created for the nodes of the
+     * instance.
+     */
+    IntensionCache &intensions;
+
+    /**
+     * The position of the next operand to read.
+     */
+    size_t position;
+
+public:
+
+    /**
+     * Creates a new Reader.
+     *
+     * @param instance The instance to read the operands from.
+     * @param intensionFactory The factory used to create intension constraints.
+     * @param intensions The intension constraints already created for the
+     *        nodes of the instance.
+     */
+    Reader(const XcspInstance &instance, AbstractUniverseIntensionConstraintFactory &intensionFactory,
+            IntensionCache &intensions) :
+            instance(instance),
+            intensionFactory(intensionFactory),
+            intensions(intensions),
+            position(0) {
+        // Nothing to do: everything is already initialized.
+    }
+
+    /**
+     * Reads the next operand.
+     *
+     * @tparam T The type of the operand to read.
+     *
+     * @return The value of the operand.
+     */
+    template <typename T>
+    T read() {
+        if constexpr (is_same_v<T, int>) {
+            return static_cast<int>(next(OperandType::INTEGER));
+
+        } else if constexpr (is_same_v<T, bool>) {
+            return next(OperandType::BOOLEAN) != 0;
+
+        } else if constexpr (is_same_v<T, Relation>) {
+            return static_cast<Relation>(next(OperandType::RELATIONAL_OPERATOR));
+
+        } else if constexpr (is_same_v<T, Arithmetic>) {
+            return static_cast<Arithmetic>(next(OperandType::ARITHMETIC_OPERATOR));
+
+        } else if constexpr (is_same_v<T, SetBelonging>) {
+            return static_cast<SetBelonging>(next(OperandType::SET_BELONGING_OPERATOR));
+
+        } else if constexpr (is_same_v<T, Condition>) {
+            if (isNext(OperandType::INTEGER)) {
+                return Condition(read<int>());
+            }
+            return Condition(read<Name>());
+
+        } else if constexpr (is_same_v<T, Name>) {
+            return name(nextIndex(OperandType::NAME));
+
+        } else if constexpr (is_same_v<T, Variable>) {
+            return Variable{static_cast<int>(next(OperandType::NAME))};
+
+        } else if constexpr (is_same_v<T, Names>) {
+            return names(instance.integers[nextIndex(OperandType::NAMES)]);
+
+        } else if constexpr (is_same_v<T, Variables>) {
+            return instance.integers[nextIndex(OperandType::NAMES)];
+
+        } else if constexpr (is_same_v<T, NameMatrix>) {
+            NameMatrix matrix;
+            for (auto row : instance.indices[nextIndex(OperandType::NAME_MATRIX)]) {
+                matrix.push_back(names(instance.integers[static_cast<size_t>(row)]));
+            }
+            return matrix;
+
+        } else if constexpr (is_same_v<T, Integers>) {
+            auto values = instance.integers[nextIndex(OperandType::INTEGERS)];
+            return Integers(values.begin(), values.end());
+
+        } else if constexpr (is_same_v<T, BigIntegers>) {
+            return bigIntegers(nextIndex(OperandType::BIG_INTEGERS));
+
+        } else if constexpr (is_same_v<T, BigIntegerMatrix>) {
+            BigIntegerMatrix matrix;
+            for (auto row : instance.indices[nextIndex(OperandType::BIG_INTEGER_MATRIX)]) {
+                matrix.push_back(bigIntegers(static_cast<size_t>(row)));
+            }
+            return matrix;
+
+        } else if constexpr (is_same_v<T, Table>) {
+            if (isNext(OperandType::COMPRESSED_TUPLES)) {
+                return Table(instance.compressedTables[nextIndex(OperandType::COMPRESSED_TUPLES)]);
+            }
+            return Table(instance.tables[nextIndex(OperandType::TUPLES)]);
+
+        } else if constexpr (is_same_v<T, Intension>) {
+            return intension(nextIndex(OperandType::INTENSION));
+
+        } else {
+            static_assert(is_same_v<T, Intensions>, "Unsupported operand type");
+            Intensions expressions;
+            for (auto node : instance.indices[nextIndex(OperandType::INTENSIONS)]) {
+                expressions.push_back(intension(static_cast<size_t>(node)));
+            }
+            return expressions;
+        }
+    }
+
+    /**
+     * Gives an identifier appearing in the instance.
+     *
+     * @param index The index of the identifier, i.e., the handle of the
+     *        variable it identifies.
+     *
+     * @return The identifier.
+     */
+    [[nodiscard]] string name(size_t index) const {
+        auto characters = instance.names[index];
+        return string(characters.begin(), characters.end());
+    }
+
+    /**
+     * Gives the identifiers of a list of variables.
+     *
+     * @param handles The handles of the variables.
+     *
+     * @return The list of identifiers.
+     */
+    [[nodiscard]] Names names(Variables handles) const {
+        Names list;
+        list.reserve(handles.size());
+        for (auto handle : handles) {
+            list.push_back(name(static_cast<size_t>(handle)));
+        }
+        return list;
+    }
+
+    /**
+     * Checks whether the next operand has the given type.
+     *
+     * @param type The type to check.
+     *
+     * @return Whether the next operand has the given type.
+     */
+    [[nodiscard]] bool isNext(OperandType type) const {
+        return (position < instance.operandTypes.size()) && (instance.operandTypes[position] == type);
+    }
+
+    /**
+     * Gives the intension constraint represented by a recorded expression,
+     * which is only created the first time it is needed.
+     *
+     * @param node The index of the root node of the expression.
+     *
+     * @return The intension constraint.
+     */
+    Intension intension(size_t node) {
+        auto &constraint = intensions[node];
+        if (constraint == nullptr) {
+            constraint = createIntension(node);
+        }
+        return constraint;
+    }
+
+private:
+
+    /**
+     * Creates the intension constraint represented by a recorded expression.
+     *
+     * @param node The index of the root node of the expression.
+     *
+     * @return The created intension constraint.
+     */
+    Intension createIntension(size_t node) {
+        auto value = instance.nodeValues[node];
+        auto intensionOperator = instance.nodeOperators[node];
+        if (intensionOperator == IntensionOperator::CONSTANT) {
+            return intensionFactory.constant(static_cast<long>(value));
+        }
+        if (intensionOperator == IntensionOperator::VARIABLE) {
+            return intensionFactory.variable(name(static_cast<size_t>(value)));
+        }
+
+        Intensions children;
+        for (auto child : instance.nodeChildren[static_cast<size_t>(value)]) {
+            children.push_back(intension(static_cast<size_t>(child)));
+        }
+        return XcspInstance::createIntension(intensionFactory, intensionOperator, children);
+    }
+
+    /**
+     * Reads the next operand, which must have the given type.
+     *
+     * @param type The expected type of the operand.
+     *
+     * @return The raw value of the operand.
+     *
+     * @throws IllegalArgumentException If the operand does not have the
+     *         expected type.
+     */
+    int64_t next(OperandType type) {
+        if (position >= instance.operands.size()) {
+            throw IllegalArgumentException("Missing operand");
+        }
+        if (instance.operandTypes[position] != type) {
+            throw IllegalArgumentException("Unexpected operand type");
+        }
+        return instance.operands[position++];
+    }
+
+    /**
+     * Reads the next operand, which must have the given type and is the
+     * index of an element of the instance.
+     * Such indices are never negative, as they are checked when a snapshot
+     * of the instance is loaded.
+     *
+     * @param type The expected type of the operand.
+     *
+     * @return The index read.
+     *
+     * @throws IllegalArgumentException If the operand does not have the
+     *         expected type.
+     */
+    size_t nextIndex(OperandType type) {
+        return static_cast<size_t>(next(type));
+    }
+
+    /**
+     * Gives a list of big integers appearing in the instance.
+     *
+     * @param index The index of the list in the arena of big integers.
+     *
+     * @return The list of big integers.
+     */
+    [[nodiscard]] BigIntegers bigIntegers(size_t index) const {
+        auto values = instance.bigIntegers[index];
+        return BigIntegers(values.begin(), values.end());
+    }
+
+};
+
+/**
+ * The OperandList reads the operands of an operation that has not been
+ * recorded, in the same way as the Reader reads recorded operands.
+ */
+class XcspInstance::OperandList {
+
+private:
+
+    /**
+     * The operands of the operation.
+     */
+    span<CspOperand> operands;
+
+    /**
+     * The position of the next operand to read.
+     */
+    size_t position;
+
+public:
+
+    /**
+     * Creates a new OperandList.
+     *
+     * @param operands The operands of the operation.
+     */
+    explicit OperandList(span<CspOperand> operands) :
+            operands(operands),
+            position(0) {
+        // Nothing to do: everything is already initialized.
+    }
+
+    /**
+     * Reads the next operand, which is moved out of the list.
+     *
+     * @tparam T The type of the operand to read.
+     *
+     * @return The value of the operand.
+     */
+    template <typename T>
+    T read() {
+        auto &operand = next();
+        if constexpr (is_same_v<T, Condition>) {
+            if (auto value = get_if<int>(&operand)) {
+                return Condition(*value);
+            }
+            return Condition(take<Name>(operand));
+
+        } else if constexpr (is_same_v<T, Table>) {
+            if (auto compressed = get_if<CompressedTuples>(&operand)) {
+                return Table(std::move(*compressed));
+            }
+            return Table(take<Tuples>(operand));
+
+        } else {
+            return take<T>(operand);
+        }
+    }
+
+    /**
+     * Checks whether all the operands have been read.
+     *
+     * @return Whether all the operands have been read.
+     */
+    [[nodiscard]] bool isEmpty() const {
+        return position == operands.size();
+    }
+
+private:
+
+    /**
+     * Gives the next operand.
+     *
+     * @return The next operand.
+     *
+     * @throws IllegalArgumentException If there is no more operand.
+     */
+    CspOperand &next() {
+        if (position >= operands.size()) {
+            throw IllegalArgumentException("Missing operand");
+        }
+        return operands[position++];
+    }
+
+    /**
+     * Moves the value of an operand out of it.
+     *
+     * @tparam T The expected type of the operand.
+     *
+     * @param operand The operand to read.
+     *
+     * @return The value of the operand.
+     *
+     * @throws IllegalArgumentException If the operand does not have the
+     *         expected type.
+     */
+    template <typename T>
+    static T take(CspOperand &operand) {
+        auto value = get_if<T>(&operand);
+        if (value == nullptr) {
+            throw IllegalArgumentException("Unexpected operand type");
+        }
+        return std::move(*value);
+    }
+
+};
+
+namespace {
+
+    /**
+     * Reads the operands of an operation, and gives them to a function.
+     * The operands are read in the order in which they have been recorded.
+     *
+     * @tparam Operands The types of the operands to read.
+     *
+     * @param reader The reader used to read the operands.
+     * @param function The function to give the operands to.
+     */
+    template <typename... Operands, typename Reader, typename Function>
+    void dispatch(Reader &reader, Function &&function) {
+        // A braced initializer guarantees that the operands are read in order.
+        tuple<Operands...> operands{reader.template read<Operands>()...};
+        apply([&](auto &... values) { invoke(function, values...); }, operands);
+    }
+
+}
+
+XcspInstance::XcspInstance() :
+        operations(),
+        operandTypes(),
+        operands(),
+        names(),
+        nameIndices(),
+        indices(),
+        integers(),
+        bigIntegers(),
+        nodeOperators(),
+        nodeValues(),
+        nodeChildren(),
+        nodeIndices(),
+        tables(),
+        compressedTables() {
+    // Nothing to do: everything is already initialized.
+}
+
+int XcspInstance::variable(const string &name) {
+    return static_cast<int>(intern(name));
+}
+
+VariableListReference XcspInstance::variables(span<const int> handles) {
+    return VariableListReference{integers.add(handles)};
+}
+
+VariableMatrixReference XcspInstance::variableMatrix(const vector<VariableListReference> &rows) {
+    vector<int64_t> lists;
+    lists.reserve(rows.size());
+    for (auto row : rows) {
+        lists.push_back(static_cast<int64_t>(row.list));
+    }
+    return VariableMatrixReference{indices.add(lists)};
+}
+
+size_t XcspInstance::getNumberOfVariables() const {
+    return names.size();
+}
+
+string_view XcspInstance::getVariableName(int handle) const {
+    auto characters = names[static_cast<size_t>(handle)];
+    return string_view(characters.data(), characters.size());
+}
+
+IntensionReference XcspInstance::intensionConstant(long value) {
+    return internNode(IntensionOperator::CONSTANT, value, {});
+}
+
+IntensionReference XcspInstance::intensionVariable(const string &name) {
+    return internNode(IntensionOperator::VARIABLE, intern(name), {});
+}
+
+IntensionReference XcspInstance::intension(IntensionOperator intensionOperator,
+        const vector<IntensionReference> &children) {
+    vector<int64_t> nodes;
+    nodes.reserve(children.size());
+    for (auto child : children) {
+        nodes.push_back(static_cast<int64_t>(child.node));
+    }
+
+    return internNode(intensionOperator, 0, nodes);
+}
+
+size_t XcspInstance::getNumberOfIntensionNodes() const {
+    return nodeValues.size();
+}
+
+size_t XcspInstance::size() const {
+    return operations.size();
+}
+
+void XcspInstance::replay(IUniverseCspSolver &solver,
+        AbstractUniverseIntensionConstraintFactory &intensionFactory) const {
+    IntensionCache intensions;
+    replay(solver, intensionFactory, intensions);
+}
+
+IUniverseIntensionConstraint *XcspInstance::intensionConstraint(IntensionReference expression,
+        AbstractUniverseIntensionConstraintFactory &intensionFactory, IntensionCache &intensions) const {
+    intensions.resize(nodeValues.size(), nullptr);
+    Reader reader(*this, intensionFactory, intensions);
+    return reader.intension(expression.node);
+}
+
+void XcspInstance::replay(IUniverseCspSolver &solver,
+        AbstractUniverseIntensionConstraintFactory &intensionFactory, IntensionCache &intensions) const {
+    intensions.resize(nodeValues.size(), nullptr);
+    Reader reader(*this, intensionFactory, intensions);
+    auto handleListener = dynamic_cast<IVariableHandleListener *>(&solver);
+    auto tableListener = dynamic_cast<ICompressedTableListener *>(&solver);
+    for (auto operation : operations) {
+        if ((handleListener == nullptr) || (!replay(operation, reader, solver, *handleListener, tableListener))) {
+            give(operation, reader, solver);
+        }
+    }
+}
+
+void XcspInstance::give(IUniverseCspSolver &solver, CspOperation operation, span<CspOperand> operands) {
+    OperandList list(operands);
+    give(operation, list, solver);
+    if (!list.isEmpty()) {
+        throw IllegalArgumentException("Too many operands");
+    }
+}
+
+template <typename Source>
+void XcspInstance::give(CspOperation operation, Source &source, IUniverseCspSolver &solver) {
+    switch (operation) {
+        case CspOperation::NEW_VARIABLE_RANGE:
+            dispatch<Name, int, int>(source, [&](auto &... operands) { solver.newVariable(operands...); });
+            break;
+
+        case CspOperation::NEW_VARIABLE_VALUES:
+            dispatch<Name, Integers>(source, [&](auto &... operands) { solver.newVariable(operands...); });
+            break;
+
+        case CspOperation::ALL_DIFFERENT:
+            dispatch<Names>(source, [&](auto &... operands) { solver.addAllDifferent(operands...); });
+            break;
+
+        case CspOperation::INTENSION:
+            dispatch<Intension>(source, [&](auto &... operands) { solver.addIntension(operands...); });
+            break;
+
+        case CspOperation::UNARY_SUPPORT:
+            dispatch<Name, BigIntegers, bool>(source, [&](auto &... operands) { solver.addSupport(operands...); });
+            break;
+
+        case CspOperation::UNARY_CONFLICTS:
+            dispatch<Name, BigIntegers, bool>(source, [&](auto &... operands) {
+                solver.addConflicts(operands...);
+            });
+            break;
+
+        case CspOperation::SUPPORT:
+            dispatch<Names, Table>(source, [&](auto &variables, auto &table) {
+                auto tuples = toTuples(table);
+                auto matrix = tuples->toBigIntegerMatrix();
+                solver.addSupport(variables, matrix, tuples->hasStar());
+            });
+            break;
+
+        case CspOperation::CONFLICTS:
+            dispatch<Names, Table>(source, [&](auto &variables, auto &table) {
+                auto tuples = toTuples(table);
+                auto matrix = tuples->toBigIntegerMatrix();
+                solver.addConflicts(variables, matrix, tuples->hasStar());
+            });
+            break;
+
+        case CspOperation::SUM:
+            dispatch<Names, Relation, Condition>(source, [&](auto &... operands) { solver.addSum(operands...); });
+            break;
+
+        case CspOperation::SUM_WITH_COEFFICIENTS:
+            dispatch<Names, BigIntegers, Relation, Condition>(source, [&](auto &... operands) {
+                solver.addSum(operands...);
+            });
+            break;
+
+        case CspOperation::SUM_WITH_VARIABLE_COEFFICIENTS:
+            dispatch<Names, Names, Relation, Condition>(source, [&](auto &... operands) {
+                solver.addSumWithVariableCoefficients(operands...);
+            });
+            break;
+
+        case CspOperation::SUM_INTENSION:
+            dispatch<Intensions, Relation, Condition>(source, [&](auto &... operands) {
+                solver.addSumIntension(operands...);
+            });
+            break;
+
+        case CspOperation::SUM_INTENSION_WITH_COEFFICIENTS:
+            dispatch<Intensions, BigIntegers, Relation, Condition>(source, [&](auto &... operands) {
+                solver.addSumIntension(operands...);
+            });
+            break;
+
+        case CspOperation::PRIMITIVE_ARITHMETIC_CONSTANT:
+            dispatch<Name, Arithmetic, int, Relation, Name>(source, [&](auto &... operands) {
+                solver.addPrimitive(operands...);
+            });
+            break;
+
+        case CspOperation::PRIMITIVE:
+            dispatch<Name, Relation, int>(source, [&](auto &... operands) { solver.addPrimitive(operands...); });
+            break;
+
+        case CspOperation::PRIMITIVE_IN_RANGE:
+            dispatch<Name, SetBelonging, int, int>(source, [&](auto &... operands) {
+                solver.addPrimitive(operands...);
+            });
+            break;
+
+        case CspOperation::PRIMITIVE_ARITHMETIC:
+            dispatch<Name, Arithmetic, Name, Relation, Name>(source, [&](auto &... operands) {
+                solver.addPrimitive(operands...);
+            });
+            break;
+
+        case CspOperation::ALL_DIFFERENT_INTENSION:
+            dispatch<Intensions>(source, [&](auto &... operands) { solver.addAllDifferentIntension(operands...); });
+            break;
+
+        case CspOperation::ALL_DIFFERENT_EXCEPT:
+            dispatch<Names, BigIntegers>(source, [&](auto &... operands) { solver.addAllDifferent(operands...); });
+            break;
+
+        case CspOperation::ALL_DIFFERENT_LIST:
+            dispatch<NameMatrix>(source, [&](auto &... operands) { solver.addAllDifferentList(operands...); });
+            break;
+
+        case CspOperation::ALL_DIFFERENT_MATRIX:
+            dispatch<NameMatrix>(source, [&](auto &... operands) { solver.addAllDifferentMatrix(operands...); });
+            break;
+
+        case CspOperation::ALL_EQUAL:
+            dispatch<Names>(source, [&](auto &... operands) { solver.addAllEqual(operands...); });
+            break;
+
+        case CspOperation::ALL_EQUAL_INTENSION:
+            dispatch<Intensions>(source, [&](auto &... operands) { solver.addAllEqualIntension(operands...); });
+            break;
+
+        case CspOperation::NOT_ALL_EQUAL:
+            dispatch<Names>(source, [&](auto &... operands) { solver.addNotAllEqual(operands...); });
+            break;
+
+        case CspOperation::ORDERED:
+            dispatch<Names, Relation>(source, [&](auto &... operands) { solver.addOrdered(operands...); });
+            break;
+
+        case CspOperation::ORDERED_WITH_CONSTANT_LENGTH:
+            dispatch<Names, BigIntegers, Relation>(source, [&](auto &... operands) {
+                solver.addOrderedWithConstantLength(operands...);
+            });
+            break;
+
+        case CspOperation::LEX:
+            dispatch<NameMatrix, Relation>(source, [&](auto &... operands) { solver.addLex(operands...); });
+            break;
+
+        case CspOperation::LEX_MATRIX:
+            dispatch<NameMatrix, Relation>(source, [&](auto &... operands) { solver.addLexMatrix(operands...); });
+            break;
+
+        case CspOperation::AT_MOST:
+            dispatch<Names, int, int>(source, [&](auto &... operands) { solver.addAtMost(operands...); });
+            break;
+
+        case CspOperation::AT_LEAST:
+            dispatch<Names, int, int>(source, [&](auto &... operands) { solver.addAtLeast(operands...); });
+            break;
+
+        case CspOperation::EXACTLY:
+            dispatch<Names, int, int>(source, [&](auto &... operands) { solver.addExactly(operands...); });
+            break;
+
+        case CspOperation::EXACTLY_VARIABLE:
+            dispatch<Names, int, Name>(source, [&](auto &... operands) { solver.addExactly(operands...); });
+            break;
+
+        case CspOperation::AMONG:
+            dispatch<Names, BigIntegers, int>(source, [&](auto &... operands) { solver.addAmong(operands...); });
+            break;
+
+        case CspOperation::COUNT_WITH_CONSTANT_VALUES:
+            dispatch<Names, BigIntegers, Relation, Condition>(source, [&](auto &... operands) {
+                solver.addCountWithConstantValues(operands...);
+            });
+            break;
+
+        case CspOperation::COUNT_WITH_VARIABLE_VALUES:
+            dispatch<Names, Names, Relation, Condition>(source, [&](auto &... operands) {
+                solver.addCountWithVariableValues(operands...);
+            });
+            break;
+
+        case CspOperation::COUNT_INTENSION_WITH_CONSTANT_VALUES:
+            dispatch<Intensions, BigIntegers, Relation, Condition>(source, [&](auto &... operands) {
+                solver.addCountIntensionWithConstantValues(operands...);
+            });
+            break;
+
+        case CspOperation::N_VALUES_EXCEPT:
+            dispatch<Names, Relation, Condition, BigIntegers>(source, [&](auto &... operands) {
+                solver.addNValuesExcept(operands...);
+            });
+            break;
+
+        case CspOperation::N_VALUES_INTENSION:
+            dispatch<Intensions, Relation, Condition>(source, [&](auto &... operands) {
+                solver.addNValuesIntension(operands...);
+            });
+            break;
+
+        case CspOperation::N_VALUES:
+            dispatch<Names, Relation, Condition>(source, [&](auto &... operands) {
+                solver.addNValues(operands...);
+            });
+            break;
+
+        case CspOperation::CARDINALITY_WITH_CONSTANT_VALUES_AND_CONSTANT_COUNTS:
+            dispatch<Names, BigIntegers, BigIntegers, bool>(source, [&](auto &... operands) {
+                solver.addCardinalityWithConstantValuesAndConstantCounts(operands...);
+            });
+            break;
+
+        case CspOperation::CARDINALITY_WITH_CONSTANT_VALUES_AND_VARIABLE_COUNTS:
+            dispatch<Names, BigIntegers, Names, bool>(source, [&](auto &... operands) {
+                solver.addCardinalityWithConstantValuesAndVariableCounts(operands...);
+            });
+            break;
+
+        case CspOperation::CARDINALITY_WITH_CONSTANT_VALUES_AND_CONSTANT_INTERVAL_COUNTS:
+            dispatch<Names, BigIntegers, BigIntegers, BigIntegers, bool>(source, [&](auto &... operands) {
+                solver.addCardinalityWithConstantValuesAndConstantIntervalCounts(operands...);
+            });
+            break;
+
+        case CspOperation::CARDINALITY_WITH_VARIABLE_VALUES_AND_CONSTANT_COUNTS:
+            dispatch<Names, Names, BigIntegers, bool>(source, [&](auto &... operands) {
+                solver.addCardinalityWithVariableValuesAndConstantCounts(operands...);
+            });
+            break;
+
+        case CspOperation::CARDINALITY_WITH_VARIABLE_VALUES_AND_VARIABLE_COUNTS:
+            dispatch<Names, Names, Names, bool>(source, [&](auto &... operands) {
+                solver.addCardinalityWithVariableValuesAndVariableCounts(operands...);
+            });
+            break;
+
+        case CspOperation::CARDINALITY_WITH_VARIABLE_VALUES_AND_CONSTANT_INTERVAL_COUNTS:
+            dispatch<Names, Names, BigIntegers, BigIntegers, bool>(source, [&](auto &... operands) {
+                solver.addCardinalityWithVariableValuesAndConstantIntervalCounts(operands...);
+            });
+            break;
+
+        case CspOperation::MINIMUM:
+            dispatch<Names, Relation, Condition>(source, [&](auto &... operands) {
+                solver.addMinimum(operands...);
+            });
+            break;
+
+        case CspOperation::MINIMUM_INTENSION:
+            dispatch<Intensions, Relation, Condition>(source, [&](auto &... operands) {
+                solver.addMinimumIntension(operands...);
+            });
+            break;
+
+        case CspOperation::MAXIMUM:
+            dispatch<Names, Relation, Condition>(source, [&](auto &... operands) {
+                solver.addMaximum(operands...);
+            });
+            break;
+
+        case CspOperation::MAXIMUM_INTENSION:
+            dispatch<Intensions, Relation, Condition>(source, [&](auto &... operands) {
+                solver.addMaximumIntension(operands...);
+            });
+            break;
+
+        case CspOperation::ELEMENT_CONSTANT:
+            dispatch<Names, Relation, int>(source, [&](auto &... operands) { solver.addElement(operands...); });
+            break;
+
+        case CspOperation::ELEMENT_WITH_INDEX:
+            dispatch<Names, int, Name, Relation, Condition>(source, [&](auto &... operands) {
+                solver.addElement(operands...);
+            });
+            break;
+
+        case CspOperation::ELEMENT_MATRIX_VARIABLE:
+            dispatch<NameMatrix, int, Name, int, Name, Relation, Name>(source, [&](auto &... operands) {
+                solver.addElementMatrix(operands...);
+            });
+            break;
+
+        case CspOperation::ELEMENT_MATRIX_CONSTANT:
+            dispatch<NameMatrix, int, Name, int, Name, Relation, int>(source, [&](auto &... operands) {
+                solver.addElementMatrix(operands...);
+            });
+            break;
+
+        case CspOperation::ELEMENT_CONSTANT_MATRIX:
+            dispatch<BigIntegerMatrix, int, Name, int, Name, Relation, Name>(source, [&](auto &... operands) {
+                solver.addElementConstantMatrix(operands...);
+            });
+            break;
+
+        case CspOperation::ELEMENT_VARIABLE:
+            dispatch<Names, Relation, Name>(source, [&](auto &... operands) { solver.addElement(operands...); });
+            break;
+
+        case CspOperation::CHANNEL:
+            dispatch<Names, int>(source, [&](auto &... operands) { solver.addChannel(operands...); });
+            break;
+
+        case CspOperation::CHANNEL_BETWEEN_LISTS:
+            dispatch<Names, int, Names, int>(source, [&](auto &... operands) { solver.addChannel(operands...); });
+            break;
+
+        case CspOperation::CHANNEL_WITH_VALUE:
+            dispatch<Names, int, Name>(source, [&](auto &... operands) { solver.addChannel(operands...); });
+            break;
+
+        case CspOperation::NO_OVERLAP:
+            dispatch<Names, BigIntegers, bool>(source, [&](auto &... operands) {
+                solver.addNoOverlap(operands...);
+            });
+            break;
+
+        case CspOperation::NO_OVERLAP_VARIABLE_LENGTH:
+            dispatch<Names, Names, bool>(source, [&](auto &... operands) {
+                solver.addNoOverlapVariableLength(operands...);
+            });
+            break;
+
+        case CspOperation::MULTI_DIMENSIONAL_NO_OVERLAP:
+            dispatch<NameMatrix, BigIntegerMatrix, bool>(source, [&](auto &... operands) {
+                solver.addMultiDimensionalNoOverlap(operands...);
+            });
+            break;
+
+        case CspOperation::MULTI_DIMENSIONAL_NO_OVERLAP_VARIABLE_LENGTH:
+            dispatch<NameMatrix, NameMatrix, bool>(source, [&](auto &... operands) {
+                solver.addMultiDimensionalNoOverlapVariableLength(operands...);
+            });
+            break;
+
+        case CspOperation::CUMULATIVE_CONSTANT_LENGTHS_CONSTANT_HEIGHTS:
+            dispatch<Names, BigIntegers, BigIntegers, Relation, Condition>(source, [&](auto &... operands) {
+                solver.addCumulativeConstantLengthsConstantHeights(operands...);
+            });
+            break;
+
+        case CspOperation::CUMULATIVE_CONSTANT_LENGTHS_VARIABLE_HEIGHTS:
+            dispatch<Names, BigIntegers, Names, Relation, Condition>(source, [&](auto &... operands) {
+                solver.addCumulativeConstantLengthsVariableHeights(operands...);
+            });
+            break;
+
+        case CspOperation::CUMULATIVE_VARIABLE_LENGTHS_CONSTANT_HEIGHTS:
+            dispatch<Names, Names, BigIntegers, Relation, Condition>(source, [&](auto &... operands) {
+                solver.addCumulativeVariableLengthsConstantHeights(operands...);
+            });
+            break;
+
+        case CspOperation::CUMULATIVE_CONSTANT_LENGTHS_CONSTANT_HEIGHTS_WITH_ENDS:
+            dispatch<Names, BigIntegers, Names, BigIntegers, Relation, Condition>(source, [&](auto &... operands) {
+                solver.addCumulativeConstantLengthsConstantHeights(operands...);
+            });
+            break;
+
+        case CspOperation::CUMULATIVE_CONSTANT_LENGTHS_VARIABLE_HEIGHTS_WITH_ENDS:
+            dispatch<Names, BigIntegers, Names, Names, Relation, Condition>(source, [&](auto &... operands) {
+                solver.addCumulativeConstantLengthsVariableHeights(operands...);
+            });
+            break;
+
+        case CspOperation::CUMULATIVE_VARIABLE_LENGTHS_VARIABLE_HEIGHTS_WITH_ENDS:
+            dispatch<Names, Names, Names, Names, Relation, Condition>(source, [&](auto &... operands) {
+                solver.addCumulativeVariableLengthsVariableHeights(operands...);
+            });
+            break;
+
+        case CspOperation::CUMULATIVE_VARIABLE_LENGTHS_CONSTANT_HEIGHTS_WITH_ENDS:
+            dispatch<Names, Names, Names, BigIntegers, Relation, Condition>(source, [&](auto &... operands) {
+                solver.addCumulativeVariableLengthsConstantHeights(operands...);
+            });
+            break;
+
+        case CspOperation::CUMULATIVE_VARIABLE_LENGTHS_VARIABLE_HEIGHTS:
+            dispatch<Names, Names, Names, Relation, Condition>(source, [&](auto &... operands) {
+                solver.addCumulativeVariableLengthsVariableHeights(operands...);
+            });
+            break;
+
+        case CspOperation::INSTANTIATION:
+            dispatch<Names, BigIntegers>(source, [&](auto &... operands) { solver.addInstantiation(operands...); });
+            break;
+
+        case CspOperation::CLAUSE:
+            dispatch<Names, Names>(source, [&](auto &... operands) { solver.addClause(operands...); });
+            break;
+
+        case CspOperation::MINIMIZE_VARIABLE:
+            dispatch<Name>(source, [&](auto &... operands) { solver.minimizeVariable(operands...); });
+            break;
+
+        case CspOperation::MAXIMIZE_VARIABLE:
+            dispatch<Name>(source, [&](auto &... operands) { solver.maximizeVariable(operands...); });
+            break;
+
+        case CspOperation::MINIMIZE_MAXIMUM:
+            dispatch<Names>(source, [&](auto &... operands) { solver.minimizeMaximum(operands...); });
+            break;
+
+        case CspOperation::MINIMIZE_MINIMUM:
+            dispatch<Names>(source, [&](auto &... operands) { solver.minimizeMinimum(operands...); });
+            break;
+
+        case CspOperation::MINIMIZE_N_VALUES:
+            dispatch<Names>(source, [&](auto &... operands) { solver.minimizeNValues(operands...); });
+            break;
+
+        case CspOperation::MINIMIZE_SUM:
+            dispatch<Names>(source, [&](auto &... operands) { solver.minimizeSum(operands...); });
+            break;
+
+        case CspOperation::MINIMIZE_PRODUCT:
+            dispatch<Names>(source, [&](auto &... operands) { solver.minimizeProduct(operands...); });
+            break;
+
+        case CspOperation::MAXIMIZE_MAXIMUM:
+            dispatch<Names>(source, [&](auto &... operands) { solver.maximizeMaximum(operands...); });
+            break;
+
+        case CspOperation::MAXIMIZE_MINIMUM:
+            dispatch<Names>(source, [&](auto &... operands) { solver.maximizeMinimum(operands...); });
+            break;
+
+        case CspOperation::MAXIMIZE_N_VALUES:
+            dispatch<Names>(source, [&](auto &... operands) { solver.maximizeNValues(operands...); });
+            break;
+
+        case CspOperation::MAXIMIZE_SUM:
+            dispatch<Names>(source, [&](auto &... operands) { solver.maximizeSum(operands...); });
+            break;
+
+        case CspOperation::MAXIMIZE_PRODUCT:
+            dispatch<Names>(source, [&](auto &... operands) { solver.maximizeProduct(operands...); });
+            break;
+
+        case CspOperation::MINIMIZE_EXPRESSION_MAXIMUM:
+            dispatch<Intensions>(source, [&](auto &... operands) {
+                solver.minimizeExpressionMaximum(operands...);
+            });
+            break;
+
+        case CspOperation::MINIMIZE_EXPRESSION_MINIMUM:
+            dispatch<Intensions>(source, [&](auto &... operands) {
+                solver.minimizeExpressionMinimum(operands...);
+            });
+            break;
+
+        case CspOperation::MINIMIZE_EXPRESSION_N_VALUES:
+            dispatch<Intensions>(source, [&](auto &... operands) {
+                solver.minimizeExpressionNValues(operands...);
+            });
+            break;
+
+        case CspOperation::MINIMIZE_EXPRESSION_SUM:
+            dispatch<Intensions>(source, [&](auto &... operands) { solver.minimizeExpressionSum(operands...); });
+            break;
+
+        case CspOperation::MINIMIZE_EXPRESSION_PRODUCT:
+            dispatch<Intensions>(source, [&](auto &... operands) {
+                solver.minimizeExpressionProduct(operands...);
+            });
+            break;
+
+        case CspOperation::MAXIMIZE_EXPRESSION_MAXIMUM:
+            dispatch<Intensions>(source, [&](auto &... operands) {
+                solver.maximizeExpressionMaximum(operands...);
+            });
+            break;
+
+        case CspOperation::MAXIMIZE_EXPRESSION_MINIMUM:
+            dispatch<Intensions>(source, [&](auto &... operands) {
+                solver.maximizeExpressionMinimum(operands...);
+            });
+            break;
+
+        case CspOperation::MAXIMIZE_EXPRESSION_N_VALUES:
+            dispatch<Intensions>(source, [&](auto &... operands) {
+                solver.maximizeExpressionNValues(operands...);
+            });
+            break;
+
+        case CspOperation::MAXIMIZE_EXPRESSION_SUM:
+            dispatch<Intensions>(source, [&](auto &... operands) { solver.maximizeExpressionSum(operands...); });
+            break;
+
+        case CspOperation::MAXIMIZE_EXPRESSION_PRODUCT:
+            dispatch<Intensions>(source, [&](auto &... operands) {
+                solver.maximizeExpressionProduct(operands...);
+            });
+            break;
+
+        case CspOperation::MINIMIZE_MAXIMUM_WITH_COEFFICIENTS:
+            dispatch<Names, BigIntegers>(source, [&](auto &... operands) { solver.minimizeMaximum(operands...); });
+            break;
+
+        case CspOperation::MINIMIZE_MINIMUM_WITH_COEFFICIENTS:
+            dispatch<Names, BigIntegers>(source, [&](auto &... operands) { solver.minimizeMinimum(operands...); });
+            break;
+
+        case CspOperation::MINIMIZE_N_VALUES_WITH_COEFFICIENTS:
+            dispatch<Names, BigIntegers>(source, [&](auto &... operands) { solver.minimizeNValues(operands...); });
+            break;
+
+        case CspOperation::MINIMIZE_SUM_WITH_COEFFICIENTS:
+            dispatch<Names, BigIntegers>(source, [&](auto &... operands) { solver.minimizeSum(operands...); });
+            break;
+
+        case CspOperation::MINIMIZE_PRODUCT_WITH_COEFFICIENTS:
+            dispatch<Names, BigIntegers>(source, [&](auto &... operands) { solver.minimizeProduct(operands...); });
+            break;
+
+        case CspOperation::MAXIMIZE_MAXIMUM_WITH_COEFFICIENTS:
+            dispatch<Names, BigIntegers>(source, [&](auto &... operands) { solver.maximizeMaximum(operands...); });
+            break;
+
+        case CspOperation::MAXIMIZE_MINIMUM_WITH_COEFFICIENTS:
+            dispatch<Names, BigIntegers>(source, [&](auto &... operands) { solver.maximizeMinimum(operands...); });
+            break;
+
+        case CspOperation::MAXIMIZE_N_VALUES_WITH_COEFFICIENTS:
+            dispatch<Names, BigIntegers>(source, [&](auto &... operands) { solver.maximizeNValues(operands...); });
+            break;
+
+        case CspOperation::MAXIMIZE_SUM_WITH_COEFFICIENTS:
+            dispatch<Names, BigIntegers>(source, [&](auto &... operands) { solver.maximizeSum(operands...); });
+            break;
+
+        case CspOperation::MAXIMIZE_PRODUCT_WITH_COEFFICIENTS:
+            dispatch<Names, BigIntegers>(source, [&](auto &... operands) { solver.maximizeProduct(operands...); });
+            break;
+
+        case CspOperation::MINIMIZE_EXPRESSION_MAXIMUM_WITH_COEFFICIENTS:
+            dispatch<Intensions, BigIntegers>(source, [&](auto &... operands) {
+                solver.minimizeExpressionMaximum(operands...);
+            });
+            break;
+
+        case CspOperation::MINIMIZE_EXPRESSION_MINIMUM_WITH_COEFFICIENTS:
+            dispatch<Intensions, BigIntegers>(source, [&](auto &... operands) {
+                solver.minimizeExpressionMinimum(operands...);
+            });
+            break;
+
+        case CspOperation::MINIMIZE_EXPRESSION_N_VALUES_WITH_COEFFICIENTS:
+            dispatch<Intensions, BigIntegers>(source, [&](auto &... operands) {
+                solver.minimizeExpressionNValues(operands...);
+            });
+            break;
+
+        case CspOperation::MINIMIZE_EXPRESSION_SUM_WITH_COEFFICIENTS:
+            dispatch<Intensions, BigIntegers>(source, [&](auto &... operands) {
+                solver.minimizeExpressionSum(operands...);
+            });
+            break;
+
+        case CspOperation::MINIMIZE_EXPRESSION_PRODUCT_WITH_COEFFICIENTS:
+            dispatch<Intensions, BigIntegers>(source, [&](auto &... operands) {
+                solver.minimizeExpressionProduct(operands...);
+            });
+            break;
+
+        case CspOperation::MAXIMIZE_EXPRESSION_MAXIMUM_WITH_COEFFICIENTS:
+            dispatch<Intensions, BigIntegers>(source, [&](auto &... operands) {
+                solver.maximizeExpressionMaximum(operands...);
+            });
+            break;
+
+        case CspOperation::MAXIMIZE_EXPRESSION_MINIMUM_WITH_COEFFICIENTS:
+            dispatch<Intensions, BigIntegers>(source, [&](auto &... operands) {
+                solver.maximizeExpressionMinimum(operands...);
+            });
+            break;
+
+        case CspOperation::MAXIMIZE_EXPRESSION_N_VALUES_WITH_COEFFICIENTS:
+            dispatch<Intensions, BigIntegers>(source, [&](auto &... operands) {
+                solver.maximizeExpressionNValues(operands...);
+            });
+            break;
+
+        case CspOperation::MAXIMIZE_EXPRESSION_SUM_WITH_COEFFICIENTS:
+            dispatch<Intensions, BigIntegers>(source, [&](auto &... operands) {
+                solver.maximizeExpressionSum(operands...);
+            });
+            break;
+
+        case CspOperation::MAXIMIZE_EXPRESSION_PRODUCT_WITH_COEFFICIENTS:
+            dispatch<Intensions, BigIntegers>(source, [&](auto &... operands) {
+                solver.maximizeExpressionProduct(operands...);
+            });
+            break;
+
+        default:
+            throw IllegalArgumentException("Unknown operation");
+    }
+}
+
+IUniverseIntensionConstraint *XcspInstance::createIntension(AbstractUniverseIntensionConstraintFactory &intensionFactory,
+        IntensionOperator intensionOperator, vector<IUniverseIntensionConstraint *> &children) {
+    switch (intensionOperator) {
+        case IntensionOperator::ABS:
+            return intensionFactory.abs(children[0]);
+        case IntensionOperator::NEG:
+            return intensionFactory.neg(children[0]);
+        case IntensionOperator::SQR:
+            return intensionFactory.sqr(children[0]);
+        case IntensionOperator::NOT:
+            return intensionFactory.negation(children[0]);
+        case IntensionOperator::DIST:
+            return intensionFactory.dist(children[0], children[1]);
+        case IntensionOperator::DIV:
+            return intensionFactory.div(children[0], children[1]);
+        case IntensionOperator::MOD:
+            return intensionFactory.mod(children[0], children[1]);
+        case IntensionOperator::POW:
+            return intensionFactory.pow(children[0], children[1]);
+        case IntensionOperator::SUB:
+            return intensionFactory.sub(children[0], children[1]);
+        case IntensionOperator::IMP:
+            return intensionFactory.impl(children[0], children[1]);
+        case IntensionOperator::LT:
+            return intensionFactory.lt(children[0], children[1]);
+        case IntensionOperator::LE:
+            return intensionFactory.le(children[0], children[1]);
+        case IntensionOperator::GE:
+            return intensionFactory.ge(children[0], children[1]);
+        case IntensionOperator::GT:
+            return intensionFactory.gt(children[0], children[1]);
+        case IntensionOperator::NE:
+            return intensionFactory.neq(children[0], children[1]);
+        case IntensionOperator::ADD:
+            return intensionFactory.add(children);
+        case IntensionOperator::MULT:
+            return intensionFactory.mult(children);
+        case IntensionOperator::MIN:
+            return intensionFactory.min(children);
+        case IntensionOperator::MAX:
+            return intensionFactory.max(children);
+        case IntensionOperator::EQ:
+            return intensionFactory.eq(children);
+        case IntensionOperator::AND:
+            return intensionFactory.conjunction(children);
+        case IntensionOperator::OR:
+            return intensionFactory.disjunction(children);
+        case IntensionOperator::XOR:
+            return intensionFactory.parity(children);
+        case IntensionOperator::IFF:
+            return intensionFactory.equiv(children);
+        default:
+            throw IllegalArgumentException("Unknown operator");
+    }
+}
+
+bool XcspInstance::replay(CspOperation operation, Reader &reader, IUniverseCspSolver &solver,
+        IVariableHandleListener &handleListener, ICompressedTableListener *tableListener) {
+    switch (operation) {
+        case CspOperation::ALL_DIFFERENT:
+            dispatch<Variables>(reader, [&](auto &variables) { handleListener.addAllDifferent(variables); });
+            return true;
+
+        case CspOperation::ALL_EQUAL:
+            dispatch<Variables>(reader, [&](auto &variables) { handleListener.addAllEqual(variables); });
+            return true;
+
+        case CspOperation::SUPPORT:
+            dispatch<Variables, Table>(reader, [&](auto &variables, auto &table) {
+                auto compressed = get_if<CompressedTuples>(&table);
+                if ((compressed != nullptr) && (tableListener != nullptr)) {
+                    tableListener->addSupport(variables, *compressed);
+                } else {
+                    handleListener.addSupport(variables, toTuples(table));
+                }
+            });
+            return true;
+
+        case CspOperation::CONFLICTS:
+            dispatch<Variables, Table>(reader, [&](auto &variables, auto &table) {
+                auto compressed = get_if<CompressedTuples>(&table);
+                if ((compressed != nullptr) && (tableListener != nullptr)) {
+                    tableListener->addConflicts(variables, *compressed);
+                } else {
+                    handleListener.addConflicts(variables, toTuples(table));
+                }
+            });
+            return true;
+
+        case CspOperation::SUM:
+            dispatch<Variables, Relation, Condition>(reader, [&](auto &variables, auto &op, auto &rhs) {
+                if constexpr (is_same_v<decay_t<decltype(rhs)>, int>) {
+                    handleListener.addSum(variables, op, BigInteger(rhs));
+                } else {
+                    // Sums compared to a variable are only known by name.
+                    solver.addSum(reader.names(variables), op, rhs);
+                }
+            });
+            return true;
+
+        case CspOperation::SUM_WITH_COEFFICIENTS:
+            dispatch<Variables, BigIntegers, Relation, Condition>(reader, [&](auto &variables, auto &coefficients,
+                    auto &op, auto &rhs) {
+                if constexpr (is_same_v<decay_t<decltype(rhs)>, int>) {
+                    handleListener.addSum(variables, coefficients, op, BigInteger(rhs));
+                } else {
+                    solver.addSum(reader.names(variables), coefficients, op, rhs);
+                }
+            });
+            return true;
+
+        case CspOperation::PRIMITIVE:
+            dispatch<Variable, Relation, int>(reader, [&](auto &variable, auto &op, auto &value) {
+                handleListener.addPrimitive(variable.handle, op, value);
+            });
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+void XcspInstance::clear() {
+    operations.clear();
+    operandTypes.clear();
+    operands.clear();
+    indices.clear();
+    integers.clear();
+    bigIntegers.clear();
+    tables.clear();
+    compressedTables.clear();
+}
+
+void XcspInstance::clearIntensions() {
+    nodeOperators.clear();
+    nodeValues.clear();
+    nodeChildren.clear();
+    nodeIndices.clear();
+}
+
+void XcspInstance::save(SnapshotWriter &writer) const {
+    writer.writeUnsigned(operations.size());
+    for (auto operation : operations) {
+        writer.writeByte(static_cast<unsigned char>(operation));
+    }
+
+    // The operands are written along with their types.
+    writer.writeUnsigned(operands.size());
+    for (size_t i = 0; i < operands.size(); i++) {
+        writer.writeByte(static_cast<unsigned char>(operandTypes[i]));
+        writer.writeSigned(operands[i]);
+    }
+
+    // The interned identifiers are written once, as raw characters.
+    writer.writeUnsigned(names.size());
+    for (size_t i = 0; i < names.size(); i++) {
+        auto name = names[i];
+        writer.writeUnsigned(name.size());
+        writer.writeBytes(name);
+    }
+
+    writer.writeUnsigned(indices.size());
+    for (size_t i = 0; i < indices.size(); i++) {
+        writer.writeDeltas(indices[i]);
+    }
+
+    writer.writeUnsigned(integers.size());
+    for (size_t i = 0; i < integers.size(); i++) {
+        writer.writeDeltas(integers[i]);
+    }
+
+    writer.writeUnsigned(bigIntegers.size());
+    for (size_t i = 0; i < bigIntegers.size(); i++) {
+        auto values = bigIntegers[i];
+        writer.writeUnsigned(values.size());
+        for (const auto &value : values) {
+            writer.writeBig(value);
+        }
+    }
+
+    // The nodes of the intension expressions.
+    writer.writeUnsigned(nodeValues.size());
+    for (size_t i = 0; i < nodeValues.size(); i++) {
+        writer.writeByte(static_cast<unsigned char>(nodeOperators[i]));
+        writer.writeSigned(nodeValues[i]);
+    }
+    writer.writeUnsigned(nodeChildren.size());
+    for (size_t i = 0; i < nodeChildren.size(); i++) {
+        writer.writeDeltas(nodeChildren[i]);
+    }
+
+    // The tables of tuples, written only once even when they are shared.
+    writer.writeUnsigned(tables.size());
+    for (auto &table : tables) {
+        writer.writeUnsigned(table->getArity());
+        writer.writeUnsigned(table->size());
+        writer.writeByte(table->hasStar() ? 1 : 0);
+        writer.writeDeltas(table->getValues());
+    }
+
+    // The compressed tables are written as their decision diagrams.
+    writer.writeUnsigned(compressedTables.size());
+    for (auto &table : compressedTables) {
+        writer.writeUnsigned(table->getArity());
+        writer.writeUnsigned(table->size());
+        writer.writeByte(table->hasStar() ? 1 : 0);
+        writer.writeUnsigned(table->getRoot());
+        writer.writeDeltas(table->getNodeOffsets());
+        writer.writeDeltas(table->getEdgeValues());
+        writer.writeDeltas(table->getEdgeTargets());
+    }
+}
+
+void XcspInstance::load(SnapshotReader &reader) {
+    auto nbOperations = reader.readSize();
+    operations.reserve(nbOperations);
+    for (size_t i = 0; i < nbOperations; i++) {
+        auto operation = reader.readByte();
+        if (operation > static_cast<unsigned char>(CspOperation::MAXIMIZE_EXPRESSION_PRODUCT_WITH_COEFFICIENTS)) {
+            throw ParseException("Invalid operation in snapshot");
+        }
+        operations.push_back(static_cast<CspOperation>(operation));
+    }
+
+    auto nbOperands = reader.readSize();
+    operandTypes.reserve(nbOperands);
+    operands.reserve(nbOperands);
+    for (size_t i = 0; i < nbOperands; i++) {
+        auto type = reader.readByte();
+        if (type > static_cast<unsigned char>(OperandType::COMPRESSED_TUPLES)) {
+            throw ParseException("Invalid operand type in snapshot");
+        }
+        operandTypes.push_back(static_cast<OperandType>(type));
+        operands.push_back(reader.readSigned());
+    }
+
+    // The table of identifiers is rebuilt along with the arena of names.
+    auto nbNames = reader.readSize();
+    for (size_t i = 0; i < nbNames; i++) {
+        auto name = reader.readBytes(reader.readSize());
+        nameIndices.emplace(string(name.begin(), name.end()), static_cast<int64_t>(names.add(name)));
+    }
+
+    vector<int64_t> indexList;
+    auto nbIndexLists = reader.readSize();
+    for (size_t i = 0; i < nbIndexLists; i++) {
+        reader.readDeltas(indexList);
+        indices.add(indexList);
+    }
+
+    vector<int> integerList;
+    auto nbIntegerLists = reader.readSize();
+    for (size_t i = 0; i < nbIntegerLists; i++) {
+        reader.readDeltas(integerList);
+        integers.add(integerList);
+    }
+
+    vector<BigInteger> bigIntegerList;
+    auto nbBigIntegerLists = reader.readSize();
+    for (size_t i = 0; i < nbBigIntegerLists; i++) {
+        bigIntegerList.resize(reader.readSize());
+        for (auto &value : bigIntegerList) {
+            reader.readBig(value);
+        }
+        bigIntegers.add(bigIntegerList);
+    }
+
+    auto nbNodes = reader.readSize();
+    nodeOperators.reserve(nbNodes);
+    nodeValues.reserve(nbNodes);
+    for (size_t i = 0; i < nbNodes; i++) {
+        auto intensionOperator = reader.readByte();
+        if (intensionOperator > static_cast<unsigned char>(IntensionOperator::IFF)) {
+            throw ParseException("Invalid intension operator in snapshot");
+        }
+        nodeOperators.push_back(static_cast<IntensionOperator>(intensionOperator));
+        nodeValues.push_back(reader.readSigned());
+    }
+
+    vector<int64_t> childList;
+    auto nbChildLists = reader.readSize();
+    for (size_t i = 0; i < nbChildLists; i++) {
+        reader.readDeltas(childList);
+        nodeChildren.add(childList);
+    }
+
+    // The nodes are indexed again, so that they are shared with the
+    // expressions recorded later on.
+    for (size_t i = 0; i < nbNodes; i++) {
+        auto intensionOperator = nodeOperators[i];
+        auto value = nodeValues[i];
+        auto leaf = (intensionOperator == IntensionOperator::CONSTANT)
+                || (intensionOperator == IntensionOperator::VARIABLE);
+        if ((intensionOperator == IntensionOperator::VARIABLE) && (!isIndex(value, names.size()))) {
+            throw ParseException("Invalid intension node in snapshot");
+        }
+        if (!leaf && (!isIndex(value, nodeChildren.size()))) {
+            throw ParseException("Invalid intension node in snapshot");
+        }
+
+        // Children are always recorded before their parents, so that the nodes cannot form a cycle.
+        auto children = leaf ? span<const int64_t>() : nodeChildren[static_cast<size_t>(value)];
+        if (!ranges::all_of(children, [i](auto child) { return isIndex(child, i); })) {
+            throw ParseException("Invalid intension node in snapshot");
+        }
+        nodeIndices.emplace(hashOf(intensionOperator, value, children), i);
+    }
+
+    auto nbTables = reader.readSize();
+    tables.reserve(nbTables);
+    for (size_t i = 0; i < nbTables; i++) {
+        auto arity = reader.readSize();
+        auto nbTuples = reader.readSize();
+        auto hasStar = reader.readByte() != 0;
+        vector<int> values;
+        reader.readDeltas(values);
+        if (values.size() != arity * nbTuples) {
+            throw ParseException("Invalid table of tuples in snapshot");
+        }
+        tables.push_back(make_shared<const TupleTable>(arity, nbTuples, move(values), hasStar));
+    }
+
+    auto nbCompressedTables = reader.readSize();
+    compressedTables.reserve(nbCompressedTables);
+    for (size_t i = 0; i < nbCompressedTables; i++) {
+        // A diagram may represent more tuples than it has edges.
+        auto arity = reader.readSize();
+        auto nbTuples = static_cast<size_t>(reader.readUnsigned());
+        auto hasStar = reader.readByte() != 0;
+        auto root = reader.readUnsigned();
+        vector<size_t> nodeOffsets;
+        vector<int> edgeValues;
+        vector<uint32_t> edgeTargets;
+        reader.readDeltas(nodeOffsets);
+        reader.readDeltas(edgeValues);
+        reader.readDeltas(edgeTargets);
+        if (root > numeric_limits<uint32_t>::max()) {
+            throw ParseException("Invalid compressed table in snapshot");
+        }
+        try {
+            compressedTables.push_back(make_shared<const CompressedTupleTable>(arity, nbTuples, hasStar,
+                    static_cast<uint32_t>(root), move(nodeOffsets), move(edgeValues), move(edgeTargets)));
+        } catch (IllegalArgumentException &) {
+            throw ParseException("Invalid compressed table in snapshot");
+        }
+    }
+
+    checkReferences();
+}
+
+void XcspInstance::checkReferences() const {
+    auto isHandleList = [this](int64_t list) {
+        return isIndex(list, integers.size())
+                && ranges::all_of(integers[static_cast<size_t>(list)],
+                        [this](auto handle) { return isIndex(handle, names.size()); });
+    };
+    auto isIndexList = [this](int64_t list, size_t size) {
+        return isIndex(list, indices.size())
+                && ranges::all_of(indices[static_cast<size_t>(list)],
+                        [size](auto index) { return isIndex(index, size); });
+    };
+
+    for (size_t i = 0; i < operands.size(); i++) {
+        auto value = operands[i];
+        bool valid;
+        switch (operandTypes[i]) {
+            case OperandType::NAME:
+                valid = isIndex(value, names.size());
+                break;
+
+            case OperandType::NAMES:
+                valid = isHandleList(value);
+                break;
+
+            case OperandType::NAME_MATRIX:
+                valid = isIndexList(value, integers.size())
+                        && ranges::all_of(indices[static_cast<size_t>(value)], isHandleList);
+                break;
+
+            case OperandType::INTEGERS:
+                valid = isIndex(value, integers.size());
+                break;
+
+            case OperandType::BIG_INTEGERS:
+                valid = isIndex(value, bigIntegers.size());
+                break;
+
+            case OperandType::BIG_INTEGER_MATRIX:
+                valid = isIndexList(value, bigIntegers.size());
+                break;
+
+            case OperandType::INTENSION:
+                valid = isIndex(value, nodeValues.size());
+                break;
+
+            case OperandType::INTENSIONS:
+                valid = isIndexList(value, nodeValues.size());
+                break;
+
+            case OperandType::TUPLES:
+                valid = isIndex(value, tables.size());
+                break;
+
+            case OperandType::COMPRESSED_TUPLES:
+                valid = isIndex(value, compressedTables.size());
+                break;
+
+            default:
+                // The other operands are values rather than indices.
+                valid = true;
+                break;
+        }
+
+        if (!valid) {
+            throw ParseException("Invalid operand in snapshot");
+        }
+    }
+}
+
+void XcspInstance::write(int value) {
+    write(OperandType::INTEGER, value);
+}
+
+void XcspInstance::write(bool value) {
+    write(OperandType::BOOLEAN, value ? 1 : 0);
+}
+
+void XcspInstance::write(UniverseRelationalOperator value) {
+    write(OperandType::RELATIONAL_OPERATOR, static_cast<int64_t>(value));
+}
+
+void XcspInstance::write(UniverseArithmeticOperator value) {
+    write(OperandType::ARITHMETIC_OPERATOR, static_cast<int64_t>(value));
+}
+
+void XcspInstance::write(UniverseSetBelongingOperator value) {
+    write(OperandType::SET_BELONGING_OPERATOR, static_cast<int64_t>(value));
+}
+
+void XcspInstance::write(const string &value) {
+    write(OperandType::NAME, intern(value));
+}
+
+void XcspInstance::write(const vector<string> &value) {
+    write(OperandType::NAMES, static_cast<int64_t>(internAll(value)));
+}
+
+void XcspInstance::write(const vector<vector<string>> &value) {
+    vector<int64_t> rows;
+    rows.reserve(value.size());
+    for (auto &row : value) {
+        rows.push_back(static_cast<int64_t>(internAll(row)));
+    }
+    write(OperandType::NAME_MATRIX, static_cast<int64_t>(indices.add(rows)));
+}
+
+void XcspInstance::write(VariableListReference value) {
+    write(OperandType::NAMES, static_cast<int64_t>(value.list));
+}
+
+void XcspInstance::write(VariableMatrixReference value) {
+    write(OperandType::NAME_MATRIX, static_cast<int64_t>(value.rows));
+}
+
+void XcspInstance::write(const vector<int> &value) {
+    write(OperandType::INTEGERS, static_cast<int64_t>(integers.add(value)));
+}
+
+void XcspInstance::write(const vector<BigInteger> &value) {
+    write(OperandType::BIG_INTEGERS, static_cast<int64_t>(bigIntegers.add(value)));
+}
+
+void XcspInstance::write(const vector<vector<BigInteger>> &value) {
+    vector<int64_t> rows;
+    rows.reserve(value.size());
+    for (auto &row : value) {
+        rows.push_back(static_cast<int64_t>(bigIntegers.add(row)));
+    }
+    write(OperandType::BIG_INTEGER_MATRIX, static_cast<int64_t>(indices.add(rows)));
+}
+
+void XcspInstance::write(IntensionReference value) {
+    write(OperandType::INTENSION, static_cast<int64_t>(value.node));
+}
+
+void XcspInstance::write(const vector<IntensionReference> &value) {
+    vector<int64_t> nodes;
+    nodes.reserve(value.size());
+    for (auto reference : value) {
+        nodes.push_back(static_cast<int64_t>(reference.node));
+    }
+    write(OperandType::INTENSIONS, static_cast<int64_t>(indices.add(nodes)));
+}
+
+void XcspInstance::write(const shared_ptr<const TupleTable> &value) {
+    if (tables.empty() || (tables.back() != value)) {
+        tables.push_back(value);
+    }
+    write(OperandType::TUPLES, static_cast<int64_t>(tables.size() - 1));
+}
+
+void XcspInstance::write(const shared_ptr<const CompressedTupleTable> &value) {
+    if (compressedTables.empty() || (compressedTables.back() != value)) {
+        compressedTables.push_back(value);
+    }
+    write(OperandType::COMPRESSED_TUPLES, static_cast<int64_t>(compressedTables.size() - 1));
+}
+
+void XcspInstance::write(OperandType type, int64_t value) {
+    operandTypes.push_back(type);
+    operands.push_back(value);
+}
+
+int64_t XcspInstance::intern(const string &name) {
+    auto [it, inserted] = nameIndices.try_emplace(name, static_cast<int64_t>(names.size()));
+    if (inserted) {
+        names.add(name);
+    }
+    return it->second;
+}
+
+size_t XcspInstance::internAll(const vector<string> &list) {
+    vector<int> handles;
+    handles.reserve(list.size());
+    for (auto &name : list) {
+        handles.push_back(static_cast<int>(intern(name)));
+    }
+    return integers.add(handles);
+}
+
+IntensionReference XcspInstance::internNode(IntensionOperator intensionOperator, int64_t value,
+        span<const int64_t> children) {
+    auto leaf = (intensionOperator == IntensionOperator::CONSTANT)
+            || (intensionOperator == IntensionOperator::VARIABLE);
+    auto hash = hashOf(intensionOperator, value, children);
+
+    // Looking for an identical node recorded before.
+    auto [first, last] = nodeIndices.equal_range(hash);
+    for (auto it = first; it != last; ++it) {
+        auto node = it->second;
+        if (nodeOperators[node] != intensionOperator) {
+            continue;
+        }
+        if (leaf ? (nodeValues[node] == value)
+                : ranges::equal(nodeChildren[static_cast<size_t>(nodeValues[node])], children)) {
+            return IntensionReference{node};
+        }
+    }
+
+    nodeOperators.push_back(intensionOperator);
+    nodeValues.push_back(leaf ? value : static_cast<int64_t>(nodeChildren.add(children)));
+    nodeIndices.emplace(hash, nodeValues.size() - 1);
+    return IntensionReference{nodeValues.size() - 1};
+}
@@ -0,0 +1,1180 @@
+/******************************************************************************
+ * AUTIS, A Unified Tool for parsIng problemS                                 *
+ * Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.                   *
+ * All rights reserved.                                                       *
+ *                                                                            *
+ * This library is free software; you can redistribute it and/or modify it    *
+ * under the terms of the GNU Lesser General Public License as published by   *
+ * the Free Software Foundation; either version 3 of the License, or (at your *
+ * option) any later version.                                                 *
+ *                                                                            *
+ * This library is distributed in the hope that it will be useful, but        *
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY *
+ * or FITNESS FOR A PARTICULAR PURPOSE.                                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public           *
+ * License along with this library.                                           *
+ * If not, see http://www.gnu.org/licenses.                                   *
+ ******************************************************************************/
+
+/**
+ * @file XcspStreamReader.cpp
+ * @brief Implements a streaming reader for XCSP3 inputs, built on libxml2.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @date 16/10/26
+ * @copyright Copyright (c) 2022 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#include <libxml/xmlreader.h>
+
+#include <crillab-except/except.hpp>
+
+#include "crillab-autis/xcsp/XcspStreamReader.hpp"
+
+using namespace Autis;
+using namespace Except;
+using namespace std;
+using namespace XCSP3Core;
+
+namespace {
+
+    /**
+     * The value used by XCSP3-CPP-Parser to represent a star in a tuple.
+     */
+    constexpr int STAR_VALUE = numeric_limits<int>::max();
+
+    /**
+     * The maximum number of values an interval may be expanded into.
+     * Larger intervals are rejected rather than filling the memory.
+     */
+    constexpr int64_t MAX_INTERVAL_SIZE = int64_t(1) << 24;
+
+    /**
+     * Feeds libxml2 with the content of an input stream.
+     *
+     * @param context The input stream to read from.
+     * @param buffer The buffer in which to store the read characters.
+     * @param length The maximum number of characters to read.
+     *
+     * @return The number of read characters.
+     */
+    int readInput(void *context, char *buffer, int length) {
+        auto input = static_cast<istream *>(context);
+        return static_cast<int>(input->rdbuf()->sgetn(buffer, length));
+    }
+
+    /**
+     * Closes the input stream given to libxml2, which is not owned by the
+     * reader.
+     *
+     * @return Always 0.
+     */
+    int closeInput(void *) {
+        return 0;
+    }
+
+    /**
+     * Checks whether a character is a blank character.
+     *
+     * @param c The character to check.
+     *
+     * @return Whether the character is blank.
+     */
+    inline bool isBlank(char c) {
+        return (c == ' ') || (c == '\t') || (c == '\n') || (c == '\r');
+    }
+
+    /**
+     * Splits a text into tokens separated by blank characters.
+     * Blank characters appearing inside parentheses do not separate tokens,
+     * so that each expression of a list is a single token.
+     *
+     * @param text The text to split.
+     *
+     * @return The tokens of the text.
+     */
+    vector<string> tokenize(string_view text) {
+        vector<string> tokens;
+        string token;
+        int depth = 0;
+        for (auto c : text) {
+            if (isBlank(c) && (depth == 0)) {
+                if (!token.empty()) {
+                    tokens.push_back(move(token));
+                    token.clear();
+                }
+                continue;
+            }
+
+            if (c == '(') {
+                depth++;
+            } else if (c == ')') {
+                depth--;
+            }
+            if (!isBlank(c)) {
+                token += c;
+            }
+        }
+
+        if (!token.empty()) {
+            tokens.push_back(move(token));
+        }
+        return tokens;
+    }
+
+    /**
+     * Removes the blank characters surrounding a text.
+     *
+     * @param text The text to trim.
+     *
+     * @return The trimmed text.
+     */
+    string trim(string_view text) {
+        size_t begin = 0;
+        size_t end = text.size();
+        while ((begin < end) && isBlank(text[begin])) {
+            begin++;
+        }
+        while ((end > begin) && isBlank(text[end - 1])) {
+            end--;
+        }
+        return string(text.substr(begin, end - begin));
+    }
+
+    /**
+     * Parses an integer.
+     *
+     * @param token The text of the integer.
+     *
+     * @return The parsed integer, if the token is an integer.
+     */
+    optional<int> parseInteger(string_view token) {
+        if (!token.empty() && (token.front() == '+')) {
+            token.remove_prefix(1);
+        }
+
+        int value;
+        auto [end, error] = from_chars(token.data(), token.data() + token.size(), value);
+        if ((error != errc()) || (end != token.data() + token.size())) {
+            return nullopt;
+        }
+        return value;
+    }
+
+    /**
+     * Reads an integer.
+     *
+     * @param token The text of the integer.
+     *
+     * @return The read integer.
+     *
+     * @throws ParseException If the token is not an integer.
+     */
+    int toInteger(string_view token) {
+        auto value = parseInteger(token);
+        if (!value) {
+            throw ParseException("Invalid integer in XCSP3 input: " + string(token));
+        }
+        return *value;
+    }
+
+    /**
+     * Reads a list of integers, in which intervals (such as 1..5) are
+     * expanded.
+     *
+     * @param text The text of the list.
+     *
+     * @return The read integers.
+     *
+     * @throws UnsupportedOperationException If an interval has more than
+     *         MAX_INTERVAL_SIZE values.
+     */
+    vector<int> toIntegers(string_view text) {
+        vector<int> values;
+        for (auto &token : tokenize(text)) {
+            auto dots = token.find("..");
+            if (dots == string::npos) {
+                values.push_back(toInteger(token));
+                continue;
+            }
+
+            // The bounds are widened, so that the loop stops even when max is INT_MAX.
+            int64_t min = toInteger(string_view(token).substr(0, dots));
+            int64_t max = toInteger(string_view(token).substr(dots + 2));
+            if (max - min >= MAX_INTERVAL_SIZE) {
+                throw UnsupportedOperationException("Interval too large in XCSP3 input: " + token);
+            }
+            for (auto value = min; value <= max; value++) {
+                values.push_back(static_cast<int>(value));
+            }
+        }
+        return values;
+    }
+
+    /**
+     * Reads a relational operator.
+     *
+     * @param text The text of the operator.
+     *
+     * @return The read operator.
+     *
+     * @throws ParseException If the text is not a relational operator.
+     */
+    OrderType toOrderType(string_view text) {
+        if (text == "lt") {
+            return OrderType::LT;
+        }
+        if (text == "le") {
+            return OrderType::LE;
+        }
+        if (text == "ge") {
+            return OrderType::GE;
+        }
+        if (text == "gt") {
+            return OrderType::GT;
+        }
+        if (text == "eq") {
+            return OrderType::EQ;
+        }
+        if (text == "ne") {
+            return OrderType::NE;
+        }
+        if (text == "in") {
+            return OrderType::IN;
+        }
+        throw ParseException("Invalid operator in XCSP3 input: " + string(text));
+    }
+
+    /**
+     * Reads a condition, such as (le,10), (ge,x) or (in,1..5).
+     *
+     * @param text The text of the condition.
+     *
+     * @return The read condition.
+     *
+     * @throws ParseException If the text is not a condition.
+     */
+    XCondition toCondition(string_view text) {
+        auto condition = trim(text);
+        auto comma = condition.find(',');
+        if ((condition.size() < 5) || (condition.front() != '(') || (condition.back() != ')')
+                || (comma == string::npos)) {
+            throw ParseException("Invalid condition in XCSP3 input: " + condition);
+        }
+
+        XCondition xc{};
+        xc.op = toOrderType(trim(string_view(condition).substr(1, comma - 1)));
+        auto operand = trim(string_view(condition).substr(comma + 1, condition.size() - comma - 2));
+        auto dots = operand.find("..");
+        if (auto value = parseInteger(operand)) {
+            xc.operandType = OperandType::INTEGER;
+            xc.val = *value;
+
+        } else if (dots != string::npos) {
+            xc.operandType = OperandType::INTERVAL;
+            xc.min = toInteger(string_view(operand).substr(0, dots));
+            xc.max = toInteger(string_view(operand).substr(dots + 2));
+
+        } else {
+            xc.operandType = OperandType::VARIABLE;
+            xc.var = operand;
+        }
+        return xc;
+    }
+
+    /**
+     * Maps the type of an objective function to the corresponding constant.
+     *
+     * @param type The type of the objective function.
+     *
+     * @return The constant representing the type.
+     *
+     * @throws UnsupportedOperationException If the type is not supported.
+     */
+    ExpressionObjective toObjectiveType(string_view type) {
+        if (type == "sum") {
+            return ExpressionObjective::SUM_O;
+        }
+        if (type == "product") {
+            return ExpressionObjective::PRODUCT_O;
+        }
+        if (type == "minimum") {
+            return ExpressionObjective::MINIMUM_O;
+        }
+        if (type == "maximum") {
+            return ExpressionObjective::MAXIMUM_O;
+        }
+        if (type == "nValues") {
+            return ExpressionObjective::NVALUES_O;
+        }
+        if (type == "lex") {
+            return ExpressionObjective::LEX_O;
+        }
+        throw UnsupportedOperationException("Unsupported objective type: " + string(type));
+    }
+
+    /**
+     * Checks whether a list contains expressions rather than variables.
+     *
+     * @param text The text of the list.
+     *
+     * @return Whether the list contains expressions.
+     */
+    bool hasExpressions(string_view text) {
+        return text.find('(') != string_view::npos;
+    }
+
+    /**
+     * Gives the text of a node of the reader.
+     *
+     * @param text The text given by libxml2, which may be null.
+     *
+     * @return The text of the node.
+     */
+    string_view toText(const xmlChar *text) {
+        if (text == nullptr) {
+            return {};
+        }
+        return string_view(reinterpret_cast<const char *>(text));
+    }
+
+    /**
+     * Gives the value of an attribute of the element at the current node of
+     * the reader.
+     *
+     * @param reader The reader positioned on the element.
+     * @param name The name of the attribute.
+     *
+     * @return The value of the attribute, or an empty string if it is missing.
+     */
+    string attributeOf(xmlTextReaderPtr reader, const char *name) {
+        auto value = xmlTextReaderGetAttribute(reader, BAD_CAST name);
+        string text(toText(value));
+        xmlFree(value);
+        return text;
+    }
+
+}
+
+/**
+ * The Element is a small tree representing an element of the input.
+ */
+struct XcspStreamReader::Element {
+
+    /**
+     * The name of the element.
+     */
+    string name;
+
+    /**
+     * The attributes of the element, as pairs of names and values.
+     */
+    vector<pair<string, string>> attributes;
+
+    /**
+     * The text directly contained in the element.
+     */
+    string text;
+
+    /**
+     * The child elements of the element.
+     */
+    vector<Element> children;
+
+    /**
+     * Gives the value of an attribute of the element.
+     *
+     * @param attributeName The name of the attribute.
+     *
+     * @return The value of the attribute, or an empty string if the element
+     *         does not have such an attribute.
+     */
+    [[nodiscard]] string attribute(string_view attributeName) const {
+        for (auto &[key, value] : attributes) {
+            if (key == attributeName) {
+                return value;
+            }
+        }
+        return "";
+    }
+
+    /**
+     * Gives the first child element having the given name.
+     *
+     * @param childName The name of the child.
+     *
+     * @return The child element, or null if there is no such child.
+     */
+    [[nodiscard]] const Element *child(string_view childName) const {
+        for (auto &element : children) {
+            if (element.name == childName) {
+                return &element;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Gives the text of the first child element having the given name, or
+     * the text of this element if there is no such child.
+     *
+     * @param childName The name of the child.
+     *
+     * @return The text of the list.
+     */
+    [[nodiscard]] const string &list(string_view childName = "list") const {
+        auto element = child(childName);
+        return (element == nullptr) ? text : element->text;
+    }
+
+    /**
+     * Gives the text of the first child element having the given name.
+     *
+     * @param childName The name of the child.
+     *
+     * @return The text of the child.
+     *
+     * @throws ParseException If there is no such child.
+     */
+    [[nodiscard]] const string &required(string_view childName) const {
+        auto element = child(childName);
+        if (element == nullptr) {
+            throw ParseException("Missing <" + string(childName) + "> in <" + name + ">");
+        }
+        return element->text;
+    }
+
+    /**
+     * Creates a copy of this element in which the parameters of a group
+     * (%0, %1, ..., %...) are replaced by their arguments.
+     *
+     * @param arguments The arguments of the parameters.
+     * @param rest The index of the first argument denoted by %....
+     *
+     * @return The instantiated element.
+     */
+    [[nodiscard]] Element instantiate(const vector<string> &arguments, size_t rest) const {
+        Element element{name, attributes, substitute(text, arguments, rest), {}};
+        element.children.reserve(children.size());
+        for (auto &child : children) {
+            element.children.push_back(child.instantiate(arguments, rest));
+        }
+        return element;
+    }
+
+    /**
+     * Gives the index of the last parameter appearing in this element.
+     *
+     * @return The index of the last parameter, or -1 if there is none.
+     */
+    [[nodiscard]] int lastParameter() const {
+        int last = -1;
+        for (size_t i = text.find('%'); i != string::npos; i = text.find('%', i + 1)) {
+            int index = 0;
+            auto end = text.data() + text.size();
+            auto [ptr, error] = from_chars(text.data() + i + 1, end, index);
+            if (error == errc()) {
+                last = std::max(last, index);
+            }
+        }
+        for (auto &element : children) {
+            last = std::max(last, element.lastParameter());
+        }
+        return last;
+    }
+
+    /**
+     * Replaces the parameters of a group appearing in a text by their
+     * arguments.
+     *
+     * @param original The text in which to replace the parameters.
+     * @param arguments The arguments of the parameters.
+     * @param rest The index of the first argument denoted by %....
+     *
+     * @return The text in which the parameters have been replaced.
+     */
+    static string substitute(const string &original, const vector<string> &arguments, size_t rest) {
+        if (original.find('%') == string::npos) {
+            return original;
+        }
+
+        string result;
+        for (size_t i = 0; i < original.size(); i++) {
+            if (original[i] != '%') {
+                result += original[i];
+                continue;
+            }
+
+            if (original.compare(i + 1, 3, "...") == 0) {
+                // All the arguments that are not explicitly referenced.
+                for (auto j = rest; j < arguments.size(); j++) {
+                    result += arguments[j];
+                    result += ' ';
+                }
+                i += 3;
+                continue;
+            }
+
+            size_t index = 0;
+            auto begin = original.data() + i + 1;
+            auto [ptr, error] = from_chars(begin, original.data() + original.size(), index);
+            if ((error != errc()) || (index >= arguments.size())) {
+                throw ParseException("Invalid parameter in XCSP3 group: " + original);
+            }
+            result += arguments[index];
+            i += static_cast<size_t>(ptr - begin);
+        }
+        return result;
+    }
+
+};
+
+XcspStreamReader::XcspStreamReader(istream &input, XCSP3CoreCallbacks &callback) :
+        input(input),
+        callback(callback),
+        reader(nullptr),
+        arraySizes(),
+        domain(),
+        variables(),
+        trees(),
+        lastTuplesHaveStars(false),
+        optimization(false) {
+    // Nothing to do: everything is already initialized.
+}
+
+void XcspStreamReader::read() {
+    // Huge text nodes must be accepted, as extension constraints may be large.
+    reader = xmlReaderForIO(readInput, closeInput, &input, nullptr, nullptr, XML_PARSE_NONET | XML_PARSE_HUGE);
+    if (reader == nullptr) {
+        throw ParseException("Could not read the XCSP3 input");
+    }
+    unique_ptr<xmlTextReader, void (*)(xmlTextReaderPtr)> owner(reader, xmlFreeTextReader);
+
+    auto section = Section::NONE;
+    while (next()) {
+        auto type = xmlTextReaderNodeType(reader);
+        auto name = toText(xmlTextReaderConstName(reader));
+
+        if (type == XML_READER_TYPE_END_ELEMENT) {
+            if (name == "instance") {
+                callback.endInstance();
+            } else if (name == "variables") {
+                callback.endVariables();
+                section = Section::NONE;
+            } else if (name == "constraints") {
+                callback.endConstraints();
+                section = Section::NONE;
+            } else if (name == "objectives") {
+                callback.endObjectives();
+                section = Section::NONE;
+            } else if ((section == Section::CONSTRAINTS) && (name == "block")) {
+                callback.endBlock();
+            }
+            continue;
+        }
+
+        if (type != XML_READER_TYPE_ELEMENT) {
+            // Blanks and comments between elements are ignored.
+            continue;
+        }
+
+        auto empty = xmlTextReaderIsEmptyElement(reader) == 1;
+        if (name == "instance") {
+            optimization = attributeOf(reader, "type") == "COP";
+            callback.beginInstance(optimization ? InstanceType::COP : InstanceType::CSP);
+            if (empty) {
+                callback.endInstance();
+            }
+            continue;
+        }
+
+        if (name == "variables") {
+            callback.beginVariables();
+            section = empty ? Section::NONE : Section::VARIABLES;
+
+        } else if (name == "constraints") {
+            callback.beginConstraints();
+            section = empty ? Section::NONE : Section::CONSTRAINTS;
+
+        } else if (name == "objectives") {
+            callback.beginObjectives();
+            optimization = true;
+            section = empty ? Section::NONE : Section::OBJECTIVES;
+
+        } else if (name == "comment") {
+            // Comments do not change the problem.
+            skipElement();
+
+        } else if ((section == Section::CONSTRAINTS) && (name == "block")) {
+            // The constraints of the block are read as the next elements.
+            callback.beginBlock(attributeOf(reader, "class"));
+            if (empty) {
+                callback.endBlock();
+            }
+
+        } else if ((section == Section::CONSTRAINTS) && (name == "group")) {
+            readGroup();
+
+        } else if (section == Section::VARIABLES) {
+            readVariables(readElement());
+
+        } else if (section == Section::CONSTRAINTS) {
+            readConstraint(readElement());
+
+        } else if (section == Section::OBJECTIVES) {
+            readObjective(readElement());
+
+        } else {
+            // Annotations are not needed to build the problem.
+            skipElement();
+        }
+    }
+    reader = nullptr;
+}
+
+bool XcspStreamReader::isOptimization() const {
+    return optimization;
+}
+
+bool XcspStreamReader::next() {
+    auto status = xmlTextReaderRead(reader);
+    if (status < 0) {
+        throw ParseException("Malformed XCSP3 input");
+    }
+    return status == 1;
+}
+
+XcspStreamReader::Element XcspStreamReader::readElement() {
+    Element element;
+    element.name = toText(xmlTextReaderConstName(reader));
+    while (xmlTextReaderMoveToNextAttribute(reader) == 1) {
+        element.attributes.emplace_back(toText(xmlTextReaderConstName(reader)),
+                toText(xmlTextReaderConstValue(reader)));
+    }
+    xmlTextReaderMoveToElement(reader);
+
+    if (xmlTextReaderIsEmptyElement(reader) == 1) {
+        return element;
+    }
+
+    while (next()) {
+        switch (xmlTextReaderNodeType(reader)) {
+            case XML_READER_TYPE_ELEMENT:
+                element.children.push_back(readElement());
+                break;
+
+            case XML_READER_TYPE_TEXT:
+            case XML_READER_TYPE_CDATA:
+                element.text += toText(xmlTextReaderConstValue(reader));
+                element.text += ' ';
+                break;
+
+            case XML_READER_TYPE_WHITESPACE:
+            case XML_READER_TYPE_SIGNIFICANT_WHITESPACE:
+                element.text += ' ';
+                break;
+
+            case XML_READER_TYPE_END_ELEMENT:
+                return element;
+
+            default:
+                // Comments and processing instructions are ignored.
+                break;
+        }
+    }
+    throw ParseException("Unexpected end of XCSP3 input in <" + element.name + ">");
+}
+
+void XcspStreamReader::skipElement() {
+    if (xmlTextReaderIsEmptyElement(reader) == 1) {
+        return;
+    }
+
+    auto depth = xmlTextReaderDepth(reader);
+    while (next()) {
+        if ((xmlTextReaderNodeType(reader) == XML_READER_TYPE_END_ELEMENT) && (xmlTextReaderDepth(reader) == depth)) {
+            return;
+        }
+    }
+}
+
+void XcspStreamReader::readGroup() {
+    callback.beginGroup(attributeOf(reader, "id"));
+    if (xmlTextReaderIsEmptyElement(reader) == 1) {
+        callback.endGroup();
+        return;
+    }
+
+    optional<Element> pattern;
+    size_t rest = 0;
+    bool sharedTuples = false;
+    bool tuplesRead = false;
+    while (next()) {
+        auto type = xmlTextReaderNodeType(reader);
+        if (type == XML_READER_TYPE_END_ELEMENT) {
+            // This is the end of the group.
+            callback.endGroup();
+            return;
+        }
+
+        if (type != XML_READER_TYPE_ELEMENT) {
+            continue;
+        }
+
+        auto element = readElement();
+        if (!pattern) {
+            // The first element of the group is the pattern of its constraints.
+            rest = static_cast<size_t>(element.lastParameter() + 1);
+            auto relation = element.child("supports");
+            if (relation == nullptr) {
+                relation = element.child("conflicts");
+            }
+            sharedTuples = (relation != nullptr) && (relation->text.find('%') == string::npos);
+            pattern = move(element);
+            continue;
+        }
+
+        if (element.name == "args") {
+            auto arguments = tokenize(element.text);
+            auto instance = pattern->instantiate(arguments, rest);
+            readConstraint(instance, sharedTuples && tuplesRead);
+
+            // The tuples of the pattern are read only once.
+            tuplesRead = true;
+        }
+    }
+}
+
+void XcspStreamReader::readVariables(const Element &element) {
+    if ((!element.attribute("type").empty()) && (element.attribute("type") != "integer")) {
+        throw UnsupportedOperationException("Unsupported type of variables: " + element.attribute("type"));
+    }
+    if (!element.attribute("as").empty()) {
+        throw UnsupportedOperationException("Unsupported attribute \"as\" on <" + element.name + ">");
+    }
+
+    auto declare = [&](const string &id, const string &text) {
+        auto tokens = tokenize(text);
+        auto dots = tokens.empty() ? string::npos : tokens[0].find("..");
+        if ((tokens.size() == 1) && (dots != string::npos)) {
+            callback.buildVariableInteger(id, toInteger(string_view(tokens[0]).substr(0, dots)),
+                    toInteger(string_view(tokens[0]).substr(dots + 2)));
+        } else {
+            auto values = toIntegers(text);
+            callback.buildVariableInteger(id, values);
+        }
+    };
+
+    auto id = element.attribute("id");
+    if (element.name == "var") {
+        declare(id, element.text);
+        return;
+    }
+
+    if (element.name != "array") {
+        throw UnsupportedOperationException("Unsupported element in XCSP3 variables: <" + element.name + ">");
+    }
+
+    // Computing the size of each dimension of the array.
+    vector<int> sizes;
+    auto size = element.attribute("size");
+    for (size_t i = size.find('['); i != string::npos; i = size.find('[', i + 1)) {
+        sizes.push_back(toInteger(string_view(size).substr(i + 1, size.find(']', i) - i - 1)));
+    }
+    arraySizes[id] = sizes;
+
+    // Finding the domain of each variable of the array.
+    unordered_map<string, const string *> domains;
+    const string *others = &element.text;
+    for (auto &child : element.children) {
+        if (child.name != "domain") {
+            continue;
+        }
+        auto target = child.attribute("for");
+        if (trim(target) == "others") {
+            others = &child.text;
+            continue;
+        }
+        for (auto &name : expand(target)) {
+            domains[name] = &child.text;
+        }
+    }
+
+    string all = id;
+    for (size_t i = 0; i < sizes.size(); i++) {
+        all += "[]";
+    }
+    callback.beginVariableArray(id);
+    for (auto &name : expand(all)) {
+        auto it = domains.find(name);
+        declare(name, *((it == domains.end()) ? others : it->second));
+    }
+    callback.endVariableArray();
+}
+
+void XcspStreamReader::readConstraint(const Element &element, bool reuseTuples) {
+    variables.clear();
+    trees.clear();
+
+    auto id = element.attribute("id");
+    auto &name = element.name;
+    if (name == "extension") {
+        readExtension(id, element, reuseTuples);
+
+    } else if (name == "intension") {
+        auto tree = make_unique<Tree>(trim(element.list("function")));
+        callback.buildConstraintIntension(id, tree.get());
+
+    } else if (name == "allDifferent") {
+        readAllDifferent(id, element);
+
+    } else if (name == "allEqual") {
+        auto &list = element.list();
+        if (hasExpressions(list)) {
+            auto expressions = toTrees(list);
+            callback.buildConstraintAllEqual(id, expressions);
+        } else {
+            auto scope = toVariables(list);
+            callback.buildConstraintAllEqual(id, scope);
+        }
+
+    } else if (name == "ordered") {
+        auto scope = toVariables(element.list());
+        auto order = toOrderType(trim(element.required("operator")));
+        if (element.child("lengths") == nullptr) {
+            callback.buildConstraintOrdered(id, scope, order);
+        } else {
+            auto lengths = toIntegers(element.required("lengths"));
+            callback.buildConstraintOrdered(id, scope, lengths, order);
+        }
+
+    } else if (name == "sum") {
+        readSum(id, element);
+
+    } else if ((name == "minimum") || (name == "maximum")) {
+        auto condition = toCondition(element.required("condition"));
+        auto &list = element.list();
+        if (hasExpressions(list)) {
+            auto expressions = toTrees(list);
+            if (name == "minimum") {
+                callback.buildConstraintMinimum(id, expressions, condition);
+            } else {
+                callback.buildConstraintMaximum(id, expressions, condition);
+            }
+        } else {
+            auto scope = toVariables(list);
+            if (name == "minimum") {
+                callback.buildConstraintMinimum(id, scope, condition);
+            } else {
+                callback.buildConstraintMaximum(id, scope, condition);
+            }
+        }
+
+    } else if (name == "instantiation") {
+        auto scope = toVariables(element.required("list"));
+        auto values = toIntegers(element.required("values"));
+        callback.buildConstraintInstantiation(id, scope, values);
+
+    } else {
+        throw UnsupportedOperationException("Unsupported XCSP3 constraint: <" + name + ">");
+    }
+}
+
+void XcspStreamReader::readExtension(const string &id, const Element &element, bool reuseTuples) {
+    auto scope = toVariables(element.required("list"));
+    auto support = element.child("supports") != nullptr;
+    auto &relation = support ? element.required("supports") : element.required("conflicts");
+
+    if (scope.size() == 1) {
+        // The tuples of a unary constraint are plain values.
+        if (relation.find('*') != string::npos) {
+            throw ParseException("Stars are not allowed in unary tables of XCSP3 inputs");
+        }
+        auto values = toIntegers(relation);
+        callback.buildConstraintExtension(id, scope[0], values, support, false);
+        return;
+    }
+
+    if (reuseTuples) {
+        callback.buildConstraintExtensionAs(id, scope, support, lastTuplesHaveStars);
+        return;
+    }
+
+    vector<vector<int>> tuples;
+    vector<int> tuple;
+    lastTuplesHaveStars = false;
+    for (size_t i = relation.find('('); i != string::npos; i = relation.find('(', i + 1)) {
+        auto end = relation.find(')', i);
+        if (end == string::npos) {
+            throw ParseException("Invalid tuple in XCSP3 input");
+        }
+
+        tuple.clear();
+        for (size_t begin = i + 1; begin <= end; ) {
+            auto comma = min(relation.find(',', begin), end);
+            auto value = trim(string_view(relation).substr(begin, comma - begin));
+            if (value == "*") {
+                tuple.push_back(STAR_VALUE);
+                lastTuplesHaveStars = true;
+            } else {
+                tuple.push_back(toInteger(value));
+            }
+            begin = comma + 1;
+        }
+        tuples.push_back(tuple);
+        i = end;
+    }
+    callback.buildConstraintExtension(id, scope, tuples, support, lastTuplesHaveStars);
+}
+
+void XcspStreamReader::readSum(const string &id, const Element &element) {
+    auto condition = toCondition(element.required("condition"));
+    auto &list = element.list();
+    auto coefficients = element.child("coeffs");
+
+    if (hasExpressions(list)) {
+        auto expressions = toTrees(list);
+        if (coefficients == nullptr) {
+            callback.buildConstraintSum(id, expressions, condition);
+        } else {
+            auto coeffs = toIntegers(coefficients->text);
+            callback.buildConstraintSum(id, expressions, coeffs, condition);
+        }
+        return;
+    }
+
+    auto scope = toVariables(list);
+    if (coefficients == nullptr) {
+        callback.buildConstraintSum(id, scope, condition);
+        return;
+    }
+
+    auto tokens = tokenize(coefficients->text);
+    auto integral = all_of(tokens.begin(), tokens.end(), [](auto &token) {
+        return (token.find("..") != string::npos) || parseInteger(token).has_value();
+    });
+    if (integral) {
+        auto coeffs = toIntegers(coefficients->text);
+        callback.buildConstraintSum(id, scope, coeffs, condition);
+    } else {
+        auto coeffs = toVariables(coefficients->text);
+        callback.buildConstraintSum(id, scope, coeffs, condition);
+    }
+}
+
+void XcspStreamReader::readAllDifferent(const string &id, const Element &element) {
+    if (auto matrix = element.child("matrix")) {
+        auto rows = toMatrix(matrix->text);
+        callback.buildConstraintAlldifferentMatrix(id, rows);
+        return;
+    }
+
+    vector<const Element *> lists;
+    for (auto &child : element.children) {
+        if (child.name == "list") {
+            lists.push_back(&child);
+        }
+    }
+    if (lists.size() > 1) {
+        vector<vector<XVariable *>> scopes;
+        for (auto list : lists) {
+            scopes.push_back(toVariables(list->text));
+        }
+        callback.buildConstraintAlldifferentList(id, scopes);
+        return;
+    }
+
+    auto &list = element.list();
+    if (hasExpressions(list)) {
+        auto expressions = toTrees(list);
+        callback.buildConstraintAlldifferent(id, expressions);
+        return;
+    }
+
+    auto scope = toVariables(list);
+    if (auto except = element.child("except")) {
+        auto values = toIntegers(except->text);
+        callback.buildConstraintAlldifferentExcept(id, scope, values);
+    } else {
+        callback.buildConstraintAlldifferent(id, scope);
+    }
+}
+
+void XcspStreamReader::readObjective(const Element &element) {
+    variables.clear();
+    trees.clear();
+
+    bool minimize = element.name == "minimize";
+    if (!minimize && (element.name != "maximize")) {
+        throw UnsupportedOperationException("Unsupported XCSP3 objective: <" + element.name + ">");
+    }
+
+    auto type = element.attribute("type");
+    if (type.empty() || (type == "expression")) {
+        // The objective is either a variable or an expression.
+        auto text = trim(element.text);
+        if (hasExpressions(text)) {
+            throw UnsupportedOperationException("Unsupported XCSP3 objective expression: " + text);
+        }
+        if (minimize) {
+            callback.buildObjectiveMinimizeVariable(toVariable(text));
+        } else {
+            callback.buildObjectiveMaximizeVariable(toVariable(text));
+        }
+        return;
+    }
+
+    auto objectiveType = toObjectiveType(type);
+    auto &list = element.list();
+    auto coefficients = element.child("coeffs");
+    if (hasExpressions(list)) {
+        auto expressions = toTrees(list);
+        if (coefficients == nullptr) {
+            minimize ? callback.buildObjectiveMinimize(objectiveType, expressions)
+                     : callback.buildObjectiveMaximize(objectiveType, expressions);
+        } else {
+            auto coeffs = toIntegers(coefficients->text);
+            minimize ? callback.buildObjectiveMinimize(objectiveType, expressions, coeffs)
+                     : callback.buildObjectiveMaximize(objectiveType, expressions, coeffs);
+        }
+        return;
+    }
+
+    auto scope = toVariables(list);
+    if (coefficients == nullptr) {
+        minimize ? callback.buildObjectiveMinimize(objectiveType, scope)
+                 : callback.buildObjectiveMaximize(objectiveType, scope);
+    } else {
+        auto coeffs = toIntegers(coefficients->text);
+        minimize ? callback.buildObjectiveMinimize(objectiveType, scope, coeffs)
+                 : callback.buildObjectiveMaximize(objectiveType, scope, coeffs);
+    }
+}
+
+vector<string> XcspStreamReader::expand(const string &text) const {
+    vector<string> names;
+    for (auto &token : tokenize(text)) {
+        auto bracket = token.find('[');
+        auto array = (bracket == string::npos) ? arraySizes.end() : arraySizes.find(token.substr(0, bracket));
+        if (array == arraySizes.end()) {
+            names.push_back(token);
+            continue;
+        }
+
+        // Reading the range of indices of each dimension.
+        auto &sizes = array->second;
+        vector<pair<int, int>> ranges;
+        for (size_t i = bracket; i < token.size(); ) {
+            auto close = token.find(']', i);
+            if ((token[i] != '[') || (close == string::npos) || (ranges.size() >= sizes.size())) {
+                throw ParseException("Invalid reference to an array in XCSP3 input: " + token);
+            }
+
+            auto index = string_view(token).substr(i + 1, close - i - 1);
+            auto dots = index.find("..");
+            if (index.empty()) {
+                ranges.emplace_back(0, sizes[ranges.size()] - 1);
+            } else if (dots == string_view::npos) {
+                auto value = toInteger(index);
+                ranges.emplace_back(value, value);
+            } else {
+                ranges.emplace_back(toInteger(index.substr(0, dots)), toInteger(index.substr(dots + 2)));
+            }
+            i = close + 1;
+        }
+
+        // Enumerating the indices in lexicographic order.
+        vector<int> indices;
+        for (auto &range : ranges) {
+            if (range.first > range.second) {
+                indices.clear();
+                break;
+            }
+            indices.push_back(range.first);
+        }
+        while (!indices.empty()) {
+            auto name = token.substr(0, bracket);
+            for (auto index : indices) {
+                name += '[' + to_string(index) + ']';
+            }
+            names.push_back(move(name));
+
+            auto dimension = indices.size();
+            while ((dimension > 0) && (indices[dimension - 1] == ranges[dimension - 1].second)) {
+                indices[dimension - 1] = ranges[dimension - 1].first;
+                dimension--;
+            }
+            if (dimension == 0) {
+                break;
+            }
+            indices[dimension - 1]++;
+        }
+    }
+    return names;
+}
+
+vector<XVariable *> XcspStreamReader::toVariables(const string &text) {
+    vector<XVariable *> list;
+    for (auto &name : expand(text)) {
+        list.push_back(toVariable(name));
+    }
+    return list;
+}
+
+XVariable *XcspStreamReader::toVariable(const string &name) {
+    variables.push_back(make_unique<XVariable>(name, &domain));
+    return variables.back().get();
+}
+
+vector<Tree *> XcspStreamReader::toTrees(const string &text) {
+    vector<Tree *> list;
+    for (auto &expression : tokenize(text)) {
+        trees.push_back(make_unique<Tree>(expression));
+        list.push_back(trees.back().get());
+    }
+    return list;
+}
+
+vector<vector<XVariable *>> XcspStreamReader::toMatrix(const string &text) {
+    vector<vector<XVariable *>> rows;
+    auto matrix = trim(text);
+    if (matrix.empty() || (matrix.front() != '(')) {
+        // The matrix is a two-dimensional array, given in compact form.
+        auto bracket = matrix.find('[');
+        auto array = arraySizes.find(matrix.substr(0, bracket));
+        if ((bracket == string::npos) || (array == arraySizes.end()) || (array->second.size() != 2)) {
+            throw UnsupportedOperationException("Unsupported matrix in XCSP3 input: " + matrix);
+        }
+        for (int i = 0; i < array->second[0]; i++) {
+            rows.push_back(toVariables(array->first + "[" + to_string(i) + "][]"));
+        }
+        return rows;
+    }
+
+    for (size_t i = matrix.find('('); i != string::npos; i = matrix.find('(', i + 1)) {
+        auto end = matrix.find(')', i);
+        if (end == string::npos) {
+            throw ParseException("Invalid matrix in XCSP3 input");
+        }
+        auto row = matrix.substr(i + 1, end - i - 1);
+        for (auto &c : row) {
+            if (c == ',') {
+                c = ' ';
+            }
+        }
+        rows.push_back(toVariables(row));
+        i = end;
+    }
+    return rows;
+}
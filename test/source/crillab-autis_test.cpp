@@ -1,11 +1,1907 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "crillab-autis/crillab-autis.hpp"
+#include "crillab-autis/cnf/BasicCnfParser.hpp"
+#include "crillab-autis/cnf/BasicWcnfParser.hpp"
+#include "crillab-autis/cnf/ClauseBatch.hpp"
+#include "crillab-autis/cnf/ClauseBatchWriter.hpp"
+#include "crillab-autis/cnf/CnfParser.hpp"
+#include "crillab-autis/cnf/IClauseBatchListener.hpp"
+#include "crillab-autis/cnf/UniverseClauseSink.hpp"
+#include "crillab-autis/core/ContentHash.hpp"
+#include "crillab-autis/core/DecompressionStreamBuffer.hpp"
+#include "crillab-autis/core/IReservationListener.hpp"
+#include "crillab-autis/core/Instance.hpp"
+#include "crillab-autis/core/ParseCache.hpp"
+#include "crillab-autis/core/IntegerTokenizer.hpp"
+#include "crillab-autis/core/MappedFile.hpp"
+#include "crillab-autis/core/MappedScanner.hpp"
+#include "crillab-autis/core/ParserConfiguration.hpp"
+#include "crillab-autis/core/Pipeline.hpp"
+#include "crillab-autis/core/ReservingSink.hpp"
+#include "crillab-autis/core/Snapshot.hpp"
+#include "crillab-autis/pb/BasicOpbParser.hpp"
+#include "crillab-autis/pb/BasicWboParser.hpp"
+#include "crillab-autis/pb/ConstraintBatch.hpp"
+#include "crillab-autis/pb/IObjectiveListener.hpp"
+#include "crillab-autis/pb/OpbParser.hpp"
+#include "crillab-autis/pb/ProductLinearizer.hpp"
+#include "crillab-autis/pb/UniversePseudoBooleanSink.hpp"
+#include "crillab-autis/xcsp/AutisXcspCallback.hpp"
+#include "crillab-autis/xcsp/CompressedTupleTable.hpp"
+#include "crillab-autis/xcsp/IVariableHandleListener.hpp"
+#include "crillab-autis/xcsp/TupleTable.hpp"
+#include "crillab-autis/xcsp/XcspInstance.hpp"
+#include "crillab-autis/xcsp/XcspStreamReader.hpp"
+
+#include <crillab-except/except.hpp>
+#include <crillab-universe/csp/intension/UniverseIntensionConstraintFactory.hpp>
 
 #include <catch2/catch_test_macros.hpp>
 
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+using Autis::CompressedTupleTable;
+using Autis::TupleTable;
+
+namespace
+{
+
+using Tuples = std::vector<std::vector<int>>;
+
+// The order in which tables enumerate their tuples: lexicographic, stars first.
+bool precedes(const std::vector<int>& left, const std::vector<int>& right)
+{
+  auto key = [](int value)
+  { return value == TupleTable::STAR ? static_cast<long long>(INT_MIN) - 1 : value; };
+  return std::lexicographical_compare(
+      left.begin(), left.end(), right.begin(), right.end(),
+      [&](int l, int r) { return key(l) < key(r); });
+}
+
+Tuples sortedAndDeduplicated(Tuples tuples)
+{
+  std::sort(tuples.begin(), tuples.end(), precedes);
+  tuples.erase(std::unique(tuples.begin(), tuples.end()), tuples.end());
+  return tuples;
+}
+
+Tuples roundTrip(const Tuples& tuples, bool hasStar)
+{
+  auto decompressed = CompressedTupleTable::of(tuples, hasStar)->decompress();
+  Tuples result;
+  for (std::size_t i = 0; i < decompressed->size(); i++) {
+    auto tuple = (*decompressed)[i];
+    result.emplace_back(tuple.begin(), tuple.end());
+  }
+  return result;
+}
+
+std::string snapshotOf(const Autis::Instance& instance)
+{
+  std::stringstream output;
+  Autis::writeSnapshot(instance, output);
+  return output.str();
+}
+
+// Reads all the integers of a text, with the tokenizer when it is used.
+std::vector<int> readAll(const std::string& text, bool tokenizing)
+{
+  Autis::MappedScanner scanner(text.data(), text.data() + text.size());
+  std::vector<int> values;
+  int buffer[16];
+  for (char c; scanner.look(c);) {
+    std::size_t nbValues = tokenizing ? scanner.readIntegers(buffer, 16) : 0;
+    if (nbValues == 0) {
+      scanner.read(buffer[0]);
+      nbValues = 1;
+    }
+    values.insert(values.end(), buffer, buffer + nbValues);
+  }
+  return values;
+}
+
+// The text compressed in GZIPPED, XZ_COMPRESSED and BZIPPED.
+std::string compressedText()
+{
+  std::string text = "p cnf 2 30000\n";
+  for (int i = 0; i < 30000; i++) {
+    text += "1 -2 0\n";
+  }
+  return text;
+}
+
+const char GZIPPED[] =
+    "\x1F\x8B\x08\x00\x00\x00\x00\x00\x02\x03\xED\xC5\xB1\x0D\xC0\x20\x10\x04\xB0\x3E\x53\xDC"
+    "\x02\x91\xE0\x19\x29\x52\x4A\xC4\xFE\x15\xEC\x81\xDD\x78\xE5\x9B\x7F\x2A\xA3\x1D\x4F\xCF"
+    "\x5B\x91\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49"
+    "\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92"
+    "\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24"
+    "\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49"
+    "\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92"
+    "\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24"
+    "\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49"
+    "\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92"
+    "\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24"
+    "\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49"
+    "\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92"
+    "\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24"
+    "\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49"
+    "\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x49\x92\x24\x5D\xD7"
+    "\x06\x47\x2C\x4A\x58\x5E\x34\x03\x00";
+
+const char XZ_COMPRESSED[] =
+    "\xFD\x37\x7A\x58\x5A\x00\x00\x04\xE6\xD6\xB4\x46\x02\x00\x21\x01\x1C\x00\x00\x00\x10\xCF"
+    "\x58\xCC\xE3\x34\x5D\x00\x76\x5D\x00\x38\x08\x08\x67\x23\xBD\x95\x93\x1E\x0C\xF4\x7A\x16"
+    "\x48\xF5\xD3\x0A\xF0\xF7\x8E\x86\x46\x42\x33\xC1\x67\xA1\xA6\xA6\x84\x29\x4D\xA0\xC0\xA1"
+    "\xAA\x51\x85\xAC\xF6\xD5\xD6\x10\xE5\xD7\x3C\xBC\xFA\xFF\xAC\x68\x49\x0E\xDF\x7F\x79\x6E"
+    "\x5E\x35\x0B\xB4\xDB\xAD\x99\xA3\x0D\x0D\x10\x37\x13\xBB\xE7\x56\x7C\x8F\x11\xE0\x88\xAD"
+    "\x82\x7D\xE0\x8C\xEF\x82\x80\x1D\x5B\xD9\x60\x38\xF2\xA9\xB5\xA2\x4F\xB1\xCF\x95\x4C\x39"
+    "\xD1\x06\x39\x48\x55\x0F\x95\x20\xEA\x89\xFD\x29\xF5\xD0\xB3\x00\x00\x00\x00\x00\xA1\xC4"
+    "\x88\x3E\x4F\x7B\x2E\x7E\x00\x01\x92\x01\xDE\xE8\x0C\x00\x9B\x4A\x54\x63\xB1\xC4\x67\xFB"
+    "\x02\x00\x00\x00\x00\x04\x59\x5A";
+
+const char BZIPPED[] =
+    "\x42\x5A\x68\x39\x31\x41\x59\x26\x53\x59\x3C\x47\x70\xF5\x01\x9A\x2F\x59\x80\x40\x10\x40"
+    "\x02\x78\x00\x09\x01\x40\x00\x20\x00\x70\x40\xD0\x34\x02\x94\xA8\xF4\x27\xA9\xE9\xAC\xC0"
+    "\xA2\x4A\xE8\x28\x92\xBB\x0A\x24\xAD\xE7\x3C\x0A\x24\xAE\xB0\x28\x92\xB1\xBF\xC1\x44\x95"
+    "\xB0\xA2\x4A\xD5\xCE\x6B\xD1\x77\x24\x53\x85\x09\x03\xC4\x77\x0F\x50";
+
+// Decompresses data, or gives nothing if the library does not support its format.
+std::optional<std::string> decompress(const std::string& compressed)
+{
+  auto format = Autis::DecompressionStreamBuffer::detect(compressed.data(), compressed.size());
+  std::istringstream source(compressed);
+  std::unique_ptr<Autis::DecompressionStreamBuffer> buffer;
+  try {
+    buffer = Autis::DecompressionStreamBuffer::create(format, *source.rdbuf());
+  } catch (Except::UnsupportedOperationException&) {
+    return std::nullopt;
+  }
+  std::istream input(buffer.get());
+  return std::string(std::istreambuf_iterator<char>(input), {});
+}
+
+// A CNF input of several MiB, with comments between its clauses.
+std::string largeCnf(int nbClauses)
+{
+  std::mt19937 random(3);
+  std::uniform_int_distribution<int> literal(-1000, 1000);
+  std::uniform_int_distribution<int> size(1, 12);
+  std::string text = "c large input\np cnf 1000 " + std::to_string(nbClauses) + "\n";
+  for (int i = 0; i < nbClauses; i++) {
+    if (i % 5000 == 0) {
+      text += "c comment " + std::to_string(i) + "\n";
+    }
+    for (int n = size(random); n > 0; n--) {
+      int l = literal(random);
+      text += std::to_string((l == 0) ? 1 : l) + " ";
+    }
+    text += "0\n";
+  }
+  return text;
+}
+
+// Reads a CNF input in memory into a batch, with the given number of threads.
+template<typename Sink>
+void parseCnf(const std::string& text, Sink& sink, unsigned nbThreads)
+{
+  Autis::MappedScanner scanner(text.data(), text.data() + text.size());
+  Autis::ParserConfiguration configuration;
+  configuration.setNumberOfThreads(nbThreads);
+  Autis::BasicCnfParser<Sink> parser(scanner, sink, configuration);
+  parser.parse();
+}
+
+// A sink receiving the clauses one at a time.
+struct ClauseList
+{
+  std::vector<std::vector<int>> clauses;
+  std::vector<std::int64_t> weights;
+
+  void addClause(std::span<const int> clause)
+  {
+    clauses.emplace_back(clause.begin(), clause.end());
+    weights.push_back(0);
+  }
+
+  void addSoftClause(std::span<const int> clause, std::int64_t weight)
+  {
+    clauses.emplace_back(clause.begin(), clause.end());
+    weights.push_back(weight);
+  }
+};
+
+// A solver receiving the clauses by batches.
+struct BatchListener
+    : ClauseList
+    , Autis::IClauseBatchListener
+{
+  std::size_t nbBatches = 0;
+  std::size_t maxBatchSize = 0;
+
+  void addClauses(std::span<const std::int32_t> literals, std::span<const std::size_t> offsets) override
+  {
+    nbBatches++;
+    maxBatchSize = std::max(maxBatchSize, offsets.back() - offsets.front());
+    for (std::size_t i = 0; (i + 1) < offsets.size(); i++) {
+      addClause(literals.subspan(offsets[i], offsets[i + 1] - offsets[i]));
+    }
+  }
+};
+
+// A solver writing down the sizes of the problems it is told to reserve.
+struct ReservationRecorder : Autis::IReservationListener
+{
+  std::vector<std::pair<int, int>> hints;
+
+  void reserve(int nbVariables, int nbConstraints) override
+  {
+    hints.emplace_back(nbVariables, nbConstraints);
+  }
+};
+
+// A sink receiving the clauses one at a time, and the size of the problem.
+struct ReservingClauseList
+    : ClauseList
+    , ReservationRecorder
+{
+};
+
+// A sink failing after having received some clauses.
+struct FailingSink
+{
+  int remaining;
+
+  void addClause(std::span<const int>)
+  {
+    if (--remaining == 0) {
+      throw std::runtime_error("Sink failure");
+    }
+  }
+};
+
+// A solver writing down the objective function it receives.
+struct ObjectiveRecorder : Autis::IObjectiveListener
+{
+  std::vector<std::string> events;
+  std::vector<int> literals;
+  std::vector<Universe::BigInteger> coefficients;
+
+  void beginObjective() override { events.emplace_back("begin"); }
+
+  void addObjectiveTerm(int literal, const Universe::BigInteger& coefficient) override
+  {
+    events.emplace_back("term");
+    literals.push_back(literal);
+    coefficients.push_back(coefficient);
+  }
+
+  void endObjective() override { events.emplace_back("end"); }
+};
+
+// A sink receiving pseudo-Boolean constraints, but no objective function.
+struct ConstraintCounter
+{
+  int nbConstraints = 0;
+
+  void addAtLeast(std::span<const int>, std::span<const Universe::BigInteger>, const Universe::BigInteger&)
+  {
+    nbConstraints++;
+  }
+
+  void addAtMost(std::span<const int>, std::span<const Universe::BigInteger>, const Universe::BigInteger&)
+  {
+    nbConstraints++;
+  }
+
+  void addExactly(std::span<const int>, std::span<const Universe::BigInteger>, const Universe::BigInteger&)
+  {
+    nbConstraints++;
+  }
+};
+
+// A sink counting pseudo-Boolean constraints, and receiving the size of the problem.
+struct ReservingCounter
+    : ConstraintCounter
+    , ReservationRecorder
+{
+};
+
+// A file in the temporary directory, removed with this object.
+struct TemporaryFile
+{
+  std::filesystem::path path;
+
+  explicit TemporaryFile(const std::string& name)
+      : path(std::filesystem::temp_directory_path() / name)
+  {
+    std::filesystem::remove(path);
+  }
+
+  TemporaryFile(const std::string& name, const std::string& content)
+      : TemporaryFile(name)
+  {
+    std::ofstream(path, std::ios::binary) << content;
+  }
+
+  ~TemporaryFile() { std::filesystem::remove(path); }
+};
+
+
+// An XCSP3 callback writing down what it is notified of.
+struct XcspEventList : XCSP3Core::XCSP3CoreCallbacks
+{
+  std::vector<std::string> events;
+
+  static std::string join(const std::vector<XCSP3Core::XVariable*>& list)
+  {
+    std::string text;
+    for (auto variable : list) {
+      text += (text.empty() ? "" : " ") + variable->id;
+    }
+    return text;
+  }
+
+  static std::string join(const std::vector<int>& values)
+  {
+    std::string text;
+    for (auto value : values) {
+      text += (text.empty() ? "" : " ") + std::to_string(value);
+    }
+    return text;
+  }
+
+  void beginInstance(XCSP3Core::InstanceType type) override
+  {
+    events.push_back(type == XCSP3Core::COP ? "COP" : "CSP");
+  }
+
+  void beginGroup(std::string id) override { events.push_back("group " + id); }
+
+  void endGroup() override { events.push_back("end group"); }
+
+  void buildVariableInteger(std::string id, int minValue, int maxValue) override
+  {
+    events.push_back("var " + id + " " + std::to_string(minValue) + ".." + std::to_string(maxValue));
+  }
+
+  void buildVariableInteger(std::string id, std::vector<int>& values) override
+  {
+    events.push_back("var " + id + " " + join(values));
+  }
+
+  void buildConstraintIntension(std::string id, XCSP3Core::Tree* tree) override
+  {
+    auto root = tree->root;
+    events.push_back("intension " + std::to_string(root->type == XCSP3Core::OLT) + " "
+                     + std::to_string(root->parameters.size()));
+  }
+
+  void buildConstraintExtension(std::string id,
+                                std::vector<XCSP3Core::XVariable*> list,
+                                std::vector<std::vector<int>>& tuples,
+                                bool support,
+                                bool hasStar) override
+  {
+    std::string text;
+    for (auto& tuple : tuples) {
+      text += "(" + join(tuple) + ")";
+    }
+    events.push_back("extension " + join(list) + " " + text + (support ? "" : " conflicts"));
+  }
+
+  void buildConstraintExtensionAs(std::string id,
+                                  std::vector<XCSP3Core::XVariable*> list,
+                                  bool support,
+                                  bool hasStar) override
+  {
+    events.push_back("extension as " + join(list));
+  }
+
+  void buildConstraintSum(std::string id,
+                          std::vector<XCSP3Core::XVariable*>& list,
+                          std::vector<int>& coeffs,
+                          XCSP3Core::XCondition& cond) override
+  {
+    events.push_back("sum " + join(list) + " * " + join(coeffs) + (cond.op == XCSP3Core::LE ? " <= " : " ? ")
+                     + std::to_string(cond.val));
+  }
+
+  void buildObjectiveMinimizeVariable(XCSP3Core::XVariable* x) override
+  {
+    events.push_back("minimize " + x->id);
+  }
+};
+
+// A CSP solver writing down the constraints it receives on variable handles.
+struct HandleRecorder
+    : Universe::IUniverseCspSolver
+    , Autis::IVariableHandleListener
+{
+  std::vector<std::string> constraints;
+  std::vector<Universe::BigInteger> rightHandSides;
+  std::vector<std::shared_ptr<const Autis::TupleTable>> tables;
+
+  static std::string join(std::span<const int> variables)
+  {
+    std::string text;
+    for (int variable : variables) {
+      text += " " + std::to_string(variable);
+    }
+    return text;
+  }
+
+  void addClause(const std::vector<int>& literals) override
+  {
+    constraints.push_back("clause" + join(literals));
+  }
+
+  void addAllDifferent(std::span<const int> variables) override
+  {
+    constraints.push_back("allDifferent" + join(variables));
+  }
+
+  void addAllEqual(std::span<const int> variables) override
+  {
+    constraints.push_back("allEqual" + join(variables));
+  }
+
+  void addSupport(std::span<const int> variables, const std::shared_ptr<const Autis::TupleTable>& tuples) override
+  {
+    constraints.push_back("support" + join(variables));
+    tables.push_back(tuples);
+  }
+
+  void addConflicts(std::span<const int> variables, const std::shared_ptr<const Autis::TupleTable>& tuples) override
+  {
+    constraints.push_back("conflicts" + join(variables));
+    tables.push_back(tuples);
+  }
+
+  void addSum(std::span<const int> variables,
+              Universe::UniverseRelationalOperator,
+              const Universe::BigInteger& rhs) override
+  {
+    constraints.push_back("sum" + join(variables));
+    rightHandSides.push_back(rhs);
+  }
+
+  void addSum(std::span<const int> variables,
+              const std::vector<Universe::BigInteger>& coefficients,
+              Universe::UniverseRelationalOperator,
+              const Universe::BigInteger& rhs) override
+  {
+    constraints.push_back("weightedSum" + join(variables) + " /" + std::to_string(coefficients.size()));
+    rightHandSides.push_back(rhs);
+  }
+
+  void addPrimitive(int variable, Universe::UniverseRelationalOperator, int value) override
+  {
+    constraints.push_back("primitive " + std::to_string(variable) + " " + std::to_string(value));
+  }
+};
+
+// Declares the variables x, y and z, and constrains them.
+void declareAndConstrain(Autis::AutisXcspCallback& callback)
+{
+  static XCSP3Core::XDomainInteger domain;
+  static XCSP3Core::XVariable x("x", &domain);
+  static XCSP3Core::XVariable y("y", &domain);
+  static XCSP3Core::XVariable z("z", &domain);
+
+  callback.buildVariableInteger("x", 0, 3);
+  std::vector<int> values = {1, 4, 9};
+  callback.buildVariableInteger("y", values);
+  callback.buildVariableInteger("z", -2, 2);
+
+  std::vector<XCSP3Core::XVariable*> all = {&x, &y, &z};
+  callback.buildConstraintAlldifferent("c1", all);
+
+  XCSP3Core::XCondition condition;
+  condition.op = XCSP3Core::LE;
+  condition.operandType = XCSP3Core::INTEGER;
+  condition.val = 5;
+  std::vector<XCSP3Core::XVariable*> last = {&z, &y};
+  callback.buildConstraintSum("c2", last, condition);
+  std::vector<int> coefficients = {2, -1};
+  callback.buildConstraintSum("c3", last, coefficients, condition);
+
+  callback.buildConstraintPrimitive("c4", XCSP3Core::GE, &y, 4);
+
+  std::vector<std::vector<int>> tuples = {{0, 1}, {2, -2}};
+  std::vector<XCSP3Core::XVariable*> pair = {&x, &z};
+  callback.buildConstraintExtension("c5", pair, tuples, true, false);
+}
+
+}  // namespace
+
 TEST_CASE("Name is crillab-autis", "[library]")
 {
   auto const exported = exported_class {};
   REQUIRE(std::string("crillab-autis") == exported.name());
 }
+
+TEST_CASE("Compressed tables give back their sorted distinct tuples",
+          "[xcsp][CompressedTupleTable]")
+{
+  SECTION("plain tuples")
+  {
+    Tuples tuples = {{1, 2, 3}, {0, 2, 3}, {1, 2, 3}, {1, 0, 3}, {0, 2, 4}};
+    auto table = CompressedTupleTable::of(tuples, false);
+    REQUIRE(table->getArity() == 3);
+    REQUIRE(table->size() == 4);
+    REQUIRE(roundTrip(tuples, false) == sortedAndDeduplicated(tuples));
+  }
+
+  SECTION("stars")
+  {
+    auto star = TupleTable::STAR;
+    Tuples tuples = {{1, star}, {star, 2}, {0, 1}, {star, star}, {1, star}};
+    auto table = CompressedTupleTable::of(tuples, true);
+    REQUIRE(table->hasStar());
+    REQUIRE(roundTrip(tuples, true) == sortedAndDeduplicated(tuples));
+  }
+
+  SECTION("negative values")
+  {
+    Tuples tuples = {{-1, 5}, {INT_MIN, 0}, {3, -7}, {-1, 5}, {INT_MAX - 1, INT_MIN}};
+    REQUIRE(roundTrip(tuples, false) == sortedAndDeduplicated(tuples));
+  }
+
+  SECTION("empty table")
+  {
+    auto table = CompressedTupleTable::of({}, false);
+    REQUIRE(table->size() == 0);
+    REQUIRE(table->decompress()->size() == 0);
+  }
+
+  SECTION("tuples of different sizes")
+  {
+    REQUIRE_THROWS(CompressedTupleTable::of({{1, 2}, {3}}, false));
+  }
+}
+
+TEST_CASE("Compressed tables radix sort their tuples on all the bytes of their values",
+          "[xcsp][CompressedTupleTable][radixSort]")
+{
+  // The keys of the first column span all the bytes, those of the second a
+  // single one, and the last column only holds stars and a constant value.
+  std::mt19937 random(42);
+  std::uniform_int_distribution<int> wide(INT_MIN, INT_MAX - 1);
+  std::uniform_int_distribution<int> narrow(-100, 100);
+  Tuples pool;
+  for (int i = 0; i < 500; i++) {
+    pool.push_back({wide(random), narrow(random), (i % 3 == 0) ? TupleTable::STAR : 7});
+  }
+
+  Tuples tuples;
+  for (int i = 0; i < 2000; i++) {
+    tuples.push_back(pool[random() % pool.size()]);
+  }
+
+  auto table = CompressedTupleTable::of(tuples, true);
+  auto expected = sortedAndDeduplicated(tuples);
+  REQUIRE(table->size() == expected.size());
+  REQUIRE(roundTrip(tuples, true) == expected);
+}
+
+TEST_CASE("Products are replaced by the same variable whatever their order",
+          "[pb][ProductLinearizer]")
+{
+  Autis::ProductLinearizer linearizer;
+  linearizer.reset(5);
+  bool fresh = false;
+
+  std::vector<int> product = {3, -1};
+  REQUIRE(linearizer.linearize(product, fresh) == 6);
+  REQUIRE(fresh);
+  REQUIRE(product == std::vector<int> {-1, 3});
+
+  product = {-1, 3, 3};
+  REQUIRE(linearizer.linearize(product, fresh) == 6);
+  REQUIRE_FALSE(fresh);
+
+  product = {2, 4};
+  REQUIRE(linearizer.linearize(product, fresh) == 7);
+  REQUIRE(fresh);
+
+  auto first = linearizer.getProduct(6);
+  REQUIRE(std::vector<int>(first.begin(), first.end()) == std::vector<int> {-1, 3});
+  REQUIRE(linearizer.size() == 2);
+  REQUIRE(linearizer.getNumberOfVariables() == 7);
+
+  SECTION("a product of a single literal is this literal")
+  {
+    product = {-4, -4};
+    REQUIRE(linearizer.linearize(product, fresh) == -4);
+    REQUIRE_FALSE(fresh);
+    REQUIRE(linearizer.size() == 2);
+  }
+
+  SECTION("products are kept while the table grows")
+  {
+    for (int i = 1; i <= 1000; i++) {
+      product = {i, i + 1};
+      linearizer.linearize(product, fresh);
+    }
+    product = {3, -1};
+    REQUIRE(linearizer.linearize(product, fresh) == 6);
+    REQUIRE_FALSE(fresh);
+    product = {4, 2};
+    REQUIRE(linearizer.linearize(product, fresh) == 7);
+    REQUIRE_FALSE(fresh);
+  }
+
+  SECTION("reset forgets the products")
+  {
+    linearizer.reset(10);
+    REQUIRE(linearizer.size() == 0);
+    product = {4, 2};
+    REQUIRE(linearizer.linearize(product, fresh) == 11);
+    REQUIRE(fresh);
+  }
+}
+
+TEST_CASE("Products of OPB inputs are replaced by defined variables", "[pb][BasicOpbParser]")
+{
+  std::string text = "* #variable= 3 #constraint= 2 #product= 2 sizeproduct= 4\n"
+                     "+1 x1 x2 +2 x3 >= 1 ;\n"
+                     "+3 ~x1 x3 -1 x2 x1 >= 0 ;\n";
+
+  SECTION("linearized products")
+  {
+    std::istringstream input(text);
+    Autis::Scanner scanner(input);
+    Autis::ConstraintBatch batch;
+    Autis::BasicOpbParser<Autis::ConstraintBatch> parser(scanner, batch, true);
+    parser.parse();
+
+    // Each product may need a variable and two constraints.
+    REQUIRE(batch.reservation);
+    REQUIRE(batch.nbVariables == 5);
+    REQUIRE(batch.nbConstraints == 6);
+    REQUIRE(parser.getNumberOfVariables() == 5);
+
+    // The same product gives the same variable, which is defined only once.
+    using Coefficients = std::vector<Universe::BigInteger>;
+    REQUIRE(batch.size() == 6);
+    REQUIRE(batch.offsets == std::vector<std::size_t> {0, 2, 5, 8, 10, 13, 16});
+    REQUIRE(batch.literals == std::vector<int> {4, 3, 1, 2, -4, 4, -1, -2, 5, 4, -1, 3, -5, 5, 1, -3});
+    REQUIRE(batch.coefficients == Coefficients {1, 2, 1, 1, 2, 1, 1, 1, 3, -1, 1, 1, 2, 1, 1, 1});
+    REQUIRE(batch.degrees == Coefficients {1, 2, 1, 0, 2, 1});
+    REQUIRE(std::all_of(batch.operators.begin(), batch.operators.end(),
+                        [](auto op) { return op == Autis::RelationalOperator::AT_LEAST; }));
+  }
+
+  SECTION("products rejected")
+  {
+    std::istringstream input(text);
+    Autis::Scanner scanner(input);
+    Autis::ConstraintBatch batch;
+    Autis::BasicOpbParser<Autis::ConstraintBatch> parser(scanner, batch, false);
+    REQUIRE_THROWS_AS(parser.parse(), Except::UnsupportedOperationException);
+  }
+}
+
+TEST_CASE("Objective functions are given term by term", "[pb][BasicOpbParser][IObjectiveListener]")
+{
+  using Coefficients = std::vector<Universe::BigInteger>;
+  const Universe::BigInteger big = 1LL << 40;
+  const Universe::BigInteger bigger = -INT64_MAX;
+
+  SECTION("big coefficients and products")
+  {
+    std::istringstream input("* #variable= 3 #constraint= 1 #product= 1\n"
+                             "min: +1099511627776 x1 -9223372036854775807 x2 x3 +3 ~x3 ;\n"
+                             "+1 x1 +1 x2 >= 1 ;\n");
+    Autis::Scanner scanner(input);
+    Autis::ConstraintBatch batch;
+    Autis::BasicOpbParser<Autis::ConstraintBatch> parser(scanner, batch);
+    parser.parse();
+
+    REQUIRE(parser.isOptimization());
+    REQUIRE(batch.objectiveBegins);
+    REQUIRE(batch.objectiveEnds);
+    REQUIRE(batch.objectiveLiterals == std::vector<int> {1, 4, -3});
+    REQUIRE(batch.objectiveCoefficients == Coefficients {big, bigger, 3});
+
+    // The product of the objective function is defined right after it.
+    REQUIRE(batch.size() == 3);
+    REQUIRE(batch.literals == std::vector<int> {2, 3, -4, 4, -2, -3, 1, 2});
+  }
+
+  SECTION("terms given to the solver")
+  {
+    std::istringstream input("* #variable= 2 #constraint= 0\n"
+                             "min: +1099511627776 x1 -9223372036854775807 ~x2 ;\n");
+    Autis::Scanner scanner(input);
+    ObjectiveRecorder recorder;
+    Autis::UniversePseudoBooleanSink sink(nullptr, nullptr, &recorder);
+    Autis::BasicOpbParser<Autis::UniversePseudoBooleanSink> parser(scanner, sink);
+    parser.parse();
+
+    REQUIRE(recorder.events == std::vector<std::string> {"begin", "term", "term", "end"});
+    REQUIRE(recorder.literals == std::vector<int> {1, -2});
+    REQUIRE(recorder.coefficients == Coefficients {big, bigger});
+  }
+
+  SECTION("sinks without objective function")
+  {
+    std::string text = "* #variable= 2 #constraint= 1\n"
+                       "min: +1 x1 ;\n"
+                       "+1 x1 +1 x2 >= 1 ;\n";
+
+    std::istringstream input(text);
+    Autis::Scanner scanner(input);
+    Autis::UniversePseudoBooleanSink sink(nullptr);
+    Autis::BasicOpbParser<Autis::UniversePseudoBooleanSink> parser(scanner, sink);
+    REQUIRE_THROWS_AS(parser.parse(), Except::UnsupportedOperationException);
+
+    std::istringstream otherInput(text);
+    Autis::Scanner otherScanner(otherInput);
+    ConstraintCounter counter;
+    Autis::BasicOpbParser<ConstraintCounter> otherParser(otherScanner, counter);
+    REQUIRE_THROWS_AS(otherParser.parse(), Except::UnsupportedOperationException);
+    REQUIRE(counter.nbConstraints == 0);
+  }
+}
+
+TEST_CASE("A snapshot is loaded back as the same instance", "[core][Snapshot]")
+{
+  Autis::Instance instance(Autis::InstanceType::CSP);
+  auto& csp = instance.getCspInstance();
+  for (auto name : {"x", "y", "z"}) {
+    csp.add(Autis::CspOperation::NEW_VARIABLE_RANGE, std::string(name), -5, 5);
+  }
+
+  std::vector<int> handles = {csp.variable("x"), csp.variable("y")};
+  auto star = TupleTable::STAR;
+  csp.add(Autis::CspOperation::SUPPORT,
+          csp.variables(handles),
+          TupleTable::of(2, {{-1, 2}, {star, 0}}, true));
+  csp.add(Autis::CspOperation::CONFLICTS,
+          csp.variables(handles),
+          CompressedTupleTable::of({{-5, 5}, {0, star}, {-5, 5}}, true));
+
+  auto distance = csp.intension(
+      Autis::IntensionOperator::DIST,
+      {csp.intensionVariable("x"), csp.intensionVariable("z")});
+  csp.add(Autis::CspOperation::INTENSION,
+          csp.intension(Autis::IntensionOperator::LT,
+                        {distance, csp.intensionConstant(-3)}));
+
+  auto snapshot = snapshotOf(instance);
+  REQUIRE(Autis::isSnapshot(snapshot.data(), snapshot.size()));
+
+  auto loaded = Autis::readSnapshot(snapshot.data(), snapshot.data() + snapshot.size());
+  REQUIRE(loaded.getType() == Autis::InstanceType::CSP);
+  REQUIRE(loaded.getCspInstance().size() == csp.size());
+  REQUIRE(snapshotOf(loaded) == snapshot);
+}
+
+TEST_CASE("Literals whose magnitude does not fit in an int are rejected", "[core][checkLiteral]")
+{
+  SECTION("CNF")
+  {
+    std::istringstream input("p cnf 3 1\n1 -2147483648 0\n");
+    Autis::Scanner scanner(input);
+    Autis::ClauseBatch batch;
+    Autis::BasicCnfParser<Autis::ClauseBatch> parser(scanner, batch);
+    REQUIRE_THROWS_AS(parser.parse(), Except::ParseException);
+  }
+
+  SECTION("WCNF")
+  {
+    std::istringstream input("h 1 -2147483648 0\n");
+    Autis::Scanner scanner(input);
+    Autis::ClauseBatch batch;
+    Autis::BasicWcnfParser<Autis::ClauseBatch> parser(scanner, batch);
+    REQUIRE_THROWS_AS(parser.parse(), Except::ParseException);
+  }
+
+  SECTION("OPB")
+  {
+    std::istringstream input("* #variable= 3 #constraint= 1\n+1 x1 +1 x-2147483648 >= 1;\n");
+    Autis::Scanner scanner(input);
+    Autis::ConstraintBatch batch;
+    Autis::BasicOpbParser<Autis::ConstraintBatch> parser(scanner, batch);
+    REQUIRE_THROWS_AS(parser.parse(), Except::ParseException);
+  }
+}
+
+TEST_CASE("Checked readers accept the bounds of their type and reject what lies beyond",
+          "[core][Scanner]")
+{
+  SECTION("32-bit integers")
+  {
+    std::istringstream input("2147483647 -2147483648 +0 -0");
+    Autis::Scanner scanner(input);
+    std::int32_t value;
+    scanner.readInt32(value);
+    REQUIRE(value == INT32_MAX);
+    scanner.readInt32(value);
+    REQUIRE(value == INT32_MIN);
+    scanner.readInt32(value);
+    REQUIRE(value == 0);
+    scanner.readInt32(value);
+    REQUIRE(value == 0);
+
+    for (auto text : {"2147483648", "-2147483649", "99999999999999999999"}) {
+      std::istringstream overflowing(text);
+      Autis::Scanner overflowingScanner(overflowing);
+      REQUIRE_THROWS_AS(overflowingScanner.readInt32(value), Except::ParseException);
+    }
+  }
+
+  SECTION("64-bit integers")
+  {
+    std::istringstream input("9223372036854775807 -9223372036854775808");
+    Autis::Scanner scanner(input);
+    std::int64_t value;
+    scanner.readInt64(value);
+    REQUIRE(value == INT64_MAX);
+    scanner.readInt64(value);
+    REQUIRE(value == INT64_MIN);
+
+    for (auto text : {"9223372036854775808", "-9223372036854775809"}) {
+      std::istringstream overflowing(text);
+      Autis::Scanner overflowingScanner(overflowing);
+      REQUIRE_THROWS_AS(overflowingScanner.readInt64(value), Except::ParseException);
+    }
+  }
+
+  SECTION("64-bit integers with a big integer fallback")
+  {
+    std::istringstream input("-9223372036854775808 9223372036854775808 7");
+    Autis::Scanner scanner(input);
+    std::int64_t value;
+    Universe::BigInteger bigValue;
+    REQUIRE(scanner.readInt64(value, bigValue));
+    REQUIRE(value == INT64_MIN);
+    REQUIRE_FALSE(scanner.readInt64(value, bigValue));
+    REQUIRE(scanner.readInt64(value, bigValue));
+    REQUIRE(value == 7);
+  }
+
+  SECTION("ints are no longer truncated")
+  {
+    std::istringstream input("4294967297");
+    Autis::Scanner scanner(input);
+    int value;
+    REQUIRE_THROWS_AS(scanner.read(value), Except::ParseException);
+  }
+
+  SECTION("missing numbers")
+  {
+    std::istringstream input("  - x");
+    Autis::Scanner scanner(input);
+    int value;
+    REQUIRE_THROWS_AS(scanner.read(value), Except::ParseException);
+  }
+}
+
+TEST_CASE("Regular files are mapped, and nothing else", "[core][MappedFile]")
+{
+  SECTION("regular file")
+  {
+    TemporaryFile file("autis-mapped.cnf", "p cnf 2 1\n1 -2 0\n");
+    Autis::MappedFile mapped;
+    REQUIRE(mapped.map(file.path.string()));
+    REQUIRE(std::string(mapped.data(), mapped.size()) == "p cnf 2 1\n1 -2 0\n");
+
+    Autis::MappedScanner scanner(mapped);
+    REQUIRE(scanner.isInMemory());
+    scanner.skipLine();
+    int literal;
+    scanner.read(literal);
+    REQUIRE(literal == 1);
+    scanner.read(literal);
+    REQUIRE(literal == -2);
+  }
+
+  SECTION("empty file")
+  {
+    TemporaryFile file("autis-empty.cnf", "");
+    Autis::MappedFile mapped;
+    REQUIRE_FALSE(mapped.map(file.path.string()));
+  }
+
+  SECTION("missing file")
+  {
+    TemporaryFile file("autis-missing.cnf");
+    Autis::MappedFile mapped;
+    REQUIRE_FALSE(mapped.map(file.path.string()));
+  }
+
+#ifndef _WIN32
+  SECTION("named pipe, which must not be opened")
+  {
+    TemporaryFile file("autis-pipe.cnf");
+    REQUIRE(mkfifo(file.path.c_str(), 0600) == 0);
+    Autis::MappedFile mapped;
+    REQUIRE_FALSE(mapped.map(file.path.string()));
+  }
+#endif
+}
+
+TEST_CASE("The rest of a line is looked at without being consumed", "[core][Scanner][lookLine]")
+{
+  SECTION("line ending with the input")
+  {
+    std::istringstream input("c comment\np wcnf 2 3");
+    Autis::Scanner scanner(input);
+    REQUIRE(scanner.lookLine() == "c comment");
+    scanner.skipLine();
+    REQUIRE(scanner.lookLine() == "p wcnf 2 3");
+    REQUIRE(scanner.read() == 'p');
+  }
+
+  SECTION("last line after a line longer than a block")
+  {
+    std::string line = "c " + std::string(1 << 17, 'x');
+    std::istringstream input(line + "\nh 1 0");
+    Autis::Scanner scanner(input);
+    REQUIRE(scanner.lookLine() == line);
+    scanner.skipLine();
+    REQUIRE(scanner.lookLine() == "h 1 0");
+  }
+}
+
+TEST_CASE("Streams are read by blocks without losing what spans two of them", "[core][Scanner]")
+{
+  // The block read from the stream at once has 64 KiB.
+  constexpr std::size_t blockSize = 1 << 16;
+
+  SECTION("numbers across a block boundary")
+  {
+    std::istringstream input(std::string(blockSize - 3, ' ') + "123456 -78\n");
+    Autis::Scanner scanner(input);
+    int value;
+    scanner.read(value);
+    REQUIRE(value == 123456);
+    scanner.read(value);
+    REQUIRE(value == -78);
+    char c;
+    REQUIRE_FALSE(scanner.look(c));
+    REQUIRE(scanner.eof());
+  }
+
+  SECTION("lines longer than a block")
+  {
+    std::string line = "c " + std::string(3 * blockSize, 'x');
+    std::istringstream input(line + "\nnext");
+    Autis::Scanner scanner(input);
+    REQUIRE(scanner.lookLine() == line);
+    REQUIRE(scanner.read() == 'c');
+    scanner.skipLine();
+    REQUIRE(scanner.lookLine() == "next");
+  }
+
+  SECTION("peeking and looking do not consume")
+  {
+    std::istringstream input("  \t\na b");
+    Autis::Scanner scanner(input);
+    char c;
+    REQUIRE(scanner.peek(c));
+    REQUIRE(c == ' ');
+    REQUIRE(scanner.look(c));
+    REQUIRE(c == 'a');
+    REQUIRE(scanner.look(c));
+    REQUIRE(c == 'a');
+    scanner.advance();
+    REQUIRE(scanner.look(c));
+    REQUIRE(c == 'b');
+  }
+
+  SECTION("the unread input is given back as a stream")
+  {
+    std::string rest(2 * blockSize, 'y');
+    std::istringstream input("42 " + rest);
+    Autis::Scanner scanner(input);
+    int value;
+    scanner.read(value);
+    REQUIRE(value == 42);
+    REQUIRE(scanner.read() == ' ');
+    std::string unread(std::istreambuf_iterator<char>(scanner.getInput()), {});
+    REQUIRE(unread == rest);
+  }
+}
+
+TEST_CASE("The integer tokenizer reads the same values as the scanner", "[core][IntegerTokenizer]")
+{
+  INFO("implementation: " << Autis::IntegerTokenizer::implementation());
+
+  SECTION("at all offsets in a window")
+  {
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int> nbDigits(1, 10);
+    std::uniform_int_distribution<int> digit(0, 9);
+    std::uniform_int_distribution<int> choice(0, 5);
+    std::string text;
+    for (int i = 0; i < 2000; i++) {
+      text += " \t\n\r  "[choice(random)];
+      if (choice(random) == 0) {
+        text += "\n";
+      }
+      text += "-+  "[choice(random) % 4];
+      // Numbers of 10 digits are kept below INT_MAX.
+      int n = nbDigits(random);
+      text += (n == 10) ? '1' : static_cast<char>('0' + digit(random));
+      for (n--; n > 0; n--) {
+        text += static_cast<char>('0' + digit(random));
+      }
+    }
+
+    for (std::size_t offset = 0; offset < 64; offset++) {
+      std::string shifted = std::string(offset, ' ') + text;
+      REQUIRE(readAll(shifted, true) == readAll(shifted, false));
+    }
+  }
+
+  SECTION("tokens left to the scanner")
+  {
+    std::string numbers;
+    for (int i = 0; i < 40; i++) {
+      numbers += "12 -3 ";
+    }
+
+    for (std::string token : {"1234567890", "-", "+x", "x1", "2147483647"}) {
+      std::string text = numbers + token + " 5" + std::string(64, ' ');
+      const char* cursor = text.data();
+      int values[256];
+      auto nbValues = Autis::IntegerTokenizer::tokenize(cursor, text.data() + text.size(), values, 256);
+      REQUIRE(nbValues == 80);
+      REQUIRE(values[78] == 12);
+      REQUIRE(values[79] == -3);
+      REQUIRE(std::string(cursor, token.size()) == token);
+    }
+  }
+
+  SECTION("numbers ending with the region")
+  {
+    std::string text = std::string(100, ' ') + "123";
+    const char* cursor = text.data();
+    int values[4];
+    Autis::IntegerTokenizer::tokenize(cursor, text.data() + text.size(), values, 4);
+    REQUIRE(cursor <= text.data() + 100);
+    REQUIRE(readAll(text, true) == std::vector<int> {123});
+  }
+}
+
+TEST_CASE("Compressed inputs are recognized and decompressed block by block",
+          "[core][DecompressionStreamBuffer]")
+{
+  using Autis::CompressionFormat;
+  using Autis::DecompressionStreamBuffer;
+
+  SECTION("magic numbers")
+  {
+    REQUIRE(DecompressionStreamBuffer::detect(GZIPPED, 6) == CompressionFormat::GZIP);
+    REQUIRE(DecompressionStreamBuffer::detect(XZ_COMPRESSED, 6) == CompressionFormat::XZ);
+    REQUIRE(DecompressionStreamBuffer::detect(BZIPPED, 6) == CompressionFormat::BZIP2);
+    REQUIRE(DecompressionStreamBuffer::detect("\x28\xB5\x2F\xFD\x00\x00", 6) == CompressionFormat::ZSTD);
+    REQUIRE(DecompressionStreamBuffer::detect("p cnf ", 6) == CompressionFormat::NONE);
+    REQUIRE(DecompressionStreamBuffer::detect("\x1F", 1) == CompressionFormat::NONE);
+  }
+
+  SECTION("round trips")
+  {
+    // The formats the library has been built without are not checked.
+    for (auto [name, data, size] : {std::tuple {"gzip", GZIPPED, sizeof(GZIPPED) - 1},
+                                    std::tuple {"xz", XZ_COMPRESSED, sizeof(XZ_COMPRESSED) - 1},
+                                    std::tuple {"bzip2", BZIPPED, sizeof(BZIPPED) - 1}})
+    {
+      INFO("format: " << name);
+      std::string compressed(data, size);
+      auto decompressed = decompress(compressed);
+      if (!decompressed) {
+        continue;
+      }
+      REQUIRE(*decompressed == compressedText());
+
+      // The content of a truncated input is never silently cut.
+      REQUIRE_THROWS_AS(decompress(compressed.substr(0, size / 2)), Except::ParseException);
+    }
+  }
+
+  SECTION("concatenated gzip members")
+  {
+    std::string gzipped(GZIPPED, sizeof(GZIPPED) - 1);
+    auto decompressed = decompress(gzipped + gzipped);
+    if (decompressed) {
+      REQUIRE(*decompressed == compressedText() + compressedText());
+    }
+  }
+}
+
+TEST_CASE("CNF inputs read in parallel give the clauses in the order of the input",
+          "[cnf][BasicCnfParser][parallel]")
+{
+  auto text = largeCnf(600000);
+  REQUIRE(text.size() > (8 << 20));
+
+  Autis::ClauseBatch sequential;
+  parseCnf(text, sequential, 1);
+  REQUIRE(sequential.size() == 600000);
+
+  SECTION("same clauses")
+  {
+    for (unsigned nbThreads : {2U, 3U, 8U}) {
+      Autis::ClauseBatch parallel;
+      parseCnf(text, parallel, nbThreads);
+      REQUIRE(parallel.nbVariables == 1000);
+      REQUIRE(parallel.literals == sequential.literals);
+      REQUIRE(parallel.offsets == sequential.offsets);
+    }
+  }
+
+  SECTION("misplaced problem line")
+  {
+    // The parallel read stops there, and the rest is read sequentially.
+    auto middle = text.find('\n', text.size() / 2) + 1;
+    auto misplaced = text.substr(0, middle) + "p cnf 1000 600000\n" + text.substr(middle);
+    Autis::ClauseBatch parallel;
+    parseCnf(misplaced, parallel, 4);
+    REQUIRE(parallel.literals == sequential.literals);
+  }
+
+  SECTION("errors in the input")
+  {
+    auto middle = text.find('\n', text.size() / 2) + 1;
+    auto illFormed = text.substr(0, middle) + "1 x 0\n" + text.substr(middle);
+    Autis::ClauseBatch parallel;
+    REQUIRE_THROWS_AS(parseCnf(illFormed, parallel, 4), Except::ParseException);
+
+    auto invalid = text.substr(0, middle) + "1001 0\n" + text.substr(middle);
+    REQUIRE_THROWS_AS(parseCnf(invalid, parallel, 4), Except::ParseException);
+  }
+
+  SECTION("errors in the sink")
+  {
+    FailingSink sink {1000};
+    REQUIRE_THROWS_AS(parseCnf(text, sink, 4), std::runtime_error);
+  }
+}
+
+TEST_CASE("Clauses are given by batches to the sinks supporting them", "[cnf][ClauseBatch]")
+{
+  auto text = largeCnf(100000);
+  ClauseList oneByOne;
+  parseCnf(text, oneByOne, 1);
+  REQUIRE(oneByOne.clauses.size() == 100000);
+
+  SECTION("batches of bounded size")
+  {
+    BatchListener listener;
+    Autis::UniverseClauseBatchSink sink(&listener);
+    parseCnf(text, sink, 1);
+    REQUIRE(listener.clauses == oneByOne.clauses);
+    REQUIRE(listener.nbBatches > 1);
+    REQUIRE(listener.maxBatchSize < (1 << 16) + 16);
+  }
+
+  SECTION("replaying a batch")
+  {
+    Autis::ClauseBatch batch;
+    parseCnf(text, batch, 1);
+    std::vector<int> clause;
+
+    ClauseList oneByOneAgain;
+    batch.replay(oneByOneAgain, clause);
+    REQUIRE(oneByOneAgain.clauses == oneByOne.clauses);
+
+    BatchListener listener;
+    Autis::UniverseClauseBatchSink sink(&listener);
+    batch.replay(sink, clause);
+    REQUIRE(listener.clauses == oneByOne.clauses);
+    REQUIRE(listener.nbBatches == 1);
+  }
+
+  SECTION("replaying a batch with soft clauses")
+  {
+    Autis::ClauseBatch batch;
+    batch.addClause(std::vector<int> {1, 2});
+    batch.addSoftClause(std::vector<int> {-1}, 5);
+    batch.addClauses(std::vector<std::int32_t> {3, -2, 4}, std::vector<std::size_t> {0, 2, 3});
+    batch.addSoftClause(std::vector<int> {2}, 7);
+
+    ClauseList list;
+    std::vector<int> clause;
+    batch.replay(list, clause);
+    REQUIRE(list.clauses == std::vector<std::vector<int>> {{1, 2}, {-1}, {3, -2}, {4}, {2}});
+    REQUIRE(list.weights == std::vector<std::int64_t> {0, 5, 0, 0, 7});
+
+    Autis::ClauseBatch copy;
+    batch.replay(copy, clause);
+    REQUIRE(copy.literals == batch.literals);
+    REQUIRE(copy.offsets == batch.offsets);
+    REQUIRE(copy.weights == batch.weights);
+  }
+}
+
+TEST_CASE("Sizes declared in headers are given to the sinks reserving them", "[core][IReservationListener]")
+{
+  using Hints = std::vector<std::pair<int, int>>;
+
+  SECTION("CNF")
+  {
+    std::string text = "c sizes\np cnf 4 3\n1 -2 0\n3 4 0\n-1 0\n";
+    for (unsigned nbThreads : {1U, 2U}) {
+      BatchListener solver;
+      ReservationRecorder recorder;
+      Autis::UniverseClauseBatchSink sink(&solver, &recorder);
+      parseCnf(text, sink, nbThreads);
+      REQUIRE(recorder.hints == Hints {{4, 3}});
+      REQUIRE(solver.clauses.size() == 3);
+    }
+
+    // Solvers that are not listeners still receive the same clauses.
+    BatchListener solver;
+    Autis::UniverseClauseBatchSink sink(&solver);
+    parseCnf(text, sink, 1);
+    static_assert(!Autis::ReservingSink<ClauseList>);
+    ClauseList list;
+    parseCnf(text, list, 1);
+    REQUIRE(list.clauses == solver.clauses);
+    REQUIRE(list.clauses.size() == 3);
+  }
+
+  SECTION("OPB")
+  {
+    // Linearizing the product may need a variable and two constraints.
+    std::string text = "* #variable= 3 #constraint= 2 #product= 1\n"
+                       "+1 x1 x2 +1 x3 >= 1 ;\n"
+                       "-1 x1 -1 x3 >= -1 ;\n";
+
+    std::istringstream input(text);
+    Autis::Scanner scanner(input);
+    ReservingCounter counter;
+    Autis::BasicOpbParser<ReservingCounter> parser(scanner, counter);
+    parser.parse();
+    REQUIRE(counter.hints == Hints {{4, 4}});
+    REQUIRE(counter.nbConstraints == 4);
+
+    std::istringstream otherInput(text);
+    Autis::Scanner otherScanner(otherInput);
+    ConstraintCounter otherCounter;
+    Autis::BasicOpbParser<ConstraintCounter> otherParser(otherScanner, otherCounter);
+    otherParser.parse();
+    REQUIRE(otherCounter.nbConstraints == 4);
+  }
+
+  SECTION("WCNF")
+  {
+    std::string text = "p wcnf 3 2 10\n10 1 2 0\n4 -3 0\n";
+
+    std::istringstream input(text);
+    Autis::Scanner scanner(input);
+    ReservingClauseList list;
+    Autis::BasicWcnfParser<ReservingClauseList> parser(scanner, list);
+    parser.parse();
+    REQUIRE(list.hints == Hints {{3, 2}});
+    REQUIRE(list.weights == std::vector<std::int64_t> {0, 4});
+
+    std::istringstream otherInput(text);
+    Autis::Scanner otherScanner(otherInput);
+    ClauseList otherList;
+    Autis::BasicWcnfParser<ClauseList> otherParser(otherScanner, otherList);
+    otherParser.parse();
+    REQUIRE(otherList.clauses == list.clauses);
+
+    // Inputs without header do not declare any size.
+    std::istringstream headless("h 1 2 0\n4 -3 0\n");
+    Autis::Scanner headlessScanner(headless);
+    ReservingClauseList headlessList;
+    Autis::BasicWcnfParser<ReservingClauseList> headlessParser(headlessScanner, headlessList);
+    headlessParser.parse();
+    REQUIRE(headlessList.hints.empty());
+    REQUIRE(headlessList.clauses.size() == 2);
+  }
+}
+
+TEST_CASE("Pipelines give the batches in order and stop on errors", "[core][Pipeline]")
+{
+  SECTION("order of the elements of a queue")
+  {
+    Autis::SpscQueue<int> queue(4);
+    std::thread producer([&queue]
+                         {
+                           for (int i = 0; i < 100000; i++) {
+                             queue.push(int(i));
+                           }
+                           queue.close();
+                         });
+    std::vector<int> values;
+    for (int value; queue.pop(value);) {
+      values.push_back(value);
+    }
+    producer.join();
+    std::vector<int> expected(100000);
+    std::iota(expected.begin(), expected.end(), 0);
+    REQUIRE(values == expected);
+  }
+
+  SECTION("order of the batches")
+  {
+    std::vector<int> values;
+    Autis::runPipeline<std::vector<int>>(
+        2,
+        [](Autis::SpscQueue<std::vector<int>>& queue)
+        {
+          for (int i = 0; i < 20000; i += 2) {
+            queue.push(std::vector<int> {i, i + 1});
+          }
+        },
+        [&values](std::vector<int>& batch) { values.insert(values.end(), batch.begin(), batch.end()); });
+    std::vector<int> expected(20000);
+    std::iota(expected.begin(), expected.end(), 0);
+    REQUIRE(values == expected);
+  }
+
+  SECTION("a failing consumer cancels the producer")
+  {
+    std::atomic<bool> cancelled = false;
+    auto produce = [&cancelled](Autis::SpscQueue<int>& queue)
+    {
+      for (int i = 0;; i++) {
+        if (!queue.push(int(i))) {
+          cancelled = true;
+          throw Autis::PipelineCancelledException();
+        }
+      }
+    };
+    auto consume = [](int& value)
+    {
+      if (value == 1000) {
+        throw std::runtime_error("Consumer failure");
+      }
+    };
+    REQUIRE_THROWS_WITH(Autis::runPipeline<int>(4, produce, consume), "Consumer failure");
+    REQUIRE(cancelled);
+  }
+
+  SECTION("a failing producer gives what it has pushed before")
+  {
+    std::vector<int> values;
+    auto produce = [](Autis::SpscQueue<int>& queue)
+    {
+      for (int i = 0; i < 1000; i++) {
+        queue.push(int(i));
+      }
+      throw std::logic_error("Producer failure");
+    };
+    auto consume = [&values](int& value) { values.push_back(value); };
+    REQUIRE_THROWS_WITH(Autis::runPipeline<int>(4, produce, consume), "Producer failure");
+    REQUIRE(values.size() == 1000);
+    REQUIRE(values.back() == 999);
+  }
+}
+
+TEST_CASE("Pipelined parses give the same problems as direct ones", "[cnf][pb][Pipeline]")
+{
+  // Parses a text with the given parser, in a pipeline or not.
+  auto parse = []<typename Parser>(const std::string& text, Autis::InstanceType type, bool pipelined)
+  {
+    std::istringstream input(text);
+    Autis::Scanner scanner(input);
+    Autis::ParserConfiguration configuration;
+    configuration.setPipelined(pipelined);
+    Autis::Instance instance(type);
+    Parser parser(scanner, nullptr, configuration);
+    parser.parse(instance);
+    return instance;
+  };
+  auto parseCnfInstance = [&](const std::string& text, bool pipelined)
+  { return parse.operator()<Autis::CnfParser>(text, Autis::InstanceType::SAT, pipelined); };
+
+  auto text = largeCnf(200000);
+
+  SECTION("clauses")
+  {
+    auto direct = parseCnfInstance(text, false);
+    REQUIRE(direct.getClauses().size() == 200000);
+    REQUIRE(snapshotOf(parseCnfInstance(text, true)) == snapshotOf(direct));
+  }
+
+  SECTION("pseudo-Boolean constraints")
+  {
+    std::string opb = "* #variable= 100 #constraint= 50000\nmin: +1 x1 -2 x3 ;\n";
+    for (int i = 0; i < 50000; i++) {
+      opb += "+" + std::to_string(i + 1) + " x" + std::to_string((i % 100) + 1) + " -1 ~x"
+             + std::to_string(((i * 7) % 100) + 1) + " >= " + std::to_string(i % 3) + " ;\n";
+    }
+    auto direct = parse.operator()<Autis::OpbParser>(opb, Autis::InstanceType::PSEUDO_BOOLEAN, false);
+    auto pipelined = parse.operator()<Autis::OpbParser>(opb, Autis::InstanceType::PSEUDO_BOOLEAN, true);
+    REQUIRE(direct.getConstraints().size() == 50000);
+    REQUIRE(snapshotOf(pipelined) == snapshotOf(direct));
+  }
+
+  SECTION("errors in the input, after some batches have been given")
+  {
+    auto end = text.find('\n', (text.size() / 4) * 3) + 1;
+    auto illFormed = text.substr(0, end) + "1 x 0\n" + text.substr(end);
+
+    Autis::ClauseBatch expected;
+    REQUIRE_THROWS_AS(parseCnf(illFormed, expected, 1), Except::ParseException);
+    REQUIRE(expected.literals.size() > (1 << 17));
+
+    std::istringstream input(illFormed);
+    Autis::Scanner scanner(input);
+    Autis::ParserConfiguration configuration;
+    configuration.setPipelined(true);
+    Autis::Instance instance(Autis::InstanceType::SAT);
+    Autis::CnfParser parser(scanner, nullptr, configuration);
+    REQUIRE_THROWS_AS(parser.parse(instance), Except::ParseException);
+    REQUIRE(instance.getClauses().literals == expected.literals);
+    REQUIRE(instance.getClauses().offsets == expected.offsets);
+  }
+
+  SECTION("errors in the sink, while the input is being read")
+  {
+    FailingSink sink {1000};
+    std::vector<int> clause;
+    auto parseInPipeline = [&]
+    {
+      Autis::MappedScanner scanner(text.data(), text.data() + text.size());
+      Autis::runParserPipeline<Autis::ClauseBatch, Autis::ClauseBatchWriter>(
+          2,
+          [&scanner](Autis::ClauseBatchWriter& writer)
+          {
+            Autis::BasicCnfParser<Autis::ClauseBatchWriter> parser(scanner, writer);
+            parser.parse();
+          },
+          [&sink, &clause](Autis::ClauseBatch& batch) { batch.replay(sink, clause); });
+    };
+    REQUIRE_THROWS_WITH(parseInPipeline(), "Sink failure");
+  }
+}
+
+TEST_CASE("Snapshots of SAT and pseudo-Boolean instances are loaded back", "[core][Snapshot]")
+{
+  SECTION("clauses, hard and soft")
+  {
+    Autis::Instance instance(Autis::InstanceType::SAT);
+    auto& clauses = instance.getClauses();
+    clauses.reserve(3, 3);
+    clauses.addClause(std::vector<int> {1, -2});
+    clauses.addSoftClause(std::vector<int> {3}, 1LL << 40);
+    clauses.addClause(std::vector<int> {-1, 2, -3});
+
+    auto snapshot = snapshotOf(instance);
+    auto loaded = Autis::readSnapshot(snapshot.data(), snapshot.data() + snapshot.size());
+    REQUIRE(loaded.getType() == Autis::InstanceType::SAT);
+    REQUIRE(loaded.getClauses().nbVariables == 3);
+    REQUIRE(loaded.getClauses().literals == clauses.literals);
+    REQUIRE(loaded.getClauses().offsets == clauses.offsets);
+    REQUIRE(loaded.getClauses().weights == clauses.weights);
+  }
+
+  SECTION("pseudo-Boolean constraints")
+  {
+    std::istringstream input("* #variable= 3 #constraint= 2\n"
+                             "min: +2 x1 -3 x2 ;\n"
+                             "+1 x1 +2 x2 -1 x3 >= 1 ;\n"
+                             "+4 ~x2 +1 x3 <= 4 ;\n");
+    Autis::Scanner scanner(input);
+    Autis::Instance instance(Autis::InstanceType::PSEUDO_BOOLEAN);
+    Autis::BasicOpbParser<Autis::ConstraintBatch> parser(scanner, instance.getConstraints());
+    parser.parse();
+
+    auto snapshot = snapshotOf(instance);
+    auto loaded = Autis::readSnapshot(snapshot.data(), snapshot.data() + snapshot.size());
+    REQUIRE(loaded.getType() == Autis::InstanceType::PSEUDO_BOOLEAN);
+    REQUIRE(loaded.getConstraints().literals == instance.getConstraints().literals);
+    REQUIRE(loaded.getConstraints().operators == instance.getConstraints().operators);
+    REQUIRE(snapshotOf(loaded) == snapshot);
+  }
+
+  SECTION("invalid snapshots")
+  {
+    Autis::Instance instance(Autis::InstanceType::SAT);
+    instance.getClauses().addClause(std::vector<int> {1});
+    auto snapshot = snapshotOf(instance);
+    REQUIRE(snapshot[sizeof(Autis::SNAPSHOT_MAGIC)] == Autis::SNAPSHOT_VERSION);
+
+    auto otherVersion = snapshot;
+    otherVersion[sizeof(Autis::SNAPSHOT_MAGIC)]++;
+    REQUIRE_THROWS_AS(Autis::readSnapshot(otherVersion.data(), otherVersion.data() + otherVersion.size()),
+                      Except::ParseException);
+
+    auto truncated = snapshot.substr(0, snapshot.size() - 1);
+    REQUIRE_THROWS_AS(Autis::readSnapshot(truncated.data(), truncated.data() + truncated.size()),
+                      Except::ParseException);
+  }
+}
+
+TEST_CASE("The parse cache gives back stored instances and bounds its size", "[core][ParseCache]")
+{
+  namespace fs = std::filesystem;
+  auto directory = fs::temp_directory_path() / "autis-cache-test";
+  fs::remove_all(directory);
+
+  Autis::ParserConfiguration configuration;
+  Autis::Instance instance(Autis::InstanceType::SAT);
+  instance.getClauses().addClause(std::vector<int> {1, -2, 3});
+  auto snapshotSize = snapshotOf(instance).size();
+
+  SECTION("hits and misses")
+  {
+    Autis::ParseCache cache(directory.string());
+    REQUIRE(!cache.find(42, configuration).has_value());
+    cache.store(42, configuration, instance);
+    auto found = cache.find(42, configuration);
+    REQUIRE(found.has_value());
+    REQUIRE(found->getClauses().literals == instance.getClauses().literals);
+    REQUIRE(!cache.find(43, configuration).has_value());
+    REQUIRE(cache.getNumberOfHits() == 1);
+    REQUIRE(cache.getNumberOfMisses() == 2);
+  }
+
+  SECTION("least recently used snapshots are evicted")
+  {
+    Autis::ParseCache cache(directory.string(), 2 * snapshotSize);
+    cache.store(1, configuration, instance);
+    cache.store(2, configuration, instance);
+    REQUIRE(cache.find(1, configuration).has_value());
+    for (auto& entry : fs::directory_iterator(directory)) {
+      if (entry.path().filename().string().starts_with(Autis::ContentHash::toString(2))) {
+        fs::last_write_time(entry.path(), fs::file_time_type::clock::now() - std::chrono::minutes(1));
+      }
+    }
+    cache.store(3, configuration, instance);
+    REQUIRE(cache.find(1, configuration).has_value());
+    REQUIRE(!cache.find(2, configuration).has_value());
+    REQUIRE(cache.find(3, configuration).has_value());
+  }
+
+  SECTION("temporary files left behind are removed")
+  {
+    auto stale = directory / "stale.autis.tmp-0";
+    auto pending = directory / "pending.autis.tmp-1";
+    Autis::ParseCache cache(directory.string());
+    std::ofstream(stale) << "stale";
+    std::ofstream(pending) << "pending";
+    fs::last_write_time(stale, fs::file_time_type::clock::now() - std::chrono::hours(2));
+
+    cache.store(1, configuration, instance);
+    REQUIRE(!fs::exists(stale));
+    REQUIRE(fs::exists(pending));
+  }
+
+  fs::remove_all(directory);
+}
+
+TEST_CASE("WBO inputs give their hard and soft constraints", "[pb][BasicWboParser]")
+{
+  auto parseWbo = [](const std::string& text)
+  {
+    std::istringstream input(text);
+    Autis::Scanner scanner(input);
+    Autis::ConstraintBatch batch;
+    Autis::BasicWboParser<Autis::ConstraintBatch> parser(scanner, batch);
+    parser.parse();
+    return batch;
+  };
+
+  SECTION("constraints with every relational operator")
+  {
+    auto batch = parseWbo("* #variable= 3 #constraint= 4 #soft= 2 mincost= 2 maxcost= 5 sumcost= 7\n"
+                          "soft: 8 ;\n"
+                          "+1 x1 +2 x2 >= 1 ;\n"
+                          "[2] +1 x1 -1 x3 <= 0 ;\n"
+                          "* A comment between the constraints.\n"
+                          "[5] +1 ~x2 +1 x3 = 1 ;\n"
+                          "+3 x1 +1 x3 <= 3 ;\n");
+    REQUIRE(batch.size() == 4);
+    REQUIRE(batch.topCostSet);
+    REQUIRE(batch.topCost == 8);
+    REQUIRE(batch.operators
+            == std::vector<Autis::RelationalOperator> {Autis::RelationalOperator::AT_LEAST,
+                                                       Autis::RelationalOperator::AT_MOST,
+                                                       Autis::RelationalOperator::EXACTLY,
+                                                       Autis::RelationalOperator::AT_MOST});
+    REQUIRE(batch.weights == std::vector<std::int64_t> {0, 2, 5, 0});
+    REQUIRE(batch.literals == std::vector<int> {1, 2, 1, 3, -2, 3, 1, 3});
+  }
+
+  SECTION("soft header without top cost")
+  {
+    auto batch = parseWbo("* #variable= 1 #constraint= 1 #soft= 1\n"
+                          "soft: ;\n"
+                          "[1] +1 x1 >= 1 ;\n");
+    REQUIRE(!batch.topCostSet);
+    REQUIRE(batch.weights == std::vector<std::int64_t> {1});
+  }
+
+  SECTION("invalid inputs")
+  {
+    REQUIRE_THROWS_AS(parseWbo("* #variable= 1 #constraint= 1 #soft= 1\n"
+                               "[1] +1 x1 >= 1 ;\n"),
+                      Except::ParseException);
+    REQUIRE_THROWS_AS(parseWbo("* #variable= 1 #constraint= 1 #soft= 1\n"
+                               "soft: ;\n"
+                               "[0] +1 x1 >= 1 ;\n"),
+                      Except::ParseException);
+    REQUIRE_THROWS_AS(parseWbo("* #variable= 1 #constraint= 2 #soft= 1\n"
+                               "soft: ;\n"
+                               "[1] +1 x1 >= 1 ;\n"),
+                      Except::ParseException);
+  }
+}
+
+TEST_CASE("WCNF inputs give their hard and soft clauses", "[cnf][BasicWcnfParser]")
+{
+  using WeightedClauses = std::vector<std::pair<std::int64_t, std::vector<int>>>;
+
+  auto parseWcnf = [](const std::string& text, auto& sink)
+  {
+    std::istringstream input(text);
+    Autis::Scanner scanner(input);
+    using Sink = std::remove_reference_t<decltype(sink)>;
+    Autis::BasicWcnfParser<Sink> parser(scanner, sink);
+    parser.parse();
+    return std::pair {parser.getNumberOfVariables(), parser.getNumberOfConstraints()};
+  };
+
+  // The clauses given one at a time, in the order of the input.
+  auto clausesOf = [&](const std::string& text)
+  {
+    ClauseList list;
+    parseWcnf(text, list);
+    WeightedClauses clauses;
+    for (std::size_t i = 0; i < list.clauses.size(); i++) {
+      clauses.emplace_back(list.weights[i], list.clauses[i]);
+    }
+    return clauses;
+  };
+
+  // The clauses given to a batch, where hard clauses are grouped.
+  auto sortedClausesOf = [&](const std::string& text)
+  {
+    Autis::ClauseBatch batch;
+    parseWcnf(text, batch);
+    WeightedClauses clauses;
+    for (std::size_t i = 0; (i + 1) < batch.offsets.size(); i++) {
+      auto weight = batch.weights.empty() ? 0 : batch.weights[i];
+      auto literals = std::span<const int>(batch.literals)
+                          .subspan(batch.offsets[i], batch.offsets[i + 1] - batch.offsets[i]);
+      clauses.emplace_back(weight, std::vector<int>(literals.begin(), literals.end()));
+    }
+    std::sort(clauses.begin(), clauses.end());
+    return clauses;
+  };
+
+  SECTION("legacy format, where heavy clauses are hard")
+  {
+    std::string text = "c legacy\n"
+                       "p wcnf 3 4 10\n"
+                       "10 1 -2 0\n"
+                       "3 2 0\n"
+                       "c a comment between the clauses\n"
+                       "12 -1 3 0\n"
+                       "9 -3 0\n";
+    WeightedClauses expected = {{0, {1, -2}}, {3, {2}}, {0, {-1, 3}}, {9, {-3}}};
+    REQUIRE(clausesOf(text) == expected);
+    std::sort(expected.begin(), expected.end());
+    REQUIRE(sortedClausesOf(text) == expected);
+
+    ClauseList list;
+    REQUIRE(parseWcnf(text, list) == std::pair {3, 4});
+  }
+
+  SECTION("legacy format without top cost")
+  {
+    WeightedClauses expected = {{5, {1}}, {1 << 20, {-1, 2}}};
+    REQUIRE(clausesOf("p wcnf 2 2\n5 1 0\n1048576 -1 2 0\n") == expected);
+  }
+
+  SECTION("header-less format")
+  {
+    std::string text = "c 2022 format\n"
+                       "h 1 2 0\n"
+                       "4294967296 -1 0\n"
+                       "h -2 3 0\n";
+    WeightedClauses expected = {{0, {1, 2}}, {4294967296LL, {-1}}, {0, {-2, 3}}};
+    REQUIRE(clausesOf(text) == expected);
+    std::sort(expected.begin(), expected.end());
+    REQUIRE(sortedClausesOf(text) == expected);
+
+    ClauseList list;
+    REQUIRE(parseWcnf(text, list) == std::pair {3, 3});
+  }
+
+  SECTION("invalid inputs")
+  {
+    REQUIRE_THROWS_AS(clausesOf("h 1 2 0\n0 -1 0\n"), Except::ParseException);
+    REQUIRE_THROWS_AS(clausesOf("p wcnf 2 1 0\n1 1 0\n"), Except::ParseException);
+    REQUIRE_THROWS_AS(clausesOf("p wcnf 2 2 5\n5 1 0\n"), Except::ParseException);
+    REQUIRE_THROWS_AS(clausesOf("p wcnf 2 1 5\n1 3 0\n"), Except::ParseException);
+    REQUIRE_THROWS_AS(clausesOf("h 1 0\np wcnf 2 1 5\n"), Except::ParseException);
+  }
+}
+
+TEST_CASE("Identical intension subexpressions are recorded once", "[xcsp][XcspInstance]")
+{
+  Autis::XcspInstance csp;
+  auto sum = [&]
+  {
+    return csp.intension(Autis::IntensionOperator::ADD,
+                         {csp.intensionVariable("x"), csp.intensionConstant(1)});
+  };
+
+  auto first = sum();
+  REQUIRE(csp.getNumberOfIntensionNodes() == 3);
+  auto second = sum();
+  REQUIRE(second.node == first.node);
+  auto comparison = csp.intension(Autis::IntensionOperator::LT, {sum(), csp.intensionVariable("x")});
+  REQUIRE(csp.getNumberOfIntensionNodes() == 4);
+  REQUIRE(comparison.node != first.node);
+
+  SECTION("clearing the operations keeps the expressions")
+  {
+    csp.add(Autis::CspOperation::INTENSION, comparison);
+    csp.clear();
+    REQUIRE(csp.size() == 0);
+    REQUIRE(sum().node == first.node);
+    REQUIRE(csp.getNumberOfIntensionNodes() == 4);
+  }
+
+  SECTION("clearing the expressions forgets them")
+  {
+    csp.clearIntensions();
+    REQUIRE(csp.getNumberOfIntensionNodes() == 0);
+    sum();
+    REQUIRE(csp.getNumberOfIntensionNodes() == 3);
+  }
+}
+
+TEST_CASE("Variables are given to solvers by their dense handles", "[xcsp][IVariableHandleListener]")
+{
+  const std::vector<std::string> expected = {
+      "allDifferent 0 1 2", "sum 2 1", "weightedSum 2 1 /2", "primitive 1 4", "support 0 2"};
+  HandleRecorder recorder;
+
+  SECTION("handles of a recorded instance")
+  {
+    Autis::XcspInstance csp;
+    Autis::AutisXcspCallback callback(csp);
+    declareAndConstrain(callback);
+
+    // The handles follow the order in which the variables are declared.
+    REQUIRE(csp.getNumberOfVariables() == 3);
+    REQUIRE(csp.getVariableName(0) == "x");
+    REQUIRE(csp.getVariableName(1) == "y");
+    REQUIRE(csp.getVariableName(2) == "z");
+
+    Universe::UniverseIntensionConstraintFactory factory;
+    csp.replay(recorder, factory);
+    REQUIRE(recorder.constraints == expected);
+    REQUIRE(recorder.rightHandSides == std::vector<Universe::BigInteger> {5, 5});
+  }
+
+  SECTION("handles given while reading")
+  {
+    std::unique_ptr<Autis::AutisXcspCallback> callback(Autis::AutisXcspCallback::newNativeInstance(&recorder));
+    declareAndConstrain(*callback);
+    REQUIRE(recorder.constraints == expected);
+    REQUIRE(recorder.rightHandSides == std::vector<Universe::BigInteger> {5, 5});
+  }
+}
+
+TEST_CASE("Extension constraints of a group share their tuple table", "[xcsp][TupleTable]")
+{
+  XCSP3Core::XDomainInteger domain;
+  XCSP3Core::XVariable x("x", &domain);
+  XCSP3Core::XVariable y("y", &domain);
+  XCSP3Core::XVariable z("z", &domain);
+  HandleRecorder recorder;
+
+  {
+    std::unique_ptr<Autis::AutisXcspCallback> callback(Autis::AutisXcspCallback::newNativeInstance(&recorder));
+    callback->buildVariableInteger("x", 0, 3);
+    callback->buildVariableInteger("y", 0, 3);
+    callback->buildVariableInteger("z", 0, 3);
+
+    std::vector<std::vector<int>> tuples = {{0, 1}, {2, 3}};
+    std::vector<XCSP3Core::XVariable*> first = {&x, &y};
+    std::vector<XCSP3Core::XVariable*> second = {&y, &z};
+    callback->buildConstraintExtension("g[0]", first, tuples, true, false);
+    callback->buildConstraintExtensionAs("g[1]", second, true, false);
+
+    std::vector<std::vector<int>> none;
+    callback->buildConstraintExtension("c", first, none, false, false);
+  }
+
+  REQUIRE(recorder.constraints == std::vector<std::string> {"support 0 1", "support 1 2", "conflicts 0 1"});
+  REQUIRE(recorder.tables.size() == 3);
+  REQUIRE(recorder.tables[0].get() == recorder.tables[1].get());
+
+  // The table outlives the callback which has read it.
+  auto& table = *recorder.tables[1];
+  REQUIRE(table.size() == 2);
+  REQUIRE(table.getArity() == 2);
+  REQUIRE(std::ranges::equal(table[1], std::vector<int> {2, 3}));
+
+  // An empty table still has the arity of its scope.
+  REQUIRE(recorder.tables[2]->size() == 0);
+  REQUIRE(recorder.tables[2]->getArity() == 2);
+}
+
+TEST_CASE("XCSP3 inputs are streamed to the callback one element at a time",
+          "[xcsp][XcspStreamReader]")
+{
+  auto read = [](const std::string& text)
+  {
+    std::istringstream input(text);
+    XcspEventList callback;
+    Autis::XcspStreamReader reader(input, callback);
+    reader.read();
+    return std::pair {callback.events, reader.isOptimization()};
+  };
+
+  SECTION("variables, constraints and objectives")
+  {
+    auto [events, optimization] = read(
+        "<instance format=\"XCSP3\" type=\"COP\">\n"
+        "  <variables>\n"
+        "    <array id=\"x\" size=\"[3]\"> 0..2 </array>\n"
+        "    <var id=\"y\"> 1 3 5 </var>\n"
+        "  </variables>\n"
+        "  <constraints>\n"
+        "    <!-- The tuples of the pattern are shared by the group. -->\n"
+        "    <group id=\"g\">\n"
+        "      <extension><list> %0 %1 </list><supports> (0,1)(1,2) </supports></extension>\n"
+        "      <args> x[0] x[1] </args>\n"
+        "      <args> x[1] x[2] </args>\n"
+        "    </group>\n"
+        "    <intension> lt(x[0],y) </intension>\n"
+        "    <sum><list> x[] </list><coeffs> 1 2 3 </coeffs><condition> (le,4) </condition></sum>\n"
+        "  </constraints>\n"
+        "  <objectives><minimize> x[2] </minimize></objectives>\n"
+        "</instance>\n");
+    REQUIRE(optimization);
+    REQUIRE(events
+            == std::vector<std::string> {"COP",
+                                         "var x[0] 0..2",
+                                         "var x[1] 0..2",
+                                         "var x[2] 0..2",
+                                         "var y 1 3 5",
+                                         "group g",
+                                         "extension x[0] x[1] (0 1)(1 2)",
+                                         "extension as x[1] x[2]",
+                                         "end group",
+                                         "intension 1 2",
+                                         "sum x[0] x[1] x[2] * 1 2 3 <= 4",
+                                         "minimize x[2]"});
+  }
+
+  SECTION("invalid inputs")
+  {
+    REQUIRE_THROWS_AS(read("<instance type=\"CSP\"><variables>"), Except::ParseException);
+    REQUIRE_THROWS_AS(read("<instance type=\"CSP\"><constraints><circuit> x[] </circuit></constraints></instance>"),
+                      Except::UnsupportedOperationException);
+  }
+}